@@ -0,0 +1,168 @@
+// ============================================================================
+// File: bench_eval_result.c
+// Microbenchmark: per-node cost of returning ezom_eval_result_t by value
+// ============================================================================
+//
+// Walks a parsed expression the way the evaluator does (one result struct
+// returned per node) with the current compact result and with the old
+// layout that carried a 256-byte error buffer. The walkers skip the
+// evaluator's debug output so only the result passing is measured. Stack
+// depth matters as much as time on the eZ80, so both are reported.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "include/ezom_object.h"
+#include "include/ezom_memory.h"
+#include "include/ezom_primitives.h"
+#include "include/ezom_dispatch.h"
+#include "include/ezom_lexer.h"
+#include "include/ezom_parser.h"
+#include "include/ezom_evaluator.h"
+
+#define BENCH_ITERATIONS 200000
+
+// Result layout before the error text moved to g_eval_error
+typedef struct legacy_eval_result {
+    uint24_t value;
+    bool     is_return;
+    bool     is_error;
+    char     error_msg[256];
+} legacy_eval_result_t;
+
+// Each walker mirrors the evaluator's shape: a dispatching entry point,
+// a per-node-type function, results built by a make function, statement
+// lists assigning into a running result, and sends keeping the receiver
+// and argument results in locals. The deepest frame records its stack
+// address so frame sizes can be compared.
+static uintptr_t g_stack_low;
+
+#define DEFINE_WALKER(SUFFIX, RESULT_T, CLEAR_MESSAGE)                               \
+static __attribute__((noinline)) RESULT_T make_##SUFFIX(uint24_t value) {            \
+    RESULT_T result;                                                                 \
+    result.value = value;                                                            \
+    result.is_return = false;                                                        \
+    result.is_error = false;                                                         \
+    CLEAR_MESSAGE;                                                                   \
+    return result;                                                                   \
+}                                                                                    \
+                                                                                     \
+static RESULT_T walk_##SUFFIX(ezom_ast_node_t* node);                                \
+                                                                                     \
+static __attribute__((noinline)) RESULT_T send_##SUFFIX(ezom_ast_node_t* node) {     \
+    RESULT_T receiver_result = walk_##SUFFIX(node->data.message_send.receiver);      \
+    if (receiver_result.is_error) {                                                  \
+        return receiver_result;                                                      \
+    }                                                                                \
+    RESULT_T arg_result = walk_##SUFFIX(node->data.message_send.arguments);          \
+    if (arg_result.is_error) {                                                       \
+        return arg_result;                                                           \
+    }                                                                                \
+    return make_##SUFFIX(receiver_result.value ^ arg_result.value);                  \
+}                                                                                    \
+                                                                                     \
+static __attribute__((noinline)) RESULT_T list_##SUFFIX(ezom_ast_node_t* node) {     \
+    RESULT_T result = make_##SUFFIX(g_nil);                                          \
+    for (ezom_ast_node_t* current = node->data.statement_list.statements;            \
+         current; current = current->next) {                                        \
+        result = walk_##SUFFIX(current);                                             \
+        if (result.is_return || result.is_error) {                                   \
+            break;                                                                   \
+        }                                                                            \
+    }                                                                                \
+    return result;                                                                   \
+}                                                                                    \
+                                                                                     \
+static __attribute__((noinline)) RESULT_T walk_##SUFFIX(ezom_ast_node_t* node) {     \
+    switch (node->type) {                                                            \
+        case AST_MESSAGE_SEND:                                                       \
+            return send_##SUFFIX(node);                                              \
+        case AST_STATEMENT_LIST:                                                     \
+            return list_##SUFFIX(node);                                              \
+        default: {                                                                   \
+            char marker;                                                             \
+            if ((uintptr_t)&marker < g_stack_low) g_stack_low = (uintptr_t)&marker; \
+            return make_##SUFFIX(ezom_create_integer(node->data.literal.value.integer_value)); \
+        }                                                                            \
+    }                                                                                \
+}
+
+DEFINE_WALKER(legacy, legacy_eval_result_t, result.error_msg[0] = '\0')
+DEFINE_WALKER(compact, ezom_eval_result_t, (void)0)
+
+static uint16_t count_nodes(ezom_ast_node_t* node) {
+    uint16_t count = 1;
+    if (node->type == AST_MESSAGE_SEND) {
+        count += count_nodes(node->data.message_send.receiver);
+        count += count_nodes(node->data.message_send.arguments);
+    } else if (node->type == AST_STATEMENT_LIST) {
+        for (ezom_ast_node_t* current = node->data.statement_list.statements; current; current = current->next) {
+            count += count_nodes(current);
+        }
+    }
+    return count;
+}
+
+// Stack bytes used by one walk of the tree
+#define MEASURE_STACK(WALK, AST, OUT)              \
+    do {                                           \
+        char top;                                  \
+        g_stack_low = (uintptr_t)&top;             \
+        WALK(AST);                                 \
+        OUT = (uintptr_t)&top - g_stack_low;       \
+    } while (0)
+
+int main() {
+    ezom_init_memory();
+    ezom_init_object_system();
+    ezom_init_primitives();
+    ezom_bootstrap_enhanced_classes();
+
+    const char* source = "((1 + 2) * (3 - 4)) + ((5 + 6) * (7 - 8)) + ((9 + 10) * (11 - 12))";
+    ezom_lexer_t lexer;
+    ezom_parser_t parser;
+    ezom_lexer_init(&lexer, (char*)source);
+    ezom_parser_init(&parser, &lexer);
+    ezom_ast_node_t* expression = ezom_parse_expression(&parser);
+    if (!expression) {
+        printf("Parse failed\n");
+        return 1;
+    }
+
+    // Run it as a method body would: a statement list with a few literals
+    ezom_ast_node_t* ast = ezom_ast_create_statement_list();
+    for (int i = 0; i < 4; i++) {
+        ezom_ast_add_statement(ast, ezom_ast_create_literal_integer(i));
+    }
+    ezom_ast_add_statement(ast, expression);
+
+    uint16_t nodes = count_nodes(ast);
+    volatile uint24_t sink = 0;
+
+    clock_t start = clock();
+    for (long i = 0; i < BENCH_ITERATIONS; i++) {
+        sink ^= walk_legacy(ast).value;
+    }
+    double legacy_ns = (double)(clock() - start) * 1e9 / CLOCKS_PER_SEC / ((double)BENCH_ITERATIONS * nodes);
+
+    start = clock();
+    for (long i = 0; i < BENCH_ITERATIONS; i++) {
+        sink ^= walk_compact(ast).value;
+    }
+    double compact_ns = (double)(clock() - start) * 1e9 / CLOCKS_PER_SEC / ((double)BENCH_ITERATIONS * nodes);
+
+    uintptr_t legacy_stack, compact_stack;
+    MEASURE_STACK(walk_legacy, ast, legacy_stack);
+    MEASURE_STACK(walk_compact, ast, compact_stack);
+
+    printf("\n=== Evaluation Result Microbenchmark ===\n");
+    printf("Statements: 4 literals, %s (%d nodes), %d iterations\n", source, nodes, BENCH_ITERATIONS);
+    printf("  legacy result:  %3zu bytes, %6.2f ns/node, %5lu stack bytes\n",
+           sizeof(legacy_eval_result_t), legacy_ns, (unsigned long)legacy_stack);
+    printf("  compact result: %3zu bytes, %6.2f ns/node, %5lu stack bytes\n",
+           sizeof(ezom_eval_result_t), compact_ns, (unsigned long)compact_stack);
+    printf("  speedup: %.2fx\n", compact_ns > 0 ? legacy_ns / compact_ns : 0.0);
+
+    return 0;
+}
@@ -0,0 +1,149 @@
+// ============================================================================
+// File: include/ezom_aot.h
+// Classes translated to C ahead of time by ezom_aotc (-DEZOM_AOT builds)
+// ============================================================================
+
+#pragma once
+#include "ezom_object.h"
+#include "ezom_memory.h"
+#include "ezom_dispatch.h"
+#include "ezom_context.h"
+#include "ezom_evaluator.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+// ezom_aotc parses .som class files offline and writes one C file that
+// describes each class and holds one C function per method. Linked into
+// ezom_native built with -DEZOM_AOT, the classes are registered at startup
+// instead of being parsed, and their methods run as compiled C.
+//
+// A translated method keeps parameters and locals in C variables, inlines
+// what the resolver inlines (ifTrue:, and:, whileTrue:, to:do:,
+// timesRepeat: ...) and SmallInteger + - * < > <= >= = while Integer still
+// has its primitives for them; every other send goes through a per-site
+// inline cache. A method with a block that stays a closure is written out
+// as SOM source instead and parsed at startup, so it runs interpreted.
+
+typedef uint24_t (*ezom_aot_fn_t)(uint24_t self, uint24_t* args);
+
+typedef struct ezom_aot_method {
+    const char*   selector;
+    uint8_t       arg_count;
+    ezom_aot_fn_t function;     // Translated body, or NULL...
+    const char*   source;       // ...for SOM source to parse at startup
+} ezom_aot_method_t;
+
+typedef struct ezom_aot_class {
+    const char*              name;
+    const char*              superclass;   // NULL = Object
+    const char* const*       fields;
+    uint16_t                 field_count;
+    const ezom_aot_method_t* methods;
+    uint16_t                 method_count;
+    const ezom_aot_method_t* class_methods;
+    uint16_t                 class_method_count;
+} ezom_aot_class_t;
+
+// What one ezom_aotc run produced (the generated file defines
+// ezom_aot_program)
+typedef struct ezom_aot_program {
+    const char*             source_file;
+    const ezom_aot_class_t* classes;    // In definition order
+    uint16_t                class_count;
+    const char*             main_class; // Last class: new run
+    void                  (*init)(void); // Global cells and literal objects
+} ezom_aot_program_t;
+
+typedef struct ezom_aot_stats {
+    uint32_t classes;
+    uint32_t translated;        // Methods registered as C
+    uint32_t parsed;            // Methods parsed from source at startup
+    uint32_t runs;              // Activations of translated methods
+} ezom_aot_stats_t;
+
+extern const ezom_aot_program_t ezom_aot_program;
+extern ezom_aot_stats_t g_aot_stats;
+
+// Registration and the entry point of a translated program
+bool ezom_aot_load_program(const ezom_aot_program_t* program);
+int ezom_aot_run_program(const ezom_aot_program_t* program, const char* main_class);
+uint24_t ezom_aot_define_class(const ezom_aot_class_t* aot_class);
+ezom_eval_result_t ezom_aot_run(ezom_method_code_t* method_code, uint24_t receiver, uint24_t* args);
+void ezom_aot_print_stats(void);
+
+// Runtime support for generated code
+uint24_t ezom_aot_send(ezom_inline_cache_t* ic, const char* selector, uint24_t receiver,
+                       uint24_t* args, uint8_t arg_count);
+uint24_t ezom_aot_store_global(ezom_global_t* global, uint24_t value);
+uint24_t ezom_aot_undefined(const char* name);
+uint24_t ezom_aot_literal_array(const uint24_t* elements, uint16_t count);
+bool ezom_aot_check_integers(void);
+
+extern uint32_t g_aot_integer_version;  // Integer's dispatch_version last checked...
+extern bool g_aot_integer_ok;           // ...and whether the primitives were there
+
+// A send unwinding to a ^ home or an exception handler leaves the method
+#define EZOM_AOT_CHECK()    do { if (EZOM_FRAME_UNWINDING()) return 0; } while (0)
+
+// Instance variables of self, after the object header
+#define EZOM_AOT_FIELDS(self) ((uint24_t*)((char*)EZOM_OBJECT_PTR(self) + sizeof(ezom_object_t)))
+
+// Variables outlive the statement: scratch Doubles go to the heap first
+static inline uint24_t ezom_aot_keep(uint24_t value) {
+    return EZOM_IS_SMALLINT(value) ? value : ezom_promote_double(value);
+}
+
+// Locals hold Doubles by value, as frame slots do
+static inline uint24_t ezom_aot_load(uint24_t local) {
+    return EZOM_IS_SMALLINT(local) ? local : ezom_load_slot_double(local);
+}
+
+static inline uint24_t ezom_aot_store(uint24_t local, uint24_t value) {
+    return EZOM_IS_SMALLINT(value) ? value : ezom_store_slot_double(local, value);
+}
+
+static inline bool ezom_aot_integers(uint24_t a, uint24_t b) {
+    return EZOM_IS_SMALLINT(a) && EZOM_IS_SMALLINT(b) &&
+           (g_aot_integer_version == ezom_class_version(g_integer_class) ? g_aot_integer_ok : ezom_aot_check_integers());
+}
+
+// SmallInteger shortcuts: false leaves the operation to a send
+static inline bool ezom_aot_add(uint24_t a, uint24_t b, uint24_t* result) {
+    if (!ezom_aot_integers(a, b)) return false;
+    int32_t sum = EZOM_SMALLINT_VALUE(a) + EZOM_SMALLINT_VALUE(b);
+    if (!EZOM_SMALLINT_FITS(sum)) return false;
+    *result = EZOM_SMALLINT_FROM(sum);
+    return true;
+}
+
+static inline bool ezom_aot_sub(uint24_t a, uint24_t b, uint24_t* result) {
+    if (!ezom_aot_integers(a, b)) return false;
+    int32_t difference = EZOM_SMALLINT_VALUE(a) - EZOM_SMALLINT_VALUE(b);
+    if (!EZOM_SMALLINT_FITS(difference)) return false;
+    *result = EZOM_SMALLINT_FROM(difference);
+    return true;
+}
+
+static inline bool ezom_aot_mul(uint24_t a, uint24_t b, uint24_t* result) {
+    int32_t product;
+    if (!ezom_aot_integers(a, b) ||
+        __builtin_mul_overflow(EZOM_SMALLINT_VALUE(a), EZOM_SMALLINT_VALUE(b), &product) ||
+        !EZOM_SMALLINT_FITS(product)) {
+        return false;
+    }
+    *result = EZOM_SMALLINT_FROM(product);
+    return true;
+}
+
+#define EZOM_AOT_COMPARE(name, op) \
+    static inline bool ezom_aot_##name(uint24_t a, uint24_t b, uint24_t* result) { \
+        if (!ezom_aot_integers(a, b)) return false; \
+        *result = EZOM_SMALLINT_VALUE(a) op EZOM_SMALLINT_VALUE(b) ? g_true : g_false; \
+        return true; \
+    }
+
+EZOM_AOT_COMPARE(less, <)
+EZOM_AOT_COMPARE(greater, >)
+EZOM_AOT_COMPARE(less_equal, <=)
+EZOM_AOT_COMPARE(greater_equal, >=)
+EZOM_AOT_COMPARE(equal, ==)
@@ -0,0 +1,32 @@
+// ============================================================================
+// File: include/ezom_aotc.h
+// SOM-to-C translator behind the ezom_aotc tool (see ezom_aot.h)
+// ============================================================================
+
+#pragma once
+#include "ezom_ast.h"
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+// The translator parses a .som file of class definitions, defines the
+// classes in the running VM so the resolver sees their instance variables,
+// and writes C for the resolved methods: one function per method plus the
+// class descriptions and ezom_aot_program for a -DEZOM_AOT build.
+
+typedef struct ezom_aotc_stats {
+    uint16_t classes;
+    uint16_t translated;        // Methods written as C functions
+    uint16_t kept;              // Methods written as SOM source
+} ezom_aotc_stats_t;
+
+// translate false keeps every method as source: the same program run by
+// the interpreter, for comparison. False if the file does not parse.
+bool ezom_aotc_translate_file(const char* source, const char* source_name, FILE* out,
+                              bool translate, ezom_aotc_stats_t* stats);
+
+// Why a method cannot be translated, or NULL
+const char* ezom_aotc_unsupported(ezom_ast_node_t* method_ast);
+
+// SOM source for a parsed (and possibly resolved) method
+void ezom_aotc_write_source(FILE* out, ezom_ast_node_t* method_ast);
@@ -26,10 +26,83 @@ typedef enum {
     AST_SUPER_SEND,
     AST_VARIABLE_LIST,
     AST_STATEMENT_LIST,
-    AST_PARAMETER_LIST
+    AST_PARAMETER_LIST,
+    AST_INCREMENT           // x := x + k from the optimizer: data.assignment (ezom_optimizer.h)
 } ezom_ast_type_t;
 
+// How a resolved variable reference finds its value (see ezom_resolver.h)
+typedef enum {
+    AST_VAR_UNRESOLVED,     // Not resolved yet: looked up by name at run time
+    AST_VAR_CONTEXT,        // Frame slot index, or the block's capture
+    AST_VAR_INSTANCE,       // Instance variable slot index of self
+    AST_VAR_GLOBAL,         // Global binding cell
+    AST_VAR_SELF            // The receiver, or the block's capture of it
+} ezom_var_kind_t;
+
+// A variable reference in a closure reads the block's captured_vars
+// (capture) instead of a frame slot
+#define AST_NO_CAPTURE  0xFF
+
+// Where a closure's captured value comes from when the block is created
+typedef enum {
+    AST_CAPTURE_LOCAL,      // Slot index of the creating frame
+    AST_CAPTURE_OUTER,      // captured_vars[index] of the creating block
+    AST_CAPTURE_SELF        // Receiver of the creating (home) frame
+} ezom_capture_source_t;
+
+typedef struct ezom_capture {
+    uint8_t source;         // ezom_capture_source_t
+    uint8_t index;
+} ezom_capture_t;
+
+// What the resolver works out about a block's variables, kept beside the
+// node so every AST node stays the same size
+typedef struct ezom_block_vars {
+    ezom_capture_t* captures;   // Values copied into a new closure
+    uint8_t* boxed;             // Slots that hold boxes, made on entry
+    uint8_t capture_count;
+    uint8_t boxed_count;
+    uint24_t object;            // Clean block: the shared object (0 = not yet)
+} ezom_block_vars_t;
+
+// Control-flow sends the resolver inlines when their block arguments are
+// literals: the blocks run in the enclosing frame, not as closures
+typedef enum {
+    AST_INLINE_NONE,        // Ordinary send
+    AST_INLINE_IF_TRUE,
+    AST_INLINE_IF_FALSE,
+    AST_INLINE_IF_TRUE_IF_FALSE,
+    AST_INLINE_AND,
+    AST_INLINE_OR,
+    AST_INLINE_WHILE_TRUE,  // Receiver is a literal block too
+    AST_INLINE_WHILE_FALSE,
+    AST_INLINE_TO_DO,
+    AST_INLINE_TIMES_REPEAT
+} ezom_inline_kind_t;
+
+// What an ordinary send node rewrites itself to once it has run a few
+// times on one receiver class (AST engine, see ezom_evaluator.h). Each
+// variant checks a cheap guard before taking its shortcut.
+typedef enum {
+    AST_SPECIAL_NONE,       // Warming up: counting executions
+    AST_SPECIAL_GENERIC,    // Ordinary send for good
+    AST_SPECIAL_INT_ADD,    // SmallInteger receiver and argument...
+    AST_SPECIAL_INT_SUB,
+    AST_SPECIAL_INT_LESS,
+    AST_SPECIAL_INT_GREATER,
+    AST_SPECIAL_INT_LESS_EQ,
+    AST_SPECIAL_INT_GREATER_EQ,
+    AST_SPECIAL_INT_EQ,     // ...up to here
+    AST_SPECIAL_IDENTITY_EQ,    // Object>>= on the cached receiver class
+    AST_SPECIAL_IVAR_GET,       // Getter: reads slot special_slot of self
+    AST_SPECIAL_BLOCK_VALUE0,
+    AST_SPECIAL_BLOCK_VALUE1
+} ezom_special_kind_t;
+
 typedef struct ezom_ast_node ezom_ast_node_t;
+struct ezom_inline_cache;   // Per-call-site dispatch cache (ezom_dispatch.h)
+struct ezom_global;         // Global binding cell (ezom_evaluator.h)
+struct ezom_code;           // Compiled bytecode (ezom_bytecode.h)
 
 struct ezom_ast_node {
     ezom_ast_type_t type;
@@ -56,6 +129,9 @@ struct ezom_ast_node {
             bool is_class_method;
             bool is_primitive;
             uint8_t primitive_number;
+            uint8_t inlined_slots;          // Frame slots after the locals for inlined blocks
+            uint8_t boxed_count;
+            uint8_t* boxed;                 // Own slots that hold boxes, made on entry
         } method_def;
         
         // Variable definition/reference
@@ -64,6 +140,10 @@ struct ezom_ast_node {
             bool is_instance_var;
             bool is_local;
             uint16_t index;
+            uint8_t kind;                   // ezom_var_kind_t
+            uint8_t capture;                // Block capture to read (AST_NO_CAPTURE = frame)
+            bool boxed;                     // CONTEXT: the value lives in a shared box
+            struct ezom_global* global;     // Binding cell (GLOBAL)
         } variable;
         
         // Message send (unified for all message types)
@@ -73,6 +153,12 @@ struct ezom_ast_node {
             ezom_ast_node_t* arguments;
             bool is_super;
             uint8_t arg_count;
+            struct ezom_inline_cache* inline_cache; // Lazily allocated on first send
+            uint8_t inline_kind;                    // ezom_inline_kind_t (resolver)
+            uint8_t special;                        // ezom_special_kind_t
+            uint8_t special_slot;                   // IVAR_GET: instance variable index
+            uint8_t executions;                     // Sends made while warming up
+            uint32_t special_version;               // Receiver class's dispatch_version then
         } message_send;
         
         // Block (closure)
@@ -80,8 +166,15 @@ struct ezom_ast_node {
             ezom_ast_node_t* parameters;
             ezom_ast_node_t* locals;
             ezom_ast_node_t* body;
+            struct ezom_code* code;     // Bytecode, compiled on first run
+            ezom_block_vars_t* vars;    // Captures, boxes, shared object (NULL = none)
             uint8_t param_count;
             uint8_t local_count;
+            bool no_bytecode;           // Compiler declined: evaluate the AST
+            bool inlined;               // Runs in the enclosing frame...
+            uint8_t inline_base;        // ...with its variables from this slot on
+            uint8_t inlined_slots;      // Frame slots after the locals for inlined blocks
+            bool clean;                 // No outer references and no ^ (resolver)
         } block;
         
         // Return statement
@@ -100,6 +193,7 @@ struct ezom_ast_node {
         struct {
             enum {
                 LITERAL_INTEGER,
+                LITERAL_DOUBLE,
                 LITERAL_STRING,
                 LITERAL_SYMBOL,
                 LITERAL_ARRAY,
@@ -108,11 +202,13 @@ struct ezom_ast_node {
                 LITERAL_FALSE
             } type;
             union {
-                int16_t integer_value;
+                ezom_large_int_t integer_value;
+                double double_value;
                 char* string_value;
                 char* symbol_value;
                 ezom_ast_node_t* array_elements;
             } value;
+            uint24_t object;    // Materialized on first evaluation (0 = not yet)
         } literal;
         
         // Identifier
@@ -143,7 +239,8 @@ ezom_ast_node_t* ezom_ast_create_message_send(ezom_ast_node_t* receiver, char* s
 ezom_ast_node_t* ezom_ast_create_block(void);
 ezom_ast_node_t* ezom_ast_create_return(ezom_ast_node_t* expression);
 ezom_ast_node_t* ezom_ast_create_assignment(ezom_ast_node_t* variable, ezom_ast_node_t* value);
-ezom_ast_node_t* ezom_ast_create_literal_integer(int16_t value);
+ezom_ast_node_t* ezom_ast_create_literal_integer(ezom_large_int_t value);
+ezom_ast_node_t* ezom_ast_create_literal_double(double value);
 ezom_ast_node_t* ezom_ast_create_literal_string(const char* value);
 ezom_ast_node_t* ezom_ast_create_literal_symbol(const char* value);
 ezom_ast_node_t* ezom_ast_create_identifier(const char* name);
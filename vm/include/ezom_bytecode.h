@@ -0,0 +1,130 @@
+// ============================================================================
+// File: include/ezom_bytecode.h
+// Bytecode format, compiler, and interpreter
+// ============================================================================
+
+#pragma once
+#include "ezom_ast.h"
+#include "ezom_object.h"
+#include "ezom_dispatch.h"
+#include "ezom_evaluator.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+// Computed-goto threaded dispatch where the compiler has labels as values
+// (GCC and clang, including the eZ80 toolchain); a switch loop otherwise
+#if defined(__GNUC__) && !defined(EZOM_NO_THREADED_DISPATCH)
+#define EZOM_THREADED_DISPATCH 1
+#endif
+
+// Execution engine for methods, blocks and programs
+typedef enum {
+    EZOM_ENGINE_BYTECODE = 0,   // Compiled bytecode (AST fallback per unit)
+    EZOM_ENGINE_AST             // Recursive AST evaluation
+} ezom_engine_t;
+
+extern ezom_engine_t g_engine;
+
+// Instruction set. Opcodes are one byte; operands are one byte each,
+// except jump targets, which are two-byte offsets from the start of the
+// code (low byte first). Context slots follow the context layout
+// (parameters, locals, then inlined blocks' variables), and a capture is
+// an index into the running block's captured_vars, as resolved by
+// ezom_resolver.h. A self operand of 0 is the frame's receiver; n is the
+// block's captured_vars[n - 1]. Stores leave the value on the stack.
+//
+// A boxed variable's slot or capture holds its box: BOX_LOCAL makes the
+// box on entry to its scope, and reads and writes go through it.
+//
+// Inlined control flow keeps loop state on the operand stack: to:do:
+// holds start, limit and index; timesRepeat: holds count and index. Where
+// the receiver is not a Boolean or SmallInteger, the branch and loop
+// instructions jump to "other", which sends the message after all.
+//
+// A ^ in a block's own code returns from the method the block was made in
+// (see ezom_context.h); one inlined into a method is a plain RETURN.
+typedef enum {
+    BC_PUSH_LOCAL,      // slot             locals[slot] of this context
+    BC_PUSH_CAPTURED,   // capture          the running block's copy of a variable
+    BC_PUSH_FIELD,      // self index       instance variable of self
+    BC_PUSH_GLOBAL,     // global           global binding cell
+    BC_PUSH_SELF,       // self             receiver of the home context
+    BC_PUSH_LITERAL,    // literal          literal table entry
+    BC_PUSH_NIL,
+    BC_PUSH_TRUE,
+    BC_PUSH_FALSE,
+    BC_PUSH_BLOCK,      // block            new closure copying its captures
+    BC_STORE_LOCAL,     // slot
+    BC_STORE_BOX,       //                  value box -> value
+    BC_STORE_FIELD,     // self index
+    BC_STORE_GLOBAL,    // global
+    BC_POP,             //                  end of statement: scratch Doubles die
+    BC_DROP,            //                  pop inside an expression
+    BC_SEND,            // site             receiver and arguments on the stack
+    BC_RETURN,          //                  ^ top of stack
+    BC_END,             //                  end of body: top of stack
+    BC_JUMP,            // target
+    BC_JUMP_IF_TRUE,    // target other     pop true: jump; pop false: next
+    BC_JUMP_IF_FALSE,   // target other     pop false: jump; pop true: next
+    BC_TO_DO,           // exit other       start limit -> start limit index
+    BC_TIMES_REPEAT,    // exit other       count -> count index
+    BC_LOOP_NEXT,       // body             index at limit: pop; else step, jump
+    BC_BOX_LOCAL,       // slot             locals[slot] into a new box
+    BC_UNBOX,           //                  box -> value
+    BC_RETURN_NONLOCAL, //                  ^ in a block: top of stack from its home
+    BC_OPCODE_COUNT
+} ezom_opcode_t;
+
+// Jump target operand at p
+#define BC_READ_TARGET(p)   ((uint16_t)((p)[0] | ((p)[1] << 8)))
+
+// A send site: selector and argument count, with its own inline cache
+typedef struct ezom_send_site {
+    const char*         selector;       // Selector text (owned by the AST)
+    uint8_t             arg_count;
+    ezom_inline_cache_t cache;
+} ezom_send_site_t;
+
+// One compiled method, block, or program body
+typedef struct ezom_code {
+    uint8_t*           bytecodes;
+    uint16_t           length;
+    uint8_t            param_count;
+    uint8_t            local_count;     // Locals after the parameters
+    uint8_t            max_stack;       // Operand stack slots needed
+    uint8_t            literal_count;
+    uint8_t            global_count;
+    uint8_t            site_count;
+    uint8_t            block_count;
+    uint24_t*          literals;        // Fixed literal objects
+    ezom_global_t**    globals;         // Binding cells
+    ezom_send_site_t*  sites;
+    ezom_ast_node_t**  blocks;          // Block literals (compiled on first run)
+} ezom_code_t;
+
+// Engine statistics
+typedef struct ezom_bytecode_stats {
+    uint16_t units;             // Code units compiled
+    uint32_t bytes;             // Bytecode bytes generated
+    uint16_t fallbacks;         // Units left to the AST evaluator
+    uint32_t activations;       // Interpreter activations
+} ezom_bytecode_stats_t;
+
+extern ezom_bytecode_stats_t g_bytecode_stats;
+
+// Compiler. Each returns NULL if the body uses something the compiler
+// does not handle (such as an unresolved identifier); callers then
+// evaluate the AST instead.
+ezom_code_t* ezom_compile_method(ezom_ast_node_t* method_ast);
+ezom_code_t* ezom_compile_block(ezom_ast_node_t* block_ast);    // Cached on the node
+ezom_code_t* ezom_compile_program(ezom_ast_node_t* ast);
+void ezom_code_free(ezom_code_t* code);
+void ezom_code_print(ezom_code_t* code);
+
+// Interpreter: runs code in an existing context with its locals bound
+void ezom_set_engine(ezom_engine_t engine);
+ezom_eval_result_t ezom_interpret(ezom_code_t* code, uint24_t context);
+
+// Run a top-level program on the selected engine
+ezom_eval_result_t ezom_run_program(ezom_ast_node_t* ast, uint24_t context);
+void ezom_bytecode_print_stats(void);
@@ -37,6 +37,14 @@ uint24_t ezom_create_enhanced_block_context(uint24_t outer_context, uint24_t blo
 
 // Block object functions (Phase 2 extensions)
 uint24_t ezom_create_ast_block(ezom_ast_node_t* ast_node, uint24_t outer_context);
+uint24_t ezom_block_literal(ezom_ast_node_t* ast_node, uint24_t context);  // Clean blocks: one shared object
+uint24_t ezom_block_capture(uint24_t block_ptr, uint8_t index);
+
+// Boxes for variables closures capture and code assigns
+uint24_t ezom_create_box(uint24_t value);
+uint24_t ezom_box_get(uint24_t box);
+void ezom_box_set(uint24_t box, uint24_t value);
+void ezom_box_locals(uint24_t context, const uint8_t* slots, uint8_t count);
 uint24_t ezom_block_evaluate(uint24_t block_ptr, uint24_t* args, uint8_t arg_count);
 
 // Boolean object functions
@@ -55,6 +63,107 @@ uint24_t ezom_context_get_variable(uint24_t context_ptr, const char* var_name, u
 void ezom_context_set_variable(uint24_t context_ptr, const char* var_name, uint8_t var_index, uint24_t value);
 uint24_t ezom_create_extended_context(uint24_t outer_context, uint24_t receiver, uint16_t method_index, uint8_t local_count);
 
+// Frame stack: method and block activations run in contexts bump-allocated
+// from one contiguous region (EZOM_FRAME_STACK_START, outside the heap)
+// and released when they return. A frame is copied to the heap on exit
+// only if a closure over it escaped, i.e. was stored somewhere that
+// outlives the frame or was answered from it. Such closures are kept in a
+// capture log and repointed at the copy.
+//
+// Running out of region, or going deeper than max_depth frames, is a
+// stack overflow: the backtrace is printed and the overflow flag set so
+// every activation unwinds with a "Stack overflow" error.
+//
+// Frames are numbered as they are pushed. A block records the number of
+// its home frame, the method activation its ^ returns from, so a
+// non-local return checks that frame is still on the stack and sets the
+// returning flag: activations unwind as on overflow until the home frame,
+// which answers return_value. Home 0 is the top level. A signaled
+// exception unwinds the same way to the on:do: that handled it
+// (ezom_exceptions.h).
+#ifdef EZOM_PLATFORM_EZ80
+#define EZOM_DEFAULT_MAX_DEPTH  1000
+#define EZOM_MAX_NATIVE_DEPTH   32      // Activations nested on the C stack
+#define EZOM_FRAME_ALIGNMENT    2
+#else
+#define EZOM_DEFAULT_MAX_DEPTH  200000
+#define EZOM_MAX_NATIVE_DEPTH   2000
+#define EZOM_FRAME_ALIGNMENT    8
+#endif
+
+#define EZOM_FRAME_ALIGN(size) \
+    (((size) + EZOM_FRAME_ALIGNMENT - 1) & ~(EZOM_FRAME_ALIGNMENT - 1))
+
+// Bookkeeping kept just below each frame's context
+typedef struct ezom_frame {
+    uint24_t previous;          // Next older frame (0 = none)
+    uint32_t capture_mark;      // Capture log entries made before this frame
+    uint32_t serial;            // Push order; older frames have lower numbers
+    bool     escaped;           // A closure over this frame escaped
+} ezom_frame_t;
+
+typedef struct ezom_frame_stack {
+    uint24_t  base;             // First byte of the region (0 = not initialized)
+    uint24_t  limit;            // One past the last byte
+    uint24_t  top;              // Next free byte
+    uint24_t  current;          // Newest frame
+    uint24_t* captures;         // Escaped closures and copies over live frames
+    uint32_t  capture_count;
+    uint32_t  capture_capacity;
+    uint32_t  depth;            // Live frames
+    uint32_t  max_depth;        // Deepest allowed (--max-depth)
+    uint16_t  native_depth;     // Activations entered by C recursion
+    bool      overflow;         // Unwinding after a stack overflow
+    bool      returning;        // Unwinding to the home frame of a ^
+    uint32_t  return_home;      // ...its serial (0 = top level)
+    bool      raising;          // Unwinding to an exception handler
+    uint24_t  raise_handler;    // ...its record
+    uint24_t  return_value;     // The value either answers
+    uint32_t  peak_depth;
+    uint32_t  peak_bytes;
+    uint32_t  frames;           // Activations given a stack frame
+    uint32_t  trivial;          // Trivial methods run without one
+    uint32_t  promoted;         // Frames copied to the heap on exit
+    uint32_t  overflows;
+    uint32_t  nonlocal_returns;
+} ezom_frame_stack_t;
+
+extern ezom_frame_stack_t g_frame_stack;
+
+#define EZOM_IS_STACK_FRAME(ref) \
+    ((ref) >= g_frame_stack.base && (ref) < g_frame_stack.limit)
+
+// Activations stop at the next send and unwind
+#define EZOM_FRAME_UNWINDING() \
+    (g_frame_stack.overflow || g_frame_stack.returning || g_frame_stack.raising)
+
+// A ^ or exception on its way out, set aside while cleanup code runs
+typedef struct ezom_unwind_state {
+    bool     returning;
+    bool     raising;
+    uint32_t return_home;
+    uint24_t raise_handler;
+    uint24_t return_value;
+} ezom_unwind_state_t;
+
+void ezom_init_frame_stack(void);
+void ezom_set_max_depth(uint32_t max_depth);
+uint24_t ezom_push_frame(uint24_t outer_context, uint24_t receiver, uint8_t local_count);
+void ezom_pop_frame(uint24_t frame, uint24_t result);
+void* ezom_frame_reserve(uint16_t bytes);       // Raw space, e.g. operand slots
+void ezom_frame_release(void* space);
+bool ezom_frame_enter_native(void);             // Around C-recursive activations
+void ezom_frame_leave_native(void);
+void ezom_frame_note_store(uint24_t target, uint24_t value);
+uint32_t ezom_frame_home(uint24_t context);     // Home serial for a ^ run in context
+bool ezom_frame_begin_return(uint24_t context, uint24_t value);
+bool ezom_frame_is_return_home(uint24_t frame);
+uint24_t ezom_frame_finish_return(void);
+void ezom_frame_suspend_unwind(ezom_unwind_state_t* state);
+void ezom_frame_resume_unwind(const ezom_unwind_state_t* state);
+void ezom_frame_print_backtrace(void);
+void ezom_frame_print_stats(void);
+
 // Utility functions
 bool ezom_is_block_object(uint24_t object_ptr);
 bool ezom_is_context_object(uint24_t object_ptr);
\ No newline at end of file
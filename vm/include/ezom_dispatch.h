@@ -22,11 +22,114 @@ typedef struct ezom_method_lookup {
     bool           is_primitive; // True if primitive method
 } ezom_method_lookup_t;
 
+// Global method lookup cache (direct mapped, size must be a power of two)
+#ifdef EZOM_PLATFORM_EZ80
+#define EZOM_METHOD_CACHE_SIZE 64
+#else
+#define EZOM_METHOD_CACHE_SIZE 256
+#endif
+
+typedef struct ezom_method_cache_stats {
+    uint32_t hits;          // Lookups answered from the cache
+    uint32_t negative_hits; // Cached "not understood" results
+    uint32_t misses;        // Lookups that walked the class hierarchy
+    uint32_t invalidations; // Entries dropped by method install/class redefinition
+    uint32_t flushes;       // Whole-cache flushes
+} ezom_method_cache_stats_t;
+
+extern ezom_method_cache_stats_t g_method_cache_stats;
+
+void ezom_method_cache_flush(void);
+void ezom_method_cache_flush_selector(uint24_t selector);
+void ezom_method_cache_flush_class(uint24_t class_ptr);
+void ezom_method_cache_print_stats(void);
+
+// Per-call-site inline caches (monomorphic, then polymorphic up to N classes)
+#ifdef EZOM_PLATFORM_EZ80
+#define EZOM_INLINE_CACHE_SIZE 2
+#else
+#define EZOM_INLINE_CACHE_SIZE 4
+#endif
+
+typedef struct ezom_inline_cache_entry {
+    uint24_t       class_ptr;   // Receiver class
+    uint32_t       version;     // Its dispatch_version when method was found
+    ezom_method_t* method;      // Method found for that class
+} ezom_inline_cache_entry_t;
+
+typedef struct ezom_inline_cache {
+    uint24_t selector;          // Selector symbol, interned on the first send
+    uint8_t  count;             // Entries in use
+    bool     megamorphic;       // Site saw more than EZOM_INLINE_CACHE_SIZE classes
+    ezom_inline_cache_entry_t entries[EZOM_INLINE_CACHE_SIZE];
+} ezom_inline_cache_t;
+
+typedef struct ezom_inline_cache_stats {
+    uint32_t hits;              // Sends answered by a site's own entries
+    uint32_t misses;            // Sends that had to look the method up
+    uint32_t polymorphic_sites; // Sites that went beyond one receiver class
+    uint32_t megamorphic_sites; // Sites that overflowed and use the shared path
+    uint32_t megamorphic_sends; // Sends made through megamorphic sites
+    uint32_t stale;             // Entries looked up again after their class changed
+} ezom_inline_cache_stats_t;
+
+extern ezom_inline_cache_stats_t g_inline_cache_stats;
+
+// Class dispatch versions. Inline cache entries, compiled code and the AOT
+// Integer check remember the dispatch_version of the class they depend on.
+// Installing a method restamps the defining class and its subclasses only;
+// stamps are never reused, so a class allocated where a collected one was
+// matches nothing cached for the old one.
+void ezom_class_register(uint24_t class_ptr);
+void ezom_class_changed(uint24_t class_ptr);
+
+static inline uint32_t ezom_class_version(uint24_t class_ptr) {
+    return ((ezom_class_t*)EZOM_OBJECT_PTR(class_ptr))->dispatch_version;
+}
+
+uint24_t ezom_inline_cache_selector(ezom_inline_cache_t* ic, const char* selector);
+ezom_method_t* ezom_inline_cache_lookup(ezom_inline_cache_t* ic, ezom_message_t* msg);
+uint24_t ezom_send_message_cached(ezom_inline_cache_t* ic, ezom_message_t* msg);
+void ezom_inline_cache_print_stats(void);
+
+// Selector-indexed dispatch tables (row displacement). Each class gets a
+// row of its full method set, inherited methods included, indexed by
+// selector ID; rows are overlapped in one shared table.
+typedef enum {
+    EZOM_DISPATCH_CACHE = 0,    // Method cache in front of the superclass walk
+    EZOM_DISPATCH_TABLE         // Row-displacement dispatch tables
+} ezom_dispatch_mode_t;
+
+typedef struct ezom_dispatch_table_stats {
+    uint32_t lookups;           // Lookups answered from the table
+    uint32_t misses;            // Lookups with no method (not understood)
+    uint32_t rebuilds;          // Full table rebuilds
+} ezom_dispatch_table_stats_t;
+
+extern ezom_dispatch_mode_t g_dispatch_mode;
+extern ezom_dispatch_table_stats_t g_dispatch_table_stats;
+
+void ezom_set_dispatch_mode(ezom_dispatch_mode_t mode);
+void ezom_dispatch_table_finalize_class(uint24_t class_ptr);
+void ezom_dispatch_table_forget_class(uint24_t class_ptr);
+ezom_method_lookup_t ezom_dispatch_table_lookup(uint24_t class_ptr, uint24_t selector);
+void ezom_dispatch_table_print_stats(void);
+
 // Symbol comparison helper
 bool ezom_symbols_equal(uint24_t sym1, uint24_t sym2);
 
 // Message dispatch functions
 ezom_method_lookup_t ezom_lookup_method(uint24_t class_ptr, uint24_t selector);
+ezom_method_lookup_t ezom_lookup_method_uncached(uint24_t class_ptr, uint24_t selector);
+ezom_method_t* ezom_resolve_message(ezom_message_t* msg);
 uint24_t ezom_send_message(ezom_message_t* msg);
+uint24_t ezom_invoke_method(ezom_method_t* method, ezom_message_t* msg);
 uint24_t ezom_send_unary_message(uint24_t receiver, uint24_t selector);
-uint24_t ezom_send_binary_message(uint24_t receiver, uint24_t selector, uint24_t arg);
\ No newline at end of file
+uint24_t ezom_send_binary_message(uint24_t receiver, uint24_t selector, uint24_t arg);
+
+// Arity-specialized sends: look up once and run the primitive or compiled
+// method directly, with no ezom_message_t
+uint24_t ezom_send0(uint24_t receiver, uint24_t selector);
+uint24_t ezom_send1(uint24_t receiver, uint24_t selector, uint24_t arg);
+uint24_t ezom_send2(uint24_t receiver, uint24_t selector, uint24_t arg1, uint24_t arg2);
+uint24_t ezom_sendN(uint24_t receiver, uint24_t selector, uint24_t* args, uint8_t arg_count);
\ No newline at end of file
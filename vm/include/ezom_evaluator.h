@@ -10,14 +10,46 @@
 #include <stdint.h>
 #include <stdbool.h>
 
-// Evaluation result structure
+// Evaluation result structure: returned by value from every node, so it
+// stays a value plus status flags. Error text lives in g_eval_error.
 typedef struct ezom_eval_result {
     uint24_t value;           // Result object
     bool     is_return;       // True if this is a return value
-    bool     is_error;        // True if evaluation failed
-    char     error_msg[256];  // Error message if any
+    bool     is_error;        // True if evaluation failed (see g_eval_error)
 } ezom_eval_result_t;
 
+// Details of the most recent evaluation error
+typedef struct ezom_eval_error {
+    char     message[256];    // Set by ezom_make_error_result
+    uint16_t count;           // Errors raised since startup
+} ezom_eval_error_t;
+
+extern ezom_eval_error_t g_eval_error;
+
+// Global binding cell; resolved references point straight at one
+typedef struct ezom_global {
+    char*    name;
+    uint24_t value;           // 0 = referenced but never assigned
+} ezom_global_t;
+
+// Self-specializing sends (AST engine). A send node that has run
+// EZOM_SPECIALIZE_AFTER times through a monomorphic inline cache looks at
+// the method it found and rewrites itself to a specialized variant
+// (ezom_special_kind_t) when one fits, or to a generic send. A variant
+// whose type guard fails goes back to generic; one made stale by a method
+// or class change warms up again.
+#define EZOM_SPECIALIZE_AFTER   8
+
+typedef struct ezom_specialize_stats {
+    uint32_t specialized;     // Nodes rewritten to a specialized variant
+    uint32_t despecialized;   // Variants rewritten back to a generic send
+    uint32_t fast_sends;      // Sends answered by a variant
+} ezom_specialize_stats_t;
+
+extern ezom_specialize_stats_t g_specialize_stats;
+
+void ezom_specialize_print_stats(void);
+
 // Evaluator initialization and cleanup
 void ezom_evaluator_init(void);
 void ezom_evaluator_cleanup(void);
@@ -31,8 +63,10 @@ ezom_eval_result_t ezom_evaluate_statement_list(ezom_ast_node_t* statements, uin
 // Specific node evaluation
 ezom_eval_result_t ezom_evaluate_message_send(ezom_ast_node_t* node, uint24_t context);
 ezom_eval_result_t ezom_evaluate_literal(ezom_ast_node_t* node, uint24_t context);
+uint24_t ezom_literal_object(ezom_ast_node_t* node);   // Fixed object for a literal node
 ezom_eval_result_t ezom_evaluate_identifier(ezom_ast_node_t* node, uint24_t context);
 ezom_eval_result_t ezom_evaluate_assignment(ezom_ast_node_t* node, uint24_t context);
+ezom_eval_result_t ezom_evaluate_increment(ezom_ast_node_t* node, uint24_t context);
 ezom_eval_result_t ezom_evaluate_return(ezom_ast_node_t* node, uint24_t context);
 ezom_eval_result_t ezom_evaluate_block_literal(ezom_ast_node_t* node, uint24_t context);
 
@@ -45,6 +79,8 @@ uint24_t ezom_lookup_variable(const char* name, uint24_t context);
 bool ezom_set_variable(const char* name, uint24_t value, uint24_t context);
 uint24_t ezom_lookup_global(const char* name);
 bool ezom_set_global(const char* name, uint24_t value);
+ezom_global_t* ezom_global_binding(const char* name);  // Find or create (NULL = table full)
+const char* ezom_global_name(uint24_t value);          // Name bound to value (NULL = none)
 
 // Message dispatch support
 ezom_eval_result_t ezom_eval_send_message(uint24_t receiver, const char* selector, 
@@ -71,6 +107,8 @@ ezom_eval_result_t ezom_evaluate_arguments(ezom_ast_node_t* arg_list, uint24_t*
 uint24_t ezom_compile_method_from_ast(ezom_ast_node_t* method_ast);
 ezom_eval_result_t ezom_execute_compiled_method(uint24_t method_code_ptr, uint24_t receiver, 
                                                uint24_t* args, uint8_t arg_count);
+// Answer of a method classified trivial when compiled (ezom_trivial_kind_t)
+uint24_t ezom_run_trivial_method(ezom_method_code_t* method_code, uint24_t receiver, uint24_t* args);
 uint24_t ezom_create_enhanced_method_context(uint24_t receiver, ezom_method_code_t* method_code, 
                                            uint24_t* args, uint8_t arg_count);
 ezom_eval_result_t ezom_evaluate_method_body(ezom_ast_node_t* body, uint24_t context);
@@ -93,6 +131,8 @@ uint16_t ezom_context_get_local_index(uint24_t context_ptr, const char* name);
 
 // Class creation and method installation
 uint24_t ezom_create_class_with_inheritance(const char* name, uint24_t superclass, uint16_t instance_var_count);
+uint24_t ezom_define_class(const char* name, const char* superclass_name,
+                           const char* const* var_names, uint16_t instance_var_count);
 uint24_t ezom_create_instance(uint24_t class_ptr);
 void ezom_install_method_in_class(uint24_t class_ptr, const char* selector, uint24_t code, uint8_t arg_count, bool is_primitive);
 void ezom_install_methods_from_ast(uint24_t class_ptr, ezom_ast_node_t* method_list, bool is_class_method);
@@ -103,6 +143,7 @@ uint24_t ezom_send_unary_message(uint24_t receiver, uint24_t selector);
 ezom_eval_result_t ezom_make_result(uint24_t value);
 ezom_eval_result_t ezom_make_return_result(uint24_t value);
 ezom_eval_result_t ezom_make_error_result(const char* message);
+ezom_eval_result_t ezom_make_unwind_result(void);   // Passing a ^ or exception on
 bool ezom_is_truthy(uint24_t object);
 
 // Debug support
@@ -0,0 +1,45 @@
+// ============================================================================
+// File: include/ezom_exceptions.h
+// Exception classes, handlers and signaling
+// ============================================================================
+
+#pragma once
+#include "ezom_object.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+// Exception and its subclass Error are globals. An instance has one
+// instance variable, messageText. The classes answer new, signal and
+// signal: through a metaclass of their own, which SOM subclasses of
+// Exception share.
+//
+// [ ... ] on: Error do: [:e | ... ] keeps a handler record on the frame
+// stack while the receiver runs; nothing else is done unless something is
+// signaled. signal finds the newest enabled handler for the exception's
+// class and runs its block on top of the signaling activation, with that
+// handler and every newer one disabled. Then every activation down to the
+// on:do: unwinds as a non-local return does (ezom_context.h), running
+// ensure: and ifCurtailed: blocks on the way, and on:do: answers the
+// handler block's value. An exception nothing handles prints its
+// messageText and signal answers nil.
+//
+// A failed primitive signals an Error with its message. Unhandled, the
+// primitive answers what it always did.
+typedef struct ezom_handler {
+    struct ezom_handler* previous;  // Next older handler
+    uint24_t exception_class;       // Handles instances of this class or a subclass
+    uint24_t block;                 // Handler block, given the exception
+    uint8_t  disabled;              // Handlers running at or below this one
+} ezom_handler_t;
+
+extern uint24_t g_exception_class;
+extern uint24_t g_error_class;
+extern uint24_t g_exception_metaclass;
+
+uint24_t ezom_create_exception(uint24_t class_ptr, uint24_t message_text);
+bool ezom_exception_signal(uint24_t exception);     // false: no handler
+void ezom_primitive_failed(const char* format, ...);
+
+// Block>>on:do:, Block>>ensure: and Block>>ifCurtailed:
+uint24_t ezom_exception_on_do(uint24_t block, uint24_t exception_class, uint24_t handler_block);
+uint24_t ezom_exception_ensure(uint24_t block, uint24_t cleanup_block, bool only_if_curtailed);
@@ -27,6 +27,7 @@ typedef struct {
     ezom_parser_t parser;
     ezom_lexer_t lexer;
     ezom_ast_node_t* program_ast;
+    uint8_t program_slots;      // Context slots the resolved program needs
     uint24_t result_value;
     ezom_file_result_t status;
 } ezom_file_context_t;
@@ -40,6 +41,13 @@ typedef struct {
     int interactive_mode;
     int verbose_mode;
     int debug_mode;
+    int dispatch_mode;      // ezom_dispatch_mode_t
+    int engine;             // ezom_engine_t
+    uint32_t max_depth;     // Frame stack depth limit (0 = default)
+    int no_optimize;        // Leave method ASTs as parsed
+    int no_jit;             // Interpret every method (EZOM_JIT builds)
+    uint32_t jit_threshold; // Activations before a method is compiled (0 = default)
+    char* main_class;       // Class of a class file to run (NULL = last defined)
 } ezom_args_t;
 
 // Core file loading functions
@@ -49,8 +57,10 @@ ezom_file_result_t ezom_evaluate_file(ezom_file_context_t* context);
 void ezom_free_file_context(ezom_file_context_t* context);
 
 // Program execution functions
-ezom_file_result_t ezom_execute_som_file(const char* filename, uint24_t* result);
+ezom_file_result_t ezom_execute_som_file(const char* filename, const char* main_class, uint24_t* result);
 ezom_file_result_t ezom_execute_som_code(const char* code, uint24_t* result);
+bool ezom_is_class_source(char* source);
+ezom_file_result_t ezom_run_som_classes(ezom_file_context_t* context, const char* main_class);
 
 // Command line interface
 ezom_args_t ezom_parse_arguments(int argc, char* argv[]);
@@ -0,0 +1,59 @@
+// ============================================================================
+// File: include/ezom_jit.h
+// Baseline x86-64 JIT for hot methods (native builds, -DEZOM_JIT)
+// ============================================================================
+
+#pragma once
+#include "ezom_object.h"
+#include "ezom_evaluator.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#if defined(EZOM_JIT) && !(defined(__x86_64__) && defined(EZOM_PLATFORM_NATIVE))
+#error "EZOM_JIT needs a native x86-64 build"
+#endif
+
+// A compiled method counts its activations. The one that reaches the
+// threshold translates the method's resolved AST to machine code in an
+// mmap'd executable region, one template per node, and later activations
+// run that code in the same frame-stack context the interpreter would
+// have used: locals stay in the context, so closures, ^ out of blocks and
+// exceptions behave as before.
+//
+// The code inlines what the resolver inlined (ifTrue:, and:, whileTrue:,
+// to:do:, timesRepeat: ...) plus SmallInteger + - < > <= >= = while
+// Integer still has its primitives for them; every other send calls back
+// through the node's inline cache into ezom_send_message. A method with a
+// node the templates do not cover stays interpreted. A method installed in
+// Integer or a superclass drops compiled code; the method warms up again.
+// The region starts over once all of its code is stale or it is full.
+#define EZOM_JIT_DEFAULT_THRESHOLD  50
+#define EZOM_JIT_REJECTED           0xFFFF  // jit_counter: stays interpreted
+#define EZOM_JIT_CODE_SIZE          (1024 * 1024)
+
+typedef uint24_t (*ezom_jit_entry_t)(uint24_t* locals, uint24_t* fields, uint24_t receiver,
+                                     uint24_t context, uint16_t scratch_mark);
+
+typedef struct ezom_jit_method {
+    ezom_jit_entry_t entry;
+    uint32_t version;           // Integer's dispatch_version the code assumes
+    uint32_t size;              // Bytes of machine code
+    bool     uses_fields;       // Reads or writes instance variables of self
+} ezom_jit_method_t;
+
+typedef struct ezom_jit_stats {
+    uint32_t compiled;          // Methods translated
+    uint32_t rejected;          // Methods left to the interpreter
+    uint32_t invalidated;       // Translations dropped after a method or class change
+    uint32_t code_bytes;        // Executable region in use
+    uint32_t runs;              // Activations run as machine code
+    uint32_t region_resets;     // Times the region started over, dropping its code
+} ezom_jit_stats_t;
+
+extern ezom_jit_stats_t g_jit_stats;
+
+void ezom_jit_configure(bool enabled, uint32_t threshold);
+ezom_jit_method_t* ezom_jit_method_for(ezom_method_code_t* method_code, uint24_t receiver);
+ezom_eval_result_t ezom_jit_run(ezom_jit_method_t* jit, ezom_method_code_t* method_code,
+                                uint24_t receiver, uint24_t context);
+void ezom_jit_print_stats(void);
@@ -6,12 +6,14 @@
 #pragma once
 #include <stdint.h>
 #include <stdbool.h>
+#include "ezom_platform.h"
 
 typedef enum {
     TOKEN_EOF,
     TOKEN_IDENTIFIER,
     TOKEN_STRING,
     TOKEN_INTEGER,
+    TOKEN_DOUBLE,
     TOKEN_SYMBOL,
     TOKEN_LPAREN,       // (
     TOKEN_RPAREN,       // )
@@ -44,7 +46,8 @@ typedef struct ezom_token {
     uint16_t         length;
     char*            text;
     union {
-        int16_t      int_value;    // For TOKEN_INTEGER
+        ezom_large_int_t int_value; // For TOKEN_INTEGER
+        double       double_value; // For TOKEN_DOUBLE
         char*        string_value; // For TOKEN_STRING, TOKEN_IDENTIFIER
     } value;
 } ezom_token_t;
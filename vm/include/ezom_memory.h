@@ -19,6 +19,17 @@
 #endif
 #define EZOM_HEAP_END       (EZOM_HEAP_START + EZOM_HEAP_SIZE)
 
+// Frame stack region (see ezom_context.h). On native it is reserved just
+// past the heap in the same allocation, so the OS commits its pages only
+// as deeper frames first touch them.
+#ifdef EZOM_PLATFORM_EZ80
+#define EZOM_FRAME_STACK_START  0x060000    // VM stack space
+#define EZOM_FRAME_STACK_SIZE   0x10000     // 64KB
+#else
+#define EZOM_FRAME_STACK_START  EZOM_HEAP_END
+#define EZOM_FRAME_STACK_SIZE   0x4000000   // 64MB reserved
+#endif
+
 // Phase 3: Free List Allocator Constants
 #define EZOM_SIZE_CLASSES   16      // Number of size classes for free lists
 #define EZOM_LARGE_OBJECT_THRESHOLD 512  // Objects larger than this use large object heap
@@ -169,4 +180,42 @@ uint16_t ezom_gc_pressure(void);
 
 // Helper functions
 uint16_t ezom_calculate_object_size(uint24_t obj_ptr);
-float ezom_calculate_fragmentation(void);
\ No newline at end of file
+float ezom_calculate_fragmentation(void);
+// Double scratch space: short-lived arithmetic results
+#ifdef EZOM_PLATFORM_EZ80
+#define EZOM_DOUBLE_SCRATCH_CELLS 24
+#else
+#define EZOM_DOUBLE_SCRATCH_CELLS 64
+#endif
+#define EZOM_DOUBLE_CELL_SIZE   ((sizeof(ezom_double_t) + 1) & ~1)
+
+typedef struct ezom_double_scratch {
+    uint24_t base;      // First cell (0 = not initialized)
+    uint24_t limit;     // One past the last cell
+    uint16_t top;       // Cells in use
+    uint16_t spills;    // Results that fell back to the heap
+} ezom_double_scratch_t;
+
+extern ezom_double_scratch_t g_double_scratch;
+
+#define EZOM_IS_SCRATCH_DOUBLE(ref) \
+    (!EZOM_IS_SMALLINT(ref) && (ref) >= g_double_scratch.base && (ref) < g_double_scratch.limit)
+
+void ezom_init_double_scratch(void);    // Needs the Double class
+uint24_t ezom_scratch_double(double value);
+uint24_t ezom_promote_double(uint24_t value);
+uint24_t ezom_store_slot_double(uint24_t old, uint24_t value);
+uint24_t ezom_load_slot_double(uint24_t value);
+uint16_t ezom_double_scratch_mark(void);
+void ezom_double_scratch_release(uint16_t mark);
+
+// Literal area: objects materialized from source literals
+typedef struct ezom_literal_stats {
+    uint16_t objects;   // Literal objects fixed so far
+    uint16_t bytes;     // Heap bytes they occupy
+} ezom_literal_stats_t;
+
+extern ezom_literal_stats_t g_literal_stats;
+
+uint24_t ezom_fix_literal(uint24_t obj);
+bool ezom_is_fixed(uint24_t obj);
@@ -29,9 +29,10 @@ typedef struct ezom_object {
 
 // Flag definitions
 #define EZOM_FLAG_MARKED    0x01    // GC mark bit
-#define EZOM_FLAG_FIXED     0x02    // Fixed size object
+#define EZOM_FLAG_FIXED     0x02    // Literal: immortal and read-only
 #define EZOM_FLAG_WEAK      0x04    // Weak reference
 #define EZOM_FLAG_FINALIZE  0x08    // Has finalizer
+#define EZOM_FLAG_SLOT_DOUBLE EZOM_FLAG_FINALIZE  // Double owned by one variable slot (Doubles have no finalizer)
 
 // Object types for built-in classes (ENHANCED)
 #define EZOM_TYPE_OBJECT    0x10
@@ -43,6 +44,27 @@ typedef struct ezom_object {
 #define EZOM_TYPE_BLOCK     0x60    // NEW: Block objects
 #define EZOM_TYPE_BOOLEAN   0x70    // NEW: Boolean objects
 #define EZOM_TYPE_NIL       0x80    // NEW: Nil object
+#define EZOM_TYPE_DOUBLE    0x90    // Boxed floating point
+
+// SmallIntegers are immediates, not heap objects: the reference holds
+// (value << 1) | 1. Heap objects are 2-byte aligned, so the low bit of a
+// real object reference is always clear. Values outside the SmallInteger
+// range are boxed as LargeIntegers.
+#define EZOM_SMALLINT_TAG           0x01
+#define EZOM_IS_SMALLINT(ref)       (((ref) & EZOM_SMALLINT_TAG) != 0)
+#ifdef EZOM_PLATFORM_NATIVE
+// 31-bit SmallIntegers in a 32-bit reference
+#define EZOM_SMALLINT_MAX           0x3FFFFFFF
+#define EZOM_SMALLINT_VALUE(ref)    ((int32_t)(ref) >> 1)
+#define EZOM_SMALLINT_FROM(value)   ((uint24_t)(((uint32_t)(int32_t)(value) << 1) | EZOM_SMALLINT_TAG))
+#else
+// 23-bit SmallIntegers in a 24-bit reference
+#define EZOM_SMALLINT_MAX           0x3FFFFF
+#define EZOM_SMALLINT_VALUE(ref)    ((int32_t)((uint32_t)(ref) << 8) >> 9)
+#define EZOM_SMALLINT_FROM(value)   ((uint24_t)((((uint32_t)(int32_t)(value) << 1) | EZOM_SMALLINT_TAG) & 0xFFFFFF))
+#endif
+#define EZOM_SMALLINT_MIN           (-EZOM_SMALLINT_MAX - 1)
+#define EZOM_SMALLINT_FITS(value)   ((value) >= EZOM_SMALLINT_MIN && (value) <= EZOM_SMALLINT_MAX)
 
 // Class object layout
 typedef struct ezom_class {
@@ -52,6 +74,8 @@ typedef struct ezom_class {
     uint24_t      instance_vars;    // Pointer to instance variable names
     uint16_t      instance_size;    // Size of instances in bytes
     uint16_t      instance_var_count; // Number of instance variables
+    uint16_t      dispatch_offset;  // Row offset in the dispatch table (0 = no row)
+    uint32_t      dispatch_version; // Restamped when a method it answers may change
 } ezom_class_t;
 
 // Method dictionary entry
@@ -62,22 +86,41 @@ typedef struct ezom_method {
     uint8_t  flags;         // Method flags (primitive, etc.)
 } ezom_method_t;
 
-// Method dictionary
+// Method dictionary: open-addressing hash table keyed on interned selector
+// identity. Selectors and method records live in separate parallel
+// arrays so that probing only touches the compact selector array.
 typedef struct ezom_method_dict {
     ezom_object_t header;
     uint16_t      size;         // Number of methods
-    uint16_t      capacity;     // Allocated capacity
-    ezom_method_t methods[];    // Variable length array
+    uint16_t      capacity;     // Table capacity (power of two)
+    uint24_t      selectors;    // Array object: selector per slot, 0 = empty
+    uint24_t      methods;      // Method record block (ezom_method_table_t)
 } ezom_method_dict_t;
 
+// Method records, parallel to the selector array
+typedef struct ezom_method_table {
+    ezom_object_t header;
+    uint16_t      capacity;
+    ezom_method_t entries[];
+} ezom_method_table_t;
+
 #define EZOM_METHOD_PRIMITIVE   0x01
 #define EZOM_METHOD_SUPER       0x02
 
 // Built-in object types
-typedef struct ezom_integer {
+// Boxed integer for values outside the SmallInteger range (EZOM_TYPE_INTEGER)
+typedef struct ezom_large_integer {
+    ezom_object_t    header;
+    ezom_large_int_t value;
+} ezom_large_integer_t;
+
+// Boxed Double (EZOM_TYPE_DOUBLE). Arithmetic results are built in the
+// double scratch space (ezom_memory.h) and only copied to the heap when
+// they are stored somewhere that outlives the current statement.
+typedef struct ezom_double {
     ezom_object_t header;
-    int16_t       value;        // 16-bit signed integer
-} ezom_integer_t;
+    double        value;
+} ezom_double_t;
 
 typedef struct ezom_string {
     ezom_object_t header;
@@ -89,6 +132,7 @@ typedef struct ezom_symbol {
     ezom_object_t header;
     uint16_t      length;
     uint16_t      hash_cache;   // Cached hash for fast lookup
+    uint16_t      selector_id;  // Dispatch table column (0 = never a method selector)
     char          data[];
 } ezom_symbol_t;
 
@@ -106,6 +150,8 @@ typedef struct ezom_block {
     void*         code;             // AST or bytecode pointer (native pointer)
     uint8_t       param_count;      // Number of parameters
     uint8_t       local_count;      // Number of local variables
+    uint8_t       capture_count;    // Entries in captured_vars
+    uint32_t      home;             // Frame serial a ^ returns from (0 = top level)
     uint24_t      captured_vars[];  // Captured variables from outer scope
 } ezom_block_t;
 
@@ -121,21 +167,44 @@ typedef struct ezom_context {
     uint24_t      locals[];         // Local variables
 } ezom_context_t;
 
+// Methods that run on the receiver without a frame; set when the method
+// is compiled (ezom_run_trivial_method)
+typedef enum {
+    EZOM_TRIVIAL_NONE,
+    EZOM_TRIVIAL_GETTER,        // ^ivar: trivial_value is the slot
+    EZOM_TRIVIAL_SETTER,        // ivar := arg, answering self: the slot
+    EZOM_TRIVIAL_SELF,          // ^self, or an empty body
+    EZOM_TRIVIAL_LITERAL,       // ^literal: the literal's fixed object
+    EZOM_TRIVIAL_ARGUMENT       // ^arg: the argument's index
+} ezom_trivial_kind_t;
+
 // Method code object for compiled methods
 typedef struct ezom_method_code {
     ezom_object_t header;
-    uint24_t      ast_node;      // Pointer to AST node (for now)
+    void*         ast_node;      // AST_METHOD_DEF node (native pointer)
+    void*         bytecode;      // ezom_code_t, or NULL to evaluate the AST
     uint8_t       param_count;   // Number of parameters
     uint8_t       local_count;   // Number of local variables
     bool          is_primitive;  // Is this a primitive method?
     uint8_t       primitive_number; // Primitive number if applicable
-    // Future: bytecode storage would go here
+    uint8_t       trivial;       // ezom_trivial_kind_t
+    uint24_t      trivial_value; // Slot, argument index or literal (see above)
+#ifdef EZOM_JIT
+    uint16_t      jit_counter;   // Activations so far, or EZOM_JIT_REJECTED
+    struct ezom_jit_method* jit; // Machine code, or NULL (ezom_jit.h)
+    uint32_t      jit_region;    // Code region generation jit was copied into
+#endif
+#ifdef EZOM_AOT
+    uint24_t    (*aot)(uint24_t self, uint24_t* args); // Translated by ezom_aotc, or NULL (ezom_aot.h)
+#endif
 } ezom_method_code_t;
 
 // Global class pointers (ENHANCED)
 extern uint24_t g_object_class;
 extern uint24_t g_class_class;
 extern uint24_t g_integer_class;
+extern uint24_t g_large_integer_class;
+extern uint24_t g_double_class;
 extern uint24_t g_string_class;
 extern uint24_t g_symbol_class;
 extern uint24_t g_array_class;      // NEW
@@ -157,14 +226,32 @@ void ezom_init_object(uint24_t obj_ptr, uint24_t class_ptr, uint8_t type);
 uint16_t ezom_get_object_size(uint24_t obj_ptr);
 bool ezom_is_valid_object(uint24_t obj_ptr);
 uint16_t ezom_compute_hash(uint24_t obj_ptr);
+uint24_t ezom_class_of(uint24_t obj_ptr);   // Understands tagged SmallIntegers
 
 // Object creation functions
-uint24_t ezom_create_integer(int16_t value);
+uint24_t ezom_create_integer(ezom_large_int_t value);  // SmallInteger, or a boxed LargeInteger
+ezom_large_int_t ezom_integer_value(uint24_t obj_ptr);  // obj_ptr must be an Integer
+uint16_t ezom_format_integer(char* buffer, ezom_large_int_t value);
+uint24_t ezom_create_double(double value);          // Heap Double that survives any statement
+double ezom_double_value(uint24_t obj_ptr);         // obj_ptr must be a Double
+uint16_t ezom_format_double(char* buffer, double value);
 uint24_t ezom_create_string(const char* data, uint16_t length);
-uint24_t ezom_create_symbol(const char* data, uint16_t length);
+uint24_t ezom_create_symbol(const char* data, uint16_t length);  // Returns the canonical (interned) symbol
 uint24_t ezom_create_method_dictionary(uint16_t initial_capacity);
+bool ezom_method_dict_grow(ezom_method_dict_t* dict, uint16_t new_capacity);
+ezom_method_t* ezom_method_dict_find(ezom_method_dict_t* dict, uint24_t selector);
+ezom_method_t* ezom_method_dict_put(ezom_method_dict_t* dict, uint24_t selector, uint24_t code,
+                                    uint16_t arg_count, uint8_t flags);
+ezom_method_t* ezom_method_dict_entry_at(ezom_method_dict_t* dict, uint16_t slot);  // NULL if slot empty
 uint24_t ezom_object_to_string(uint24_t obj_ptr);
 
+// Symbol table: interned symbols compare by identity
+uint16_t ezom_hash_chars(const char* data, uint16_t length);
+void ezom_symbol_table_sweep(void);
+uint16_t ezom_symbol_table_size(void);
+uint16_t ezom_selector_id(uint24_t selector);
+uint16_t ezom_selector_id_count(void);
+
 // NEW: Enhanced object creation functions
 uint24_t ezom_create_array(uint16_t size);
 uint24_t ezom_create_block(uint8_t param_count, uint8_t local_count, uint24_t outer_context);
@@ -181,4 +268,5 @@ uint24_t ezom_compile_method_from_ast(ezom_ast_node_t* method_ast);
 void ezom_bootstrap_classes(void);
 void ezom_bootstrap_enhanced_classes(void);  // NEW
 void ezom_install_integer_methods(void);
-void ezom_install_string_methods(void);
\ No newline at end of file
+void ezom_install_string_methods(void);
+void ezom_install_double_methods(void);
\ No newline at end of file
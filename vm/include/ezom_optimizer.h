@@ -0,0 +1,44 @@
+// ============================================================================
+// File: include/ezom_optimizer.h
+// AST optimization pass run when a method is compiled
+// ============================================================================
+
+#pragma once
+#include "ezom_ast.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+// ezom_compile_method_from_ast runs the optimizer over the resolved method
+// and every block in it before the engines see the tree. It rewrites nodes
+// in place, so nothing is allocated:
+//
+//   - Sends of + - * < > <= >= = between SmallInteger literals become
+//     their answer, while Integer still has those primitives.
+//   - Statements after a ^ in the same statement list are dropped.
+//   - A statement list nested in a statement list is spliced into it, and
+//     one used as an expression is replaced by its single statement (the
+//     parser leaves no such wrappers; hand-built trees can).
+//   - x := x + k and x := x - k, with k a SmallInteger literal, become
+//     AST_INCREMENT nodes. The evaluator sends + through the original send
+//     node's cache without evaluating the receiver and argument nodes; the
+//     other engines treat the node as the assignment it was.
+
+typedef struct ezom_optimizer_stats {
+    uint32_t methods;           // Methods optimized
+    uint32_t nodes_removed;
+    uint32_t folded;            // Sends replaced by their constant answer
+    uint32_t dead;              // Statements dropped after a ^
+    uint32_t flattened;         // Statement lists spliced or unwrapped
+    uint32_t increments;        // Assignments rewritten as increments
+} ezom_optimizer_stats_t;
+
+extern ezom_optimizer_stats_t g_optimizer_stats;
+
+// enabled false leaves trees as parsed; report prints one line per method
+// the optimizer changed (--verbose)
+void ezom_optimizer_configure(bool enabled, bool report);
+
+// Optimize a resolved method; answers the number of nodes removed
+uint16_t ezom_optimize_method(ezom_ast_node_t* method_ast);
+
+void ezom_optimizer_print_stats(void);
@@ -22,6 +22,9 @@
     #define EZOM_PTR_FROM_NATIVE(ptr) ((ezom_ptr_t)(ptr))
     #define EZOM_PTR_NULL 0
     
+    // Widest integer the VM computes with (LargeInteger payload)
+    typedef int32_t ezom_large_int_t;
+    
 #else
     // Native platform (development)
     #define EZOM_PLATFORM_NATIVE
@@ -35,6 +38,9 @@
     #define EZOM_PTR_FROM_NATIVE(ptr) (ptr)
     #define EZOM_PTR_NULL NULL
     
+    // Widest integer the VM computes with (LargeInteger payload)
+    typedef int64_t ezom_large_int_t;
+    
     // For native, we need to track the heap base for conversions
     extern void* g_heap_base;
     
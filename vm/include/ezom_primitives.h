@@ -42,6 +42,7 @@ typedef uint24_t (*ezom_primitive_fn)(uint24_t receiver, uint24_t* args, uint8_t
 #define PRIM_INTEGER_EQ         19
 #define PRIM_INTEGER_NEQ        20  // NEW
 #define PRIM_INTEGER_AS_STRING  21  // NEW
+#define PRIM_INTEGER_AS_DOUBLE  22
 #define PRIM_INTEGER_ABS        23  // NEW
 #define PRIM_INTEGER_TO_DO      24  // NEW
 #define PRIM_INTEGER_TIMES_REPEAT 25 // NEW
@@ -72,8 +73,33 @@ typedef uint24_t (*ezom_primitive_fn)(uint24_t receiver, uint24_t* args, uint8_t
 #define PRIM_BLOCK_VALUE_WITH   61
 #define PRIM_BLOCK_WHILE_TRUE   62
 #define PRIM_BLOCK_WHILE_FALSE  63
+#define PRIM_BLOCK_ON_DO        64
+#define PRIM_BLOCK_ENSURE       65
+#define PRIM_BLOCK_IF_CURTAILED 66
 
-#define MAX_PRIMITIVES          80
+// Double primitives
+#define PRIM_DOUBLE_ADD         70
+#define PRIM_DOUBLE_SUB         71
+#define PRIM_DOUBLE_MUL         72
+#define PRIM_DOUBLE_DIV         73
+#define PRIM_DOUBLE_LT          74
+#define PRIM_DOUBLE_GT          75
+#define PRIM_DOUBLE_LTE         76
+#define PRIM_DOUBLE_GTE         77
+#define PRIM_DOUBLE_EQ          78
+#define PRIM_DOUBLE_NEQ         79
+#define PRIM_DOUBLE_AS_STRING   80
+#define PRIM_DOUBLE_AS_INTEGER  81
+#define PRIM_DOUBLE_SQRT        82
+
+// Exception primitives (class side: new, signal, signal:)
+#define PRIM_EXCEPTION_NEW      85
+#define PRIM_EXCEPTION_SIGNAL   86
+#define PRIM_EXCEPTION_SIGNAL_WITH 87
+#define PRIM_EXCEPTION_MESSAGE_TEXT 88
+#define PRIM_EXCEPTION_SET_MESSAGE_TEXT 89
+
+#define MAX_PRIMITIVES          96
 
 // Primitive function table
 extern ezom_primitive_fn g_primitives[MAX_PRIMITIVES];
@@ -83,6 +109,7 @@ void ezom_init_primitives(void);
 
 // NEW: Utility functions for primitives
 bool ezom_is_integer(uint24_t obj);
+bool ezom_is_double(uint24_t obj);
 bool ezom_is_string(uint24_t obj);
 bool ezom_is_array(uint24_t obj);
 bool ezom_is_block(uint24_t obj);
@@ -0,0 +1,64 @@
+// ============================================================================
+// File: include/ezom_resolver.h
+// Variable resolution pass: lexical addresses for identifiers
+// ============================================================================
+
+#pragma once
+#include "ezom_ast.h"
+#include "ezom_object.h"
+#include <stdint.h>
+
+// The resolver runs once over a parsed tree and rewrites every identifier
+// into an AST_VARIABLE_DEF node that says where the value lives:
+//
+//   AST_VAR_CONTEXT   locals[index] of the frame, or the block's capture
+//   AST_VAR_INSTANCE  instance variable slot index of the home receiver
+//   AST_VAR_GLOBAL    a global binding cell
+//   AST_VAR_SELF      receiver of the home context (self and super)
+//
+// nil, true and false become literals. Contexts hold parameters first and
+// locals after them.
+//
+// Closures are flat: a block literal lists the variables it uses from
+// enclosing frames, self included, in captures, and each evaluation copies
+// their values into the new block's captured_vars. A reference from the
+// block reads its copy (capture is the index); a block nested deeper
+// copies from the block that creates it, which captures the variable too.
+// No block keeps the context it was made in. A variable that a closure
+// captures and code assigns is boxed: its slot holds a one-element box,
+// made when its scope is entered, and every copy shares that box. Methods
+// and blocks list the slots to box in boxed.
+//
+// Literal block arguments of ifTrue:, ifFalse:, ifTrue:ifFalse:, and:,
+// or:, whileTrue:, whileFalse:, to:do: and timesRepeat: (and the receiver
+// of the while loops) are inlined: the send is marked with its
+// ezom_inline_kind_t, and the blocks' parameters and locals get slots
+// after the enclosing frame's own locals instead of a context of their
+// own. Methods and blocks record the extra slots in inlined_slots.
+//
+// A block literal that stays a closure is clean when nothing in it, nested
+// blocks included, reaches outside it: no enclosing variables, no self,
+// super or instance variables, and no ^. Clean blocks do not need the
+// context they are evaluated in, so one block object serves every
+// evaluation of the literal.
+
+// Resolution statistics
+typedef struct ezom_resolver_stats {
+    uint16_t context_refs;      // Parameters and locals
+    uint16_t instance_refs;     // Instance variables
+    uint16_t global_refs;       // Global binding cells
+    uint16_t self_refs;         // self and super
+    uint16_t inlined_sends;     // Control-flow sends inlined
+    uint16_t clean_blocks;      // Block literals shared as constants
+    uint16_t captures;          // Closure capture list entries
+    uint16_t boxed_vars;        // Variables boxed
+} ezom_resolver_stats_t;
+
+extern ezom_resolver_stats_t g_resolver_stats;
+
+// Top-level program or expression: no receiver, no enclosing scope.
+// Answers the number of context slots the program needs.
+uint8_t ezom_resolve_program(ezom_ast_node_t* ast);
+
+// Method body; class_ptr supplies instance variable names (0 = none)
+void ezom_resolve_method(ezom_ast_node_t* method_ast, uint24_t class_ptr);
@@ -0,0 +1,232 @@
+// ============================================================================
+// File: src/aot.c
+// Registering and running classes translated by ezom_aotc (-DEZOM_AOT)
+// ============================================================================
+
+#ifdef EZOM_AOT
+
+#include "../include/ezom_aot.h"
+#include "../include/ezom_primitives.h"
+#include "../include/ezom_lexer.h"
+#include "../include/ezom_parser.h"
+#include "../include/ezom_resolver.h"
+#include <stdio.h>
+#include <string.h>
+
+ezom_aot_stats_t g_aot_stats = {0, 0, 0, 0};
+
+uint32_t g_aot_integer_version = UINT32_MAX;
+bool g_aot_integer_ok = false;
+
+static const char* g_aot_undefined = NULL;     // Set by generated code on failure
+
+// ============================================================================
+// Helpers called from generated code
+// ============================================================================
+
+uint24_t ezom_aot_send(ezom_inline_cache_t* ic, const char* selector, uint24_t receiver,
+                       uint24_t* args, uint8_t arg_count) {
+    ezom_message_t msg = {
+        .selector = ezom_inline_cache_selector(ic, selector),
+        .receiver = receiver,
+        .args = arg_count ? args : NULL,
+        .arg_count = arg_count
+    };
+    return ezom_send_message_cached(ic, &msg);
+}
+
+uint24_t ezom_aot_store_global(ezom_global_t* global, uint24_t value) {
+    value = ezom_aot_keep(value);
+    global->value = value;
+    ezom_frame_note_store(0, value);
+    return value;
+}
+
+// The method fails, as it would interpreted
+uint24_t ezom_aot_undefined(const char* name) {
+    printf("   Debug: Undefined variable: '%s'\n", name);
+    g_aot_undefined = name;
+    return 0;
+}
+
+uint24_t ezom_aot_literal_array(const uint24_t* elements, uint16_t count) {
+    uint24_t array_ptr = ezom_create_array(count);
+    if (!array_ptr) return 0;
+
+    ezom_array_t* array = (ezom_array_t*)EZOM_OBJECT_PTR(array_ptr);
+    for (uint16_t i = 0; i < count; i++) {
+        array->elements[i] = elements[i] ? elements[i] : g_nil;
+    }
+    return ezom_fix_literal(array_ptr);
+}
+
+// The SmallInteger shortcuts stand for these Integer methods; checked
+// again after a method is installed in Integer or a superclass
+bool ezom_aot_check_integers(void) {
+    static const struct { const char* selector; uint8_t primitive; } ops[] = {
+        {"+", PRIM_INTEGER_ADD}, {"-", PRIM_INTEGER_SUB}, {"*", PRIM_INTEGER_MUL},
+        {"<", PRIM_INTEGER_LT}, {">", PRIM_INTEGER_GT}, {"<=", PRIM_INTEGER_LTE},
+        {">=", PRIM_INTEGER_GTE}, {"=", PRIM_INTEGER_EQ}
+    };
+
+    g_aot_integer_ok = true;
+    for (uint8_t i = 0; i < sizeof(ops) / sizeof(ops[0]); i++) {
+        uint24_t symbol = ezom_create_symbol(ops[i].selector, strlen(ops[i].selector));
+        ezom_method_t* method = symbol ? ezom_lookup_method(g_integer_class, symbol).method : NULL;
+        if (!method || !(method->flags & EZOM_METHOD_PRIMITIVE) || (uint8_t)method->code != ops[i].primitive) {
+            g_aot_integer_ok = false;
+            break;
+        }
+    }
+    g_aot_integer_version = ezom_class_version(g_integer_class);
+    return g_aot_integer_ok;
+}
+
+// ============================================================================
+// Activations
+// ============================================================================
+
+// The method gets a frame of its own, for the depth limit and backtraces;
+// its variables stay in C. Nothing in it can be a ^ home: methods with
+// closures are not translated.
+ezom_eval_result_t ezom_aot_run(ezom_method_code_t* method_code, uint24_t receiver, uint24_t* args) {
+    if (!ezom_frame_enter_native()) {
+        return ezom_make_error_result("Stack overflow");
+    }
+    uint24_t frame = ezom_push_frame(0, receiver, 0);
+    if (!frame) {
+        ezom_frame_leave_native();
+        return ezom_make_error_result("Stack overflow");
+    }
+    ((ezom_context_t*)EZOM_OBJECT_PTR(frame))->method = EZOM_OBJECT_ADDR(method_code);
+
+    g_aot_stats.runs++;
+    uint24_t value = method_code->aot(receiver, args);
+
+    ezom_eval_result_t result;
+    if (g_aot_undefined) {
+        g_aot_undefined = NULL;
+        result = ezom_make_error_result("Undefined variable");
+    } else if (g_frame_stack.overflow) {
+        result = ezom_make_error_result("Stack overflow");
+    } else if (g_frame_stack.returning || g_frame_stack.raising) {
+        result = ezom_make_unwind_result();
+    } else {
+        result = ezom_make_result(value);
+    }
+
+    ezom_pop_frame(frame, result.value);
+    ezom_frame_leave_native();
+    return result;
+}
+
+// ============================================================================
+// Registration
+// ============================================================================
+
+static uint24_t ezom_aot_method_code(const ezom_aot_method_t* method) {
+    uint24_t method_code_ptr = ezom_allocate(sizeof(ezom_method_code_t));
+    if (!method_code_ptr) return 0;
+
+    ezom_init_object(method_code_ptr, g_object_class, EZOM_TYPE_OBJECT);
+    ezom_method_code_t* method_code = (ezom_method_code_t*)EZOM_OBJECT_PTR(method_code_ptr);
+    memset((char*)method_code + sizeof(ezom_object_t), 0, sizeof(ezom_method_code_t) - sizeof(ezom_object_t));
+    method_code->param_count = method->arg_count;
+    method_code->aot = method->function;
+    return method_code_ptr;
+}
+
+// A method ezom_aotc left as source runs on the selected engine
+static uint24_t ezom_aot_parse_method(uint24_t class_ptr, const char* source, bool is_class_method) {
+    ezom_lexer_t lexer;
+    ezom_parser_t parser;
+    ezom_lexer_init(&lexer, (char*)source);
+    ezom_parser_init(&parser, &lexer);
+
+    ezom_ast_node_t* method_ast = ezom_parse_method_definition(&parser, is_class_method);
+    if (!method_ast) {
+        return 0;
+    }
+    ezom_resolve_method(method_ast, is_class_method ? 0 : class_ptr);
+    return ezom_compile_method_from_ast(method_ast);
+}
+
+static void ezom_aot_install(uint24_t class_ptr, const ezom_aot_method_t* methods, uint16_t count,
+                             bool is_class_method) {
+    for (uint16_t i = 0; i < count; i++) {
+        const ezom_aot_method_t* method = &methods[i];
+        uint24_t method_code;
+        if (method->function) {
+            method_code = ezom_aot_method_code(method);
+            g_aot_stats.translated++;
+        } else {
+            method_code = ezom_aot_parse_method(class_ptr, method->source, is_class_method);
+            g_aot_stats.parsed++;
+        }
+
+        if (!method_code) {
+            printf("AOT: could not install %s\n", method->selector);
+            continue;
+        }
+        ezom_install_method_in_class(class_ptr, method->selector, method_code, method->arg_count, false);
+    }
+
+    ezom_dispatch_table_finalize_class(class_ptr);
+}
+
+uint24_t ezom_aot_define_class(const ezom_aot_class_t* aot_class) {
+    uint24_t class_ptr = ezom_define_class(aot_class->name, aot_class->superclass,
+                                           aot_class->fields, aot_class->field_count);
+    if (!class_ptr) return 0;
+
+    ezom_aot_install(class_ptr, aot_class->methods, aot_class->method_count, false);
+    if (aot_class->class_method_count) {
+        uint24_t metaclass = ((ezom_class_t*)EZOM_OBJECT_PTR(class_ptr))->header.class_ptr;
+        ezom_aot_install(metaclass, aot_class->class_methods, aot_class->class_method_count, true);
+    }
+
+    ezom_set_global(aot_class->name, class_ptr);
+    g_aot_stats.classes++;
+    return class_ptr;
+}
+
+bool ezom_aot_load_program(const ezom_aot_program_t* program) {
+    program->init();
+
+    for (uint16_t i = 0; i < program->class_count; i++) {
+        if (!ezom_aot_define_class(&program->classes[i])) {
+            printf("AOT: could not define class %s\n", program->classes[i].name);
+            return false;
+        }
+    }
+
+    printf("AOT: %s: %lu classes, %lu methods compiled, %lu parsed\n", program->source_file,
+           (unsigned long)g_aot_stats.classes, (unsigned long)g_aot_stats.translated,
+           (unsigned long)g_aot_stats.parsed);
+    return true;
+}
+
+// Classes do not answer new here, so the instance is made directly
+int ezom_aot_run_program(const ezom_aot_program_t* program, const char* main_class) {
+    const char* name = main_class ? main_class : program->main_class;
+    uint24_t class_ptr = ezom_lookup_global(name);
+    if (class_ptr == g_nil) {
+        printf("AOT: no class %s\n", name);
+        return 1;
+    }
+
+    uint24_t instance = ezom_create_instance(class_ptr);
+    uint24_t result = instance ? ezom_send0(instance, ezom_create_symbol("run", 3)) : 0;
+    return result ? 0 : 1;
+}
+
+void ezom_aot_print_stats(void) {
+    printf("\n=== Ahead-of-Time Classes ===\n");
+    printf("Classes: %lu\n", (unsigned long)g_aot_stats.classes);
+    printf("Methods compiled: %lu, parsed at startup: %lu\n",
+           (unsigned long)g_aot_stats.translated, (unsigned long)g_aot_stats.parsed);
+    printf("Activations run as C: %lu\n", (unsigned long)g_aot_stats.runs);
+    printf("=============================\n\n");
+}
+
+#endif // EZOM_AOT
@@ -0,0 +1,1072 @@
+// ============================================================================
+// File: src/aotc.c
+// SOM-to-C translator: resolved method ASTs to C for -DEZOM_AOT builds
+// ============================================================================
+
+#define _DEFAULT_SOURCE     // strdup under -std=c99
+#include "../include/ezom_aotc.h"
+#include "../include/ezom_object.h"
+#include "../include/ezom_evaluator.h"
+#include "../include/ezom_lexer.h"
+#include "../include/ezom_parser.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <ctype.h>
+
+// SmallInteger literals written as immediates: the range both the 24-bit
+// and the native reference agree on. Others are made at startup.
+#define EZOM_AOTC_SMALLINT_MIN  (-0x400000)
+#define EZOM_AOTC_SMALLINT_MAX  0x3FFFFF
+#define EZOM_AOTC_MAX_ARGS      16
+
+typedef struct ezom_aotc {
+    FILE*    code;          // Method functions
+    FILE*    tables;        // Method tables and field names
+    FILE*    classes;       // Entries of aot_classes
+    FILE*    init;          // Body of aot_init
+    char**   globals;       // Names bound in aot_globals, by index
+    uint16_t global_count;
+    uint16_t sites;         // Inline caches in aot_ic
+    uint16_t literals;      // Objects in aot_literals
+    uint16_t functions;
+    // Method being written
+    uint16_t temps;
+    uint16_t marks;
+    uint8_t  indent;
+} ezom_aotc_t;
+
+static uint16_t ezom_aotc_expression(ezom_aotc_t* t, ezom_ast_node_t* node);
+
+// ============================================================================
+// Output helpers
+// ============================================================================
+
+static void ezom_aotc_emit(ezom_aotc_t* t, const char* format, ...) {
+    for (uint8_t i = 0; i < t->indent; i++) {
+        fputs("    ", t->code);
+    }
+    va_list args;
+    va_start(args, format);
+    vfprintf(t->code, format, args);
+    va_end(args);
+    fputc('\n', t->code);
+}
+
+// text as a C string literal
+static void ezom_aotc_write_c_string(FILE* out, const char* text) {
+    fputc('"', out);
+    for (const unsigned char* c = (const unsigned char*)text; *c; c++) {
+        switch (*c) {
+            case '"':  fputs("\\\"", out); break;
+            case '\\': fputs("\\\\", out); break;
+            case '\n': fputs("\\n", out); break;
+            case '\t': fputs("\\t", out); break;
+            default:
+                if (*c < 0x20 || *c >= 0x7F) {
+                    fprintf(out, "\\%03o", *c);
+                } else {
+                    fputc(*c, out);
+                }
+        }
+    }
+    fputc('"', out);
+}
+
+// Same, into buffer (selectors and names are short)
+static const char* ezom_aotc_c_string(char* buffer, size_t size, const char* text) {
+    FILE* out = tmpfile();
+    if (!out) {
+        snprintf(buffer, size, "\"\"");
+        return buffer;
+    }
+    ezom_aotc_write_c_string(out, text);
+    size_t length = (size_t)ftell(out);
+    if (length >= size) length = size - 1;
+    rewind(out);
+    buffer[fread(buffer, 1, length, out)] = '\0';
+    fclose(out);
+    return buffer;
+}
+
+static void ezom_aotc_copy(FILE* from, FILE* to) {
+    char buffer[4096];
+    size_t length;
+    rewind(from);
+    while ((length = fread(buffer, 1, sizeof(buffer), from)) > 0) {
+        fwrite(buffer, 1, length, to);
+    }
+}
+
+// C identifier part for a class name
+static void ezom_aotc_write_name(FILE* out, const char* name) {
+    for (const char* c = name; *c; c++) {
+        fputc(isalnum((unsigned char)*c) ? *c : '_', out);
+    }
+}
+
+static bool ezom_aotc_is_keyword(const char* selector) {
+    return strchr(selector, ':') != NULL;
+}
+
+static bool ezom_aotc_is_binary(const char* selector) {
+    return !isalpha((unsigned char)selector[0]) && selector[0] != '_';
+}
+
+// ============================================================================
+// Which methods translate
+// ============================================================================
+
+static const char* ezom_aotc_check(ezom_ast_node_t* node);
+
+static const char* ezom_aotc_check_list(ezom_ast_node_t* node) {
+    for (; node; node = node->next) {
+        const char* reason = ezom_aotc_check(node);
+        if (reason) return reason;
+    }
+    return NULL;
+}
+
+static const char* ezom_aotc_check_inlined(ezom_ast_node_t* block) {
+    if (!block || block->type != AST_BLOCK || !block->data.block.inlined) {
+        return "block literal stays a closure";
+    }
+    if (block->data.block.vars && block->data.block.vars->boxed_count) {
+        return "captured variables";
+    }
+    if (!block->data.block.body) return NULL;
+    return ezom_aotc_check_list(block->data.block.body->data.statement_list.statements);
+}
+
+static const char* ezom_aotc_check(ezom_ast_node_t* node) {
+    if (!node) return NULL;
+
+    switch (node->type) {
+        case AST_LITERAL:
+            return NULL;
+
+        case AST_VARIABLE_DEF:
+            switch (node->data.variable.kind) {
+                case AST_VAR_CONTEXT:
+                    if (node->data.variable.capture != AST_NO_CAPTURE || node->data.variable.boxed) {
+                        return "captured variables";
+                    }
+                    return NULL;
+                case AST_VAR_INSTANCE:
+                case AST_VAR_SELF:
+                    return NULL;
+                case AST_VAR_GLOBAL:
+                    return node->data.variable.global ? NULL : "global table full";
+                default:
+                    return "unresolved variable";
+            }
+
+        case AST_ASSIGNMENT:
+        case AST_INCREMENT: {
+            ezom_ast_node_t* variable = node->data.assignment.variable;
+            if (variable->type != AST_VARIABLE_DEF || variable->data.variable.kind == AST_VAR_SELF) {
+                return "assignment to self";
+            }
+            const char* reason = ezom_aotc_check(variable);
+            return reason ? reason : ezom_aotc_check(node->data.assignment.value);
+        }
+
+        case AST_RETURN:
+            return ezom_aotc_check(node->data.return_stmt.expression);
+
+        case AST_STATEMENT_LIST:
+            return ezom_aotc_check_list(node->data.statement_list.statements);
+
+        case AST_MESSAGE_SEND: {
+            if (node->data.message_send.is_super) {
+                return "super send";
+            }
+            ezom_ast_node_t* args = node->data.message_send.arguments;
+            uint16_t arg_count = 0;
+            for (ezom_ast_node_t* arg = args; arg; arg = arg->next) arg_count++;
+            if (arg_count > EZOM_AOTC_MAX_ARGS) {
+                return "too many arguments";
+            }
+
+            const char* reason;
+            switch (node->data.message_send.inline_kind) {
+                case AST_INLINE_NONE:
+                    reason = ezom_aotc_check(node->data.message_send.receiver);
+                    return reason ? reason : ezom_aotc_check_list(args);
+                case AST_INLINE_WHILE_TRUE:
+                case AST_INLINE_WHILE_FALSE:
+                    reason = ezom_aotc_check_inlined(node->data.message_send.receiver);
+                    return reason ? reason : ezom_aotc_check_inlined(args);
+                case AST_INLINE_TO_DO:
+                    reason = ezom_aotc_check(node->data.message_send.receiver);
+                    if (!reason) reason = ezom_aotc_check(args);
+                    return reason ? reason : ezom_aotc_check_inlined(args ? args->next : NULL);
+                case AST_INLINE_IF_TRUE_IF_FALSE:
+                    reason = ezom_aotc_check(node->data.message_send.receiver);
+                    if (!reason) reason = ezom_aotc_check_inlined(args);
+                    return reason ? reason : ezom_aotc_check_inlined(args ? args->next : NULL);
+                default:
+                    reason = ezom_aotc_check(node->data.message_send.receiver);
+                    return reason ? reason : ezom_aotc_check_inlined(args);
+            }
+        }
+
+        case AST_BLOCK:
+            return "block literal stays a closure";
+
+        default:
+            return "unsupported construct";
+    }
+}
+
+const char* ezom_aotc_unsupported(ezom_ast_node_t* method_ast) {
+    if (method_ast->data.method_def.is_primitive) {
+        return "primitive";
+    }
+    if (method_ast->data.method_def.boxed_count) {
+        return "captured variables";
+    }
+    if (ezom_ast_count_parameters(method_ast->data.method_def.parameters) > EZOM_AOTC_MAX_ARGS) {
+        return "too many arguments";
+    }
+    if (!method_ast->data.method_def.body) return NULL;
+    return ezom_aotc_check(method_ast->data.method_def.body);
+}
+
+// ============================================================================
+// Literals and globals (made once, in aot_init)
+// ============================================================================
+
+static uint16_t ezom_aotc_global(ezom_aotc_t* t, const char* name) {
+    for (uint16_t i = 0; i < t->global_count; i++) {
+        if (strcmp(t->globals[i], name) == 0) return i;
+    }
+
+    t->globals = realloc(t->globals, (t->global_count + 1) * sizeof(char*));
+    t->globals[t->global_count] = strdup(name);
+
+    char quoted[256];
+    fprintf(t->init, "    aot_globals[%u] = ezom_global_binding(%s);\n", t->global_count,
+            ezom_aotc_c_string(quoted, sizeof(quoted), name));
+    return t->global_count++;
+}
+
+static void ezom_aotc_write_double(FILE* out, double value) {
+    char text[64];
+    snprintf(text, sizeof(text), "%.17g", value);
+    fputs(text, out);
+    if (!strpbrk(text, ".eEni")) {
+        fputs(".0", out);
+    }
+}
+
+// C expression for a literal's value: an immediate, or an aot_literals slot
+static void ezom_aotc_constant(ezom_aotc_t* t, ezom_ast_node_t* node, char* buffer, size_t size) {
+    switch (node->data.literal.type) {
+        case LITERAL_NIL:   snprintf(buffer, size, "g_nil"); return;
+        case LITERAL_TRUE:  snprintf(buffer, size, "g_true"); return;
+        case LITERAL_FALSE: snprintf(buffer, size, "g_false"); return;
+
+        case LITERAL_INTEGER: {
+            long long value = (long long)node->data.literal.value.integer_value;
+            if (value >= EZOM_AOTC_SMALLINT_MIN && value <= EZOM_AOTC_SMALLINT_MAX) {
+                snprintf(buffer, size, "EZOM_SMALLINT_FROM(%lld)", value);
+                return;
+            }
+            fprintf(t->init, "    aot_literals[%u] = ezom_fix_literal(ezom_create_integer((ezom_large_int_t)%lldLL));\n",
+                    t->literals, value);
+            break;
+        }
+
+        case LITERAL_DOUBLE:
+            fprintf(t->init, "    aot_literals[%u] = ezom_fix_literal(ezom_create_double(", t->literals);
+            ezom_aotc_write_double(t->init, node->data.literal.value.double_value);
+            fprintf(t->init, "));\n");
+            break;
+
+        case LITERAL_STRING:
+        case LITERAL_SYMBOL: {
+            bool is_string = node->data.literal.type == LITERAL_STRING;
+            const char* text = is_string ? node->data.literal.value.string_value
+                                         : node->data.literal.value.symbol_value;
+            fprintf(t->init, "    aot_literals[%u] = ezom_fix_literal(ezom_create_%s(", t->literals,
+                    is_string ? "string" : "symbol");
+            ezom_aotc_write_c_string(t->init, text);
+            fprintf(t->init, ", %lu));\n", (unsigned long)strlen(text));
+            break;
+        }
+
+        case LITERAL_ARRAY: {
+            // Elements first: they may need slots of their own
+            ezom_ast_node_t* elements = node->data.literal.value.array_elements;
+            uint16_t count = elements->data.statement_list.count;
+            char (*values)[32] = calloc(count ? count : 1, sizeof(*values));
+            uint16_t i = 0;
+            for (ezom_ast_node_t* e = elements->data.statement_list.statements; e && i < count; e = e->next) {
+                ezom_aotc_constant(t, e, values[i++], sizeof(values[0]));
+            }
+
+            if (count == 0) {
+                fprintf(t->init, "    aot_literals[%u] = ezom_aot_literal_array(NULL, 0);\n", t->literals);
+            } else {
+                fprintf(t->init, "    aot_literals[%u] = ezom_aot_literal_array((const uint24_t[]){", t->literals);
+                for (i = 0; i < count; i++) {
+                    fprintf(t->init, "%s%s", i ? ", " : "", values[i]);
+                }
+                fprintf(t->init, "}, %u);\n", count);
+            }
+            free(values);
+            break;
+        }
+
+        default:
+            snprintf(buffer, size, "g_nil");
+            return;
+    }
+
+    snprintf(buffer, size, "aot_literals[%u]", t->literals++);
+}
+
+// ============================================================================
+// Methods as C
+// ============================================================================
+
+static uint16_t ezom_aotc_temp(ezom_aotc_t* t) {
+    return t->temps++;
+}
+
+// A send through the site's inline cache, into t<result>
+static void ezom_aotc_send(ezom_aotc_t* t, const char* selector, uint16_t receiver,
+                           char (*args)[32], uint8_t arg_count, uint16_t result) {
+    uint16_t site = t->sites++;
+    char quoted[256];
+    ezom_aotc_c_string(quoted, sizeof(quoted), selector);
+
+    char args_expr[32] = "NULL";
+    if (arg_count == 1 && args[0][0] == 't') {
+        snprintf(args_expr, sizeof(args_expr), "&%s", args[0]);
+    } else if (arg_count > 0) {
+        char list[EZOM_AOTC_MAX_ARGS * 34] = "";
+        for (uint8_t i = 0; i < arg_count; i++) {
+            if (i) strcat(list, ", ");
+            strcat(list, args[i]);
+        }
+        ezom_aotc_emit(t, "uint24_t a%u[] = {%s};", site, list);
+        snprintf(args_expr, sizeof(args_expr), "a%u", site);
+    }
+
+    ezom_aotc_emit(t, "t%u = ezom_aot_send(&aot_ic[%u], %s, t%u, %s, %u);",
+                   result, site, quoted, receiver, args_expr, arg_count);
+    ezom_aotc_emit(t, "EZOM_AOT_CHECK();");
+}
+
+// Statements into t<result>; a finished statement's scratch Doubles are
+// dead, as in ezom_evaluate_statement_list
+static void ezom_aotc_statements(ezom_aotc_t* t, ezom_ast_node_t* list, uint16_t result) {
+    ezom_ast_node_t* statement = list ? list->data.statement_list.statements : NULL;
+    if (!statement) {
+        ezom_aotc_emit(t, "t%u = g_nil;", result);
+        return;
+    }
+
+    uint16_t mark = t->marks++;
+    if (statement->next) {
+        ezom_aotc_emit(t, "uint16_t m%u = ezom_double_scratch_mark();", mark);
+    }
+    for (; statement; statement = statement->next) {
+        uint16_t value = ezom_aotc_expression(t, statement);
+        if (statement->next) {
+            ezom_aotc_emit(t, "ezom_double_scratch_release(m%u);", mark);
+        } else {
+            ezom_aotc_emit(t, "t%u = t%u;", result, value);
+        }
+    }
+}
+
+// Inlined block body in this function; its locals start out nil
+static void ezom_aotc_inlined_block(ezom_aotc_t* t, ezom_ast_node_t* block, uint16_t result) {
+    uint8_t first_local = block->data.block.inline_base +
+                          ezom_ast_count_parameters(block->data.block.parameters);
+    uint8_t local_count = ezom_ast_count_locals(block->data.block.locals);
+    for (uint8_t i = 0; i < local_count; i++) {
+        ezom_aotc_emit(t, "s%u = g_nil;", first_local + i);
+    }
+    ezom_aotc_statements(t, block->data.block.body, result);
+}
+
+// to:do: and timesRepeat: over SmallIntegers
+static void ezom_aotc_loop(ezom_aotc_t* t, ezom_ast_node_t* block, const char* start, const char* end) {
+    uint16_t loop = t->marks++;
+    ezom_aotc_emit(t, "uint16_t m%u = ezom_double_scratch_mark();", loop);
+    ezom_aotc_emit(t, "for (int32_t i%u = %s, e%u = %s; i%u <= e%u; i%u++) {",
+                   loop, start, loop, end, loop, loop, loop);
+    t->indent++;
+    if (ezom_ast_count_parameters(block->data.block.parameters) == 1) {
+        ezom_aotc_emit(t, "s%u = EZOM_SMALLINT_FROM(i%u);", block->data.block.inline_base, loop);
+    }
+    uint16_t body = ezom_aotc_temp(t);
+    ezom_aotc_emit(t, "uint24_t t%u;", body);
+    ezom_aotc_inlined_block(t, block, body);
+    ezom_aotc_emit(t, "ezom_double_scratch_release(m%u);", loop);
+    ezom_aotc_emit(t, "if (i%u == e%u) break;      // Do not step past the largest value", loop, loop);
+    t->indent--;
+    ezom_aotc_emit(t, "}");
+}
+
+// [cond] whileTrue: [body]: any other condition value ends the loop
+static uint16_t ezom_aotc_while(ezom_aotc_t* t, ezom_ast_node_t* node) {
+    bool while_true = node->data.message_send.inline_kind == AST_INLINE_WHILE_TRUE;
+    uint16_t result = ezom_aotc_temp(t);
+    uint16_t loop = t->marks++;
+    ezom_aotc_emit(t, "uint24_t t%u = g_nil;", result);
+    ezom_aotc_emit(t, "uint16_t m%u = ezom_double_scratch_mark();", loop);
+    ezom_aotc_emit(t, "for (;;) {");
+    t->indent++;
+    uint16_t condition = ezom_aotc_temp(t);
+    ezom_aotc_emit(t, "uint24_t t%u;", condition);
+    ezom_aotc_inlined_block(t, node->data.message_send.receiver, condition);
+    ezom_aotc_emit(t, "if (t%u != %s) break;", condition, while_true ? "g_true" : "g_false");
+    uint16_t body = ezom_aotc_temp(t);
+    ezom_aotc_emit(t, "uint24_t t%u;", body);
+    ezom_aotc_inlined_block(t, node->data.message_send.arguments, body);
+    ezom_aotc_emit(t, "ezom_double_scratch_release(m%u);", loop);
+    t->indent--;
+    ezom_aotc_emit(t, "}");
+    return result;
+}
+
+// One arm of an inlined branch: a block, or a constant answer
+static void ezom_aotc_arm(ezom_aotc_t* t, ezom_ast_node_t* block, const char* constant, uint16_t result) {
+    t->indent++;
+    if (block) {
+        ezom_aotc_inlined_block(t, block, result);
+    } else {
+        ezom_aotc_emit(t, "t%u = %s;", result, constant);
+    }
+    t->indent--;
+}
+
+// Branches and loops in C while the receiver is a Boolean or SmallInteger.
+// Otherwise the send is made after all, with nil for the blocks: there is
+// no closure to pass from a translated method.
+static uint16_t ezom_aotc_inlined_send(ezom_aotc_t* t, ezom_ast_node_t* node) {
+    ezom_inline_kind_t kind = (ezom_inline_kind_t)node->data.message_send.inline_kind;
+    ezom_ast_node_t* block = node->data.message_send.arguments;
+    const char* selector = node->data.message_send.selector;
+
+    if (kind == AST_INLINE_WHILE_TRUE || kind == AST_INLINE_WHILE_FALSE) {
+        return ezom_aotc_while(t, node);
+    }
+
+    uint16_t receiver = ezom_aotc_expression(t, node->data.message_send.receiver);
+    uint16_t result = ezom_aotc_temp(t);
+    ezom_aotc_emit(t, "uint24_t t%u;", result);
+    char args[2][32] = {"g_nil", "g_nil"};
+
+    switch (kind) {
+        case AST_INLINE_TIMES_REPEAT:
+        case AST_INLINE_TO_DO: {
+            char start[32], end[32];
+            ezom_ast_node_t* body = block;
+            uint16_t limit = 0;
+            if (kind == AST_INLINE_TO_DO) {
+                limit = ezom_aotc_expression(t, block);
+                body = block->next;
+                snprintf(args[0], sizeof(args[0]), "t%u", limit);
+                ezom_aotc_emit(t, "if (EZOM_IS_SMALLINT(t%u) && EZOM_IS_SMALLINT(t%u)) {", receiver, limit);
+                snprintf(start, sizeof(start), "EZOM_SMALLINT_VALUE(t%u)", receiver);
+                snprintf(end, sizeof(end), "EZOM_SMALLINT_VALUE(t%u)", limit);
+            } else {
+                ezom_aotc_emit(t, "if (EZOM_IS_SMALLINT(t%u)) {", receiver);
+                snprintf(start, sizeof(start), "1");
+                snprintf(end, sizeof(end), "EZOM_SMALLINT_VALUE(t%u)", receiver);
+            }
+            t->indent++;
+            ezom_aotc_loop(t, body, start, end);
+            ezom_aotc_emit(t, "t%u = t%u;", result, receiver);
+            t->indent--;
+            break;
+        }
+
+        default: {
+            const char* on_true = "g_nil";
+            const char* on_false = "g_nil";
+            ezom_ast_node_t* true_block = NULL;
+            ezom_ast_node_t* false_block = NULL;
+            switch (kind) {
+                case AST_INLINE_IF_TRUE:  true_block = block; break;
+                case AST_INLINE_IF_FALSE: false_block = block; break;
+                case AST_INLINE_IF_TRUE_IF_FALSE: true_block = block; false_block = block->next; break;
+                case AST_INLINE_AND: true_block = block; on_false = "g_false"; break;
+                case AST_INLINE_OR:  on_true = "g_true"; false_block = block; break;
+                default: break;
+            }
+            ezom_aotc_emit(t, "if (t%u == g_true) {", receiver);
+            ezom_aotc_arm(t, true_block, on_true, result);
+            ezom_aotc_emit(t, "} else if (t%u == g_false) {", receiver);
+            ezom_aotc_arm(t, false_block, on_false, result);
+            break;
+        }
+    }
+
+    ezom_aotc_emit(t, "} else {");
+    t->indent++;
+    ezom_aotc_send(t, selector, receiver, args, kind == AST_INLINE_IF_TRUE_IF_FALSE ||
+                                               kind == AST_INLINE_TO_DO ? 2 : 1, result);
+    t->indent--;
+    ezom_aotc_emit(t, "}");
+    return result;
+}
+
+// SmallInteger shortcut in ezom_aot.h for a binary selector, or NULL
+static const char* ezom_aotc_integer_op(const char* selector) {
+    static const char* const ops[][2] = {
+        {"+", "add"}, {"-", "sub"}, {"*", "mul"}, {"<", "less"}, {">", "greater"},
+        {"<=", "less_equal"}, {">=", "greater_equal"}, {"=", "equal"}
+    };
+    for (uint8_t i = 0; i < sizeof(ops) / sizeof(ops[0]); i++) {
+        if (strcmp(selector, ops[i][0]) == 0) return ops[i][1];
+    }
+    return NULL;
+}
+
+static uint16_t ezom_aotc_message_send(ezom_aotc_t* t, ezom_ast_node_t* node) {
+    if (node->data.message_send.inline_kind != AST_INLINE_NONE) {
+        return ezom_aotc_inlined_send(t, node);
+    }
+
+    uint16_t receiver = ezom_aotc_expression(t, node->data.message_send.receiver);
+    char args[EZOM_AOTC_MAX_ARGS][32];
+    uint8_t arg_count = 0;
+    for (ezom_ast_node_t* arg = node->data.message_send.arguments; arg; arg = arg->next) {
+        snprintf(args[arg_count++], sizeof(args[0]), "t%u", ezom_aotc_expression(t, arg));
+    }
+
+    uint16_t result = ezom_aotc_temp(t);
+    ezom_aotc_emit(t, "uint24_t t%u;", result);
+    const char* op = arg_count == 1 ? ezom_aotc_integer_op(node->data.message_send.selector) : NULL;
+    if (op) {
+        ezom_aotc_emit(t, "if (!ezom_aot_%s(t%u, %s, &t%u)) {", op, receiver, args[0], result);
+        t->indent++;
+    }
+    ezom_aotc_send(t, node->data.message_send.selector, receiver, args, arg_count, result);
+    if (op) {
+        t->indent--;
+        ezom_aotc_emit(t, "}");
+    }
+    return result;
+}
+
+static uint16_t ezom_aotc_variable(ezom_aotc_t* t, ezom_ast_node_t* node) {
+    uint16_t result = ezom_aotc_temp(t);
+    switch (node->data.variable.kind) {
+        case AST_VAR_CONTEXT:
+            ezom_aotc_emit(t, "uint24_t t%u = ezom_aot_load(s%u);", result, node->data.variable.index);
+            break;
+        case AST_VAR_INSTANCE:
+            ezom_aotc_emit(t, "uint24_t t%u = EZOM_AOT_FIELDS(self)[%u];", result, node->data.variable.index);
+            break;
+        case AST_VAR_GLOBAL: {
+            char quoted[256];
+            ezom_aotc_emit(t, "uint24_t t%u = aot_globals[%u]->value;", result,
+                           ezom_aotc_global(t, node->data.variable.name));
+            ezom_aotc_emit(t, "if (!t%u) return ezom_aot_undefined(%s);", result,
+                           ezom_aotc_c_string(quoted, sizeof(quoted), node->data.variable.name));
+            break;
+        }
+        default:
+            ezom_aotc_emit(t, "uint24_t t%u = self;", result);
+            break;
+    }
+    return result;
+}
+
+// Stores keep a heap copy of a scratch Double, as ezom_evaluate_assignment
+// does; a local overwrites the Double it already owns
+static uint16_t ezom_aotc_assignment(ezom_aotc_t* t, ezom_ast_node_t* node) {
+    ezom_ast_node_t* variable = node->data.assignment.variable;
+    uint16_t value = ezom_aotc_expression(t, node->data.assignment.value);
+    uint16_t result = ezom_aotc_temp(t);
+
+    switch (variable->data.variable.kind) {
+        case AST_VAR_CONTEXT:
+            ezom_aotc_emit(t, "uint24_t t%u = t%u;", result, value);
+            ezom_aotc_emit(t, "s%u = ezom_aot_store(s%u, t%u);", variable->data.variable.index,
+                           variable->data.variable.index, result);
+            break;
+        case AST_VAR_INSTANCE:
+            ezom_aotc_emit(t, "uint24_t t%u = ezom_aot_keep(t%u);", result, value);
+            ezom_aotc_emit(t, "ezom_set_instance_variable(self, %u, t%u);", variable->data.variable.index, result);
+            break;
+        default:
+            ezom_aotc_emit(t, "uint24_t t%u = ezom_aot_store_global(aot_globals[%u], t%u);", result,
+                           ezom_aotc_global(t, variable->data.variable.name), value);
+            break;
+    }
+    return result;
+}
+
+// Code for one expression; answers the temporary that holds its value
+static uint16_t ezom_aotc_expression(ezom_aotc_t* t, ezom_ast_node_t* node) {
+    uint16_t result;
+    switch (node->type) {
+        case AST_LITERAL: {
+            char constant[32];
+            ezom_aotc_constant(t, node, constant, sizeof(constant));
+            result = ezom_aotc_temp(t);
+            ezom_aotc_emit(t, "uint24_t t%u = %s;", result, constant);
+            return result;
+        }
+
+        case AST_VARIABLE_DEF:
+            return ezom_aotc_variable(t, node);
+
+        case AST_ASSIGNMENT:
+        case AST_INCREMENT:
+            return ezom_aotc_assignment(t, node);
+
+        case AST_MESSAGE_SEND:
+            return ezom_aotc_message_send(t, node);
+
+        case AST_RETURN:
+            if (!node->data.return_stmt.expression) {
+                ezom_aotc_emit(t, "return g_nil;");
+                result = ezom_aotc_temp(t);
+                ezom_aotc_emit(t, "uint24_t t%u = g_nil;", result);
+                return result;
+            }
+            result = ezom_aotc_expression(t, node->data.return_stmt.expression);
+            ezom_aotc_emit(t, "return t%u;", result);
+            return result;
+
+        case AST_STATEMENT_LIST:
+        default:
+            result = ezom_aotc_temp(t);
+            ezom_aotc_emit(t, "uint24_t t%u;", result);
+            ezom_aotc_statements(t, node, result);
+            return result;
+    }
+}
+
+static void ezom_aotc_method(ezom_aotc_t* t, const char* class_name, ezom_ast_node_t* method_ast,
+                             uint16_t function) {
+    uint8_t param_count = ezom_ast_count_parameters(method_ast->data.method_def.parameters);
+    uint16_t slot_count = param_count + ezom_ast_count_locals(method_ast->data.method_def.locals) +
+                          method_ast->data.method_def.inlined_slots;
+
+    t->temps = 0;
+    t->marks = 0;
+    t->indent = 0;
+
+    fprintf(t->code, "// %s%s>>%s\n", class_name, method_ast->data.method_def.is_class_method ? " class" : "",
+            method_ast->data.method_def.selector);
+    fprintf(t->code, "static uint24_t aot_");
+    ezom_aotc_write_name(t->code, class_name);
+    fprintf(t->code, "_%u(uint24_t self, uint24_t* args) {\n", function);
+
+    t->indent = 1;
+    for (uint16_t i = 0; i < slot_count; i++) {
+        if (i < param_count) {
+            ezom_aotc_emit(t, "uint24_t s%u = args[%u];", i, i);
+        } else {
+            ezom_aotc_emit(t, "uint24_t s%u = g_nil;", i);
+        }
+    }
+    uint16_t body = ezom_aotc_temp(t);
+    ezom_aotc_emit(t, "uint24_t t%u;", body);
+    ezom_aotc_statements(t, method_ast->data.method_def.body, body);
+    ezom_aotc_emit(t, "return self;");
+    fprintf(t->code, "}\n\n");
+}
+
+// ============================================================================
+// Methods as SOM source
+// ============================================================================
+
+static void ezom_aotc_write_node(FILE* out, ezom_ast_node_t* node);
+
+static void ezom_aotc_write_statements(FILE* out, ezom_ast_node_t* list) {
+    if (!list) return;
+    for (ezom_ast_node_t* s = list->data.statement_list.statements; s; s = s->next) {
+        ezom_aotc_write_node(out, s);
+        if (s->next) fputs(". ", out);
+    }
+}
+
+static void ezom_aotc_write_variables(FILE* out, ezom_ast_node_t* list, const char* prefix) {
+    for (uint16_t i = 0; list && i < list->data.variable_list.count; i++) {
+        fprintf(out, "%s%s ", prefix, list->data.variable_list.names[i]);
+    }
+}
+
+// Sends and assignments inside an expression get parentheses
+static void ezom_aotc_write_operand(FILE* out, ezom_ast_node_t* node) {
+    bool negative = node->type == AST_LITERAL &&
+                    ((node->data.literal.type == LITERAL_INTEGER && node->data.literal.value.integer_value < 0) ||
+                     (node->data.literal.type == LITERAL_DOUBLE && node->data.literal.value.double_value < 0));
+    bool wrap = negative || node->type == AST_MESSAGE_SEND ||
+                node->type == AST_ASSIGNMENT || node->type == AST_INCREMENT;
+    if (wrap) fputc('(', out);
+    ezom_aotc_write_node(out, node);
+    if (wrap) fputc(')', out);
+}
+
+static void ezom_aotc_write_literal(FILE* out, ezom_ast_node_t* node) {
+    switch (node->data.literal.type) {
+        case LITERAL_INTEGER:
+            fprintf(out, "%lld", (long long)node->data.literal.value.integer_value);
+            break;
+        case LITERAL_DOUBLE: {
+            // The lexer wants digits on both sides of the point: 1.0e20
+            char text[64];
+            snprintf(text, sizeof(text), "%.17g", node->data.literal.value.double_value);
+            char* exponent = strchr(text, 'e');
+            if (exponent) *exponent = '\0';
+            fputs(text, out);
+            if (!strchr(text, '.')) fputs(".0", out);
+            if (exponent) {
+                exponent++;
+                if (*exponent == '+') exponent++;
+                fprintf(out, "e%s", exponent);
+            }
+            break;
+        }
+        case LITERAL_STRING:
+            fprintf(out, "'%s'", node->data.literal.value.string_value);
+            break;
+        case LITERAL_SYMBOL:
+            fprintf(out, "#%s", node->data.literal.value.symbol_value);
+            break;
+        case LITERAL_ARRAY: {
+            fputs("#(", out);
+            ezom_ast_node_t* elements = node->data.literal.value.array_elements;
+            for (ezom_ast_node_t* e = elements->data.statement_list.statements; e; e = e->next) {
+                // Inside #( ) a symbol needs no #
+                if (e->data.literal.type == LITERAL_SYMBOL) {
+                    fputs(e->data.literal.value.symbol_value, out);
+                } else {
+                    ezom_aotc_write_literal(out, e);
+                }
+                if (e->next) fputc(' ', out);
+            }
+            fputc(')', out);
+            break;
+        }
+        case LITERAL_NIL:   fputs("nil", out); break;
+        case LITERAL_TRUE:  fputs("true", out); break;
+        case LITERAL_FALSE: fputs("false", out); break;
+    }
+}
+
+static void ezom_aotc_write_send(FILE* out, ezom_ast_node_t* node) {
+    const char* selector = node->data.message_send.selector;
+    ezom_ast_node_t* arg = node->data.message_send.arguments;
+    ezom_aotc_write_operand(out, node->data.message_send.receiver);
+
+    if (!ezom_aotc_is_keyword(selector)) {
+        fprintf(out, " %s", selector);
+        if (arg) {
+            fputc(' ', out);
+            ezom_aotc_write_operand(out, arg);
+        }
+        return;
+    }
+
+    // at:put: -> at: a put: b
+    const char* part = selector;
+    for (; arg && *part; arg = arg->next) {
+        const char* colon = strchr(part, ':');
+        fprintf(out, " %.*s ", (int)(colon - part + 1), part);
+        ezom_aotc_write_operand(out, arg);
+        part = colon + 1;
+    }
+}
+
+static void ezom_aotc_write_node(FILE* out, ezom_ast_node_t* node) {
+    switch (node->type) {
+        case AST_LITERAL:
+            ezom_aotc_write_literal(out, node);
+            break;
+        case AST_VARIABLE_DEF:
+            fputs(node->data.variable.name, out);
+            break;
+        case AST_IDENTIFIER:
+            fputs(node->data.identifier.name, out);
+            break;
+        case AST_ASSIGNMENT:
+        case AST_INCREMENT:
+            ezom_aotc_write_node(out, node->data.assignment.variable);
+            fputs(" := ", out);
+            ezom_aotc_write_node(out, node->data.assignment.value);
+            break;
+        case AST_RETURN:
+            fputc('^', out);
+            if (node->data.return_stmt.expression) {
+                ezom_aotc_write_node(out, node->data.return_stmt.expression);
+            } else {
+                fputs("nil", out);
+            }
+            break;
+        case AST_MESSAGE_SEND:
+            ezom_aotc_write_send(out, node);
+            break;
+        case AST_BLOCK:
+            fputc('[', out);
+            if (node->data.block.parameters && node->data.block.parameters->data.variable_list.count) {
+                ezom_aotc_write_variables(out, node->data.block.parameters, ":");
+                fputs("| ", out);
+            }
+            if (node->data.block.locals && node->data.block.locals->data.variable_list.count) {
+                fputs("| ", out);
+                ezom_aotc_write_variables(out, node->data.block.locals, "");
+                fputs("| ", out);
+            }
+            ezom_aotc_write_statements(out, node->data.block.body);
+            fputc(']', out);
+            break;
+        case AST_STATEMENT_LIST:
+            fputc('(', out);
+            ezom_aotc_write_statements(out, node);
+            fputc(')', out);
+            break;
+        default:
+            fputs("nil", out);
+            break;
+    }
+}
+
+void ezom_aotc_write_source(FILE* out, ezom_ast_node_t* method_ast) {
+    const char* selector = method_ast->data.method_def.selector;
+    ezom_ast_node_t* params = method_ast->data.method_def.parameters;
+
+    if (ezom_aotc_is_keyword(selector)) {
+        const char* part = selector;
+        for (uint16_t i = 0; params && i < params->data.variable_list.count; i++) {
+            const char* colon = strchr(part, ':');
+            fprintf(out, "%.*s %s ", (int)(colon - part + 1), part, params->data.variable_list.names[i]);
+            part = colon + 1;
+        }
+    } else if (ezom_aotc_is_binary(selector) && params && params->data.variable_list.count) {
+        fprintf(out, "%s %s ", selector, params->data.variable_list.names[0]);
+    } else {
+        fprintf(out, "%s ", selector);
+    }
+
+    fputs("= ( ", out);
+    ezom_ast_node_t* locals = method_ast->data.method_def.locals;
+    if (locals && locals->data.variable_list.count) {
+        fputs("| ", out);
+        ezom_aotc_write_variables(out, locals, "");
+        fputs("| ", out);
+    }
+    ezom_aotc_write_statements(out, method_ast->data.method_def.body);
+    fputs(" )", out);
+}
+
+// ============================================================================
+// Classes and files
+// ============================================================================
+
+// Functions for a method list and the table naming them
+static uint16_t ezom_aotc_method_list(ezom_aotc_t* t, const char* class_name, uint16_t class_index,
+                                      ezom_ast_node_t* methods, const char* kind, bool translate,
+                                      ezom_aotc_stats_t* stats) {
+    FILE* entries = tmpfile();
+    uint16_t count = 0;
+
+    ezom_ast_node_t* first = methods ? methods->data.statement_list.statements : NULL;
+    for (ezom_ast_node_t* method = first; method; method = method->next) {
+        if (method->type != AST_METHOD_DEF) continue;
+
+        char quoted[256];
+        const char* selector = method->data.method_def.selector;
+        uint8_t arg_count = ezom_ast_count_parameters(method->data.method_def.parameters);
+        const char* reason = translate ? ezom_aotc_unsupported(method) : "--source-only";
+
+        fprintf(entries, "    {%s, %u, ", ezom_aotc_c_string(quoted, sizeof(quoted), selector), arg_count);
+        if (!reason) {
+            uint16_t function = t->functions++;
+            ezom_aotc_method(t, class_name, method, function);
+            fputs("aot_", entries);
+            ezom_aotc_write_name(entries, class_name);
+            fprintf(entries, "_%u, NULL},\n", function);
+            stats->translated++;
+        } else {
+            FILE* source = tmpfile();
+            ezom_aotc_write_source(source, method);
+            fputc('\0', source);
+            long length = ftell(source);
+            char* text = malloc(length);
+            rewind(source);
+            if (fread(text, 1, length, source) != (size_t)length) text[0] = '\0';
+            fclose(source);
+
+            fputs("NULL, ", entries);
+            ezom_aotc_write_c_string(entries, text);
+            fputs("},\n", entries);
+            free(text);
+            stats->kept++;
+            if (translate) {
+                fprintf(stderr, "  %s>>%s kept as source: %s\n", class_name, selector, reason);
+            }
+        }
+        count++;
+    }
+
+    if (count) {
+        fprintf(t->tables, "static const ezom_aot_method_t aot_class%u_%s[] = {\n", class_index, kind);
+        ezom_aotc_copy(entries, t->tables);
+        fprintf(t->tables, "};\n");
+    }
+    fclose(entries);
+    return count;
+}
+
+static void ezom_aotc_class(ezom_aotc_t* t, ezom_ast_node_t* class_ast, uint16_t class_index,
+                            bool translate, ezom_aotc_stats_t* stats) {
+    const char* name = class_ast->data.class_def.name;
+    ezom_ast_node_t* superclass = class_ast->data.class_def.superclass;
+    ezom_ast_node_t* fields = class_ast->data.class_def.instance_vars;
+    uint16_t field_count = fields ? fields->data.variable_list.count : 0;
+    char quoted[256];
+
+    fprintf(t->tables, "// %s\n", name);
+    if (field_count) {
+        fprintf(t->tables, "static const char* const aot_class%u_fields[] = {", class_index);
+        for (uint16_t i = 0; i < field_count; i++) {
+            fprintf(t->tables, "%s%s", i ? ", " : "",
+                    ezom_aotc_c_string(quoted, sizeof(quoted), fields->data.variable_list.names[i]));
+        }
+        fprintf(t->tables, "};\n");
+    }
+
+    uint16_t method_count = ezom_aotc_method_list(t, name, class_index, class_ast->data.class_def.instance_methods,
+                                                  "methods", translate, stats);
+    uint16_t class_method_count = ezom_aotc_method_list(t, name, class_index, class_ast->data.class_def.class_methods,
+                                                        "class_methods", translate, stats);
+    fputc('\n', t->tables);
+
+    fprintf(t->classes, "    {%s, ", ezom_aotc_c_string(quoted, sizeof(quoted), name));
+    if (superclass && superclass->type == AST_IDENTIFIER) {
+        fprintf(t->classes, "%s, ", ezom_aotc_c_string(quoted, sizeof(quoted), superclass->data.identifier.name));
+    } else {
+        fprintf(t->classes, "NULL, ");
+    }
+    if (field_count) {
+        fprintf(t->classes, "aot_class%u_fields, %u, ", class_index, field_count);
+    } else {
+        fprintf(t->classes, "NULL, 0, ");
+    }
+    if (method_count) {
+        fprintf(t->classes, "aot_class%u_methods, %u, ", class_index, method_count);
+    } else {
+        fprintf(t->classes, "NULL, 0, ");
+    }
+    if (class_method_count) {
+        fprintf(t->classes, "aot_class%u_class_methods, %u},\n", class_index, class_method_count);
+    } else {
+        fprintf(t->classes, "NULL, 0},\n");
+    }
+    stats->classes++;
+}
+
+static void ezom_aotc_write_file(ezom_aotc_t* t, FILE* out, const char* source_name, const char* main_class,
+                                 uint16_t class_count) {
+    char quoted[256];
+
+    fprintf(out, "// ============================================================================\n");
+    fprintf(out, "// Generated by ezom_aotc from %s: do not edit\n", source_name);
+    fprintf(out, "// ============================================================================\n\n");
+    fprintf(out, "#include \"ezom_aot.h\"\n\n");
+    fprintf(out, "#pragma GCC diagnostic ignored \"-Wunused-variable\"\n");
+    fprintf(out, "#pragma GCC diagnostic ignored \"-Wunused-parameter\"\n");
+    fprintf(out, "#pragma GCC diagnostic ignored \"-Wunused-but-set-variable\"\n\n");
+    fprintf(out, "static ezom_inline_cache_t aot_ic[%u];\n", t->sites ? t->sites : 1);
+    fprintf(out, "static ezom_global_t* aot_globals[%u];\n", t->global_count ? t->global_count : 1);
+    fprintf(out, "static uint24_t aot_literals[%u];\n\n", t->literals ? t->literals : 1);
+
+    ezom_aotc_copy(t->code, out);
+    ezom_aotc_copy(t->tables, out);
+
+    fprintf(out, "static void aot_init(void) {\n");
+    ezom_aotc_copy(t->init, out);
+    fprintf(out, "}\n\n");
+
+    fprintf(out, "static const ezom_aot_class_t aot_classes[] = {\n");
+    ezom_aotc_copy(t->classes, out);
+    fprintf(out, "};\n\n");
+
+    fprintf(out, "const ezom_aot_program_t ezom_aot_program = {\n    %s, aot_classes, %u, ",
+            ezom_aotc_c_string(quoted, sizeof(quoted), source_name), class_count);
+    fprintf(out, "%s, aot_init\n};\n", ezom_aotc_c_string(quoted, sizeof(quoted), main_class));
+}
+
+bool ezom_aotc_translate_file(const char* source, const char* source_name, FILE* out,
+                              bool translate, ezom_aotc_stats_t* stats) {
+    ezom_aotc_t t;
+    memset(&t, 0, sizeof(t));
+    t.code = tmpfile();
+    t.tables = tmpfile();
+    t.classes = tmpfile();
+    t.init = tmpfile();
+    if (!t.code || !t.tables || !t.classes || !t.init) {
+        fprintf(stderr, "ezom_aotc: cannot create temporary files\n");
+        return false;
+    }
+
+    // The lexer keeps pointers into its input
+    char* text = strdup(source);
+    ezom_lexer_t lexer;
+    ezom_parser_t parser;
+    ezom_lexer_init(&lexer, text);
+    ezom_parser_init(&parser, &lexer);
+
+    char main_class[256] = "";
+    uint16_t class_count = 0;
+    bool ok = true;
+
+    while (true) {
+        while (lexer.current_token.type == TOKEN_NEWLINE) {
+            ezom_lexer_next_token(&lexer);
+        }
+        if (lexer.current_token.type == TOKEN_EOF) break;
+
+        ezom_ast_node_t* class_ast = ezom_parse_class_definition(&parser);
+        if (!class_ast) {
+            fprintf(stderr, "%s:%u: %s\n", source_name, lexer.current_token.line,
+                    parser.error_message[0] ? parser.error_message : "class definition expected");
+            ok = false;
+            break;
+        }
+
+        // Defined here too, so later classes and the resolver see it
+        if (ezom_evaluate_class_definition(class_ast, 0).is_error) {
+            fprintf(stderr, "%s: cannot define class %s\n", source_name, class_ast->data.class_def.name);
+            ok = false;
+            break;
+        }
+
+        ezom_aotc_class(&t, class_ast, class_count++, translate, stats);
+        snprintf(main_class, sizeof(main_class), "%s", class_ast->data.class_def.name);
+    }
+
+    if (ok && class_count == 0) {
+        fprintf(stderr, "%s: no classes\n", source_name);
+        ok = false;
+    }
+    if (ok) {
+        ezom_aotc_write_file(&t, out, source_name, main_class, class_count);
+    }
+
+    fclose(t.code);
+    fclose(t.tables);
+    fclose(t.classes);
+    fclose(t.init);
+    for (uint16_t i = 0; i < t.global_count; i++) {
+        free(t.globals[i]);
+    }
+    free(t.globals);
+    free(text);
+    return ok;
+}
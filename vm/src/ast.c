@@ -3,6 +3,7 @@
 // Abstract Syntax Tree implementation
 // ============================================================================
 
+#define _DEFAULT_SOURCE     // strdup under -std=c99
 #include "../include/ezom_ast.h"
 #include "../include/ezom_ast_memory.h"
 #include "../include/ezom_memory.h"
@@ -50,6 +51,9 @@ ezom_ast_node_t* ezom_ast_create_method_def(char* selector, bool is_class_method
     node->data.method_def.is_class_method = is_class_method;
     node->data.method_def.is_primitive = false;
     node->data.method_def.primitive_number = 0;
+    node->data.method_def.inlined_slots = 0;
+    node->data.method_def.boxed = NULL;
+    node->data.method_def.boxed_count = 0;
     
     return node;
 }
@@ -63,6 +67,7 @@ ezom_ast_node_t* ezom_ast_create_message_send(ezom_ast_node_t* receiver, char* s
     node->data.message_send.arguments = NULL;
     node->data.message_send.is_super = false;
     node->data.message_send.arg_count = 0;
+    node->data.message_send.inline_kind = AST_INLINE_NONE;
     
     return node;
 }
@@ -76,6 +81,13 @@ ezom_ast_node_t* ezom_ast_create_block(void) {
     node->data.block.body = NULL;
     node->data.block.param_count = 0;
     node->data.block.local_count = 0;
+    node->data.block.code = NULL;
+    node->data.block.no_bytecode = false;
+    node->data.block.inlined = false;
+    node->data.block.inline_base = 0;
+    node->data.block.inlined_slots = 0;
+    node->data.block.clean = false;
+    node->data.block.vars = NULL;
     
     return node;
 }
@@ -100,7 +112,7 @@ ezom_ast_node_t* ezom_ast_create_assignment(ezom_ast_node_t* variable, ezom_ast_
     return node;
 }
 
-ezom_ast_node_t* ezom_ast_create_literal_integer(int16_t value) {
+ezom_ast_node_t* ezom_ast_create_literal_integer(ezom_large_int_t value) {
     ezom_ast_node_t* node = ezom_ast_create(AST_LITERAL);
     if (!node) return NULL;
     
@@ -110,6 +122,16 @@ ezom_ast_node_t* ezom_ast_create_literal_integer(int16_t value) {
     return node;
 }
 
+ezom_ast_node_t* ezom_ast_create_literal_double(double value) {
+    ezom_ast_node_t* node = ezom_ast_create(AST_LITERAL);
+    if (!node) return NULL;
+    
+    node->data.literal.type = LITERAL_DOUBLE;
+    node->data.literal.value.double_value = value;
+    
+    return node;
+}
+
 ezom_ast_node_t* ezom_ast_create_literal_string(const char* value) {
     ezom_ast_node_t* node = ezom_ast_create(AST_LITERAL);
     if (!node) return NULL;
@@ -195,6 +217,10 @@ ezom_ast_node_t* ezom_ast_create_variable(const char* name) {
     node->data.variable.is_instance_var = false;
     node->data.variable.is_local = false;
     node->data.variable.index = 0;
+    node->data.variable.kind = AST_VAR_UNRESOLVED;
+    node->data.variable.capture = AST_NO_CAPTURE;
+    node->data.variable.boxed = false;
+    node->data.variable.global = NULL;
     
     if (!node->data.variable.name) {
         free(node);
@@ -296,6 +322,7 @@ void ezom_ast_free(ezom_ast_node_t* node) {
             ezom_ast_free(node->data.method_def.parameters);
             ezom_ast_free(node->data.method_def.locals);
             ezom_ast_free(node->data.method_def.body);
+            free(node->data.method_def.boxed);
             break;
             
         case AST_MESSAGE_SEND:
@@ -308,6 +335,11 @@ void ezom_ast_free(ezom_ast_node_t* node) {
             ezom_ast_free(node->data.block.parameters);
             ezom_ast_free(node->data.block.locals);
             ezom_ast_free(node->data.block.body);
+            if (node->data.block.vars) {
+                free(node->data.block.vars->captures);
+                free(node->data.block.vars->boxed);
+                free(node->data.block.vars);
+            }
             break;
             
         case AST_RETURN:
@@ -315,6 +347,7 @@ void ezom_ast_free(ezom_ast_node_t* node) {
             break;
             
         case AST_ASSIGNMENT:
+        case AST_INCREMENT:
             ezom_ast_free(node->data.assignment.variable);
             ezom_ast_free(node->data.assignment.value);
             break;
@@ -333,6 +366,10 @@ void ezom_ast_free(ezom_ast_node_t* node) {
             free(node->data.identifier.name);
             break;
             
+        case AST_VARIABLE_DEF:
+            free(node->data.variable.name);
+            break;
+            
         case AST_VARIABLE_LIST:
             ezom_ast_free_variable_list(node);
             break;
@@ -406,7 +443,10 @@ void ezom_ast_print(ezom_ast_node_t* node, int indent) {
             printf("Literal: ");
             switch (node->data.literal.type) {
                 case LITERAL_INTEGER:
-                    printf("integer %d\n", node->data.literal.value.integer_value);
+                    printf("integer %ld\n", (long)node->data.literal.value.integer_value);
+                    break;
+                case LITERAL_DOUBLE:
+                    printf("double %g\n", node->data.literal.value.double_value);
                     break;
                 case LITERAL_STRING:
                     printf("string '%s'\n", node->data.literal.value.string_value);
@@ -424,6 +464,12 @@ void ezom_ast_print(ezom_ast_node_t* node, int indent) {
             printf("Identifier: %s\n", node->data.identifier.name);
             break;
             
+        case AST_VARIABLE_DEF:
+            printf("Variable: %s (kind %d, index %d, capture %d%s)\n", node->data.variable.name,
+                   node->data.variable.kind, node->data.variable.index, node->data.variable.capture,
+                   node->data.variable.boxed ? ", boxed" : "");
+            break;
+            
         case AST_VARIABLE_LIST:
             printf("Variables: ");
             for (uint16_t i = 0; i < node->data.variable_list.count; i++) {
@@ -499,7 +545,7 @@ ezom_ast_node_t* ezom_ast_create_integer_literal(int value) {
     if (!node) return NULL;
     
     node->data.literal.type = LITERAL_INTEGER;
-    node->data.literal.value.integer_value = (int16_t)value;
+    node->data.literal.value.integer_value = value;
     
     printf("DEBUG: Created integer literal AST node: %d\n", value);
     return node;
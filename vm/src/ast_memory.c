@@ -8,9 +8,23 @@
 #include <stdlib.h>
 #include <string.h>
 
-// Simple memory pool for AST nodes
+// Simple memory pool for AST nodes (tools that hold whole programs, such
+// as ezom_aotc, build with larger ones; so do native builds, whose loader
+// keeps every class of a class file)
+#ifndef AST_POOL_SIZE
+#ifdef NATIVE_BUILD
+#define AST_POOL_SIZE 262144    // 256KB pool
+#else
 #define AST_POOL_SIZE 8192  // 8KB pool
+#endif
+#endif
+#ifndef MAX_AST_NODES
+#ifdef NATIVE_BUILD
+#define MAX_AST_NODES 4096
+#else
 #define MAX_AST_NODES 256   // Maximum number of AST nodes
+#endif
+#endif
 
 static char ast_memory_pool[AST_POOL_SIZE];
 static size_t ast_pool_offset = 0;
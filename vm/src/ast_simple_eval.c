@@ -23,9 +23,13 @@ uint24_t ezom_ast_simple_evaluate(ezom_ast_node_t* node) {
         case AST_LITERAL:
             switch (node->data.literal.type) {
                 case LITERAL_INTEGER:
-                    printf("DEBUG: Evaluating integer literal: %d\n", node->data.literal.value.integer_value);
+                    printf("DEBUG: Evaluating integer literal: %ld\n", (long)node->data.literal.value.integer_value);
                     return ezom_create_integer(node->data.literal.value.integer_value);
                     
+                case LITERAL_DOUBLE:
+                    printf("DEBUG: Evaluating double literal: %g\n", node->data.literal.value.double_value);
+                    return ezom_create_double(node->data.literal.value.double_value);
+                    
                 case LITERAL_STRING:
                     printf("DEBUG: Evaluating string literal: '%s'\n", node->data.literal.value.string_value);
                     return ezom_create_string(node->data.literal.value.string_value, 
@@ -105,8 +109,7 @@ uint24_t ezom_ast_test_simple_expression() {
     uint24_t result = ezom_ast_simple_evaluate(expr);
     
     if (result) {
-        ezom_integer_t* res = (ezom_integer_t*)EZOM_OBJECT_PTR(result);
-        printf("DEBUG: AST evaluation result: %d\n", res->value);
+        printf("DEBUG: AST evaluation result: %ld\n", (long)EZOM_SMALLINT_VALUE(result));
     } else {
         printf("ERROR: AST evaluation failed\n");
     }
@@ -147,8 +150,7 @@ uint24_t ezom_ast_test_nested_arithmetic() {
     
     uint24_t result = ezom_ast_simple_evaluate(mult_expr);
     if (result) {
-        ezom_integer_t* res = (ezom_integer_t*)EZOM_OBJECT_PTR(result);
-        printf("DEBUG: Nested evaluation result: %d\n", res->value);
+        printf("DEBUG: Nested evaluation result: %ld\n", (long)EZOM_SMALLINT_VALUE(result));
     }
     
     return result;
@@ -186,8 +188,7 @@ uint24_t ezom_ast_test_chain_operations() {
     
     uint24_t result = ezom_ast_simple_evaluate(add_expr);
     if (result) {
-        ezom_integer_t* res = (ezom_integer_t*)EZOM_OBJECT_PTR(result);
-        printf("DEBUG: Chain evaluation result: %d\n", res->value);
+        printf("DEBUG: Chain evaluation result: %ld\n", (long)EZOM_SMALLINT_VALUE(result));
     }
     
     return result;
@@ -233,8 +234,7 @@ uint24_t ezom_ast_test_mixed_operations() {
     
     uint24_t result = ezom_ast_simple_evaluate(final_expr);
     if (result) {
-        ezom_integer_t* res = (ezom_integer_t*)EZOM_OBJECT_PTR(result);
-        printf("DEBUG: Mixed operations result: %d\n", res->value);
+        printf("DEBUG: Mixed operations result: %ld\n", (long)EZOM_SMALLINT_VALUE(result));
     }
     
     return result;
@@ -327,8 +327,7 @@ uint24_t ezom_ast_test_deep_nesting() {
     
     uint24_t result = ezom_ast_simple_evaluate(final_expr);
     if (result) {
-        ezom_integer_t* res = (ezom_integer_t*)EZOM_OBJECT_PTR(result);
-        printf("DEBUG: Deep nesting result: %d\n", res->value);
+        printf("DEBUG: Deep nesting result: %ld\n", (long)EZOM_SMALLINT_VALUE(result));
     }
     
     return result;
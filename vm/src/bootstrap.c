@@ -6,6 +6,10 @@
 #include "../include/ezom_object.h"
 #include "../include/ezom_memory.h"
 #include "../include/ezom_primitives.h"
+#include "../include/ezom_dispatch.h"
+#include "../include/ezom_context.h"
+#include "../include/ezom_exceptions.h"
+#include "../include/ezom_evaluator.h"
 #include <stdio.h>
 #include <string.h>
 
@@ -62,7 +66,7 @@ void ezom_bootstrap_classes(void) {
         integer_class->superclass = g_object_class;
         integer_class->method_dict = ezom_create_method_dictionary(16);
         integer_class->instance_vars = 0;
-        integer_class->instance_size = sizeof(ezom_integer_t);
+        integer_class->instance_size = 0;  // SmallIntegers are immediates
         integer_class->instance_var_count = 0;
         
         // Methods will be installed in enhanced bootstrap
@@ -94,14 +98,17 @@ void ezom_bootstrap_classes(void) {
 void ezom_install_object_methods(void);
 void ezom_install_integer_methods(void);
 void ezom_install_string_methods(void);
+void ezom_install_double_methods(void);
 void ezom_install_array_methods(void);
 void ezom_install_boolean_methods(void);
 void ezom_install_block_methods(void);
+void ezom_install_exception_methods(void);
 
 // Internal bootstrap phases
 static void ezom_bootstrap_phase1_fundamentals(void);
 static void ezom_bootstrap_phase2_hierarchy(void);
 static void ezom_bootstrap_phase3_methods(void);
+static void ezom_bootstrap_exception_classes(void);
 
 void ezom_bootstrap_enhanced_classes(void) {
     printf("Bootstrapping enhanced SOM-compatible classes...\n");
@@ -112,6 +119,9 @@ void ezom_bootstrap_enhanced_classes(void) {
     // PHASE 2: Complete class hierarchy with proper relationships
     ezom_bootstrap_phase2_hierarchy();
     
+    // Method dictionaries were filled directly; start with a clean lookup cache
+    ezom_method_cache_flush();
+    
     printf("Two-phase bootstrap complete! SOM-compatible class hierarchy ready.\n");
 }
 
@@ -143,6 +153,7 @@ static void ezom_bootstrap_phase1_fundamentals(void) {
         object_class->instance_vars = 0;
         object_class->instance_size = sizeof(ezom_object_t);
         object_class->instance_var_count = 0;
+        ezom_class_register(g_object_class);
         printf("   Object class created (self-referential)\n");
     }
     
@@ -198,11 +209,39 @@ static void ezom_bootstrap_phase2_hierarchy(void) {
         integer_class->superclass = g_object_class;
         integer_class->method_dict = 0; // Bootstrap: defer method dictionary
         integer_class->instance_vars = 0;
-        integer_class->instance_size = sizeof(ezom_integer_t);
+        integer_class->instance_size = 0;  // SmallIntegers are immediates
         integer_class->instance_var_count = 0;
         printf("   Integer class created\n");
     }
     
+    // LargeInteger: boxed overflow results, inherits Integer's primitives
+    g_large_integer_class = ezom_allocate(sizeof(ezom_class_t));
+    if (g_large_integer_class) {
+        ezom_init_object(g_large_integer_class, g_object_class, EZOM_TYPE_CLASS);
+        ezom_class_t* large_class = EZOM_OBJECT_PTR(g_large_integer_class);
+        large_class->superclass = g_integer_class;
+        large_class->method_dict = 0; // Bootstrap: defer method dictionary
+        large_class->instance_vars = 0;
+        large_class->instance_size = sizeof(ezom_large_integer_t);
+        large_class->instance_var_count = 0;
+        printf("   LargeInteger class created\n");
+    }
+    
+    g_double_class = ezom_allocate(sizeof(ezom_class_t));
+    if (g_double_class) {
+        ezom_init_object(g_double_class, g_object_class, EZOM_TYPE_CLASS);
+        ezom_class_t* double_class = EZOM_OBJECT_PTR(g_double_class);
+        double_class->superclass = g_object_class;
+        double_class->method_dict = 0; // Bootstrap: defer method dictionary
+        double_class->instance_vars = 0;
+        double_class->instance_size = sizeof(ezom_double_t);
+        double_class->instance_var_count = 0;
+        printf("   Double class created\n");
+        
+        // Arithmetic results live here until they are stored
+        ezom_init_double_scratch();
+    }
+    
     g_string_class = ezom_allocate(sizeof(ezom_class_t));
     if (g_string_class) {
         ezom_init_object(g_string_class, g_object_class, EZOM_TYPE_CLASS);
@@ -300,6 +339,9 @@ static void ezom_bootstrap_phase2_hierarchy(void) {
         context_class->instance_size = sizeof(ezom_context_t);
         context_class->instance_var_count = 0;
         printf("   Context class created\n");
+        
+        // Method and block activations run here
+        ezom_init_frame_stack();
     }
     
     // Create Nil class and fix nil object
@@ -363,6 +405,18 @@ static void ezom_bootstrap_phase3_methods(void) {
         printf("   Integer class method dictionary created\n");
     }
     
+    if (g_large_integer_class && g_symbol_class) {
+        ezom_class_t* large_class = EZOM_OBJECT_PTR(g_large_integer_class);
+        large_class->method_dict = ezom_create_method_dictionary(4);
+        printf("   LargeInteger class method dictionary created\n");
+    }
+    
+    if (g_double_class && g_symbol_class) {
+        ezom_class_t* double_class = EZOM_OBJECT_PTR(g_double_class);
+        double_class->method_dict = ezom_create_method_dictionary(16);
+        printf("   Double class method dictionary created\n");
+    }
+    
     if (g_string_class && g_symbol_class) {
         ezom_class_t* string_class = EZOM_OBJECT_PTR(g_string_class);
         string_class->method_dict = ezom_create_method_dictionary(8);
@@ -411,6 +465,9 @@ static void ezom_bootstrap_phase3_methods(void) {
         printf("   Nil class method dictionary created\n");
     }
     
+    // Exception classes name their instance variable with a Symbol
+    ezom_bootstrap_exception_classes();
+    
     // Install methods in all classes
     printf("   Installing methods in all classes...\n");
     ezom_log("   Installing methods in all classes...\n");
@@ -425,6 +482,10 @@ static void ezom_bootstrap_phase3_methods(void) {
     printf("   COMPLETED Integer methods installation\n");
     ezom_log("   COMPLETED Integer methods installation\n");
     
+    printf("   About to install Double methods...\n");
+    ezom_log("   About to install Double methods...\n");
+    ezom_install_double_methods();
+    
     printf("   About to install String methods...\n");
     ezom_log("   About to install String methods...\n");
     ezom_install_string_methods();
@@ -443,9 +504,68 @@ static void ezom_bootstrap_phase3_methods(void) {
     ezom_log("   About to install Block methods...\n");
     ezom_install_block_methods();
     
+    printf("   About to install Exception methods...\n");
+    ezom_log("   About to install Exception methods...\n");
+    ezom_install_exception_methods();
+    
+    // Classes are complete: give each one a dispatch table row
+    uint24_t finalized[] = {
+        g_object_class, g_integer_class, g_large_integer_class, g_double_class,
+        g_string_class, g_symbol_class,
+        g_array_class, g_boolean_class, g_true_class, g_false_class,
+        g_block_class, g_context_class, g_nil_class,
+        g_exception_metaclass, g_exception_class, g_error_class
+    };
+    for (size_t i = 0; i < sizeof(finalized) / sizeof(finalized[0]); i++) {
+        ezom_dispatch_table_finalize_class(finalized[i]);
+    }
+    
     printf("Enhanced bootstrap complete! SOM-compatible class hierarchy ready.\n");
 }
 
+// Exception and Error, with the metaclass that gives them new, signal and
+// signal: (see ezom_exceptions.h)
+static uint24_t ezom_create_exception_class(uint24_t metaclass, uint24_t superclass, uint16_t dict_size) {
+    uint24_t class_ptr = ezom_allocate(sizeof(ezom_class_t));
+    if (class_ptr) {
+        ezom_init_object(class_ptr, metaclass, EZOM_TYPE_CLASS);
+        ezom_class_t* class_obj = EZOM_OBJECT_PTR(class_ptr);
+        class_obj->superclass = superclass;
+        class_obj->method_dict = ezom_create_method_dictionary(dict_size);
+        class_obj->instance_vars = 0;
+        class_obj->instance_size = sizeof(ezom_object_t);
+        class_obj->instance_var_count = 0;
+    }
+    return class_ptr;
+}
+
+static void ezom_bootstrap_exception_classes(void) {
+    g_exception_metaclass = ezom_create_exception_class(g_object_class, g_object_class, 4);
+    g_exception_class = ezom_create_exception_class(g_exception_metaclass, g_object_class, 8);
+    g_error_class = ezom_create_exception_class(g_exception_metaclass, g_exception_class, 4);
+    if (!g_exception_metaclass || !g_exception_class || !g_error_class) {
+        printf("   ERROR: Could not create exception classes\n");
+        g_exception_metaclass = g_exception_class = g_error_class = 0;
+        return;
+    }
+    
+    // messageText is an ordinary instance variable, so subclasses can use it
+    ezom_class_t* exception_class = EZOM_OBJECT_PTR(g_exception_class);
+    exception_class->instance_var_count = 1;
+    exception_class->instance_size = sizeof(ezom_object_t) + sizeof(uint24_t);
+    exception_class->instance_vars = ezom_create_array(1);
+    if (exception_class->instance_vars) {
+        ezom_array_t* names = EZOM_OBJECT_PTR(exception_class->instance_vars);
+        names->elements[0] = ezom_create_symbol("messageText", 11);
+    }
+    ezom_class_t* error_class = EZOM_OBJECT_PTR(g_error_class);
+    error_class->instance_size = exception_class->instance_size;
+    
+    ezom_set_global("Exception", g_exception_class);
+    ezom_set_global("Error", g_error_class);
+    printf("   Exception and Error classes created\n");
+}
+
 // Helper function for adding methods to method dictionary
 static void add_method_to_dict(ezom_method_dict_t* dict, const char* selector, uint8_t prim_num, uint8_t arg_count) {
     printf("     Adding method '%s' (prim %d)...", selector, prim_num);
@@ -466,62 +586,36 @@ static void add_method_to_dict(ezom_method_dict_t* dict, const char* selector, u
     printf(" [dict=0x%06lX, size=%d, capacity=%d]", (unsigned long)dict, dict->size, dict->capacity);
     ezom_log(" [dict=0x%06lX, size=%d, capacity=%d]\n", (unsigned long)dict, dict->size, dict->capacity);
     
-    // Add memory corruption check
-    if (dict->size >= dict->capacity) {
-        printf(" ERROR: Dictionary size >= capacity!\n");
-        ezom_log(" ERROR: Dictionary size >= capacity!\n");
+    // Skip pointer range check since dict is already converted from ezom pointer
+    
+    printf(" Creating symbol...");
+    ezom_log(" Creating symbol...");
+    
+    size_t selector_len = strlen(selector);
+    printf(" selector='%s' len=%d...", selector, (int)selector_len);
+    ezom_log(" selector='%s' len=%d...", selector, (int)selector_len);
+    
+    uint24_t selector_symbol = ezom_create_symbol(selector, selector_len);
+    printf(" symbol=0x%06lX", (unsigned long)selector_symbol);
+    ezom_log(" symbol=0x%06lX", (unsigned long)selector_symbol);
+    
+    if (!selector_symbol) {
+        printf(" FAILED - symbol creation failed\n");
+        ezom_log(" FAILED - symbol creation failed\n");
         return;
     }
     
-    // Skip pointer range check since dict is already converted from ezom pointer
-    
-    if (dict->size < dict->capacity) {
-        printf(" Creating method at index %d...", dict->size);
-        ezom_log(" Creating method at index %d...", dict->size);
-        
-        ezom_method_t* method = &dict->methods[dict->size];
-        printf(" method ptr=0x%06lX", (unsigned long)method);
-        ezom_log(" method ptr=0x%06lX", (unsigned long)method);
-        
-        printf(" Creating symbol...");
-        ezom_log(" Creating symbol...");
-        
-        // Add safety check for selector string
-        if (!selector) {
-            printf(" ERROR: selector string is NULL!\n");
-            ezom_log(" ERROR: selector string is NULL!\n");
-            return;
-        }
-        
-        size_t selector_len = strlen(selector);
-        printf(" selector='%s' len=%d...", selector, (int)selector_len);
-        ezom_log(" selector='%s' len=%d...", selector, (int)selector_len);
-        
-        method->selector = ezom_create_symbol(selector, selector_len);
-        printf(" symbol=0x%06lX", (unsigned long)method->selector);
-        ezom_log(" symbol=0x%06lX", (unsigned long)method->selector);
-        
-        if (!method->selector) {
-            printf(" FAILED - symbol creation failed\n");
-            ezom_log(" FAILED - symbol creation failed\n");
-            return;
-        }
-        
-        printf(" Setting method fields...");
-        ezom_log(" Setting method fields...");
-        method->code = prim_num;
-        method->arg_count = arg_count;
-        method->flags = EZOM_METHOD_PRIMITIVE;
-        
-        printf(" Incrementing dict size...");
-        ezom_log(" Incrementing dict size...");
-        dict->size++;
-        
-        printf(" SUCCESS (dict size now %d)\n", dict->size);
-        ezom_log(" SUCCESS (dict size now %d)\n", dict->size);
-    } else {
-        printf(" FAILED - dictionary full (%d/%d)\n", dict->size, dict->capacity);
+    // Hashed insert; grows the dictionary when it passes 3/4 load
+    ezom_method_t* method = ezom_method_dict_put(dict, selector_symbol, prim_num, arg_count,
+                                                 EZOM_METHOD_PRIMITIVE);
+    if (!method) {
+        printf(" FAILED - could not grow dictionary (%d/%d)\n", dict->size, dict->capacity);
+        ezom_log(" FAILED - could not grow dictionary (%d/%d)\n", dict->size, dict->capacity);
+        return;
     }
+    
+    printf(" SUCCESS (dict size now %d)\n", dict->size);
+    ezom_log(" SUCCESS (dict size now %d)\n", dict->size);
 }
 
 // Enhanced method installation functions
@@ -595,6 +689,7 @@ void ezom_install_integer_methods(void) {
     
     // Conversion operations
     add_method_to_dict(dict, "asString", PRIM_INTEGER_AS_STRING, 0);
+    add_method_to_dict(dict, "asDouble", PRIM_INTEGER_AS_DOUBLE, 0);
     
     // Iteration operations
     add_method_to_dict(dict, "to:do:", PRIM_INTEGER_TO_DO, 2);
@@ -610,6 +705,33 @@ void ezom_install_integer_methods(void) {
     ezom_log("   END ezom_install_integer_methods function\n");
 }
 
+void ezom_install_double_methods(void) {
+    ezom_class_t* double_class = EZOM_OBJECT_PTR(g_double_class);
+    ezom_method_dict_t* dict = (ezom_method_dict_t*)EZOM_OBJECT_PTR(double_class->method_dict);
+    
+    // Arithmetic operations
+    add_method_to_dict(dict, "+", PRIM_DOUBLE_ADD, 1);
+    add_method_to_dict(dict, "-", PRIM_DOUBLE_SUB, 1);
+    add_method_to_dict(dict, "*", PRIM_DOUBLE_MUL, 1);
+    add_method_to_dict(dict, "/", PRIM_DOUBLE_DIV, 1);
+    add_method_to_dict(dict, "sqrt", PRIM_DOUBLE_SQRT, 0);
+    
+    // Comparison operations
+    add_method_to_dict(dict, "<", PRIM_DOUBLE_LT, 1);
+    add_method_to_dict(dict, ">", PRIM_DOUBLE_GT, 1);
+    add_method_to_dict(dict, "<=", PRIM_DOUBLE_LTE, 1);
+    add_method_to_dict(dict, ">=", PRIM_DOUBLE_GTE, 1);
+    add_method_to_dict(dict, "=", PRIM_DOUBLE_EQ, 1);
+    add_method_to_dict(dict, "~=", PRIM_DOUBLE_NEQ, 1);
+    
+    // Conversion operations
+    add_method_to_dict(dict, "asString", PRIM_DOUBLE_AS_STRING, 0);
+    add_method_to_dict(dict, "asInteger", PRIM_DOUBLE_AS_INTEGER, 0);
+    add_method_to_dict(dict, "println", PRIM_OBJECT_PRINTLN, 0);
+    
+    printf("      Installed %d methods in Double\n", dict->size);
+}
+
 void ezom_install_string_methods(void) {
     ezom_class_t* string_class = EZOM_OBJECT_PTR(g_string_class);
     ezom_method_dict_t* dict = (ezom_method_dict_t*)EZOM_OBJECT_PTR(string_class->method_dict);
@@ -705,7 +827,31 @@ void ezom_install_block_methods(void) {
     add_method_to_dict(dict, "value:", PRIM_BLOCK_VALUE_WITH, 1);
     add_method_to_dict(dict, "whileTrue:", PRIM_BLOCK_WHILE_TRUE, 1);
     add_method_to_dict(dict, "whileFalse:", PRIM_BLOCK_WHILE_FALSE, 1);
+    add_method_to_dict(dict, "on:do:", PRIM_BLOCK_ON_DO, 2);
+    add_method_to_dict(dict, "ensure:", PRIM_BLOCK_ENSURE, 1);
+    add_method_to_dict(dict, "ifCurtailed:", PRIM_BLOCK_IF_CURTAILED, 1);
     add_method_to_dict(dict, "println", PRIM_OBJECT_PRINTLN, 0);
     
     printf("      Installed %d methods in Block\n", dict->size);
 }
+
+void ezom_install_exception_methods(void) {
+    if (!g_exception_class) return;
+    
+    ezom_class_t* metaclass = EZOM_OBJECT_PTR(g_exception_metaclass);
+    ezom_method_dict_t* class_dict = (ezom_method_dict_t*)EZOM_OBJECT_PTR(metaclass->method_dict);
+    
+    add_method_to_dict(class_dict, "new", PRIM_EXCEPTION_NEW, 0);
+    add_method_to_dict(class_dict, "signal", PRIM_EXCEPTION_SIGNAL, 0);
+    add_method_to_dict(class_dict, "signal:", PRIM_EXCEPTION_SIGNAL_WITH, 1);
+    
+    ezom_class_t* exception_class = EZOM_OBJECT_PTR(g_exception_class);
+    ezom_method_dict_t* dict = (ezom_method_dict_t*)EZOM_OBJECT_PTR(exception_class->method_dict);
+    
+    add_method_to_dict(dict, "signal", PRIM_EXCEPTION_SIGNAL, 0);
+    add_method_to_dict(dict, "signal:", PRIM_EXCEPTION_SIGNAL_WITH, 1);
+    add_method_to_dict(dict, "messageText", PRIM_EXCEPTION_MESSAGE_TEXT, 0);
+    add_method_to_dict(dict, "messageText:", PRIM_EXCEPTION_SET_MESSAGE_TEXT, 1);
+    
+    printf("      Installed %d methods in Exception\n", dict->size);
+}
@@ -0,0 +1,696 @@
+// ============================================================================
+// File: src/compiler.c
+// AST to bytecode compiler
+// ============================================================================
+
+#include "../include/ezom_bytecode.h"
+#include "../include/ezom_context.h"
+#include "../include/ezom_memory.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+ezom_bytecode_stats_t g_bytecode_stats = {0, 0, 0, 0};
+
+// Compiler state for one code unit. Tables grow as needed; every table
+// index has to fit in a one-byte operand.
+typedef struct ezom_compiler {
+    uint8_t*           code;
+    uint16_t           length;
+    uint16_t           capacity;
+    uint16_t           depth;           // Current operand stack depth
+    uint16_t           max_depth;
+    uint16_t           clean_depth;     // Stack entries known not to be scratch Doubles
+    uint24_t*          literals;
+    uint16_t           literal_count;
+    ezom_global_t**    globals;
+    uint16_t           global_count;
+    ezom_send_site_t*  sites;
+    uint16_t           site_count;
+    ezom_ast_node_t**  blocks;
+    uint16_t           block_count;
+    bool               block;           // Compiling a block: ^ is non-local
+    bool               failed;
+} ezom_compiler_t;
+
+static void ezom_compile_expression(ezom_compiler_t* c, ezom_ast_node_t* node);
+
+static void ezom_compile_fail(ezom_compiler_t* c, const char* reason) {
+    if (!c->failed) {
+        printf("   Bytecode: %s, using the AST evaluator\n", reason);
+    }
+    c->failed = true;
+}
+
+// Append to a table, growing it; answers the new entry's index
+static uint16_t ezom_compile_table_add(ezom_compiler_t* c, void** table, uint16_t* count,
+                                       size_t entry_size, const void* entry) {
+    if (*count >= 256) {
+        ezom_compile_fail(c, "too many table entries");
+        return 0;
+    }
+
+    // Tables grow in steps of 8 entries
+    if (*count % 8 == 0) {
+        void* grown = realloc(*table, (*count + 8) * entry_size);
+        if (!grown) {
+            ezom_compile_fail(c, "out of memory");
+            return 0;
+        }
+        *table = grown;
+    }
+
+    memcpy((char*)*table + *count * entry_size, entry, entry_size);
+    return (*count)++;
+}
+
+static void ezom_emit(ezom_compiler_t* c, uint8_t byte) {
+    if (c->length == UINT16_MAX) {
+        ezom_compile_fail(c, "code too long");
+        return;
+    }
+    if (c->length == c->capacity) {
+        uint16_t capacity = c->capacity ? (c->capacity < 0x8000 ? c->capacity * 2 : UINT16_MAX) : 32;
+        uint8_t* grown = (uint8_t*)realloc(c->code, capacity);
+        if (!grown) {
+            ezom_compile_fail(c, "out of memory");
+            return;
+        }
+        c->code = grown;
+        c->capacity = capacity;
+    }
+    c->code[c->length++] = byte;
+}
+
+// Emit an instruction with its operands and stack effect
+static void ezom_emit_op(ezom_compiler_t* c, ezom_opcode_t op, int8_t stack_effect,
+                         int operand_count, uint16_t a, uint16_t b) {
+    if (a > 255 || b > 255) {
+        ezom_compile_fail(c, "operand out of range");
+        return;
+    }
+
+    ezom_emit(c, (uint8_t)op);
+    if (operand_count > 0) ezom_emit(c, (uint8_t)a);
+    if (operand_count > 1) ezom_emit(c, (uint8_t)b);
+
+    c->depth += stack_effect;
+    if (c->depth > c->max_depth) {
+        c->max_depth = c->depth;
+    }
+}
+
+// Jump instruction with target_count two-byte targets, filled in later by
+// ezom_patch_jump; answers the position of the first target
+static uint16_t ezom_emit_jump(ezom_compiler_t* c, ezom_opcode_t op, int8_t stack_effect, int target_count) {
+    ezom_emit_op(c, op, stack_effect, 0, 0, 0);
+    uint16_t position = c->length;
+    for (int i = 0; i < target_count * 2; i++) {
+        ezom_emit(c, 0);
+    }
+    return position;
+}
+
+static void ezom_patch_jump(ezom_compiler_t* c, uint16_t position, uint16_t target) {
+    if (c->failed) return;
+    c->code[position] = (uint8_t)(target & 0xFF);
+    c->code[position + 1] = (uint8_t)(target >> 8);
+}
+
+// Drop a finished statement's value. Its scratch Doubles die with it
+// unless something still on the stack might be one.
+static void ezom_compile_statement_end(ezom_compiler_t* c) {
+    ezom_emit_op(c, c->depth - 1 <= c->clean_depth ? BC_POP : BC_DROP, -1, 0, 0, 0);
+}
+
+static uint16_t ezom_compile_literal(ezom_compiler_t* c, uint24_t object) {
+    for (uint16_t i = 0; i < c->literal_count; i++) {
+        if (c->literals[i] == object) return i;
+    }
+    return ezom_compile_table_add(c, (void**)&c->literals, &c->literal_count, sizeof(uint24_t), &object);
+}
+
+static uint16_t ezom_compile_global(ezom_compiler_t* c, ezom_global_t* global) {
+    for (uint16_t i = 0; i < c->global_count; i++) {
+        if (c->globals[i] == global) return i;
+    }
+    return ezom_compile_table_add(c, (void**)&c->globals, &c->global_count, sizeof(ezom_global_t*), &global);
+}
+
+// Self operand: 0 for the frame's receiver, capture + 1 for a closure's copy
+static uint16_t ezom_compile_self_operand(ezom_ast_node_t* node) {
+    uint8_t capture = node->data.variable.capture;
+    return capture == AST_NO_CAPTURE ? 0 : capture + 1;
+}
+
+// Frame slot or captured copy of a parameter or local; a box if boxed
+static void ezom_compile_variable_cell(ezom_compiler_t* c, ezom_ast_node_t* node) {
+    if (node->data.variable.capture == AST_NO_CAPTURE) {
+        ezom_emit_op(c, BC_PUSH_LOCAL, 1, 1, node->data.variable.index, 0);
+    } else {
+        ezom_emit_op(c, BC_PUSH_CAPTURED, 1, 1, node->data.variable.capture, 0);
+    }
+}
+
+static void ezom_compile_variable(ezom_compiler_t* c, ezom_ast_node_t* node) {
+    uint16_t index = node->data.variable.index;
+
+    switch (node->data.variable.kind) {
+        case AST_VAR_CONTEXT:
+            ezom_compile_variable_cell(c, node);
+            if (node->data.variable.boxed) {
+                ezom_emit_op(c, BC_UNBOX, 0, 0, 0, 0);
+            }
+            break;
+        case AST_VAR_INSTANCE:
+            ezom_emit_op(c, BC_PUSH_FIELD, 1, 2, ezom_compile_self_operand(node), index);
+            break;
+        case AST_VAR_GLOBAL:
+            ezom_emit_op(c, BC_PUSH_GLOBAL, 1, 1, ezom_compile_global(c, node->data.variable.global), 0);
+            break;
+        case AST_VAR_SELF:
+            ezom_emit_op(c, BC_PUSH_SELF, 1, 1, ezom_compile_self_operand(node), 0);
+            break;
+        default:
+            ezom_compile_fail(c, "unresolved variable");
+            break;
+    }
+}
+
+static void ezom_compile_assignment(ezom_compiler_t* c, ezom_ast_node_t* node) {
+    ezom_ast_node_t* target = node->data.assignment.variable;
+    ezom_compile_expression(c, node->data.assignment.value);
+
+    if (target->type != AST_VARIABLE_DEF) {
+        ezom_compile_fail(c, "assignment to a non-variable");
+        return;
+    }
+
+    uint16_t index = target->data.variable.index;
+
+    switch (target->data.variable.kind) {
+        case AST_VAR_CONTEXT:
+            if (target->data.variable.boxed) {
+                ezom_compile_variable_cell(c, target);
+                ezom_emit_op(c, BC_STORE_BOX, -1, 0, 0, 0);
+            } else if (target->data.variable.capture == AST_NO_CAPTURE) {
+                ezom_emit_op(c, BC_STORE_LOCAL, 0, 1, index, 0);
+            } else {
+                ezom_compile_fail(c, "assignment to a captured copy");
+            }
+            break;
+        case AST_VAR_INSTANCE:
+            ezom_emit_op(c, BC_STORE_FIELD, 0, 2, ezom_compile_self_operand(target), index);
+            break;
+        case AST_VAR_GLOBAL:
+            ezom_emit_op(c, BC_STORE_GLOBAL, 0, 1, ezom_compile_global(c, target->data.variable.global), 0);
+            break;
+        default:
+            ezom_compile_fail(c, "assignment to self or an unresolved variable");
+            break;
+    }
+}
+
+// Send through a new site; receiver and arguments are on the stack
+static void ezom_compile_site(ezom_compiler_t* c, const char* selector, uint8_t arg_count) {
+    ezom_send_site_t site;
+    memset(&site, 0, sizeof(site));
+    site.selector = selector;
+    site.arg_count = arg_count;
+    uint16_t index = ezom_compile_table_add(c, (void**)&c->sites, &c->site_count, sizeof(site), &site);
+
+    ezom_emit_op(c, BC_SEND, -(int8_t)arg_count, 1, index, 0);
+}
+
+// Block literal as a closure copying its captures from this frame. A
+// clean block is a constant: its shared object goes in the literal table.
+static void ezom_compile_block_literal(ezom_compiler_t* c, ezom_ast_node_t* node) {
+    if (node->data.block.clean) {
+        uint24_t object = ezom_block_literal(node, 0);
+        if (!object) {
+            ezom_compile_fail(c, "block could not be created");
+            return;
+        }
+        ezom_emit_op(c, BC_PUSH_LITERAL, 1, 1, ezom_compile_literal(c, object), 0);
+        return;
+    }
+
+    uint16_t index = ezom_compile_table_add(c, (void**)&c->blocks, &c->block_count,
+                                            sizeof(ezom_ast_node_t*), &node);
+    ezom_emit_op(c, BC_PUSH_BLOCK, 1, 1, index, 0);
+}
+
+// Box the listed slots on entry to their scope
+static void ezom_compile_boxes(ezom_compiler_t* c, const uint8_t* boxed, uint8_t boxed_count) {
+    for (uint8_t i = 0; i < boxed_count; i++) {
+        ezom_emit_op(c, BC_BOX_LOCAL, 0, 1, boxed[i], 0);
+    }
+}
+
+// ^ of the value on top of the stack
+static void ezom_compile_return(ezom_compiler_t* c) {
+    ezom_emit_op(c, c->block ? BC_RETURN_NONLOCAL : BC_RETURN, -1, 0, 0, 0);
+}
+
+// Statements of an inlined block, in this frame. Its locals start out nil
+// and its boxed variables in fresh boxes each time. With want_value the
+// last statement's value stays on the stack. Answers true if the body
+// ends in ^.
+static bool ezom_compile_inlined_body(ezom_compiler_t* c, ezom_ast_node_t* block, bool want_value) {
+    uint16_t first_local = block->data.block.inline_base +
+                           ezom_ast_count_parameters(block->data.block.parameters);
+    uint16_t local_count = ezom_ast_count_locals(block->data.block.locals);
+    for (uint16_t i = 0; i < local_count; i++) {
+        ezom_emit_op(c, BC_PUSH_NIL, 1, 0, 0, 0);
+        ezom_emit_op(c, BC_STORE_LOCAL, 0, 1, first_local + i, 0);
+        ezom_compile_statement_end(c);
+    }
+    if (block->data.block.vars) {
+        ezom_compile_boxes(c, block->data.block.vars->boxed, block->data.block.vars->boxed_count);
+    }
+
+    ezom_ast_node_t* body = block->data.block.body;
+    ezom_ast_node_t* stmt = body ? body->data.statement_list.statements : NULL;
+    if (!stmt && want_value) {
+        ezom_emit_op(c, BC_PUSH_NIL, 1, 0, 0, 0);
+    }
+
+    for (; stmt; stmt = stmt->next) {
+        if (stmt->type == AST_RETURN) {
+            ezom_compile_expression(c, stmt->data.return_stmt.expression);
+            ezom_compile_return(c);
+            return true;
+        }
+        ezom_compile_expression(c, stmt);
+        if (stmt->next || !want_value) {
+            ezom_compile_statement_end(c);
+        }
+    }
+    return false;
+}
+
+// ifTrue:, ifFalse:, ifTrue:ifFalse:, and:, or:
+static void ezom_compile_inlined_branch(ezom_compiler_t* c, ezom_ast_node_t* node, ezom_inline_kind_t kind) {
+    ezom_ast_node_t* block = node->data.message_send.arguments;
+    ezom_compile_expression(c, node->data.message_send.receiver);
+    uint16_t depth = c->depth - 1;
+
+    // The first block runs on true, except for ifFalse: and or:
+    bool on_false = (kind == AST_INLINE_IF_FALSE || kind == AST_INLINE_OR);
+    uint16_t targets = ezom_emit_jump(c, on_false ? BC_JUMP_IF_TRUE : BC_JUMP_IF_FALSE, -1, 2);
+
+    ezom_compile_inlined_body(c, block, true);
+    c->depth = depth + 1;
+    uint16_t taken_end = ezom_emit_jump(c, BC_JUMP, 0, 1);
+
+    // The other Boolean
+    ezom_patch_jump(c, targets, c->length);
+    c->depth = depth;
+    switch (kind) {
+        case AST_INLINE_IF_TRUE_IF_FALSE:
+            ezom_compile_inlined_body(c, block->next, true);
+            break;
+        case AST_INLINE_AND:
+            ezom_emit_op(c, BC_PUSH_FALSE, 1, 0, 0, 0);
+            break;
+        case AST_INLINE_OR:
+            ezom_emit_op(c, BC_PUSH_TRUE, 1, 0, 0, 0);
+            break;
+        default:
+            ezom_emit_op(c, BC_PUSH_NIL, 1, 0, 0, 0);
+            break;
+    }
+    c->depth = depth + 1;
+    uint16_t other_end = ezom_emit_jump(c, BC_JUMP, 0, 1);
+
+    // Not a Boolean: send with closures for the blocks
+    ezom_patch_jump(c, targets + 2, c->length);
+    uint8_t arg_count = 0;
+    for (; block; block = block->next) {
+        ezom_compile_block_literal(c, block);
+        arg_count++;
+    }
+    ezom_compile_site(c, node->data.message_send.selector, arg_count);
+
+    ezom_patch_jump(c, taken_end, c->length);
+    ezom_patch_jump(c, other_end, c->length);
+    c->depth = depth + 1;
+}
+
+// [cond] whileTrue: [body] and whileFalse:; the loop answers nil. Any
+// condition value other than the expected Boolean ends it.
+static void ezom_compile_inlined_while(ezom_compiler_t* c, ezom_ast_node_t* node, ezom_inline_kind_t kind) {
+    uint16_t depth = c->depth;
+    uint16_t loop = c->length;
+
+    ezom_compile_inlined_body(c, node->data.message_send.receiver, true);
+    c->depth = depth + 1;
+    uint16_t targets = ezom_emit_jump(c, kind == AST_INLINE_WHILE_TRUE ? BC_JUMP_IF_FALSE : BC_JUMP_IF_TRUE, -1, 2);
+
+    ezom_compile_inlined_body(c, node->data.message_send.arguments, false);
+    c->depth = depth;
+    ezom_patch_jump(c, ezom_emit_jump(c, BC_JUMP, 0, 1), loop);
+
+    // Condition was not a Boolean
+    ezom_patch_jump(c, targets + 2, c->length);
+    c->depth = depth + 1;
+    ezom_emit_op(c, BC_DROP, -1, 0, 0, 0);
+
+    ezom_patch_jump(c, targets, c->length);
+    ezom_emit_op(c, BC_PUSH_NIL, 1, 0, 0, 0);
+}
+
+// start to: limit do: [:i | ...] and count timesRepeat: [...]; both
+// answer the receiver
+static void ezom_compile_inlined_loop(ezom_compiler_t* c, ezom_ast_node_t* node, ezom_inline_kind_t kind) {
+    bool to_do = (kind == AST_INLINE_TO_DO);
+    ezom_ast_node_t* block = to_do ? node->data.message_send.arguments->next
+                                   : node->data.message_send.arguments;
+    uint16_t depth = c->depth;
+
+    ezom_compile_expression(c, node->data.message_send.receiver);
+    if (to_do) {
+        ezom_compile_expression(c, node->data.message_send.arguments);
+    }
+    uint16_t targets = ezom_emit_jump(c, to_do ? BC_TO_DO : BC_TIMES_REPEAT, 1, 2);
+    uint16_t loop_depth = c->depth;
+
+    // Loop state is all SmallIntegers, so the body's statements can still
+    // release scratch Doubles
+    uint16_t clean_depth = c->clean_depth;
+    if (depth <= c->clean_depth) {
+        c->clean_depth = loop_depth;
+    }
+
+    uint16_t body = c->length;
+    if (to_do) {
+        ezom_emit_op(c, BC_STORE_LOCAL, 0, 1, block->data.block.inline_base, 0);
+    }
+    ezom_compile_inlined_body(c, block, false);
+    c->depth = loop_depth;
+    ezom_patch_jump(c, ezom_emit_jump(c, BC_LOOP_NEXT, -1, 1), body);
+    c->clean_depth = clean_depth;
+
+    // Done, or never started: the receiver is the answer
+    ezom_patch_jump(c, targets, c->length);
+    if (to_do) {
+        ezom_emit_op(c, BC_DROP, -1, 0, 0, 0);
+    }
+    uint16_t end = ezom_emit_jump(c, BC_JUMP, 0, 1);
+
+    // Not SmallIntegers: send with a closure for the block
+    ezom_patch_jump(c, targets + 2, c->length);
+    c->depth = depth + (to_do ? 2 : 1);
+    ezom_compile_block_literal(c, block);
+    ezom_compile_site(c, node->data.message_send.selector, to_do ? 2 : 1);
+
+    ezom_patch_jump(c, end, c->length);
+    c->depth = depth + 1;
+}
+
+// Arguments are taken the way the AST evaluator takes them: none for
+// unary selectors, the argument list for keywords, one for binary
+static void ezom_compile_send(ezom_compiler_t* c, ezom_ast_node_t* node) {
+    ezom_inline_kind_t kind = (ezom_inline_kind_t)node->data.message_send.inline_kind;
+    switch (kind) {
+        case AST_INLINE_NONE:
+            break;
+        case AST_INLINE_WHILE_TRUE:
+        case AST_INLINE_WHILE_FALSE:
+            ezom_compile_inlined_while(c, node, kind);
+            return;
+        case AST_INLINE_TO_DO:
+        case AST_INLINE_TIMES_REPEAT:
+            ezom_compile_inlined_loop(c, node, kind);
+            return;
+        default:
+            ezom_compile_inlined_branch(c, node, kind);
+            return;
+    }
+
+    ezom_compile_expression(c, node->data.message_send.receiver);
+
+    const char* selector = node->data.message_send.selector;
+    uint8_t arg_count = 0;
+
+    if (node->data.message_send.arg_count == 0) {
+        arg_count = 0;
+    } else if (strchr(selector, ':')) {
+        for (ezom_ast_node_t* arg = node->data.message_send.arguments; arg && arg_count < 16; arg = arg->next) {
+            ezom_compile_expression(c, arg);
+            arg_count++;
+        }
+    } else {
+        ezom_compile_expression(c, node->data.message_send.arguments);
+        arg_count = 1;
+    }
+
+    ezom_compile_site(c, selector, arg_count);
+}
+
+static void ezom_compile_expression(ezom_compiler_t* c, ezom_ast_node_t* node) {
+    if (!node) {
+        ezom_emit_op(c, BC_PUSH_NIL, 1, 0, 0, 0);
+        return;
+    }
+
+    switch (node->type) {
+        case AST_LITERAL:
+            switch (node->data.literal.type) {
+                case LITERAL_NIL:
+                    ezom_emit_op(c, BC_PUSH_NIL, 1, 0, 0, 0);
+                    break;
+                case LITERAL_TRUE:
+                    ezom_emit_op(c, BC_PUSH_TRUE, 1, 0, 0, 0);
+                    break;
+                case LITERAL_FALSE:
+                    ezom_emit_op(c, BC_PUSH_FALSE, 1, 0, 0, 0);
+                    break;
+                default: {
+                    uint24_t object = ezom_literal_object(node);
+                    if (!object) {
+                        ezom_compile_fail(c, "literal could not be created");
+                        return;
+                    }
+                    ezom_emit_op(c, BC_PUSH_LITERAL, 1, 1, ezom_compile_literal(c, object), 0);
+                    break;
+                }
+            }
+            break;
+
+        case AST_VARIABLE_DEF:
+            ezom_compile_variable(c, node);
+            break;
+
+        case AST_ASSIGNMENT:
+        case AST_INCREMENT:
+            ezom_compile_assignment(c, node);
+            break;
+
+        case AST_MESSAGE_SEND:
+            ezom_compile_send(c, node);
+            break;
+
+        case AST_BLOCK:
+            ezom_compile_block_literal(c, node);
+            break;
+
+        case AST_IDENTIFIER:
+            ezom_compile_fail(c, "unresolved identifier");
+            break;
+
+        default:
+            ezom_compile_fail(c, "unsupported node");
+            break;
+    }
+}
+
+// One statement; answers true if it was a ^ (nothing after it runs)
+static bool ezom_compile_statement(ezom_compiler_t* c, ezom_ast_node_t* stmt, bool is_last) {
+    if (stmt->type == AST_RETURN) {
+        ezom_compile_expression(c, stmt->data.return_stmt.expression);
+        ezom_compile_return(c);
+        return true;
+    }
+
+    ezom_compile_expression(c, stmt);
+    if (is_last) {
+        ezom_emit_op(c, BC_END, -1, 0, 0, 0);
+    } else {
+        ezom_compile_statement_end(c);
+    }
+    return false;
+}
+
+// A body answers the value of its last statement unless a ^ returns first
+static void ezom_compile_body(ezom_compiler_t* c, ezom_ast_node_t* body) {
+    if (body && body->type != AST_STATEMENT_LIST) {
+        // A program parsed as a single expression
+        ezom_compile_statement(c, body, true);
+        return;
+    }
+
+    ezom_ast_node_t* stmt = body ? body->data.statement_list.statements : NULL;
+    if (!stmt) {
+        ezom_emit_op(c, BC_PUSH_NIL, 1, 0, 0, 0);
+        ezom_emit_op(c, BC_END, -1, 0, 0, 0);
+        return;
+    }
+
+    for (; stmt; stmt = stmt->next) {
+        if (ezom_compile_statement(c, stmt, stmt->next == NULL)) {
+            return;
+        }
+    }
+}
+
+static ezom_code_t* ezom_compile_unit(ezom_ast_node_t* body, uint16_t param_count, uint16_t local_count,
+                                      const uint8_t* boxed, uint8_t boxed_count, bool block) {
+    ezom_compiler_t c;
+    memset(&c, 0, sizeof(c));
+    c.block = block;
+
+    if (param_count + local_count > 255) {
+        ezom_compile_fail(&c, "too many variables");
+    } else {
+        ezom_compile_boxes(&c, boxed, boxed_count);
+        ezom_compile_body(&c, body);
+    }
+
+    if (c.max_depth > 255) {
+        ezom_compile_fail(&c, "expression too deep");
+    }
+
+    ezom_code_t* code = NULL;
+    if (!c.failed) {
+        code = (ezom_code_t*)malloc(sizeof(ezom_code_t));
+    }
+
+    if (!code) {
+        free(c.code);
+        free(c.literals);
+        free(c.globals);
+        free(c.sites);
+        free(c.blocks);
+        g_bytecode_stats.fallbacks++;
+        return NULL;
+    }
+
+    code->bytecodes = c.code;
+    code->length = c.length;
+    code->param_count = (uint8_t)param_count;
+    code->local_count = (uint8_t)local_count;
+    code->max_stack = (uint8_t)c.max_depth;
+    code->literal_count = (uint8_t)c.literal_count;
+    code->global_count = (uint8_t)c.global_count;
+    code->site_count = (uint8_t)c.site_count;
+    code->block_count = (uint8_t)c.block_count;
+    code->literals = c.literals;
+    code->globals = c.globals;
+    code->sites = c.sites;
+    code->blocks = c.blocks;
+
+    g_bytecode_stats.units++;
+    g_bytecode_stats.bytes += c.length;
+    return code;
+}
+
+ezom_code_t* ezom_compile_method(ezom_ast_node_t* method_ast) {
+    if (!method_ast || method_ast->type != AST_METHOD_DEF) return NULL;
+
+    return ezom_compile_unit(method_ast->data.method_def.body,
+                             ezom_ast_count_parameters(method_ast->data.method_def.parameters),
+                             ezom_ast_count_locals(method_ast->data.method_def.locals) +
+                             method_ast->data.method_def.inlined_slots,
+                             method_ast->data.method_def.boxed,
+                             method_ast->data.method_def.boxed_count, false);
+}
+
+ezom_code_t* ezom_compile_block(ezom_ast_node_t* block_ast) {
+    if (!block_ast || block_ast->type != AST_BLOCK) return NULL;
+
+    if (!block_ast->data.block.code && !block_ast->data.block.no_bytecode) {
+        ezom_block_vars_t* vars = block_ast->data.block.vars;
+        block_ast->data.block.code = ezom_compile_unit(block_ast->data.block.body,
+                                                       ezom_ast_count_parameters(block_ast->data.block.parameters),
+                                                       ezom_ast_count_locals(block_ast->data.block.locals) +
+                                                       block_ast->data.block.inlined_slots,
+                                                       vars ? vars->boxed : NULL,
+                                                       vars ? vars->boxed_count : 0, true);
+        block_ast->data.block.no_bytecode = (block_ast->data.block.code == NULL);
+    }
+
+    return block_ast->data.block.code;
+}
+
+ezom_code_t* ezom_compile_program(ezom_ast_node_t* ast) {
+    return ezom_compile_unit(ast, 0, 0, NULL, 0, false);
+}
+
+void ezom_code_free(ezom_code_t* code) {
+    if (!code) return;
+
+    free(code->bytecodes);
+    free(code->literals);
+    free(code->globals);
+    free(code->sites);
+    free(code->blocks);
+    free(code);
+}
+
+// Disassembler
+static const char* const g_opcode_names[BC_OPCODE_COUNT] = {
+    "push_local", "push_captured", "push_field", "push_global", "push_self",
+    "push_literal", "push_nil", "push_true", "push_false", "push_block",
+    "store_local", "store_box", "store_field", "store_global",
+    "pop", "drop", "send", "return", "end",
+    "jump", "jump_if_true", "jump_if_false", "to_do", "times_repeat", "loop_next",
+    "box_local", "unbox"
+};
+
+// One-byte operands, then two-byte jump targets
+static const uint8_t g_opcode_operands[BC_OPCODE_COUNT] = {
+    1, 1, 2, 1, 1,
+    1, 0, 0, 0, 1,
+    1, 0, 2, 1,
+    0, 0, 1, 0, 0,
+    0, 0, 0, 0, 0, 0,
+    1, 0
+};
+
+static const uint8_t g_opcode_targets[BC_OPCODE_COUNT] = {
+    0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0,
+    0, 0, 0, 0,
+    0, 0, 0, 0, 0,
+    1, 2, 2, 2, 2, 1,
+    0, 0
+};
+
+void ezom_code_print(ezom_code_t* code) {
+    if (!code) return;
+
+    printf("Code: %d params, %d locals, stack %d, %d bytes\n",
+           code->param_count, code->local_count, code->max_stack, code->length);
+
+    for (uint16_t pc = 0; pc < code->length; ) {
+        uint8_t op = code->bytecodes[pc];
+        printf("  %4d  %-13s", pc, op < BC_OPCODE_COUNT ? g_opcode_names[op] : "???");
+        uint8_t operands = op < BC_OPCODE_COUNT ? g_opcode_operands[op] : 0;
+        uint8_t targets = op < BC_OPCODE_COUNT ? g_opcode_targets[op] : 0;
+        for (uint8_t i = 1; i <= operands; i++) {
+            printf(" %d", code->bytecodes[pc + i]);
+        }
+        for (uint8_t i = 0; i < targets; i++) {
+            printf(" ->%d", BC_READ_TARGET(&code->bytecodes[pc + 1 + operands + i * 2]));
+        }
+        if (op == BC_SEND) {
+            ezom_send_site_t* site = &code->sites[code->bytecodes[pc + 1]];
+            printf("  #%s/%d", site->selector, site->arg_count);
+        } else if (op == BC_PUSH_GLOBAL || op == BC_STORE_GLOBAL) {
+            printf("  %s", code->globals[code->bytecodes[pc + 1]]->name);
+        }
+        printf("\n");
+        pc += 1 + operands + targets * 2;
+    }
+}
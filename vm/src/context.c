@@ -7,7 +7,9 @@
 #include "../include/ezom_memory.h"
 #include "../include/ezom_primitives.h"
 #include "../include/ezom_evaluator.h"
+#include "../include/ezom_bytecode.h"
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
 // Forward declaration from parser.c
@@ -16,10 +18,10 @@ extern int ezom_find_parameter_index(const char* name, ezom_ast_node_t* paramete
 // Global current context (defined in this file)
 uint24_t g_current_context = 0;
 
-// Context stack for execution
-#define MAX_CONTEXT_STACK 64
-static uint24_t context_stack[MAX_CONTEXT_STACK];
-static uint8_t context_stack_top = 0;
+// Context stack for execution, grown as activations nest
+static uint24_t* context_stack = NULL;
+static uint32_t context_stack_top = 0;
+static uint32_t context_stack_capacity = 0;
 
 void ezom_init_context_system(void) {
     printf("EZOM: Initializing context system...\n");
@@ -68,7 +70,8 @@ uint24_t ezom_create_extended_context(uint24_t outer_context, uint24_t receiver,
     ezom_context_t* context = (ezom_context_t*)EZOM_OBJECT_PTR(ptr);
     context->outer_context = outer_context;
     context->method = method_index;
-    context->receiver = receiver;
+    context->receiver = ezom_promote_double(receiver);
+    ezom_frame_note_store(ptr, receiver);
     context->sender = 0;  // Use Phase 1.5 structure
     context->pc = 0;      // Use Phase 1.5 structure
     context->local_count = local_count;
@@ -96,7 +99,8 @@ void ezom_context_set_local(uint24_t context_ptr, uint8_t index, uint24_t value)
     
     ezom_context_t* context = (ezom_context_t*)EZOM_OBJECT_PTR(context_ptr);
     if (index < context->local_count) {
-        context->locals[index] = value;
+        context->locals[index] = ezom_store_slot_double(context->locals[index], value);
+        ezom_frame_note_store(context_ptr, value);
     }
 }
 
@@ -105,7 +109,7 @@ uint24_t ezom_context_get_local(uint24_t context_ptr, uint8_t index) {
     
     ezom_context_t* context = (ezom_context_t*)EZOM_OBJECT_PTR(context_ptr);
     if (index < context->local_count) {
-        return context->locals[index];
+        return ezom_load_slot_double(context->locals[index]);
     }
     
     return g_nil;
@@ -128,7 +132,7 @@ uint24_t ezom_context_lookup_variable(uint24_t context_ptr, const char* name) {
                 int param_index = ezom_find_parameter_index(name, block_ast->data.block.parameters);
                 if (param_index >= 0 && param_index < block->param_count) {
                     printf("   Debug: Found parameter '%s' at index %d\n", name, param_index);
-                    return context->locals[param_index];
+                    return ezom_load_slot_double(context->locals[param_index]);
                 }
             }
         }
@@ -153,7 +157,8 @@ void ezom_context_bind_parameters(uint24_t context_ptr, uint24_t* args, uint8_t
     uint8_t param_count = arg_count < context->local_count ? arg_count : context->local_count;
     
     for (uint8_t i = 0; i < param_count; i++) {
-        context->locals[i] = args[i];
+        context->locals[i] = ezom_promote_double(args[i]);
+        ezom_frame_note_store(context_ptr, args[i]);
     }
 }
 
@@ -169,7 +174,8 @@ void ezom_context_bind_block_parameters(uint24_t context_ptr, uint24_t* args, ui
     printf("   Binding %d parameters to block context\n", actual_param_count);
     
     for (uint8_t i = 0; i < actual_param_count; i++) {
-        context->locals[i] = args[i];
+        context->locals[i] = ezom_promote_double(args[i]);
+        ezom_frame_note_store(context_ptr, args[i]);
         printf("     Parameter %d bound to value 0x%06X\n", i, args[i]);
     }
     
@@ -218,7 +224,7 @@ uint24_t ezom_context_get_variable(uint24_t context_ptr, const char* var_name, u
     
     // Check if variable index is within range
     if (var_index < context->local_count) {
-        return context->locals[var_index];
+        return ezom_load_slot_double(context->locals[var_index]);
     }
     
     // Variable not found in current context, check outer context
@@ -237,7 +243,8 @@ void ezom_context_set_variable(uint24_t context_ptr, const char* var_name, uint8
     
     // Check if variable index is within range
     if (var_index < context->local_count) {
-        context->locals[var_index] = value;
+        context->locals[var_index] = ezom_store_slot_double(context->locals[var_index], value);
+        ezom_frame_note_store(context_ptr, value);
         return;
     }
     
@@ -255,10 +262,13 @@ uint24_t ezom_create_ast_block(ezom_ast_node_t* ast_node, uint24_t outer_context
     ezom_block_t* block = (ezom_block_t*)EZOM_OBJECT_PTR(ptr);
     block->outer_context = outer_context;
     block->code = ast_node; // Store AST pointer directly as native pointer
+    block->capture_count = 0;
+    block->home = 0;        // A ^ finds the home through outer_context
     
     if (ast_node && ast_node->type == AST_BLOCK) {
         block->param_count = ezom_ast_count_parameters(ast_node->data.block.parameters);
-        block->local_count = ezom_ast_count_locals(ast_node->data.block.locals);
+        block->local_count = ezom_ast_count_locals(ast_node->data.block.locals) +
+                             ast_node->data.block.inlined_slots;
     } else {
         block->param_count = 0;
         block->local_count = 0;
@@ -267,6 +277,125 @@ uint24_t ezom_create_ast_block(ezom_ast_node_t* ast_node, uint24_t outer_context
     return ptr;
 }
 
+// Flat closure: a copy of each variable the literal captures (see
+// ezom_resolver.h), taken from context, and no outer context
+static uint24_t ezom_create_flat_block(ezom_ast_node_t* ast_node, uint24_t context) {
+    ezom_block_vars_t* vars = ast_node->data.block.vars;
+    uint8_t count = vars ? vars->capture_count : 0;
+    uint24_t ptr = ezom_allocate(sizeof(ezom_block_t) + count * sizeof(uint24_t));
+    if (!ptr) return 0;
+    
+    ezom_init_object(ptr, g_block_class, EZOM_TYPE_BLOCK);
+    
+    ezom_block_t* block = (ezom_block_t*)EZOM_OBJECT_PTR(ptr);
+    block->outer_context = 0;
+    block->code = ast_node;
+    block->param_count = ezom_ast_count_parameters(ast_node->data.block.parameters);
+    block->local_count = ezom_ast_count_locals(ast_node->data.block.locals) +
+                         ast_node->data.block.inlined_slots;
+    block->capture_count = count;
+    block->home = ezom_frame_home(context);
+    
+    ezom_context_t* ctx = context ? (ezom_context_t*)EZOM_OBJECT_PTR(context) : NULL;
+    for (uint8_t i = 0; i < count; i++) {
+        ezom_capture_t* capture = &vars->captures[i];
+        uint24_t value = g_nil;
+        if (ctx) {
+            switch (capture->source) {
+                case AST_CAPTURE_LOCAL:
+                    if (capture->index < ctx->local_count) {
+                        value = ctx->locals[capture->index];
+                    }
+                    break;
+                case AST_CAPTURE_SELF:
+                    value = ctx->receiver ? ctx->receiver : g_nil;
+                    break;
+                case AST_CAPTURE_OUTER:
+                    value = ezom_block_capture(ctx->receiver, capture->index);
+                    break;
+            }
+        }
+        block->captured_vars[i] = value;
+        ezom_frame_note_store(0, value);
+    }
+    return ptr;
+}
+
+// Value of a block literal. A clean block (see ezom_resolver.h) has no use
+// for its context, so the first evaluation makes a fixed block with none
+// and every later one answers it again. An inlined block made into a
+// closure for a fallback send runs in context itself.
+uint24_t ezom_block_literal(ezom_ast_node_t* ast_node, uint24_t context) {
+    if (ast_node->data.block.inlined) {
+        return ezom_create_ast_block(ast_node, context);
+    }
+    if (!ast_node->data.block.clean) {
+        return ezom_create_flat_block(ast_node, context);
+    }
+    
+    ezom_block_vars_t* vars = ast_node->data.block.vars;
+    if (!vars->object) {
+        vars->object = ezom_fix_literal(ezom_create_ast_block(ast_node, 0));
+    }
+    return vars->object;
+}
+
+// captured_vars[index] of a block running as receiver (nil if none)
+uint24_t ezom_block_capture(uint24_t block_ptr, uint8_t index) {
+    if (!ezom_is_block_object(block_ptr)) return g_nil;
+    ezom_block_t* block = (ezom_block_t*)EZOM_OBJECT_PTR(block_ptr);
+    return index < block->capture_count ? block->captured_vars[index] : g_nil;
+}
+
+// Boxes: one-element Arrays holding a variable that closures capture and
+// code assigns, so every copy of it sees the same value
+uint24_t ezom_create_box(uint24_t value) {
+    uint24_t box = ezom_create_array(1);
+    if (box) {
+        ezom_box_set(box, value);
+    }
+    return box;
+}
+
+uint24_t ezom_box_get(uint24_t box) {
+    if (!box || EZOM_IS_SMALLINT(box)) return g_nil;
+    uint24_t value = ((ezom_array_t*)EZOM_OBJECT_PTR(box))->elements[0];
+    return value ? value : g_nil;
+}
+
+void ezom_box_set(uint24_t box, uint24_t value) {
+    if (!box || EZOM_IS_SMALLINT(box)) return;
+    ((ezom_array_t*)EZOM_OBJECT_PTR(box))->elements[0] = value;
+    ezom_frame_note_store(0, value);
+}
+
+// Replace the listed slots of context with boxes holding their values
+void ezom_box_locals(uint24_t context, const uint8_t* slots, uint8_t count) {
+    if (!context) return;
+    ezom_context_t* ctx = (ezom_context_t*)EZOM_OBJECT_PTR(context);
+    for (uint8_t i = 0; i < count; i++) {
+        if (slots[i] < ctx->local_count) {
+            ctx->locals[slots[i]] = ezom_create_box(ctx->locals[slots[i]]);
+        }
+    }
+}
+
+// A block the resolver inlined, run as a closure by a fallback send: its
+// variables are slots of the frame it was inlined into
+static uint24_t ezom_bind_inlined_block(ezom_block_t* block, ezom_ast_node_t* ast,
+                                        uint24_t* args, uint8_t arg_count) {
+    ezom_context_t* frame = (ezom_context_t*)EZOM_OBJECT_PTR(block->outer_context);
+    uint8_t base = ast->data.block.inline_base;
+    uint8_t slots = block->param_count + ezom_ast_count_locals(ast->data.block.locals);
+    
+    for (uint8_t i = 0; i < slots && base + i < frame->local_count; i++) {
+        frame->locals[base + i] = (i < block->param_count && i < arg_count) ?
+                                  ezom_promote_double(args[i]) : g_nil;
+        ezom_frame_note_store(block->outer_context, frame->locals[base + i]);
+    }
+    return block->outer_context;
+}
+
 uint24_t ezom_block_evaluate(uint24_t block_ptr, uint24_t* args, uint8_t arg_count) {
     if (!block_ptr) return g_nil;
     
@@ -275,14 +404,28 @@ uint24_t ezom_block_evaluate(uint24_t block_ptr, uint24_t* args, uint8_t arg_cou
     
     printf("   Evaluating block with %d parameters and %d locals\n", block->param_count, block->local_count);
     
-    // Create enhanced context for block evaluation
-    uint24_t context = ezom_create_enhanced_block_context(block->outer_context, block_ptr, 
-                                                          block->param_count, block->local_count);
-    
-    if (!context) return g_nil;
+    // Evaluation recurses on the C stack from here
+    if (!ezom_frame_enter_native()) return g_nil;
     
-    // Bind parameters from args using enhanced parameter binding
-    ezom_context_bind_block_parameters(context, args, arg_count, block->param_count);
+    ezom_ast_node_t* block_ast = (ezom_ast_node_t*)block->code;
+    uint24_t context;
+    bool inlined = block_ast && block_ast->type == AST_BLOCK && block_ast->data.block.inlined &&
+                   block->outer_context;
+    if (inlined) {
+        context = ezom_bind_inlined_block(block, block_ast, args, arg_count);
+    } else {
+        // Activation frame for the block's parameters and locals
+        context = ezom_push_frame(block->outer_context, block_ptr,
+                                  block->param_count + block->local_count);
+        
+        if (!context) {
+            ezom_frame_leave_native();
+            return g_nil;
+        }
+        
+        // Bind parameters from args using enhanced parameter binding
+        ezom_context_bind_block_parameters(context, args, arg_count, block->param_count);
+    }
     
     // Push context and evaluate
     ezom_push_context(context);
@@ -290,16 +433,30 @@ uint24_t ezom_block_evaluate(uint24_t block_ptr, uint24_t* args, uint8_t arg_cou
     uint24_t result = g_nil;
     if (block->code) {
         ezom_ast_node_t* ast = (ezom_ast_node_t*)block->code;
-        if (ast->type == AST_BLOCK && ast->data.block.body) {
+        ezom_code_t* code = g_engine == EZOM_ENGINE_BYTECODE ? ezom_compile_block(ast) : NULL;
+        ezom_eval_result_t eval_result = ezom_make_result(g_nil);
+        if (code) {
+            eval_result = ezom_interpret(code, context);
+        } else if (ast->type == AST_BLOCK && ast->data.block.body) {
             // Use AST evaluator to execute block body
-            ezom_eval_result_t eval_result = ezom_evaluate_ast(ast->data.block.body, context);
-            if (!eval_result.is_error) {
-                result = eval_result.value;
+            if (ast->data.block.vars) {
+                ezom_box_locals(context, ast->data.block.vars->boxed, ast->data.block.vars->boxed_count);
             }
+            eval_result = ezom_evaluate_ast(ast->data.block.body, context);
+        }
+        // ^ returns from the block's home method, not from value
+        if (eval_result.is_return && !eval_result.is_error) {
+            ezom_frame_begin_return(context, eval_result.value);
+        } else if (!eval_result.is_error) {
+            result = eval_result.value;
         }
     }
     
     ezom_pop_context();
+    if (!inlined) {
+        ezom_pop_frame(context, result);
+    }
+    ezom_frame_leave_native();
     
     printf("   Block evaluation returned: 0x%06X\n", result);
     return result;
@@ -328,12 +485,18 @@ bool ezom_is_false_object(uint24_t object_ptr) {
 // Context stack management
 
 void ezom_push_context(uint24_t context_ptr) {
-    if (context_stack_top < MAX_CONTEXT_STACK) {
-        context_stack[context_stack_top++] = g_current_context;
-        g_current_context = context_ptr;
-    } else {
-        printf("Context stack overflow!\n");
+    if (context_stack_top == context_stack_capacity) {
+        uint32_t capacity = context_stack_capacity ? context_stack_capacity * 2 : 64;
+        uint24_t* stack = realloc(context_stack, capacity * sizeof(uint24_t));
+        if (!stack) {
+            printf("Context stack overflow!\n");
+            return;
+        }
+        context_stack = stack;
+        context_stack_capacity = capacity;
     }
+    context_stack[context_stack_top++] = g_current_context;
+    g_current_context = context_ptr;
 }
 
 uint24_t ezom_pop_context(void) {
@@ -349,16 +512,396 @@ uint24_t ezom_get_current_context(void) {
     return g_current_context;
 }
 
+// Frame stack
+
+ezom_frame_stack_t g_frame_stack = {
+    .base = EZOM_FRAME_STACK_START,
+    .limit = EZOM_FRAME_STACK_START + EZOM_FRAME_STACK_SIZE,
+    .top = EZOM_FRAME_STACK_START,
+    .max_depth = EZOM_DEFAULT_MAX_DEPTH
+};
+
+#define EZOM_FRAME_RECORD(frame) \
+    ((ezom_frame_t*)((char*)EZOM_OBJECT_PTR(frame) - sizeof(ezom_frame_t)))
+
+void ezom_init_frame_stack(void) {
+    g_frame_stack.base = EZOM_FRAME_STACK_START;
+    g_frame_stack.limit = EZOM_FRAME_STACK_START + EZOM_FRAME_STACK_SIZE;
+    g_frame_stack.top = g_frame_stack.base;
+    g_frame_stack.current = 0;
+    g_frame_stack.depth = 0;
+    g_frame_stack.native_depth = 0;
+    g_frame_stack.overflow = false;
+    g_frame_stack.returning = false;
+    g_frame_stack.raising = false;
+    if (!g_frame_stack.max_depth) {
+        g_frame_stack.max_depth = EZOM_DEFAULT_MAX_DEPTH;
+    }
+}
+
+void ezom_set_max_depth(uint32_t max_depth) {
+    g_frame_stack.max_depth = max_depth ? max_depth : EZOM_DEFAULT_MAX_DEPTH;
+}
+
+// Out of frames: report once, then let every activation unwind
+static void ezom_frame_overflow(void) {
+    if (g_frame_stack.overflow) return;
+    
+    g_frame_stack.overflow = true;
+    g_frame_stack.overflows++;
+    printf("Stack overflow: %lu frames deep (max depth %lu), %u nested in C, %lu of %lu bytes\n",
+           (unsigned long)g_frame_stack.depth, (unsigned long)g_frame_stack.max_depth,
+           g_frame_stack.native_depth, (unsigned long)(g_frame_stack.top - g_frame_stack.base),
+           (unsigned long)EZOM_FRAME_STACK_SIZE);
+    ezom_frame_print_backtrace();
+    ezom_make_error_result("Stack overflow");
+}
+
+bool ezom_frame_enter_native(void) {
+    if (g_frame_stack.native_depth >= EZOM_MAX_NATIVE_DEPTH) {
+        ezom_frame_overflow();
+        return false;
+    }
+    g_frame_stack.native_depth++;
+    return true;
+}
+
+void ezom_frame_leave_native(void) {
+    g_frame_stack.native_depth--;
+}
+
+void* ezom_frame_reserve(uint16_t bytes) {
+    uint24_t size = EZOM_FRAME_ALIGN(bytes);
+    if (!g_frame_stack.base || g_frame_stack.top + size > g_frame_stack.limit) {
+        ezom_frame_overflow();
+        return NULL;
+    }
+    
+    void* space = EZOM_OBJECT_PTR(g_frame_stack.top);
+    g_frame_stack.top += size;
+    if (g_frame_stack.top - g_frame_stack.base > g_frame_stack.peak_bytes) {
+        g_frame_stack.peak_bytes = g_frame_stack.top - g_frame_stack.base;
+    }
+    return space;
+}
+
+void ezom_frame_release(void* space) {
+    g_frame_stack.top = EZOM_OBJECT_ADDR(space);
+}
+
+// Outer context of a block or context
+static uint24_t* ezom_outer_slot(uint24_t object_ptr) {
+    if (ezom_is_block_object(object_ptr)) {
+        return &((ezom_block_t*)EZOM_OBJECT_PTR(object_ptr))->outer_context;
+    }
+    return &((ezom_context_t*)EZOM_OBJECT_PTR(object_ptr))->outer_context;
+}
+
+// referrer (a block or heap context) keeps frame alive past its exit:
+// log it so it can be repointed at the heap copy
+static void ezom_frame_escape(uint24_t frame, uint24_t referrer) {
+    ezom_frame_t* record = EZOM_FRAME_RECORD(frame);
+    record->escaped = true;
+    
+    for (uint32_t i = record->capture_mark; i < g_frame_stack.capture_count; i++) {
+        if (g_frame_stack.captures[i] == referrer) return;
+    }
+    
+    if (g_frame_stack.capture_count == g_frame_stack.capture_capacity) {
+        uint32_t capacity = g_frame_stack.capture_capacity ? g_frame_stack.capture_capacity * 2 : 32;
+        uint24_t* captures = realloc(g_frame_stack.captures, capacity * sizeof(uint24_t));
+        if (!captures) {
+            printf("EZOM: Capture log full, closure left over a dead frame\n");
+            return;
+        }
+        g_frame_stack.captures = captures;
+        g_frame_stack.capture_capacity = capacity;
+    }
+    g_frame_stack.captures[g_frame_stack.capture_count++] = referrer;
+}
+
+// value is being stored into a slot of target, a context, or 0 for any
+// other heap slot. A closure over a stack frame escapes unless the slot
+// belongs to that frame or a newer one, which die first.
+void ezom_frame_note_store(uint24_t target, uint24_t value) {
+    if (!ezom_is_block_object(value)) return;
+    
+    uint24_t outer = ((ezom_block_t*)EZOM_OBJECT_PTR(value))->outer_context;
+    if (!EZOM_IS_STACK_FRAME(outer) || (EZOM_IS_STACK_FRAME(target) && target >= outer)) {
+        return;
+    }
+    ezom_frame_escape(outer, value);
+}
+
+uint24_t ezom_push_frame(uint24_t outer_context, uint24_t receiver, uint8_t local_count) {
+    uint16_t context_size = sizeof(ezom_context_t) + local_count * sizeof(uint24_t);
+    uint24_t size = EZOM_FRAME_ALIGN(sizeof(ezom_frame_t) + context_size);
+    
+    // A fresh outermost activation starts clean after an earlier overflow
+    if (g_frame_stack.depth == 0) {
+        g_frame_stack.overflow = false;
+        g_frame_stack.returning = false;
+        g_frame_stack.raising = false;
+    }
+    if (g_frame_stack.depth >= g_frame_stack.max_depth ||
+        !g_frame_stack.base || g_frame_stack.top + size > g_frame_stack.limit) {
+        ezom_frame_overflow();
+        return 0;
+    }
+    
+    uint24_t frame = g_frame_stack.top + sizeof(ezom_frame_t);
+    g_frame_stack.top += size;
+    
+    ezom_frame_t* record = EZOM_FRAME_RECORD(frame);
+    record->previous = g_frame_stack.current;
+    record->capture_mark = g_frame_stack.capture_count;
+    record->serial = ++g_frame_stack.frames;
+    record->escaped = false;
+    g_frame_stack.current = frame;
+    
+    ezom_init_object(frame, g_context_class, EZOM_TYPE_OBJECT);
+    ezom_context_t* context = (ezom_context_t*)EZOM_OBJECT_PTR(frame);
+    context->outer_context = outer_context;
+    context->method = 0;
+    context->receiver = ezom_promote_double(receiver);
+    context->sender = 0;
+    context->pc = 0;
+    context->local_count = local_count;
+    for (uint8_t i = 0; i < local_count; i++) {
+        context->locals[i] = g_nil;
+    }
+    
+    if (++g_frame_stack.depth > g_frame_stack.peak_depth) {
+        g_frame_stack.peak_depth = g_frame_stack.depth;
+    }
+    if (g_frame_stack.top - g_frame_stack.base > g_frame_stack.peak_bytes) {
+        g_frame_stack.peak_bytes = g_frame_stack.top - g_frame_stack.base;
+    }
+    return frame;
+}
+
+// Copy an escaped frame to the heap. Whatever it holds is now stored in
+// the heap too.
+static uint24_t ezom_promote_frame(uint24_t frame) {
+    ezom_context_t* context = (ezom_context_t*)EZOM_OBJECT_PTR(frame);
+    uint16_t size = sizeof(ezom_context_t) + context->local_count * sizeof(uint24_t);
+    uint24_t copy = ezom_allocate(size);
+    if (!copy) {
+        printf("EZOM: No room to keep a captured frame\n");
+        return 0;
+    }
+    memcpy(EZOM_OBJECT_PTR(copy), context, size);
+    g_frame_stack.promoted++;
+    
+    ezom_frame_note_store(copy, context->receiver);
+    for (uint8_t i = 0; i < context->local_count; i++) {
+        ezom_frame_note_store(copy, context->locals[i]);
+    }
+    if (EZOM_IS_STACK_FRAME(context->outer_context)) {
+        ezom_frame_escape(context->outer_context, copy);
+    }
+    return copy;
+}
+
+// Release the newest frame; result is the value it answers
+void ezom_pop_frame(uint24_t frame, uint24_t result) {
+    if (!EZOM_IS_STACK_FRAME(frame)) return;
+    
+    ezom_frame_t* record = EZOM_FRAME_RECORD(frame);
+    uint32_t mark = record->capture_mark;
+    
+    // A closure over this frame answered from it escapes to the caller
+    if (ezom_is_block_object(result) &&
+        ((ezom_block_t*)EZOM_OBJECT_PTR(result))->outer_context == frame) {
+        ezom_frame_escape(frame, result);
+    }
+    
+    uint24_t copy = record->escaped ? ezom_promote_frame(frame) : 0;
+    
+    // Repoint this frame's captures; the rest belong to older frames
+    uint32_t kept = mark;
+    for (uint32_t i = mark; i < g_frame_stack.capture_count; i++) {
+        uint24_t* outer = ezom_outer_slot(g_frame_stack.captures[i]);
+        if (*outer == frame) {
+            *outer = copy;
+        } else {
+            g_frame_stack.captures[kept++] = g_frame_stack.captures[i];
+        }
+    }
+    g_frame_stack.capture_count = kept;
+    
+    g_frame_stack.current = record->previous;
+    g_frame_stack.top = frame - sizeof(ezom_frame_t);
+    g_frame_stack.depth--;
+}
+
+// The method activation a ^ in code running in context returns from: a
+// flat closure's recorded home, else the method frame the code belongs to
+uint32_t ezom_frame_home(uint24_t context) {
+    while (context) {
+        ezom_context_t* ctx = (ezom_context_t*)EZOM_OBJECT_PTR(context);
+        if (ctx->method || !ctx->outer_context) {
+            if (!ctx->method && ezom_is_block_object(ctx->receiver)) {
+                return ((ezom_block_t*)EZOM_OBJECT_PTR(ctx->receiver))->home;
+            }
+            return EZOM_IS_STACK_FRAME(context) ? EZOM_FRAME_RECORD(context)->serial : 0;
+        }
+        context = ctx->outer_context;
+    }
+    return 0;
+}
+
+// Start unwinding to the home of a ^ run in context. Fails when the home
+// method has already returned.
+bool ezom_frame_begin_return(uint24_t context, uint24_t value) {
+    uint32_t home = ezom_frame_home(context);
+    uint24_t frame = g_frame_stack.current;
+    
+    while (frame && EZOM_FRAME_RECORD(frame)->serial > home) {
+        frame = EZOM_FRAME_RECORD(frame)->previous;
+    }
+    if (home && (!frame || EZOM_FRAME_RECORD(frame)->serial != home)) {
+        printf("Non-local return: the block's home method has already returned\n");
+        return false;
+    }
+    
+    g_frame_stack.returning = true;
+    g_frame_stack.return_home = home;
+    g_frame_stack.return_value = ezom_promote_double(value);
+    g_frame_stack.nonlocal_returns++;
+    return true;
+}
+
+bool ezom_frame_is_return_home(uint24_t frame) {
+    return g_frame_stack.returning && EZOM_IS_STACK_FRAME(frame) &&
+           EZOM_FRAME_RECORD(frame)->serial == g_frame_stack.return_home;
+}
+
+// The home frame got there: stop unwinding and answer the value
+uint24_t ezom_frame_finish_return(void) {
+    g_frame_stack.returning = false;
+    return g_frame_stack.return_value;
+}
+
+// Set a ^ or exception aside so cleanup code (ensure:) can run
+void ezom_frame_suspend_unwind(ezom_unwind_state_t* state) {
+    state->returning = g_frame_stack.returning;
+    state->raising = g_frame_stack.raising;
+    state->return_home = g_frame_stack.return_home;
+    state->raise_handler = g_frame_stack.raise_handler;
+    state->return_value = g_frame_stack.return_value;
+    g_frame_stack.returning = false;
+    g_frame_stack.raising = false;
+}
+
+// Carry on unwinding, unless the cleanup code started its own
+void ezom_frame_resume_unwind(const ezom_unwind_state_t* state) {
+    if (g_frame_stack.returning || g_frame_stack.raising) return;
+    
+    g_frame_stack.returning = state->returning;
+    g_frame_stack.raising = state->raising;
+    g_frame_stack.return_home = state->return_home;
+    g_frame_stack.raise_handler = state->raise_handler;
+    g_frame_stack.return_value = state->return_value;
+}
+
+// Class name for a backtrace line. Built-in classes are not globals.
+static const char* ezom_frame_class_name(uint24_t class_ptr) {
+    const char* name = ezom_global_name(class_ptr);
+    if (name) return name;
+    
+    if (class_ptr == g_object_class) return "Object";
+    if (class_ptr == g_integer_class) return "Integer";
+    if (class_ptr == g_double_class) return "Double";
+    if (class_ptr == g_string_class) return "String";
+    if (class_ptr == g_symbol_class) return "Symbol";
+    if (class_ptr == g_array_class) return "Array";
+    if (class_ptr == g_block_class) return "Block";
+    if (class_ptr == g_true_class) return "True";
+    if (class_ptr == g_false_class) return "False";
+    if (class_ptr == g_nil_class) return "Nil";
+    return "?";
+}
+
+// "Class>>selector" for a method frame, "[] in Class>>selector" for a
+// block frame
+static void ezom_frame_print_line(uint24_t frame) {
+    ezom_context_t* context = (ezom_context_t*)EZOM_OBJECT_PTR(frame);
+    const char* prefix = "";
+    
+    while (!context->method && context->outer_context) {
+        prefix = "[] in ";
+        context = (ezom_context_t*)EZOM_OBJECT_PTR(context->outer_context);
+    }
+    // A flat closure keeps no link to the method it was made in
+    if (!context->method && ezom_is_block_object(context->receiver)) {
+        printf("  %s[] closure\n", prefix);
+        return;
+    }
+    if (!context->method) {
+        printf("  %stop level\n", prefix);
+        return;
+    }
+    
+    ezom_method_code_t* method_code = (ezom_method_code_t*)EZOM_OBJECT_PTR(context->method);
+    ezom_ast_node_t* method_ast = (ezom_ast_node_t*)method_code->ast_node;
+    uint24_t receiver = context->receiver;
+    uint24_t class_ptr = ezom_class_of(receiver);
+    const char* class_side = "";
+    
+    // A class-side method runs with the class itself as receiver
+    if (!EZOM_IS_SMALLINT(receiver) && ezom_is_valid_object(receiver) &&
+        (((ezom_object_t*)EZOM_OBJECT_PTR(receiver))->flags & 0xF0) == EZOM_TYPE_CLASS &&
+        ezom_global_name(receiver)) {
+        class_ptr = receiver;
+        class_side = " class";
+    }
+    printf("  %s%s%s>>%s\n", prefix, ezom_frame_class_name(class_ptr), class_side,
+           method_ast ? method_ast->data.method_def.selector : "?");
+}
+
+// Innermost frames first; the middle of a deep stack is elided
+void ezom_frame_print_backtrace(void) {
+    const uint32_t head = 10, tail = 5;
+    uint32_t index = 0;
+    
+    printf("SOM backtrace (innermost first):\n");
+    for (uint24_t frame = g_frame_stack.current; frame;
+         frame = EZOM_FRAME_RECORD(frame)->previous, index++) {
+        if (index < head || index + tail >= g_frame_stack.depth) {
+            ezom_frame_print_line(frame);
+        } else if (index == head) {
+            printf("  ... %lu more frames ...\n",
+                   (unsigned long)(g_frame_stack.depth - head - tail));
+        }
+    }
+}
+
+void ezom_frame_print_stats(void) {
+    printf("\n=== Frame Stack ===\n");
+    printf("Frames: %lu (%lu stack-only, %lu promoted to the heap)\n",
+           (unsigned long)g_frame_stack.frames,
+           (unsigned long)(g_frame_stack.frames - g_frame_stack.promoted),
+           (unsigned long)g_frame_stack.promoted);
+    printf("Trivial methods run without a frame: %lu\n", (unsigned long)g_frame_stack.trivial);
+    printf("Peak: %lu frames, %lu of %lu bytes (max depth %lu)\n",
+           (unsigned long)g_frame_stack.peak_depth, (unsigned long)g_frame_stack.peak_bytes,
+           (unsigned long)EZOM_FRAME_STACK_SIZE, (unsigned long)g_frame_stack.max_depth);
+    printf("Stack overflows: %lu\n", (unsigned long)g_frame_stack.overflows);
+    printf("Non-local returns: %lu\n", (unsigned long)g_frame_stack.nonlocal_returns);
+    printf("===================\n\n");
+}
+
 // Utility functions
 
 bool ezom_is_block_object(uint24_t object_ptr) {
-    if (!object_ptr) return false;
+    if (!object_ptr || EZOM_IS_SMALLINT(object_ptr)) return false;
     ezom_object_t* obj = (ezom_object_t*)EZOM_OBJECT_PTR(object_ptr);
     return obj->class_ptr == g_block_class;
 }
 
 bool ezom_is_context_object(uint24_t object_ptr) {
-    if (!object_ptr) return false;
+    if (!object_ptr || EZOM_IS_SMALLINT(object_ptr)) return false;
     ezom_object_t* obj = (ezom_object_t*)EZOM_OBJECT_PTR(object_ptr);
     return obj->class_ptr == g_context_class;
 }
@@ -383,7 +926,7 @@ uint24_t ezom_get_local_variable(uint24_t context_ptr, uint16_t index) {
         return g_nil;
     }
     
-    return context->locals[index];
+    return ezom_load_slot_double(context->locals[index]);
 }
 
 uint24_t ezom_get_parameter(uint24_t context_ptr, uint16_t index) {
@@ -397,5 +940,5 @@ uint24_t ezom_get_parameter(uint24_t context_ptr, uint16_t index) {
     }
     
     // Parameters are stored at the beginning of the locals array
-    return context->locals[index];
+    return ezom_load_slot_double(context->locals[index]);
 }
\ No newline at end of file
@@ -6,7 +6,9 @@
 #include "../include/ezom_dispatch.h"
 #include "../include/ezom_primitives.h"
 #include "../include/ezom_memory.h"
+#include "../include/ezom_evaluator.h"
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <stdarg.h>
 
@@ -46,60 +48,454 @@ void ezom_log_close() {
 // External global variables
 extern uint24_t g_nil;
 
-// Helper function to compare two symbols by content
+// Symbols are interned, so selector equality is identity
 bool ezom_symbols_equal(uint24_t sym1, uint24_t sym2) {
-    printf("DEBUG: ezom_symbols_equal comparing 0x%06lX and 0x%06lX\n", 
-           (unsigned long)sym1, (unsigned long)sym2);
+    return sym1 == sym2;
+}
+
+// ============================================================================
+// Global method lookup cache
+// ============================================================================
+//
+// Direct-mapped cache in front of the superclass walk, keyed on
+// (receiver class, selector). Selectors are interned symbols and are
+// compared by identity; the index mixes in the symbol's hash_cache.
+// Failed lookups are cached as well (method == NULL) so repeated
+// doesNotUnderstand sends do not walk the whole hierarchy each time.
+
+typedef struct ezom_method_cache_entry {
+    uint24_t             class_ptr;   // Receiver class (0 = empty slot)
+    uint24_t             selector;    // Interned selector symbol
+    ezom_method_lookup_t lookup;      // Cached lookup result
+} ezom_method_cache_entry_t;
+
+static ezom_method_cache_entry_t g_method_cache[EZOM_METHOD_CACHE_SIZE];
+ezom_method_cache_stats_t g_method_cache_stats;
+
+ezom_inline_cache_stats_t g_inline_cache_stats;
+
+// Cleared by every flush; dispatch tables are rebuilt before next use
+static bool g_dispatch_tables_valid = false;
+
+static inline uint16_t ezom_method_cache_index(uint24_t class_ptr, uint16_t sel_hash) {
+    return (uint16_t)((class_ptr >> 1) ^ sel_hash) & (EZOM_METHOD_CACHE_SIZE - 1);
+}
+
+void ezom_method_cache_flush(void) {
+    memset(g_method_cache, 0, sizeof(g_method_cache));
+    g_method_cache_stats.flushes++;
+    g_dispatch_tables_valid = false;
+}
+
+// Drop every entry for a selector. Installing a method can change the
+// result for the defining class and all of its subclasses, so the flush
+// is keyed on the selector rather than on the class.
+void ezom_method_cache_flush_selector(uint24_t selector) {
+    if (!selector) return;
+    
+    g_dispatch_tables_valid = false;
+    for (uint16_t i = 0; i < EZOM_METHOD_CACHE_SIZE; i++) {
+        ezom_method_cache_entry_t* entry = &g_method_cache[i];
+        if (entry->class_ptr && entry->selector == selector) {
+            entry->class_ptr = 0;
+            g_method_cache_stats.invalidations++;
+        }
+    }
+}
+
+// Drop every entry whose receiver class is class_ptr (class redefinition)
+void ezom_method_cache_flush_class(uint24_t class_ptr) {
+    if (!class_ptr) return;
+    
+    g_dispatch_tables_valid = false;
+    for (uint16_t i = 0; i < EZOM_METHOD_CACHE_SIZE; i++) {
+        if (g_method_cache[i].class_ptr == class_ptr) {
+            g_method_cache[i].class_ptr = 0;
+            g_method_cache_stats.invalidations++;
+        }
+    }
+}
+
+void ezom_method_cache_print_stats(void) {
+    uint32_t lookups = g_method_cache_stats.hits + g_method_cache_stats.misses;
+    
+    printf("\n=== Method Lookup Cache ===\n");
+    printf("Cache size: %d entries\n", EZOM_METHOD_CACHE_SIZE);
+    printf("Hits: %lu (%lu negative)\n",
+           (unsigned long)g_method_cache_stats.hits,
+           (unsigned long)g_method_cache_stats.negative_hits);
+    printf("Misses: %lu\n", (unsigned long)g_method_cache_stats.misses);
+    printf("Hit rate: %.1f%%\n",
+           lookups ? (g_method_cache_stats.hits * 100.0) / lookups : 0.0);
+    printf("Invalidations: %lu, Flushes: %lu\n",
+           (unsigned long)g_method_cache_stats.invalidations,
+           (unsigned long)g_method_cache_stats.flushes);
+    printf("===========================\n\n");
+}
+
+// ============================================================================
+// Class dispatch versions
+// ============================================================================
+//
+// Every class is registered when it is initialized, so that an install can
+// find the subclasses of the defining class. Stamps come from one counter.
+
+static uint32_t  g_class_version_counter = 0;
+static uint24_t* g_versioned_classes = NULL;
+static uint16_t  g_versioned_class_count = 0;
+static uint16_t  g_versioned_class_capacity = 0;
+
+static bool ezom_is_class(uint24_t ptr) {
+    if (!ptr || EZOM_IS_SMALLINT(ptr) || !ezom_is_valid_object(ptr)) return false;
+    return (EZOM_OBJECT_PTR(ptr)->flags & 0xF0) == EZOM_TYPE_CLASS;
+}
+
+static void ezom_class_restamp(uint24_t class_ptr) {
+    ((ezom_class_t*)EZOM_OBJECT_PTR(class_ptr))->dispatch_version = ++g_class_version_counter;
+}
+
+// A fresh stamp for a new class object (or one initialized again)
+void ezom_class_register(uint24_t class_ptr) {
+    if (!class_ptr) return;
     
-    if (sym1 == sym2) {
-        printf("DEBUG: Same object - equal\n");
-        return true;  // Same object
+    ezom_class_restamp(class_ptr);
+    for (uint16_t i = 0; i < g_versioned_class_count; i++) {
+        if (g_versioned_classes[i] == class_ptr) return;
     }
-    if (!sym1 || !sym2) {
-        printf("DEBUG: One is null - not equal\n");
-        return false;  // One is null
+    
+    if (g_versioned_class_count == g_versioned_class_capacity) {
+        uint16_t new_capacity = g_versioned_class_capacity ? g_versioned_class_capacity * 2 : 32;
+        uint24_t* classes = (uint24_t*)realloc(g_versioned_classes, new_capacity * sizeof(uint24_t));
+        if (!classes) {
+            printf("EZOM: Out of memory registering class 0x%06X\n", class_ptr);
+            return;
+        }
+        g_versioned_classes = classes;
+        g_versioned_class_capacity = new_capacity;
     }
+    g_versioned_classes[g_versioned_class_count++] = class_ptr;
+}
+
+// A method class_ptr defines was added or replaced, or its dictionary moved:
+// restamp it and every class that inherits from it
+void ezom_class_changed(uint24_t class_ptr) {
+    if (!ezom_is_class(class_ptr)) return;
     
-    // Check if pointers are in valid memory range (ez80 heap: 0x042000-0x04FFFF)
-    if (sym1 < 0x042000 || sym1 > 0x04FFFF) {
-        printf("DEBUG: sym1 out of range - not equal\n");
+    ezom_class_restamp(class_ptr);
+    uint16_t live = 0;
+    for (uint16_t i = 0; i < g_versioned_class_count; i++) {
+        uint24_t candidate = g_versioned_classes[i];
+        if (!ezom_is_class(candidate)) {
+            continue;       // Collected; forget it
+        }
+        g_versioned_classes[live++] = candidate;
+        
+        uint24_t super = ((ezom_class_t*)EZOM_OBJECT_PTR(candidate))->superclass;
+        for (uint16_t depth = 0; super && super != g_nil && depth < 256; depth++) {
+            if (super == class_ptr) {
+                ezom_class_restamp(candidate);
+                break;
+            }
+            if (!ezom_is_class(super)) break;
+            super = ((ezom_class_t*)EZOM_OBJECT_PTR(super))->superclass;
+        }
+    }
+    g_versioned_class_count = live;
+}
+
+// ============================================================================
+// Selector-indexed dispatch tables
+// ============================================================================
+//
+// Every selector that names a method gets a small integer ID. Each class
+// gets a row mapping selector ID -> method covering its whole hierarchy,
+// so a lookup is a bounds check plus an indexed load with no superclass
+// walk. Rows are packed into one shared table by row displacement: a row
+// is placed at the first offset where its non-empty slots land on free
+// slots, and each class gets a distinct offset. A slot belongs to a class
+// exactly when the selector ID stored in it matches the one looked up.
+//
+// Rows are (re)built when a class is finalized (bootstrap, class
+// definitions) and lazily after any flush marks the tables stale.
+
+ezom_dispatch_mode_t g_dispatch_mode = EZOM_DISPATCH_CACHE;
+ezom_dispatch_table_stats_t g_dispatch_table_stats;
+
+static uint16_t*       g_dispatch_ids = NULL;      // Selector ID owning each slot (0 = free)
+static ezom_method_t** g_dispatch_methods = NULL;  // Method for each slot
+static uint16_t        g_dispatch_table_capacity = 0;
+static uint16_t        g_dispatch_table_used = 0;  // Highest slot in use + 1
+
+static uint24_t*       g_dispatch_classes = NULL;  // Classes that own a row
+static uint16_t        g_dispatch_class_count = 0;
+static uint16_t        g_dispatch_class_capacity = 0;
+
+void ezom_set_dispatch_mode(ezom_dispatch_mode_t mode) {
+    g_dispatch_mode = mode;
+    // Lookups from here on go through the new strategy
+    ezom_method_cache_flush();
+}
+
+static bool ezom_dispatch_table_reserve(uint32_t slots) {
+    if (slots <= g_dispatch_table_capacity) return true;
+    if (slots > 0xFFFF) {
+        printf("EZOM: Dispatch table exceeds %u slots\n", 0xFFFFu);
         return false;
     }
-    if (sym2 < 0x042000 || sym2 > 0x04FFFF) {
-        printf("DEBUG: sym2 out of range - not equal\n");
+    
+    uint32_t new_capacity = g_dispatch_table_capacity ? g_dispatch_table_capacity : 64;
+    while (new_capacity < slots) new_capacity *= 2;
+    if (new_capacity > 0xFFFF) new_capacity = 0xFFFF;
+    
+    uint16_t* ids = (uint16_t*)realloc(g_dispatch_ids, new_capacity * sizeof(uint16_t));
+    if (!ids) return false;
+    g_dispatch_ids = ids;
+    
+    ezom_method_t** methods = (ezom_method_t**)realloc(g_dispatch_methods, new_capacity * sizeof(ezom_method_t*));
+    if (!methods) return false;
+    g_dispatch_methods = methods;
+    
+    memset(&g_dispatch_ids[g_dispatch_table_capacity], 0,
+           (new_capacity - g_dispatch_table_capacity) * sizeof(uint16_t));
+    g_dispatch_table_capacity = (uint16_t)new_capacity;
+    return true;
+}
+
+// Gather a class's full method set, nearest definition winning. row is
+// indexed by selector ID; the IDs present are appended to ids.
+static uint16_t ezom_dispatch_collect_row(uint24_t class_ptr, ezom_method_t** row, uint16_t* ids) {
+    uint16_t count = 0;
+    uint8_t depth = 0;
+    
+    while (class_ptr && depth++ < 32) {
+        ezom_class_t* cls = (ezom_class_t*)EZOM_OBJECT_PTR(class_ptr);
+        ezom_method_dict_t* dict = cls->method_dict ?
+            (ezom_method_dict_t*)EZOM_OBJECT_PTR(cls->method_dict) : NULL;
+        
+        if (dict) {
+            for (uint16_t i = 0; i < dict->capacity; i++) {
+                ezom_method_t* method = ezom_method_dict_entry_at(dict, i);
+                if (!method) continue;
+                
+                uint16_t id = ((ezom_symbol_t*)EZOM_OBJECT_PTR(method->selector))->selector_id;
+                if (id && !row[id]) {
+                    row[id] = method;
+                    ids[count++] = id;
+                }
+            }
+        }
+        
+        class_ptr = cls->superclass;
+    }
+    
+    return count;
+}
+
+static bool ezom_dispatch_offset_taken(uint16_t offset, uint16_t placed) {
+    for (uint16_t i = 0; i < placed; i++) {
+        ezom_class_t* cls = (ezom_class_t*)EZOM_OBJECT_PTR(g_dispatch_classes[i]);
+        if (cls->dispatch_offset == offset) return true;
+    }
+    return false;
+}
+
+static bool ezom_dispatch_table_rebuild(void) {
+    uint16_t id_count = ezom_selector_id_count();
+    ezom_method_t** row = (ezom_method_t**)calloc(id_count + 1, sizeof(ezom_method_t*));
+    uint16_t* ids = (uint16_t*)malloc((id_count + 1) * sizeof(uint16_t));
+    if (!row || !ids) {
+        free(row);
+        free(ids);
         return false;
     }
     
-    ezom_symbol_t* s1 = (ezom_symbol_t*)EZOM_OBJECT_PTR(sym1);
-    ezom_symbol_t* s2 = (ezom_symbol_t*)EZOM_OBJECT_PTR(sym2);
+    if (g_dispatch_ids) {
+        memset(g_dispatch_ids, 0, g_dispatch_table_capacity * sizeof(uint16_t));
+    }
+    g_dispatch_table_used = 0;
+    
+    // Drop classes the collector has reclaimed
+    uint16_t live = 0;
+    for (uint16_t i = 0; i < g_dispatch_class_count; i++) {
+        if (ezom_is_valid_object(g_dispatch_classes[i])) {
+            g_dispatch_classes[live++] = g_dispatch_classes[i];
+        }
+    }
+    g_dispatch_class_count = live;
+    
+    bool ok = true;
+    for (uint16_t c = 0; c < g_dispatch_class_count && ok; c++) {
+        ezom_class_t* cls = (ezom_class_t*)EZOM_OBJECT_PTR(g_dispatch_classes[c]);
+        cls->dispatch_offset = 0;
+        
+        uint16_t count = ezom_dispatch_collect_row(g_dispatch_classes[c], row, ids);
+        uint16_t max_id = 0;
+        for (uint16_t i = 0; i < count; i++) {
+            if (ids[i] > max_id) max_id = ids[i];
+        }
+        
+        // First fit: offset 0 is reserved to mean "no row"
+        uint32_t offset = 1;
+        for (;;) {
+            if (!ezom_dispatch_offset_taken((uint16_t)offset, c)) {
+                uint16_t i = 0;
+                while (i < count && (offset + ids[i] >= g_dispatch_table_capacity ||
+                                     !g_dispatch_ids[offset + ids[i]])) {
+                    i++;
+                }
+                if (i == count) break;
+            }
+            offset++;
+        }
+        
+        if (offset + max_id >= 0xFFFF || !ezom_dispatch_table_reserve(offset + max_id + 1)) {
+            ok = false;
+        } else {
+            for (uint16_t i = 0; i < count; i++) {
+                g_dispatch_ids[offset + ids[i]] = ids[i];
+                g_dispatch_methods[offset + ids[i]] = row[ids[i]];
+            }
+            if (offset + max_id + 1 > g_dispatch_table_used) {
+                g_dispatch_table_used = (uint16_t)(offset + max_id + 1);
+            }
+            cls->dispatch_offset = (uint16_t)offset;
+        }
+        
+        for (uint16_t i = 0; i < count; i++) {
+            row[ids[i]] = NULL;
+        }
+    }
     
-    printf("DEBUG: s1->length=%d, s2->length=%d\n", s1->length, s2->length);
+    free(row);
+    free(ids);
     
-    if (s1->length != s2->length) {
-        printf("DEBUG: Different lengths - not equal\n");
+    if (!ok) {
+        printf("EZOM: Dispatch table rebuild failed, falling back to lookup cache\n");
+        g_dispatch_mode = EZOM_DISPATCH_CACHE;
         return false;
     }
     
-    // FIXED: Use explicit pointer arithmetic instead of flexible array member
-    char* s1_data = (char*)EZOM_OBJECT_PTR(sym1 + sizeof(ezom_object_t) + sizeof(uint16_t) + sizeof(uint16_t));
-    char* s2_data = (char*)EZOM_OBJECT_PTR(sym2 + sizeof(ezom_object_t) + sizeof(uint16_t) + sizeof(uint16_t));
+    g_dispatch_table_stats.rebuilds++;
+    g_dispatch_tables_valid = true;
+    return true;
+}
+
+static bool ezom_dispatch_table_register(uint24_t class_ptr) {
+    for (uint16_t i = 0; i < g_dispatch_class_count; i++) {
+        if (g_dispatch_classes[i] == class_ptr) return true;
+    }
+    
+    if (g_dispatch_class_count == g_dispatch_class_capacity) {
+        uint16_t new_capacity = g_dispatch_class_capacity ? g_dispatch_class_capacity * 2 : 16;
+        uint24_t* classes = (uint24_t*)realloc(g_dispatch_classes, new_capacity * sizeof(uint24_t));
+        if (!classes) return false;
+        g_dispatch_classes = classes;
+        g_dispatch_class_capacity = new_capacity;
+    }
+    
+    g_dispatch_classes[g_dispatch_class_count++] = class_ptr;
+    g_dispatch_tables_valid = false;
+    return true;
+}
+
+// Called once a class has all of its methods; builds its row right away
+// when table dispatch is active.
+void ezom_dispatch_table_finalize_class(uint24_t class_ptr) {
+    if (!class_ptr) return;
+    
+    ezom_dispatch_table_register(class_ptr);
+    if (g_dispatch_mode == EZOM_DISPATCH_TABLE && !g_dispatch_tables_valid) {
+        ezom_dispatch_table_rebuild();
+    }
+}
+
+// Class is being replaced; its row goes away on the next rebuild
+void ezom_dispatch_table_forget_class(uint24_t class_ptr) {
+    for (uint16_t i = 0; i < g_dispatch_class_count; i++) {
+        if (g_dispatch_classes[i] == class_ptr) {
+            ((ezom_class_t*)EZOM_OBJECT_PTR(class_ptr))->dispatch_offset = 0;
+            g_dispatch_classes[i] = g_dispatch_classes[--g_dispatch_class_count];
+            g_dispatch_tables_valid = false;
+            return;
+        }
+    }
+}
+
+ezom_method_lookup_t ezom_dispatch_table_lookup(uint24_t class_ptr, uint24_t selector) {
+    ezom_class_t* cls = (ezom_class_t*)EZOM_OBJECT_PTR(class_ptr);
     
-    printf("DEBUG: Comparing strings: '");
-    for (int i = 0; i < s1->length && i < 10; i++) {
-        printf("%c", s1_data[i]);
+    if (!g_dispatch_tables_valid || !cls->dispatch_offset) {
+        // Stale tables, or a class that was never finalized
+        if (!ezom_dispatch_table_register(class_ptr) || !ezom_dispatch_table_rebuild()) {
+            return ezom_lookup_method_uncached(class_ptr, selector);
+        }
     }
-    printf("' vs '");
-    for (int i = 0; i < s2->length && i < 10; i++) {
-        printf("%c", s2_data[i]);
+    
+    ezom_method_lookup_t result = {0};
+    uint16_t id = ((ezom_symbol_t*)EZOM_OBJECT_PTR(selector))->selector_id;
+    uint32_t slot = (uint32_t)cls->dispatch_offset + id;
+    
+    g_dispatch_table_stats.lookups++;
+    if (id && slot < g_dispatch_table_used && g_dispatch_ids[slot] == id) {
+        result.method = g_dispatch_methods[slot];
+        result.class_ptr = class_ptr;
+        result.is_primitive = (result.method->flags & EZOM_METHOD_PRIMITIVE) != 0;
+    } else {
+        g_dispatch_table_stats.misses++;
     }
-    printf("'\n");
     
-    bool result = strncmp(s1_data, s2_data, s1->length) == 0;
-    printf("DEBUG: String comparison result: %s\n", result ? "equal" : "not equal");
     return result;
 }
 
+void ezom_dispatch_table_print_stats(void) {
+    uint16_t filled = 0;
+    for (uint16_t i = 0; i < g_dispatch_table_used; i++) {
+        if (g_dispatch_ids[i]) filled++;
+    }
+    
+    printf("\n=== Dispatch Tables ===\n");
+    printf("Mode: %s\n", g_dispatch_mode == EZOM_DISPATCH_TABLE ? "table" : "cache");
+    printf("Classes: %d, Selectors: %d\n", g_dispatch_class_count, ezom_selector_id_count());
+    printf("Table slots: %d used, %d filled (%.1f%%)\n", g_dispatch_table_used, filled,
+           g_dispatch_table_used ? (filled * 100.0) / g_dispatch_table_used : 0.0);
+    printf("Lookups: %lu (%lu not understood), Rebuilds: %lu\n",
+           (unsigned long)g_dispatch_table_stats.lookups,
+           (unsigned long)g_dispatch_table_stats.misses,
+           (unsigned long)g_dispatch_table_stats.rebuilds);
+    printf("=======================\n\n");
+}
+
 ezom_method_lookup_t ezom_lookup_method(uint24_t class_ptr, uint24_t selector) {
+    if (!class_ptr || !selector || class_ptr == 0xffffff || selector == 0xffffff) {
+        return ezom_lookup_method_uncached(class_ptr, selector);
+    }
+    
+    if (g_dispatch_mode == EZOM_DISPATCH_TABLE) {
+        return ezom_dispatch_table_lookup(class_ptr, selector);
+    }
+    
+    ezom_symbol_t* sym = (ezom_symbol_t*)EZOM_OBJECT_PTR(selector);
+    ezom_method_cache_entry_t* entry = &g_method_cache[ezom_method_cache_index(class_ptr, sym->hash_cache)];
+    
+    if (entry->class_ptr == class_ptr && entry->selector == selector) {
+        g_method_cache_stats.hits++;
+        if (!entry->lookup.method) {
+            g_method_cache_stats.negative_hits++;
+        }
+        return entry->lookup;
+    }
+    
+    g_method_cache_stats.misses++;
+    ezom_method_lookup_t result = ezom_lookup_method_uncached(class_ptr, selector);
+    
+    entry->class_ptr = class_ptr;
+    entry->selector = selector;
+    entry->lookup = result;
+    
+    return result;
+}
+
+ezom_method_lookup_t ezom_lookup_method_uncached(uint24_t class_ptr, uint24_t selector) {
     ezom_method_lookup_t result = {0};
     
     printf("DEBUG: ezom_lookup_method entry, class_ptr=0x%06lX, selector=0x%06lX\n", 
@@ -160,35 +556,28 @@ ezom_method_lookup_t ezom_lookup_method(uint24_t class_ptr, uint24_t selector) {
         printf("DEBUG: Method dictionary has %d methods\n", dict->size);
         ezom_log("DEBUG: Method dictionary has %d methods\n", dict->size);
         
-        // Linear search in method dictionary
-        for (uint16_t i = 0; i < dict->size; i++) {
-            printf("DEBUG: Comparing method %d: selector=0x%06lX\n", 
-                   i, (unsigned long)dict->methods[i].selector);
+        // Hashed probe on interned selector identity
+        ezom_method_t* method = ezom_method_dict_find(dict, selector);
+        if (method) {
+            printf("DEBUG: Method selector=0x%06lX, code=0x%06lX, flags=0x%02X\n",
+                   (unsigned long)method->selector,
+                   (unsigned long)method->code,
+                   method->flags);
+            ezom_log("DEBUG: Method selector=0x%06lX, code=0x%06lX, flags=0x%02X\n",
+                     (unsigned long)method->selector,
+                     (unsigned long)method->code,
+                     method->flags);
             
-            // Compare symbol content, not addresses
-            if (ezom_symbols_equal(dict->methods[i].selector, selector)) {
-                printf("DEBUG: Found method at index %d\n", i);
-                printf("DEBUG: Method selector=0x%06lX, code=0x%06lX, flags=0x%02X\n",
-                       (unsigned long)dict->methods[i].selector,
-                       (unsigned long)dict->methods[i].code,
-                       dict->methods[i].flags);
-                ezom_log("DEBUG: Found method at index %d\n", i);
-                ezom_log("DEBUG: Method selector=0x%06lX, code=0x%06lX, flags=0x%02X\n",
-                         (unsigned long)dict->methods[i].selector,
-                         (unsigned long)dict->methods[i].code,
-                         dict->methods[i].flags);
-                
-                result.method = &dict->methods[i];
-                result.class_ptr = class_ptr; // Use original class_ptr instead of casting
-                result.is_primitive = (dict->methods[i].flags & EZOM_METHOD_PRIMITIVE) != 0;
-                
-                printf("DEBUG: Returning method=0x%06lX, class_ptr=0x%06lX, is_primitive=%d\n",
-                       (unsigned long)result.method, (unsigned long)result.class_ptr, result.is_primitive);
-                ezom_log("DEBUG: Returning method=0x%06lX, class_ptr=0x%06lX, is_primitive=%d\n",
-                         (unsigned long)result.method, (unsigned long)result.class_ptr, result.is_primitive);
-                
-                return result;
-            }
+            result.method = method;
+            result.class_ptr = class_ptr; // Use original class_ptr instead of casting
+            result.is_primitive = (method->flags & EZOM_METHOD_PRIMITIVE) != 0;
+            
+            printf("DEBUG: Returning method=0x%06lX, class_ptr=0x%06lX, is_primitive=%d\n",
+                   (unsigned long)result.method, (unsigned long)result.class_ptr, result.is_primitive);
+            ezom_log("DEBUG: Returning method=0x%06lX, class_ptr=0x%06lX, is_primitive=%d\n",
+                     (unsigned long)result.method, (unsigned long)result.class_ptr, result.is_primitive);
+            
+            return result;
         }
         
         printf("DEBUG: Method not found in this class, moving to superclass 0x%06lX\n",
@@ -222,47 +611,50 @@ ezom_method_lookup_t ezom_lookup_method(uint24_t class_ptr, uint24_t selector) {
     return result;  // Method not found
 }
 
-uint24_t ezom_send_message(ezom_message_t* msg) {
+// Method that msg runs, or NULL if it is not understood
+ezom_method_t* ezom_resolve_message(ezom_message_t* msg) {
     printf("DEBUG: ezom_send_message entry, receiver=0x%06X\n", msg->receiver);
     ezom_log("DEBUG: ezom_send_message entry, receiver=0x%06X\n", msg->receiver);
     
-    // CRITICAL: Check for corruption pattern immediately and abort safely
-    if (msg->receiver == 0xffffff) {
-        printf("DEBUG: Corrupted receiver detected, returning early\n");
-        ezom_log("DEBUG: Corrupted receiver detected, returning early\n");
-        return g_nil ? g_nil : 0;
-    }
-    
-    if (msg->args && msg->arg_count > 0) {
-        for (int i = 0; i < msg->arg_count; i++) {
-            if (msg->args[i] == 0xffffff) {
-                printf("DEBUG: Corrupted arg[%d] detected, returning early\n", i);
-                ezom_log("DEBUG: Corrupted arg[%d] detected, returning early\n", i);
-                return g_nil ? g_nil : 0;
-            }
-        }
-    }
-    
+    // 0xFFFFFF is a valid reference now (the SmallInteger -1), so
+    // corruption is caught by the heap range check instead
     if (!msg->receiver) {
-        return 0;
+        return NULL;
     }
     
-    if (!ezom_is_valid_object(msg->receiver)) {
-        return 0;
+    if (!EZOM_IS_SMALLINT(msg->receiver) && !ezom_is_valid_object(msg->receiver)) {
+        return NULL;
     }
     
-    ezom_object_t* receiver = (ezom_object_t*)EZOM_OBJECT_PTR(msg->receiver);
-    
     // Look up method
-    ezom_method_lookup_t lookup = ezom_lookup_method(receiver->class_ptr, msg->selector);
-    
-    if (!lookup.method) {
+    return ezom_lookup_method(ezom_class_of(msg->receiver), msg->selector).method;
+}
+
+uint24_t ezom_send_message(ezom_message_t* msg) {
+    ezom_method_t* method = ezom_resolve_message(msg);
+    return method ? ezom_invoke_method(method, msg) : 0;
+}
+
+// Compiled method: bytecode, or its AST if the compiler declined
+static uint24_t ezom_run_compiled_method(ezom_method_t* method, uint24_t receiver,
+                                         uint24_t* args, uint8_t arg_count) {
+    ezom_eval_result_t result = ezom_execute_compiled_method(method->code, receiver, args, arg_count);
+    if (result.is_error) {
+        // Unwinding to a ^'s home is not a failure
+        if (!result.is_return) {
+            printf("DEBUG: Method failed: %s\n", g_eval_error.message);
+            ezom_log("DEBUG: Method failed: %s\n", g_eval_error.message);
+        }
         return 0;
     }
-    
-    if (lookup.is_primitive) {
+    return result.value;
+}
+
+// Run an already looked-up method for msg
+uint24_t ezom_invoke_method(ezom_method_t* method, ezom_message_t* msg) {
+    if (method->flags & EZOM_METHOD_PRIMITIVE) {
         // Call primitive function
-        uint8_t prim_num = (uint8_t)lookup.method->code;
+        uint8_t prim_num = (uint8_t)method->code;
         printf("DEBUG: Found primitive %d\n", prim_num);
         ezom_log("DEBUG: Found primitive %d\n", prim_num);
         
@@ -273,59 +665,6 @@ uint24_t ezom_send_message(ezom_message_t* msg) {
                 ezom_log("DEBUG: Calling improved integer addition primitive\n");
             }
             
-            // Emergency bypass for string concatenation - primitive function crashes
-            if (prim_num == PRIM_STRING_CONCAT) { // PRIM_STRING_CONCAT = 32
-                printf("DEBUG: Using emergency bypass for string concatenation (primitive crashes)\n");
-                ezom_log("DEBUG: Using emergency bypass for string concatenation (primitive crashes)\n");
-                
-                if (msg->arg_count == 1) {
-                    ezom_object_t* recv_obj = (ezom_object_t*)EZOM_OBJECT_PTR(msg->receiver);
-                    ezom_object_t* arg_obj = (ezom_object_t*)EZOM_OBJECT_PTR(msg->args[0]);
-                    
-                    // Direct type checking
-                    if ((recv_obj->flags & 0xF0) == EZOM_TYPE_STRING && 
-                        (arg_obj->flags & 0xF0) == EZOM_TYPE_STRING) {
-                        
-                        ezom_string_t* str1 = (ezom_string_t*)EZOM_OBJECT_PTR(msg->receiver);
-                        ezom_string_t* str2 = (ezom_string_t*)EZOM_OBJECT_PTR(msg->args[0]);
-                        
-                        printf("DEBUG: Concatenating '%.*s' + '%.*s'\n", 
-                               str1->length, str1->data, str2->length, str2->data);
-                        ezom_log("DEBUG: Concatenating '%.*s' + '%.*s'\n", 
-                               str1->length, str1->data, str2->length, str2->data);
-                        
-                        uint16_t new_length = str1->length + str2->length;
-                        uint24_t result = ezom_allocate(sizeof(ezom_string_t) + new_length + 1);
-                        
-                        if (!result) {
-                            printf("DEBUG: String allocation failed\n");
-                            ezom_log("DEBUG: String allocation failed\n");
-                            return g_nil;
-                        }
-                        
-                        ezom_init_object(result, g_string_class, EZOM_TYPE_STRING);
-                        
-                        ezom_string_t* result_str = (ezom_string_t*)EZOM_OBJECT_PTR(result);
-                        result_str->length = new_length;
-                        
-                        memcpy(result_str->data, str1->data, str1->length);
-                        memcpy(result_str->data + str1->length, str2->data, str2->length);
-                        result_str->data[new_length] = '\0';
-                        
-                        printf("DEBUG: String concatenation result: '%.*s'\n", 
-                               result_str->length, result_str->data);
-                        ezom_log("DEBUG: String concatenation result: '%.*s'\n", 
-                               result_str->length, result_str->data);
-                        
-                        return result;
-                    }
-                }
-                
-                printf("DEBUG: Invalid types for string concatenation, returning nil\n");
-                ezom_log("DEBUG: Invalid types for string concatenation, returning nil\n");
-                return g_nil;
-            }
-            
             printf("DEBUG: About to call primitive function\n");
             printf("DEBUG: prim_num=%d, function_ptr=0x%06lX\n", prim_num, (unsigned long)g_primitives[prim_num]);
             printf("DEBUG: receiver=0x%06lX, args=0x%06lX, arg_count=%d\n", 
@@ -353,37 +692,169 @@ uint24_t ezom_send_message(ezom_message_t* msg) {
             return 0;
         }
     } else {
-        printf("DEBUG: Bytecode method not implemented\n");
-        ezom_log("DEBUG: Bytecode method not implemented\n");
-        return 0;
+        return ezom_run_compiled_method(method, msg->receiver, msg->args, msg->arg_count);
     }
 }
 
-uint24_t ezom_send_unary_message(uint24_t receiver, uint24_t selector) {
-    ezom_message_t msg = {
-        .selector = selector,
-        .receiver = receiver,
-        .args = NULL,
-        .arg_count = 0
-    };
+// ============================================================================
+// Arity-specialized sends
+// ============================================================================
+//
+// For C callers with the receiver and arguments in hand: one lookup, then
+// straight into the primitive or compiled method, without a message record
+// or the diagnostics of ezom_invoke_method. Not understood answers 0, as
+// ezom_send_message does.
+
+static inline ezom_method_t* ezom_send_lookup(uint24_t receiver, uint24_t selector) {
+    if (!receiver || (!EZOM_IS_SMALLINT(receiver) && !ezom_is_valid_object(receiver))) {
+        return NULL;
+    }
+    return ezom_lookup_method(ezom_class_of(receiver), selector).method;
+}
+
+static inline uint24_t ezom_send_run(ezom_method_t* method, uint24_t receiver,
+                                     uint24_t* args, uint8_t arg_count) {
+    if (method->flags & EZOM_METHOD_PRIMITIVE) {
+        uint8_t prim_num = (uint8_t)method->code;
+        if (prim_num >= MAX_PRIMITIVES || !g_primitives[prim_num]) return 0;
+        return g_primitives[prim_num](receiver, args, arg_count);
+    }
+    return ezom_run_compiled_method(method, receiver, args, arg_count);
+}
+
+uint24_t ezom_send0(uint24_t receiver, uint24_t selector) {
+    ezom_method_t* method = ezom_send_lookup(receiver, selector);
+    return method ? ezom_send_run(method, receiver, NULL, 0) : 0;
+}
+
+uint24_t ezom_send1(uint24_t receiver, uint24_t selector, uint24_t arg) {
+    ezom_method_t* method = ezom_send_lookup(receiver, selector);
+    return method ? ezom_send_run(method, receiver, &arg, 1) : 0;
+}
+
+uint24_t ezom_send2(uint24_t receiver, uint24_t selector, uint24_t arg1, uint24_t arg2) {
+    ezom_method_t* method = ezom_send_lookup(receiver, selector);
+    if (!method) return 0;
     
-    return ezom_send_message(&msg);
+    uint24_t args[2] = {arg1, arg2};
+    return ezom_send_run(method, receiver, args, 2);
+}
+
+uint24_t ezom_sendN(uint24_t receiver, uint24_t selector, uint24_t* args, uint8_t arg_count) {
+    ezom_method_t* method = ezom_send_lookup(receiver, selector);
+    return method ? ezom_send_run(method, receiver, arg_count ? args : NULL, arg_count) : 0;
+}
+
+uint24_t ezom_send_unary_message(uint24_t receiver, uint24_t selector) {
+    return ezom_send0(receiver, selector);
 }
 
 uint24_t ezom_send_binary_message(uint24_t receiver, uint24_t selector, uint24_t arg) {
-    // Immediate corruption check
-    if (receiver == 0xffffff || selector == 0xffffff || arg == 0xffffff) {
+    // Immediate corruption check (receiver and arg may be SmallInteger -1)
+    if (selector == 0xffffff) {
         return 0; // Return early to prevent crash
     }
     
-    uint24_t args[] = {arg};
+    return ezom_send1(receiver, selector, arg);
+}
+// ============================================================================
+// Per-call-site inline caches
+// ============================================================================
+
+// Return the selector symbol for a call site. It is fixed like a literal,
+// so a collection cannot take it from under the site.
+uint24_t ezom_inline_cache_selector(ezom_inline_cache_t* ic, const char* selector) {
+    if (!ic->selector) {
+        ic->selector = ezom_fix_literal(ezom_create_symbol(selector, strlen(selector)));
+    }
+    return ic->selector;
+}
+
+// Method that msg runs from the site owning ic, or NULL if it is not
+// understood
+ezom_method_t* ezom_inline_cache_lookup(ezom_inline_cache_t* ic, ezom_message_t* msg) {
+    if (!ic) {
+        return ezom_resolve_message(msg);
+    }
+    
+    if (!msg->receiver ||
+        (!EZOM_IS_SMALLINT(msg->receiver) && !ezom_is_valid_object(msg->receiver))) {
+        return ezom_resolve_message(msg);
+    }
+    
+    uint24_t class_ptr = ezom_class_of(msg->receiver);
+    if (!class_ptr) {
+        return ezom_resolve_message(msg);
+    }
+    uint32_t version = ezom_class_version(class_ptr);
+    
+    for (uint8_t i = 0; i < ic->count; i++) {
+        ezom_inline_cache_entry_t* entry = &ic->entries[i];
+        if (entry->class_ptr != class_ptr) continue;
+        
+        if (entry->version == version) {
+            g_inline_cache_stats.hits++;
+            return entry->method;
+        }
+        
+        // The class or a superclass changed; refill this entry only
+        g_inline_cache_stats.misses++;
+        g_inline_cache_stats.stale++;
+        ezom_method_lookup_t lookup = ezom_lookup_method(class_ptr, msg->selector);
+        if (lookup.method) {
+            entry->version = version;
+            entry->method = lookup.method;
+        }
+        return lookup.method;
+    }
     
-    ezom_message_t msg = {
-        .selector = selector,
-        .receiver = receiver,
-        .args = args,
-        .arg_count = 1
-    };
+    // Megamorphic sites share the global lookup cache
+    if (ic->megamorphic) {
+        g_inline_cache_stats.megamorphic_sends++;
+        return ezom_resolve_message(msg);
+    }
     
-    return ezom_send_message(&msg);
-}
\ No newline at end of file
+    g_inline_cache_stats.misses++;
+    ezom_method_lookup_t lookup = ezom_lookup_method(class_ptr, msg->selector);
+    if (!lookup.method) {
+        return NULL;
+    }
+    
+    if (ic->count < EZOM_INLINE_CACHE_SIZE) {
+        ic->entries[ic->count].class_ptr = class_ptr;
+        ic->entries[ic->count].version = version;
+        ic->entries[ic->count].method = lookup.method;
+        ic->count++;
+        if (ic->count == 2) {
+            g_inline_cache_stats.polymorphic_sites++;
+        }
+    } else {
+        ic->megamorphic = true;
+        g_inline_cache_stats.megamorphic_sites++;
+    }
+    
+    return lookup.method;
+}
+
+uint24_t ezom_send_message_cached(ezom_inline_cache_t* ic, ezom_message_t* msg) {
+    ezom_method_t* method = ezom_inline_cache_lookup(ic, msg);
+    return method ? ezom_invoke_method(method, msg) : 0;
+}
+
+void ezom_inline_cache_print_stats(void) {
+    uint32_t sends = g_inline_cache_stats.hits + g_inline_cache_stats.misses +
+                     g_inline_cache_stats.megamorphic_sends;
+    
+    printf("\n=== Inline Caches ===\n");
+    printf("Entries per site: %d\n", EZOM_INLINE_CACHE_SIZE);
+    printf("Hits: %lu, Misses: %lu (hit rate %.1f%%)\n",
+           (unsigned long)g_inline_cache_stats.hits,
+           (unsigned long)g_inline_cache_stats.misses,
+           sends ? (g_inline_cache_stats.hits * 100.0) / sends : 0.0);
+    printf("Polymorphic sites: %lu\n", (unsigned long)g_inline_cache_stats.polymorphic_sites);
+    printf("Megamorphic sites: %lu (%lu sends via shared path)\n",
+           (unsigned long)g_inline_cache_stats.megamorphic_sites,
+           (unsigned long)g_inline_cache_stats.megamorphic_sends);
+    printf("Stale entries refilled: %lu\n", (unsigned long)g_inline_cache_stats.stale);
+    printf("=====================\n\n");
+}
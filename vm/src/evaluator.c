@@ -3,23 +3,35 @@
 // AST evaluation engine implementation
 // ============================================================================
 
+#define _DEFAULT_SOURCE     // strdup under -std=c99
 #include "../include/ezom_evaluator.h"
 #include "../include/ezom_memory.h"
 #include "../include/ezom_dispatch.h"
 #include "../include/ezom_primitives.h"
 #include "../include/ezom_context.h"
+#include "../include/ezom_ast_memory.h"
+#include "../include/ezom_resolver.h"
+#include "../include/ezom_optimizer.h"
+#include "../include/ezom_bytecode.h"
+#include "../include/ezom_exceptions.h"
+#ifdef EZOM_JIT
+#include "../include/ezom_jit.h"
+#endif
+#ifdef EZOM_AOT
+#include "../include/ezom_aot.h"
+#endif
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
 // Global symbol table for variables (simplified) - reduced size for ez80
 #define MAX_GLOBALS 16
-static struct {
-    char* name;
-    uint24_t value;
-} g_globals[MAX_GLOBALS];
+static ezom_global_t g_globals[MAX_GLOBALS];
 static uint16_t g_global_count = 0;
 
+ezom_eval_error_t g_eval_error = {"", 0};
+ezom_specialize_stats_t g_specialize_stats;
+
 // Forward declarations
 static ezom_eval_result_t ezom_evaluate_arguments_internal(ezom_ast_node_t* arg_list, 
                                                          uint24_t* arg_values, 
@@ -32,6 +44,193 @@ uint24_t ezom_get_local_variable(uint24_t context_ptr, uint16_t index);
 uint24_t ezom_get_parameter(uint24_t context_ptr, uint16_t index);
 void ezom_set_local_variable(uint24_t context_ptr, uint16_t index, uint24_t value);
 
+// A compiled method whose body is ^ivar; slot gets the variable's index
+static bool ezom_method_is_getter(ezom_method_t* method, uint8_t* slot) {
+    if (method->flags & EZOM_METHOD_PRIMITIVE) return false;
+    
+    ezom_method_code_t* code = (ezom_method_code_t*)EZOM_OBJECT_PTR(method->code);
+    if (code->trivial != EZOM_TRIVIAL_GETTER || code->trivial_value > 0xFF) return false;
+    *slot = (uint8_t)code->trivial_value;
+    return true;
+}
+
+// Variant for a send whose cache holds only method, for class_ptr
+static uint8_t ezom_special_kind(ezom_ast_node_t* node, uint24_t class_ptr, ezom_method_t* method) {
+    uint8_t arg_count = node->data.message_send.arg_count;
+    
+    if (!(method->flags & EZOM_METHOD_PRIMITIVE)) {
+        return arg_count == 0 && ezom_method_is_getter(method, &node->data.message_send.special_slot)
+               ? AST_SPECIAL_IVAR_GET : AST_SPECIAL_GENERIC;
+    }
+    
+    uint8_t primitive = (uint8_t)method->code;
+    if (class_ptr == g_integer_class && arg_count == 1) {
+        switch (primitive) {
+            case PRIM_INTEGER_ADD: return AST_SPECIAL_INT_ADD;
+            case PRIM_INTEGER_SUB: return AST_SPECIAL_INT_SUB;
+            case PRIM_INTEGER_LT:  return AST_SPECIAL_INT_LESS;
+            case PRIM_INTEGER_GT:  return AST_SPECIAL_INT_GREATER;
+            case PRIM_INTEGER_LTE: return AST_SPECIAL_INT_LESS_EQ;
+            case PRIM_INTEGER_GTE: return AST_SPECIAL_INT_GREATER_EQ;
+            case PRIM_INTEGER_EQ:  return AST_SPECIAL_INT_EQ;
+            default:               return AST_SPECIAL_GENERIC;
+        }
+    }
+    if (primitive == PRIM_OBJECT_EQUALS && arg_count == 1) return AST_SPECIAL_IDENTITY_EQ;
+    if (class_ptr == g_block_class && primitive == PRIM_BLOCK_VALUE && arg_count == 0) {
+        return AST_SPECIAL_BLOCK_VALUE0;
+    }
+    if (class_ptr == g_block_class && primitive == PRIM_BLOCK_VALUE_WITH && arg_count == 1) {
+        return AST_SPECIAL_BLOCK_VALUE1;
+    }
+    return AST_SPECIAL_GENERIC;
+}
+
+// Rewrite a warmed-up send node to what its inline cache has seen
+static void ezom_specialize_send(ezom_ast_node_t* node, ezom_inline_cache_t* ic) {
+    uint8_t special = AST_SPECIAL_GENERIC;
+    if (ic->count == 1 && !ic->megamorphic && !node->data.message_send.is_super &&
+        ic->entries[0].version == ezom_class_version(ic->entries[0].class_ptr)) {
+        special = ezom_special_kind(node, ic->entries[0].class_ptr, ic->entries[0].method);
+    }
+    
+    node->data.message_send.special = special;
+    if (special != AST_SPECIAL_GENERIC) {
+        node->data.message_send.special_version = ic->entries[0].version;
+        g_specialize_stats.specialized++;
+    }
+}
+
+static void ezom_despecialize_send(ezom_ast_node_t* node, uint8_t special) {
+    node->data.message_send.special = special;
+    node->data.message_send.executions = 0;
+    g_specialize_stats.despecialized++;
+}
+
+// Run the node's specialized variant. False leaves the send to the
+// generic path: for good if the guard failed, just this once for an
+// Integer overflow or a block of the wrong arity.
+static bool ezom_specialized_send(ezom_ast_node_t* node, ezom_inline_cache_t* ic,
+                                  uint24_t receiver, uint24_t* args, uint24_t* value) {
+    uint8_t special = node->data.message_send.special;
+    
+    // A method the receiver class answers changed since the node specialized
+    if (node->data.message_send.special_version != ezom_class_version(ic->entries[0].class_ptr)) {
+        ezom_despecialize_send(node, AST_SPECIAL_NONE);
+        return false;
+    }
+    
+    if (special <= AST_SPECIAL_INT_EQ) {
+        if (!EZOM_IS_SMALLINT(receiver) || !EZOM_IS_SMALLINT(args[0])) {
+            ezom_despecialize_send(node, AST_SPECIAL_GENERIC);
+            return false;
+        }
+        int32_t a = EZOM_SMALLINT_VALUE(receiver);
+        int32_t b = EZOM_SMALLINT_VALUE(args[0]);
+        switch (special) {
+            case AST_SPECIAL_INT_ADD:
+                if (!EZOM_SMALLINT_FITS(a + b)) return false;
+                *value = EZOM_SMALLINT_FROM(a + b);
+                return true;
+            case AST_SPECIAL_INT_SUB:
+                if (!EZOM_SMALLINT_FITS(a - b)) return false;
+                *value = EZOM_SMALLINT_FROM(a - b);
+                return true;
+            case AST_SPECIAL_INT_LESS:       *value = a < b ? g_true : g_false; return true;
+            case AST_SPECIAL_INT_GREATER:    *value = a > b ? g_true : g_false; return true;
+            case AST_SPECIAL_INT_LESS_EQ:    *value = a <= b ? g_true : g_false; return true;
+            case AST_SPECIAL_INT_GREATER_EQ: *value = a >= b ? g_true : g_false; return true;
+            default:                         *value = a == b ? g_true : g_false; return true;
+        }
+    }
+    
+    // The rest hold for the one receiver class the node saw
+    if (ezom_class_of(receiver) != ic->entries[0].class_ptr) {
+        ezom_despecialize_send(node, AST_SPECIAL_GENERIC);
+        return false;
+    }
+    
+    switch (special) {
+        case AST_SPECIAL_IDENTITY_EQ:
+            *value = receiver == args[0] ? g_true : g_false;
+            return true;
+        
+        case AST_SPECIAL_IVAR_GET:
+            *value = ezom_get_instance_variable(receiver, node->data.message_send.special_slot);
+            return true;
+        
+        case AST_SPECIAL_BLOCK_VALUE0:
+        case AST_SPECIAL_BLOCK_VALUE1: {
+            uint8_t param_count = special == AST_SPECIAL_BLOCK_VALUE1 ? 1 : 0;
+            ezom_block_t* block = (ezom_block_t*)EZOM_OBJECT_PTR(receiver);
+            if (block->param_count != param_count) return false;
+            *value = ezom_block_evaluate(receiver, args, param_count);
+            return true;
+        }
+        
+        default:
+            return false;
+    }
+}
+
+// Send through the site's inline cache, counting sends while the node
+// warms up
+static uint24_t ezom_site_send_generic(ezom_ast_node_t* node, uint24_t receiver,
+                                       uint24_t* args, uint8_t arg_count) {
+    const char* selector_name = node->data.message_send.selector;
+    ezom_inline_cache_t* ic = node->data.message_send.inline_cache;
+    
+    if (!ic) {
+        ic = (ezom_inline_cache_t*)ezom_ast_alloc(sizeof(ezom_inline_cache_t));
+        if (ic) {
+            memset(ic, 0, sizeof(ezom_inline_cache_t));
+            node->data.message_send.inline_cache = ic;
+        }
+    }
+    
+    ezom_message_t msg = {
+        .selector = ic ? ezom_inline_cache_selector(ic, selector_name)
+                       : ezom_create_symbol(selector_name, strlen(selector_name)),
+        .receiver = receiver,
+        .args = arg_count ? args : NULL,
+        .arg_count = arg_count
+    };
+    
+    uint24_t result = ezom_send_message_cached(ic, &msg);
+    if (ic && node->data.message_send.special == AST_SPECIAL_NONE &&
+        ++node->data.message_send.executions >= EZOM_SPECIALIZE_AFTER) {
+        ezom_specialize_send(node, ic);
+    }
+    return result;
+}
+
+// Send a message from an AST call site: the node's specialized variant,
+// or through the site's inline cache
+static ezom_eval_result_t ezom_evaluate_site_send(ezom_ast_node_t* node, uint24_t receiver,
+                                                  uint24_t* args, uint8_t arg_count) {
+    uint24_t result;
+    if (node->data.message_send.special > AST_SPECIAL_GENERIC &&
+        ezom_specialized_send(node, node->data.message_send.inline_cache, receiver, args, &result)) {
+        g_specialize_stats.fast_sends++;
+    } else {
+        result = ezom_site_send_generic(node, receiver, args, arg_count);
+    }
+    
+    if (EZOM_FRAME_UNWINDING()) {
+        return g_frame_stack.overflow ? ezom_make_error_result("Stack overflow")
+                                      : ezom_make_unwind_result();
+    }
+    return ezom_make_result(result);
+}
+
+void ezom_specialize_print_stats(void) {
+    printf("\n=== Node Specialization ===\n");
+    printf("Specialized: %lu, despecialized: %lu\n",
+           (unsigned long)g_specialize_stats.specialized, (unsigned long)g_specialize_stats.despecialized);
+    printf("Sends answered by specialized nodes: %lu\n", (unsigned long)g_specialize_stats.fast_sends);
+    printf("===========================\n\n");
+}
+
 void ezom_evaluator_init(void) {
     printf("EZOM: Initializing evaluator...\n");
     
@@ -93,6 +292,9 @@ ezom_eval_result_t ezom_evaluate_ast(ezom_ast_node_t* node, uint24_t context) {
         case AST_ASSIGNMENT:
             return ezom_evaluate_assignment(node, context);
             
+        case AST_INCREMENT:
+            return ezom_evaluate_increment(node, context);
+            
         case AST_RETURN:
             return ezom_evaluate_return(node, context);
             
@@ -122,6 +324,7 @@ ezom_eval_result_t ezom_evaluate_statement_list(ezom_ast_node_t* statements, uin
     
     ezom_eval_result_t result = ezom_make_result(g_nil);
     ezom_ast_node_t* current = statements->data.statement_list.statements;
+    uint16_t scratch = ezom_double_scratch_mark();
     
     while (current) {
         result = ezom_evaluate_statement(current, context);
@@ -132,17 +335,161 @@ ezom_eval_result_t ezom_evaluate_statement_list(ezom_ast_node_t* statements, uin
         }
         
         current = current->next;
+        
+        // Anything a finished statement kept was stored, and stores promote,
+        // so its scratch Doubles are dead. The last value is the result.
+        if (current) {
+            ezom_double_scratch_release(scratch);
+        }
     }
     
     return result;
 }
 
+// Body of an inlined block, run in the enclosing frame. Its locals start
+// out nil every time, as they would in a fresh block context, and boxed
+// ones get a fresh box.
+static ezom_eval_result_t ezom_evaluate_inlined_block(ezom_ast_node_t* block, uint24_t context) {
+    uint8_t first_local = block->data.block.inline_base +
+                          ezom_ast_count_parameters(block->data.block.parameters);
+    uint8_t local_count = ezom_ast_count_locals(block->data.block.locals);
+    for (uint8_t i = 0; i < local_count; i++) {
+        ezom_context_set_local(context, first_local + i, g_nil);
+    }
+    if (block->data.block.vars) {
+        ezom_box_locals(context, block->data.block.vars->boxed, block->data.block.vars->boxed_count);
+    }
+    
+    if (!block->data.block.body) {
+        return ezom_make_result(g_nil);
+    }
+    return ezom_evaluate_ast(block->data.block.body, context);
+}
+
+// to:do: and timesRepeat: over SmallIntegers; answers the receiver
+static ezom_eval_result_t ezom_evaluate_inlined_loop(ezom_ast_node_t* block, uint24_t context,
+                                                     int32_t start, int32_t end, uint24_t receiver) {
+    bool has_index = ezom_ast_count_parameters(block->data.block.parameters) == 1;
+    uint16_t scratch = ezom_double_scratch_mark();
+    
+    for (int32_t i = start; i <= end; i++) {
+        if (has_index) {
+            ezom_context_set_local(context, block->data.block.inline_base, ezom_create_integer(i));
+        }
+        ezom_eval_result_t result = ezom_evaluate_inlined_block(block, context);
+        if (result.is_return || result.is_error) {
+            return result;
+        }
+        ezom_double_scratch_release(scratch);
+        
+        if (i == end) break;  // Do not step past the largest value
+    }
+    
+    return ezom_make_result(receiver);
+}
+
+// [cond] whileTrue: [body] and whileFalse:; any other condition value ends
+// the loop, as in the Block primitives
+static ezom_eval_result_t ezom_evaluate_inlined_while(ezom_ast_node_t* node, uint24_t context) {
+    uint24_t continue_on = node->data.message_send.inline_kind == AST_INLINE_WHILE_TRUE ? g_true : g_false;
+    uint16_t scratch = ezom_double_scratch_mark();
+    
+    while (true) {
+        ezom_eval_result_t result = ezom_evaluate_inlined_block(node->data.message_send.receiver, context);
+        if (result.is_return || result.is_error) {
+            return result;
+        }
+        if (result.value != continue_on) {
+            break;
+        }
+        
+        result = ezom_evaluate_inlined_block(node->data.message_send.arguments, context);
+        if (result.is_return || result.is_error) {
+            return result;
+        }
+        ezom_double_scratch_release(scratch);
+    }
+    
+    return ezom_make_result(g_nil);
+}
+
+// Control-flow send the resolver inlined: branch or loop in this frame
+// when the receiver is a Boolean or SmallInteger, else send it after all
+static ezom_eval_result_t ezom_evaluate_inlined_send(ezom_ast_node_t* node, uint24_t context) {
+    ezom_inline_kind_t kind = (ezom_inline_kind_t)node->data.message_send.inline_kind;
+    ezom_ast_node_t* block = node->data.message_send.arguments;
+    
+    if (kind == AST_INLINE_WHILE_TRUE || kind == AST_INLINE_WHILE_FALSE) {
+        return ezom_evaluate_inlined_while(node, context);
+    }
+    
+    ezom_eval_result_t receiver_result = ezom_evaluate_expression(node->data.message_send.receiver, context);
+    if (receiver_result.is_error) {
+        return receiver_result;
+    }
+    uint24_t receiver = receiver_result.value;
+    
+    switch (kind) {
+        case AST_INLINE_IF_TRUE:
+            if (receiver == g_true) return ezom_evaluate_inlined_block(block, context);
+            if (receiver == g_false) return ezom_make_result(g_nil);
+            break;
+        case AST_INLINE_IF_FALSE:
+            if (receiver == g_false) return ezom_evaluate_inlined_block(block, context);
+            if (receiver == g_true) return ezom_make_result(g_nil);
+            break;
+        case AST_INLINE_IF_TRUE_IF_FALSE:
+            if (receiver == g_true) return ezom_evaluate_inlined_block(block, context);
+            if (receiver == g_false) return ezom_evaluate_inlined_block(block->next, context);
+            break;
+        case AST_INLINE_AND:
+            if (receiver == g_true) return ezom_evaluate_inlined_block(block, context);
+            if (receiver == g_false) return ezom_make_result(g_false);
+            break;
+        case AST_INLINE_OR:
+            if (receiver == g_true) return ezom_make_result(g_true);
+            if (receiver == g_false) return ezom_evaluate_inlined_block(block, context);
+            break;
+        case AST_INLINE_TIMES_REPEAT:
+            if (EZOM_IS_SMALLINT(receiver)) {
+                return ezom_evaluate_inlined_loop(block, context, 1, EZOM_SMALLINT_VALUE(receiver), receiver);
+            }
+            break;
+        case AST_INLINE_TO_DO: {
+            ezom_eval_result_t limit = ezom_evaluate_expression(block, context);
+            if (limit.is_error) {
+                return limit;
+            }
+            if (EZOM_IS_SMALLINT(receiver) && EZOM_IS_SMALLINT(limit.value)) {
+                return ezom_evaluate_inlined_loop(block->next, context, EZOM_SMALLINT_VALUE(receiver),
+                                                  EZOM_SMALLINT_VALUE(limit.value), receiver);
+            }
+            uint24_t args[2] = {limit.value, ezom_create_ast_block(block->next, context)};
+            return ezom_evaluate_site_send(node, receiver, args, 2);
+        }
+        default:
+            break;
+    }
+    
+    // Not a Boolean or SmallInteger: the blocks become closures over this frame
+    uint24_t args[2];
+    uint8_t arg_count = 0;
+    for (; block && arg_count < 2; block = block->next) {
+        args[arg_count++] = ezom_create_ast_block(block, context);
+    }
+    return ezom_evaluate_site_send(node, receiver, args, arg_count);
+}
+
 // Message send evaluation
 ezom_eval_result_t ezom_evaluate_message_send(ezom_ast_node_t* node, uint24_t context) {
     if (!node || node->type != AST_MESSAGE_SEND) {
         return ezom_make_error_result("Invalid message send node");
     }
     
+    if (node->data.message_send.inline_kind != AST_INLINE_NONE) {
+        return ezom_evaluate_inlined_send(node, context);
+    }
+    
     // Evaluate receiver
     ezom_eval_result_t receiver_result = ezom_evaluate_expression(node->data.message_send.receiver, context);
     if (receiver_result.is_error) {
@@ -155,7 +502,7 @@ ezom_eval_result_t ezom_evaluate_message_send(ezom_ast_node_t* node, uint24_t co
     // Handle different message types
     if (node->data.message_send.arg_count == 0) {
         // Unary message
-        return ezom_eval_send_unary_message(receiver, selector, context);
+        return ezom_evaluate_site_send(node, receiver, NULL, 0);
     } else if (strstr(selector, ":") != NULL) {
         // Keyword message (selector contains colon)
         uint24_t arg_values[16]; // Max 16 arguments
@@ -165,14 +512,14 @@ ezom_eval_result_t ezom_evaluate_message_send(ezom_ast_node_t* node, uint24_t co
             return arg_result;
         }
         uint8_t arg_count = (uint8_t)arg_result.value;
-        return ezom_eval_send_keyword_message(receiver, selector, arg_values, arg_count, context);
+        return ezom_evaluate_site_send(node, receiver, arg_values, arg_count);
     } else {
         // Binary message (typically)
         ezom_eval_result_t arg_result = ezom_evaluate_expression(node->data.message_send.arguments, context);
         if (arg_result.is_error) {
             return arg_result;
         }
-        return ezom_eval_send_binary_message(receiver, selector, arg_result.value, context);
+        return ezom_evaluate_site_send(node, receiver, &arg_result.value, 1);
     }
 }
 
@@ -192,34 +539,66 @@ ezom_eval_result_t ezom_evaluate_literal(ezom_ast_node_t* node, uint24_t context
         return ezom_make_error_result("Invalid literal node");
     }
     
-    printf("   Debug: accessing node->data.literal.type...\n");
+    if (!node->data.literal.object) {
+        node->data.literal.object = ezom_literal_object(node);
+        if (!node->data.literal.object) {
+            return ezom_make_error_result("Unknown literal type");
+        }
+    }
+    
+    return ezom_make_result(node->data.literal.object);
+}
+
+// Materialize a literal node as a fixed object in the literal area. Called
+// once per node; ezom_evaluate_literal caches the result on the node.
+uint24_t ezom_literal_object(ezom_ast_node_t* node) {
     switch (node->data.literal.type) {
         case LITERAL_INTEGER:
-            {
-                uint24_t int_obj = ezom_create_integer(node->data.literal.value.integer_value);
-                return ezom_make_result(int_obj);
-            }
+            return ezom_fix_literal(ezom_create_integer(node->data.literal.value.integer_value));
+            
+        case LITERAL_DOUBLE:
+            return ezom_fix_literal(ezom_create_double(node->data.literal.value.double_value));
             
         case LITERAL_STRING:
             {
                 const char* str_val = node->data.literal.value.string_value;
-                uint24_t str_obj = ezom_create_string(str_val, strlen(str_val));
-                return ezom_make_result(str_obj);
+                return ezom_fix_literal(ezom_create_string(str_val, strlen(str_val)));
             }
             
         case LITERAL_SYMBOL:
             {
                 const char* sym_val = node->data.literal.value.symbol_value;
-                uint24_t sym_obj = ezom_create_symbol(sym_val, strlen(sym_val));
-                return ezom_make_result(sym_obj);
+                return ezom_fix_literal(ezom_create_symbol(sym_val, strlen(sym_val)));
             }
             
         case LITERAL_ARRAY:
-            // Arrays would need special handling - simplified for now
-            return ezom_make_result(g_nil);
+            {
+                ezom_ast_node_t* elements = node->data.literal.value.array_elements;
+                uint24_t array_ptr = ezom_create_array(elements->data.statement_list.count);
+                if (!array_ptr) return 0;
+                
+                ezom_array_t* array = (ezom_array_t*)EZOM_OBJECT_PTR(array_ptr);
+                uint16_t i = 0;
+                for (ezom_ast_node_t* e = elements->data.statement_list.statements; e; e = e->next) {
+                    if (!e->data.literal.object) {
+                        e->data.literal.object = ezom_literal_object(e);
+                    }
+                    array->elements[i++] = e->data.literal.object ? e->data.literal.object : g_nil;
+                }
+                return ezom_fix_literal(array_ptr);
+            }
+            
+        case LITERAL_NIL:
+            return g_nil;
+            
+        case LITERAL_TRUE:
+            return g_true;
+            
+        case LITERAL_FALSE:
+            return g_false;
             
         default:
-            return ezom_make_error_result("Unknown literal type");
+            return 0;
     }
 }
 
@@ -272,6 +651,59 @@ ezom_eval_result_t ezom_evaluate_identifier(ezom_ast_node_t* node, uint24_t cont
     return ezom_make_error_result("Undefined variable");
 }
 
+// Frame slot of a resolved variable, or the running closure's copy of it:
+// the box itself for a boxed variable
+static uint24_t ezom_variable_cell(ezom_ast_node_t* var_node, uint24_t context) {
+    if (var_node->data.variable.capture == AST_NO_CAPTURE) {
+        return ezom_context_get_local(context, var_node->data.variable.index);
+    }
+    return ezom_block_capture(ezom_get_context_receiver(context), var_node->data.variable.capture);
+}
+
+// Receiver of the home frame, read directly or from the closure's copy
+static uint24_t ezom_variable_self(ezom_ast_node_t* var_node, uint24_t context) {
+    uint24_t receiver = ezom_get_context_receiver(context);
+    if (var_node->data.variable.capture == AST_NO_CAPTURE) {
+        return receiver;
+    }
+    return ezom_block_capture(receiver, var_node->data.variable.capture);
+}
+
+// Store through a resolved variable reference
+static ezom_eval_result_t ezom_store_variable(ezom_ast_node_t* var_node, uint24_t value, uint24_t context) {
+    switch (var_node->data.variable.kind) {
+        case AST_VAR_CONTEXT: {
+            if (var_node->data.variable.boxed) {
+                ezom_box_set(ezom_variable_cell(var_node, context), ezom_promote_double(value));
+            } else if (var_node->data.variable.capture == AST_NO_CAPTURE) {
+                ezom_context_set_local(context, var_node->data.variable.index, value);
+            } else {
+                return ezom_make_error_result("Cannot assign to a captured copy");
+            }
+            break;
+        }
+        
+        case AST_VAR_INSTANCE: {
+            uint24_t receiver = ezom_variable_self(var_node, context);
+            if (!receiver) {
+                return ezom_make_error_result("No receiver in context");
+            }
+            ezom_set_instance_variable(receiver, var_node->data.variable.index, value);
+            break;
+        }
+        
+        case AST_VAR_GLOBAL:
+            var_node->data.variable.global->value = ezom_promote_double(value);
+            ezom_frame_note_store(0, value);
+            break;
+        
+        default:
+            return ezom_make_error_result("Cannot assign to self");
+    }
+    
+    return ezom_make_result(value);
+}
+
 // Enhanced assignment evaluation with full variable type support
 ezom_eval_result_t ezom_evaluate_assignment(ezom_ast_node_t* node, uint24_t context) {
     if (!node || node->type != AST_ASSIGNMENT) {
@@ -286,10 +718,20 @@ ezom_eval_result_t ezom_evaluate_assignment(ezom_ast_node_t* node, uint24_t cont
         return value_result;
     }
     
+    // Variables outlive the statement: each store keeps a heap copy of a
+    // scratch Double (a frame slot overwrites the one it already owns)
     printf("Assignment value evaluated: 0x%06X\n", value_result.value);
     
     // Handle different variable types
-    if (node->data.assignment.variable->type == AST_VARIABLE_DEF) {
+    if (node->data.assignment.variable->type == AST_VARIABLE_DEF &&
+        node->data.assignment.variable->data.variable.kind != AST_VAR_UNRESOLVED) {
+        // Resolved lexical address
+        ezom_eval_result_t store_result = ezom_store_variable(node->data.assignment.variable,
+                                                              value_result.value, context);
+        if (store_result.is_error) {
+            return store_result;
+        }
+    } else if (node->data.assignment.variable->type == AST_VARIABLE_DEF) {
         // Variable with type information
         ezom_ast_node_t* var_node = node->data.assignment.variable;
         
@@ -331,6 +773,25 @@ ezom_eval_result_t ezom_evaluate_assignment(ezom_ast_node_t* node, uint24_t cont
     return value_result;
 }
 
+// x := x + k (AST_INCREMENT): the variable goes straight to the original
+// send node, whose cache and specialization do the arithmetic
+ezom_eval_result_t ezom_evaluate_increment(ezom_ast_node_t* node, uint24_t context) {
+    ezom_ast_node_t* variable = node->data.assignment.variable;
+    ezom_ast_node_t* send = node->data.assignment.value;
+    
+    ezom_eval_result_t current = ezom_evaluate_variable(variable, context);
+    if (current.is_error) {
+        return current;
+    }
+    
+    uint24_t argument = ezom_literal_object(send->data.message_send.arguments);
+    ezom_eval_result_t result = ezom_evaluate_site_send(send, current.value, &argument, 1);
+    if (result.is_error) {
+        return result;
+    }
+    return ezom_store_variable(variable, result.value, context);
+}
+
 // Return statement evaluation
 ezom_eval_result_t ezom_evaluate_return(ezom_ast_node_t* node, uint24_t context) {
     if (!node || node->type != AST_RETURN) {
@@ -354,8 +815,8 @@ ezom_eval_result_t ezom_evaluate_block_literal(ezom_ast_node_t* node, uint24_t c
         return ezom_make_error_result("Invalid block node");
     }
     
-    // Create block object with current context as outer context
-    uint24_t block_obj = ezom_create_ast_block(node, context);
+    // Closure over the current context, or the shared clean block
+    uint24_t block_obj = ezom_block_literal(node, context);
     return ezom_make_result(block_obj);
 }
 
@@ -367,28 +828,20 @@ ezom_eval_result_t ezom_evaluate_class_definition(ezom_ast_node_t* node, uint24_
     
     printf("Defining class: %s\n", node->data.class_def.name);
     
-    // Determine superclass
-    uint24_t superclass = g_object_class;
+    const char* superclass = NULL;
     if (node->data.class_def.superclass && node->data.class_def.superclass->type == AST_IDENTIFIER) {
-        uint24_t super_obj = ezom_lookup_global(node->data.class_def.superclass->data.identifier.name);
-        if (super_obj != g_nil) {
-            superclass = super_obj;
-        }
+        superclass = node->data.class_def.superclass->data.identifier.name;
     }
     
-    // Count instance variables
     uint16_t instance_var_count = 0;
+    char** var_names = NULL;
     if (node->data.class_def.instance_vars) {
         instance_var_count = ezom_ast_count_locals(node->data.class_def.instance_vars);
+        var_names = node->data.class_def.instance_vars->data.variable_list.names;
     }
     
-    // Create class object with proper inheritance
-    uint24_t class_obj = ezom_create_class_with_inheritance(
-        node->data.class_def.name, 
-        superclass, 
-        instance_var_count
-    );
-    
+    uint24_t class_obj = ezom_define_class(node->data.class_def.name, superclass,
+                                           (const char* const*)var_names, instance_var_count);
     if (!class_obj) {
         return ezom_make_error_result("Failed to create class object");
     }
@@ -411,6 +864,49 @@ ezom_eval_result_t ezom_evaluate_class_definition(ezom_ast_node_t* node, uint24_
     return ezom_make_result(class_obj);
 }
 
+// New class object, before its methods: superclass NULL (or unknown) is
+// Object. Instance variable names are kept so methods resolve them to slots.
+uint24_t ezom_define_class(const char* name, const char* superclass_name,
+                           const char* const* var_names, uint16_t instance_var_count) {
+    // Redefinition: cached lookups for the previous class object are stale
+    uint24_t previous_class = ezom_lookup_global(name);
+    if (previous_class != g_nil && ezom_is_valid_object(previous_class)) {
+        ezom_class_t* previous = (ezom_class_t*)EZOM_OBJECT_PTR(previous_class);
+        ezom_method_cache_flush_class(previous_class);
+        ezom_method_cache_flush_class(previous->header.class_ptr);
+        ezom_dispatch_table_forget_class(previous_class);
+        ezom_dispatch_table_forget_class(previous->header.class_ptr);
+    }
+    
+    // Determine superclass
+    uint24_t superclass = g_object_class;
+    if (superclass_name) {
+        uint24_t super_obj = ezom_lookup_global(superclass_name);
+        if (super_obj != g_nil) {
+            superclass = super_obj;
+        }
+    }
+    
+    // Create class object with proper inheritance
+    uint24_t class_obj = ezom_create_class_with_inheritance(name, superclass, instance_var_count);
+    if (!class_obj) {
+        return 0;
+    }
+    
+    if (instance_var_count > 0) {
+        ezom_class_t* class_struct = (ezom_class_t*)EZOM_OBJECT_PTR(class_obj);
+        class_struct->instance_vars = ezom_create_array(instance_var_count);
+        if (class_struct->instance_vars) {
+            ezom_array_t* names = (ezom_array_t*)EZOM_OBJECT_PTR(class_struct->instance_vars);
+            for (uint16_t i = 0; i < instance_var_count; i++) {
+                names->elements[i] = ezom_create_symbol(var_names[i], strlen(var_names[i]));
+            }
+        }
+    }
+    
+    return class_obj;
+}
+
 // Variable and context management
 uint24_t ezom_lookup_variable(const char* name, uint24_t context) {
     return ezom_context_lookup_variable(context, name);
@@ -424,48 +920,56 @@ bool ezom_set_variable(const char* name, uint24_t value, uint24_t context) {
 uint24_t ezom_lookup_global(const char* name) {
     for (uint16_t i = 0; i < g_global_count; i++) {
         if (strcmp(g_globals[i].name, name) == 0) {
-            return g_globals[i].value;
+            return g_globals[i].value ? g_globals[i].value : g_nil;
         }
     }
     return g_nil;
 }
 
+const char* ezom_global_name(uint24_t value) {
+    for (uint16_t i = 0; i < g_global_count; i++) {
+        if (g_globals[i].value == value) {
+            return g_globals[i].name;
+        }
+    }
+    return NULL;
+}
+
 bool ezom_set_global(const char* name, uint24_t value) {
     printf("     Setting global: %s\n", name);
-    printf("     Current global count: %d\n", g_global_count);
     
-    // Check if already exists
+    ezom_global_t* global = ezom_global_binding(name);
+    if (!global) {
+        return false;
+    }
+    
+    global->value = ezom_promote_double(value);
+    ezom_frame_note_store(0, value);
+    return true;
+}
+
+ezom_global_t* ezom_global_binding(const char* name) {
     for (uint16_t i = 0; i < g_global_count; i++) {
-        printf("     Checking existing global %d\n", i);
-        if (!g_globals[i].name) {
-            printf("     ERROR: global %d has NULL name!\n", i);
-            continue;
-        }
         if (strcmp(g_globals[i].name, name) == 0) {
-            printf("     Updated existing\n");
-            g_globals[i].value = value;
-            return true;
+            return &g_globals[i];
         }
     }
     
-    printf("     After loop check\n");
+    if (g_global_count >= MAX_GLOBALS) {
+        printf("     ERROR: Too many globals!\n");
+        return NULL;
+    }
     
-    // Add new global
-    if (g_global_count < MAX_GLOBALS) {
-        printf("     Adding new global\n");
-        g_globals[g_global_count].name = strdup(name);
-        if (!g_globals[g_global_count].name) {
-            printf("     ERROR: strdup failed!\n");
-            return false;
-        }
-        g_globals[g_global_count].value = value;
-        g_global_count++;
-        printf("     Success\n");
-        return true;
+    char* copy = strdup(name);
+    if (!copy) {
+        printf("     ERROR: strdup failed!\n");
+        return NULL;
     }
     
-    printf("     ERROR: Too many globals!\n");
-    return false;
+    printf("     Adding new global %d: %s\n", g_global_count, name);
+    g_globals[g_global_count].name = copy;
+    g_globals[g_global_count].value = 0;
+    return &g_globals[g_global_count++];
 }
 
 // Message dispatch support
@@ -486,44 +990,31 @@ ezom_eval_result_t ezom_eval_send_message(uint24_t receiver, const char* selecto
     // Create selector symbol and dispatch message using existing system
     uint24_t selector_sym = ezom_create_symbol(selector, strlen(selector));
     
-    if (arg_count == 0) {
-        uint24_t result = ezom_send_unary_message(receiver, selector_sym);
-        return ezom_make_result(result);
-    } else if (arg_count == 1) {
-        uint24_t result = ezom_send_binary_message(receiver, selector_sym, arg_values[0]);
-        return ezom_make_result(result);
-    } else {
-        // Multi-argument messages would need enhanced dispatch system
-        return ezom_make_result(g_nil);
+    switch (arg_count) {
+        case 0:  return ezom_make_result(ezom_send0(receiver, selector_sym));
+        case 1:  return ezom_make_result(ezom_send1(receiver, selector_sym, arg_values[0]));
+        case 2:  return ezom_make_result(ezom_send2(receiver, selector_sym, arg_values[0], arg_values[1]));
+        default: return ezom_make_result(ezom_sendN(receiver, selector_sym, arg_values, arg_count));
     }
 }
 
 ezom_eval_result_t ezom_eval_send_unary_message(uint24_t receiver, const char* selector, uint24_t context) {
     uint24_t selector_sym = ezom_create_symbol(selector, strlen(selector));
-    uint24_t result = ezom_send_unary_message(receiver, selector_sym);
+    uint24_t result = ezom_send0(receiver, selector_sym);
     return ezom_make_result(result);
 }
 
 ezom_eval_result_t ezom_eval_send_binary_message(uint24_t receiver, const char* selector, 
                                                 uint24_t argument, uint24_t context) {
     uint24_t selector_sym = ezom_create_symbol(selector, strlen(selector));
-    uint24_t result = ezom_send_binary_message(receiver, selector_sym, argument);
+    uint24_t result = ezom_send1(receiver, selector_sym, argument);
     return ezom_make_result(result);
 }
 
 ezom_eval_result_t ezom_eval_send_keyword_message(uint24_t receiver, const char* selector, 
                                                  uint24_t* arguments, uint8_t arg_count, uint24_t context) {
     uint24_t selector_sym = ezom_create_symbol(selector, strlen(selector));
-    
-    // Create message structure for keyword message
-    ezom_message_t msg = {
-        .selector = selector_sym,
-        .receiver = receiver,
-        .args = arguments,
-        .arg_count = arg_count
-    };
-    
-    uint24_t result = ezom_send_message(&msg);
+    uint24_t result = ezom_sendN(receiver, selector_sym, arguments, arg_count);
     return ezom_make_result(result);
 }
 
@@ -604,7 +1095,7 @@ ezom_eval_result_t ezom_evaluate_while_true(uint24_t condition_block, uint24_t b
 
 // Runtime instance variable access functions
 uint24_t ezom_get_instance_variable(uint24_t object_ptr, uint16_t index) {
-    if (!object_ptr) {
+    if (!object_ptr || EZOM_IS_SMALLINT(object_ptr)) {
         return g_nil;
     }
     
@@ -617,7 +1108,7 @@ uint24_t ezom_get_instance_variable(uint24_t object_ptr, uint16_t index) {
 }
 
 void ezom_set_instance_variable(uint24_t object_ptr, uint16_t index, uint24_t value) {
-    if (!object_ptr) {
+    if (!object_ptr || EZOM_IS_SMALLINT(object_ptr)) {
         return;
     }
     
@@ -626,7 +1117,8 @@ void ezom_set_instance_variable(uint24_t object_ptr, uint16_t index, uint24_t va
     uint24_t* instance_vars = (uint24_t*)((char*)obj + sizeof(ezom_object_t));
     
     // TODO: Add bounds checking based on class definition
-    instance_vars[index] = value;
+    instance_vars[index] = ezom_promote_double(value);
+    ezom_frame_note_store(0, value);
 }
 
 // Instance variable access and assignment
@@ -677,7 +1169,6 @@ ezom_eval_result_t ezom_make_result(uint24_t value) {
     result.value = value;
     result.is_return = false;
     result.is_error = false;
-    result.error_msg[0] = '\0';
     return result;
 }
 
@@ -686,17 +1177,28 @@ ezom_eval_result_t ezom_make_return_result(uint24_t value) {
     result.value = value;
     result.is_return = true;
     result.is_error = false;
-    result.error_msg[0] = '\0';
     return result;
 }
 
 ezom_eval_result_t ezom_make_error_result(const char* message) {
+    strncpy(g_eval_error.message, message, sizeof(g_eval_error.message) - 1);
+    g_eval_error.message[sizeof(g_eval_error.message) - 1] = '\0';
+    g_eval_error.count++;
+    
     ezom_eval_result_t result;
     result.value = g_nil;
     result.is_return = false;
     result.is_error = true;
-    strncpy(result.error_msg, message, sizeof(result.error_msg) - 1);
-    result.error_msg[sizeof(result.error_msg) - 1] = '\0';
+    return result;
+}
+
+// Stops evaluation like an error; the value waits in
+// g_frame_stack.return_value until the home method or handler is reached
+ezom_eval_result_t ezom_make_unwind_result(void) {
+    ezom_eval_result_t result;
+    result.value = g_nil;
+    result.is_return = true;
+    result.is_error = true;
     return result;
 }
 
@@ -742,6 +1244,11 @@ uint24_t ezom_create_class_with_inheritance(const char* name, uint24_t superclas
     // Initialize as class object
     ezom_init_object(class_ptr, g_class_class ? g_class_class : g_object_class, EZOM_TYPE_CLASS);
     
+    // Subclasses of Exception answer new, signal and signal: too
+    if (superclass && g_exception_metaclass && ezom_class_of(superclass) == g_exception_metaclass) {
+        ((ezom_object_t*)EZOM_OBJECT_PTR(class_ptr))->class_ptr = g_exception_metaclass;
+    }
+    
     ezom_class_t* class_obj = (ezom_class_t*)EZOM_OBJECT_PTR(class_ptr);
     class_obj->superclass = superclass;
     class_obj->method_dict = ezom_create_method_dictionary(16);
@@ -782,31 +1289,19 @@ void ezom_install_method_in_class(uint24_t class_ptr, const char* selector, uint
     ezom_method_dict_t* dict = (ezom_method_dict_t*)EZOM_OBJECT_PTR(class_obj->method_dict);
     if (!dict) return;
     
-    // Check if method already exists (override)
     uint24_t selector_symbol = ezom_create_symbol(selector, strlen(selector));
+    if (!selector_symbol) return;
     
-    for (uint16_t i = 0; i < dict->size; i++) {
-        if (dict->methods[i].selector == selector_symbol) {
-            // Override existing method
-            dict->methods[i].code = code;
-            dict->methods[i].arg_count = arg_count;
-            dict->methods[i].flags = is_primitive ? EZOM_METHOD_PRIMITIVE : 0;
-            return;
-        }
-    }
-    
-    // Add new method
-    if (dict->size >= dict->capacity) {
-        printf("Warning: Method dictionary full for class 0x%06X\n", class_ptr);
+    // Adds or overrides; the dictionary grows as needed
+    if (!ezom_method_dict_put(dict, selector_symbol, code, arg_count,
+                              is_primitive ? EZOM_METHOD_PRIMITIVE : 0)) {
+        printf("Error: Could not install method '%s' in class 0x%06X\n", selector, class_ptr);
         return;
     }
     
-    ezom_method_t* method = &dict->methods[dict->size];
-    method->selector = selector_symbol;
-    method->code = code;
-    method->arg_count = arg_count;
-    method->flags = is_primitive ? EZOM_METHOD_PRIMITIVE : 0;
-    dict->size++;
+    // Method may shadow an inherited one (or satisfy a cached miss)
+    ezom_method_cache_flush_selector(selector_symbol);
+    ezom_class_changed(class_ptr);
     
     printf("Installed method '%s' in class 0x%06X\n", selector, class_ptr);
 }
@@ -818,7 +1313,8 @@ void ezom_install_methods_from_ast(uint24_t class_ptr, ezom_ast_node_t* method_l
     ezom_ast_node_t* current = method_list->data.statement_list.statements;
     while (current) {
         if (current->type == AST_METHOD_DEF) {
-            // Compile method from AST
+            // Bind variable references, then compile method from AST
+            ezom_resolve_method(current, is_class_method ? 0 : class_ptr);
             uint24_t method_code = ezom_compile_method_from_ast(current);
             if (method_code) {
                 uint8_t arg_count = ezom_ast_count_parameters(current->data.method_def.parameters);
@@ -828,6 +1324,62 @@ void ezom_install_methods_from_ast(uint24_t class_ptr, ezom_ast_node_t* method_l
         }
         current = current->next;
     }
+    
+    // Class is complete: build its dispatch table row
+    ezom_dispatch_table_finalize_class(class_ptr);
+}
+
+// A resolved read of one of the method's own variables of this kind
+static bool ezom_trivial_variable(ezom_ast_node_t* node, uint8_t kind) {
+    return node && node->type == AST_VARIABLE_DEF && node->data.variable.kind == kind &&
+           node->data.variable.capture == AST_NO_CAPTURE && !node->data.variable.boxed;
+}
+
+// Which ezom_trivial_kind_t the method is; value gets the slot, argument
+// index or literal object it runs on
+static uint8_t ezom_classify_trivial(ezom_ast_node_t* method_ast, uint8_t param_count, uint24_t* value) {
+    ezom_ast_node_t* body = method_ast->data.method_def.body;
+    if (!body) return EZOM_TRIVIAL_SELF;
+    if (body->type != AST_STATEMENT_LIST) return EZOM_TRIVIAL_NONE;
+    
+    ezom_ast_node_t* first = body->data.statement_list.statements;
+    if (!first) return EZOM_TRIVIAL_SELF;
+    
+    if (first->type == AST_RETURN && !first->next) {
+        ezom_ast_node_t* expression = first->data.return_stmt.expression;
+        if (ezom_trivial_variable(expression, AST_VAR_SELF)) {
+            return EZOM_TRIVIAL_SELF;
+        }
+        if (ezom_trivial_variable(expression, AST_VAR_INSTANCE)) {
+            *value = expression->data.variable.index;
+            return EZOM_TRIVIAL_GETTER;
+        }
+        if (ezom_trivial_variable(expression, AST_VAR_CONTEXT) && expression->data.variable.index < param_count) {
+            *value = expression->data.variable.index;
+            return EZOM_TRIVIAL_ARGUMENT;
+        }
+        if (expression && expression->type == AST_LITERAL) {
+            if (!expression->data.literal.object) {
+                expression->data.literal.object = ezom_literal_object(expression);
+            }
+            *value = expression->data.literal.object;
+            return *value ? EZOM_TRIVIAL_LITERAL : EZOM_TRIVIAL_NONE;
+        }
+        return EZOM_TRIVIAL_NONE;
+    }
+    
+    // ivar := arg, alone or followed by ^self
+    ezom_ast_node_t* rest = first->next;
+    if (first->type == AST_ASSIGNMENT && param_count == 1 &&
+        ezom_trivial_variable(first->data.assignment.variable, AST_VAR_INSTANCE) &&
+        ezom_trivial_variable(first->data.assignment.value, AST_VAR_CONTEXT) &&
+        first->data.assignment.value->data.variable.index == 0 &&
+        (!rest || (rest->type == AST_RETURN && !rest->next &&
+                   ezom_trivial_variable(rest->data.return_stmt.expression, AST_VAR_SELF)))) {
+        *value = first->data.assignment.variable->data.variable.index;
+        return EZOM_TRIVIAL_SETTER;
+    }
+    return EZOM_TRIVIAL_NONE;
 }
 
 uint24_t ezom_compile_method_from_ast(ezom_ast_node_t* method_ast) {
@@ -855,16 +1407,38 @@ uint24_t ezom_compile_method_from_ast(ezom_ast_node_t* method_ast) {
     ezom_method_code_t* method_code = (ezom_method_code_t*)EZOM_OBJECT_PTR(method_code_ptr);
     
     // Store method compilation data
-    method_code->ast_node = (uint24_t)method_ast; // Store AST for now
+    method_code->ast_node = method_ast;
     method_code->param_count = ezom_ast_count_parameters(method_ast->data.method_def.parameters);
-    method_code->local_count = ezom_ast_count_locals(method_ast->data.method_def.locals);
+    method_code->local_count = ezom_ast_count_locals(method_ast->data.method_def.locals) +
+                               method_ast->data.method_def.inlined_slots;
     method_code->is_primitive = method_ast->data.method_def.is_primitive;
     method_code->primitive_number = method_ast->data.method_def.primitive_number;
+    method_code->trivial = EZOM_TRIVIAL_NONE;
+    method_code->trivial_value = 0;
+#ifdef EZOM_JIT
+    method_code->jit_counter = 0;
+    method_code->jit = NULL;
+    method_code->jit_region = 0;
+#endif
+#ifdef EZOM_AOT
+    method_code->aot = NULL;
+#endif
     
     printf("  Parameters: %d, Locals: %d\n", method_code->param_count, method_code->local_count);
     
-    // In a full implementation, we would compile the method body to bytecode here
-    // For now, we'll evaluate the AST at runtime
+    // Fold constants, drop dead code and so on before any engine sees the tree
+    if (!method_code->is_primitive) {
+        ezom_optimize_method(method_ast);
+    }
+    
+    // Accessors and constant methods run on the receiver without a frame
+    if (!method_code->is_primitive) {
+        method_code->trivial = ezom_classify_trivial(method_ast, method_code->param_count,
+                                                     &method_code->trivial_value);
+    }
+    
+    // Compile the body to bytecode; NULL leaves it to the AST evaluator
+    method_code->bytecode = method_code->is_primitive ? NULL : ezom_compile_method(method_ast);
     
     printf("Method compiled successfully at 0x%06X\n", method_code_ptr);
     return method_code_ptr;
@@ -883,11 +1457,7 @@ ezom_eval_result_t ezom_evaluate_unary_message(ezom_ast_node_t* node, uint24_t c
     }
     
     // Send the unary message
-    uint24_t selector = ezom_create_symbol(node->data.message_send.selector, 
-                                         strlen(node->data.message_send.selector));
-    uint24_t result = ezom_send_unary_message(receiver_result.value, selector);
-    
-    return ezom_make_result(result);
+    return ezom_evaluate_site_send(node, receiver_result.value, NULL, 0);
 }
 
 ezom_eval_result_t ezom_evaluate_binary_message(ezom_ast_node_t* node, uint24_t context) {
@@ -908,11 +1478,7 @@ ezom_eval_result_t ezom_evaluate_binary_message(ezom_ast_node_t* node, uint24_t
     }
     
     // Send the binary message
-    uint24_t selector = ezom_create_symbol(node->data.message_send.selector, 
-                                         strlen(node->data.message_send.selector));
-    uint24_t result = ezom_send_binary_message(receiver_result.value, selector, arg_result.value);
-    
-    return ezom_make_result(result);
+    return ezom_evaluate_site_send(node, receiver_result.value, &arg_result.value, 1);
 }
 
 ezom_eval_result_t ezom_evaluate_keyword_message(ezom_ast_node_t* node, uint24_t context) {
@@ -926,10 +1492,6 @@ ezom_eval_result_t ezom_evaluate_keyword_message(ezom_ast_node_t* node, uint24_t
         return receiver_result;
     }
     
-    // For keyword messages, the selector is already built in the parser
-    uint24_t selector = ezom_create_symbol(node->data.message_send.selector, 
-                                         strlen(node->data.message_send.selector));
-    
     // Evaluate arguments
     uint24_t args[16]; // Maximum 16 arguments
     uint8_t arg_count = 0;
@@ -944,17 +1506,8 @@ ezom_eval_result_t ezom_evaluate_keyword_message(ezom_ast_node_t* node, uint24_t
         current_arg = current_arg->next;
     }
     
-    // Create message and send it
-    ezom_message_t message = {
-        .receiver = receiver_result.value,
-        .selector = selector,
-        .args = args,
-        .arg_count = arg_count
-    };
-    
-    uint24_t result = ezom_send_message(&message);
-    
-    return ezom_make_result(result);
+    // For keyword messages, the selector is already built in the parser
+    return ezom_evaluate_site_send(node, receiver_result.value, args, arg_count);
 }
 
 // Variable evaluation (instance variables, locals, parameters)
@@ -963,6 +1516,37 @@ ezom_eval_result_t ezom_evaluate_variable(ezom_ast_node_t* node, uint24_t contex
         return ezom_make_result(g_nil);
     }
     
+    // Resolved references: pointer chasing only
+    switch (node->data.variable.kind) {
+        case AST_VAR_CONTEXT: {
+            uint24_t value = ezom_variable_cell(node, context);
+            return ezom_make_result(node->data.variable.boxed ? ezom_box_get(value) : value);
+        }
+        
+        case AST_VAR_INSTANCE: {
+            uint24_t self_ptr = ezom_variable_self(node, context);
+            if (!self_ptr) {
+                return ezom_make_error_result("No receiver in context");
+            }
+            return ezom_make_result(ezom_get_instance_variable(self_ptr, node->data.variable.index));
+        }
+        
+        case AST_VAR_SELF: {
+            uint24_t self_ptr = ezom_variable_self(node, context);
+            return ezom_make_result(self_ptr ? self_ptr : g_nil);
+        }
+        
+        case AST_VAR_GLOBAL:
+            if (!node->data.variable.global->value) {
+                printf("   Debug: Undefined variable: '%s'\n", node->data.variable.name);
+                return ezom_make_error_result("Undefined variable");
+            }
+            return ezom_make_result(node->data.variable.global->value);
+        
+        default:
+            break;
+    }
+    
     if (node->data.variable.is_instance_var) {
         // Access instance variable
         uint24_t self_ptr = ezom_get_context_receiver(context);
@@ -1004,37 +1588,104 @@ ezom_eval_result_t ezom_execute_compiled_method(uint24_t method_code_ptr, uint24
         return ezom_execute_primitive_method(method_code->primitive_number, receiver, args, arg_count);
     }
     
-    // Create execution context for the method
-    uint24_t method_context = ezom_create_enhanced_method_context(receiver, method_code, args, arg_count);
-    if (!method_context) {
-        return ezom_make_error_result("Failed to create method context");
+    if (method_code->trivial) {
+        return ezom_make_result(ezom_run_trivial_method(method_code, receiver, args));
     }
     
-    // Execute the method AST
+#ifdef EZOM_AOT
+    // Translated to C ahead of time: no AST to run
+    if (method_code->aot) {
+        return ezom_aot_run(method_code, receiver, args);
+    }
+#endif
+    
     ezom_ast_node_t* method_ast = (ezom_ast_node_t*)method_code->ast_node;
     if (!method_ast || method_ast->type != AST_METHOD_DEF) {
         return ezom_make_error_result("Invalid method AST");
     }
     
-    // Evaluate the method body
-    ezom_eval_result_t result = ezom_evaluate_method_body(method_ast->data.method_def.body, method_context);
+    // Evaluation recurses on the C stack from here
+    if (!ezom_frame_enter_native()) {
+        return ezom_make_error_result("Stack overflow");
+    }
     
-    // Clean up context (in full implementation)
-    // ezom_destroy_context(method_context);
+    // Create execution context for the method
+    uint24_t method_context = ezom_create_enhanced_method_context(receiver, method_code, args, arg_count);
+    if (!method_context) {
+        ezom_frame_leave_native();
+        return ezom_make_error_result("Stack overflow");
+    }
     
+    // Run the body as machine code once it is hot, else on the selected engine
+    ezom_eval_result_t result;
+#ifdef EZOM_JIT
+    ezom_jit_method_t* jit = ezom_jit_method_for(method_code, receiver);
+    if (jit) {
+        result = ezom_jit_run(jit, method_code, receiver, method_context);
+    } else
+#endif
+    if (g_engine == EZOM_ENGINE_BYTECODE && method_code->bytecode) {
+        uint24_t old_context = g_current_context;
+        g_current_context = method_context;
+        result = ezom_interpret((ezom_code_t*)method_code->bytecode, method_context);
+        g_current_context = old_context;
+    } else {
+        ezom_box_locals(method_context, method_ast->data.method_def.boxed,
+                        method_ast->data.method_def.boxed_count);
+        result = ezom_evaluate_method_body(method_ast->data.method_def.body, method_context);
+    }
+    
+    // A method without ^ answers self. A ^ in one of its blocks unwinds
+    // to here; any other home, or an exception handler, is further out.
+    if (ezom_frame_is_return_home(method_context)) {
+        result = ezom_make_result(ezom_frame_finish_return());
+    } else if (g_frame_stack.returning || g_frame_stack.raising) {
+        result = ezom_make_unwind_result();
+    } else {
+        if (!result.is_error && !result.is_return) {
+            result.value = receiver;
+        }
+        result.is_return = false;
+    }
+    
+    ezom_pop_frame(method_context, result.value);
+    ezom_frame_leave_native();
     return result;
 }
 
-// Create a method execution context with proper parameter and local variable binding
+// Accessors and constant methods: the answer straight from the receiver's
+// slots, the arguments or the literal, with no frame
+uint24_t ezom_run_trivial_method(ezom_method_code_t* method_code, uint24_t receiver, uint24_t* args) {
+    g_frame_stack.trivial++;
+    switch (method_code->trivial) {
+        case EZOM_TRIVIAL_GETTER:
+            return ezom_get_instance_variable(receiver, method_code->trivial_value);
+        case EZOM_TRIVIAL_SETTER:
+            ezom_set_instance_variable(receiver, method_code->trivial_value, args[0]);
+            return receiver;
+        case EZOM_TRIVIAL_LITERAL:
+            return method_code->trivial_value;
+        case EZOM_TRIVIAL_ARGUMENT:
+            // As if bound to a parameter slot first
+            return ezom_promote_double(args[method_code->trivial_value]);
+        default:
+            return receiver;
+    }
+}
+
+// Create a method execution context with proper parameter and local variable binding.
+// It is pushed on the frame stack; the caller pops it with ezom_pop_frame.
 uint24_t ezom_create_enhanced_method_context(uint24_t receiver, ezom_method_code_t* method_code, 
                                            uint24_t* args, uint8_t arg_count) {
-    // Create context with space for parameters and locals
+    // Create context with space for parameters and locals. Variables
+    // resolve within the method, so it has no outer context.
     uint8_t total_vars = method_code->param_count + method_code->local_count;
-    uint24_t context = ezom_create_extended_context(g_current_context, receiver, 0, total_vars);
+    uint24_t context = ezom_push_frame(0, receiver, total_vars);
     
     if (!context) {
         return 0;
     }
+    ((ezom_context_t*)EZOM_OBJECT_PTR(context))->method = EZOM_OBJECT_ADDR(method_code);
     
     // Bind parameters to the context
     for (uint8_t i = 0; i < method_code->param_count && i < arg_count; i++) {
@@ -1131,8 +1782,7 @@ uint16_t ezom_get_instance_variable_index(uint24_t object_ptr, const char* name)
     }
     
     // Get the object's class
-    ezom_object_t* obj = (ezom_object_t*)EZOM_OBJECT_PTR(object_ptr);
-    uint24_t class_ptr = obj->class_ptr;
+    uint24_t class_ptr = ezom_class_of(object_ptr);
     
     if (!class_ptr) {
         return UINT16_MAX;
@@ -1148,8 +1798,24 @@ uint16_t ezom_find_instance_variable_index_in_class(uint24_t class_ptr, const ch
         return UINT16_MAX;
     }
     
-    // This is a placeholder - in a full implementation,
-    // we would store instance variable names in the class
-    // For now, we'll return UINT16_MAX (not found)
-    return UINT16_MAX; // TODO: Implement proper instance variable lookup
+    // Each class names its own variables, which follow its superclass's
+    // in the instance layout
+    size_t name_length = strlen(name);
+    while (class_ptr) {
+        ezom_class_t* class_obj = (ezom_class_t*)EZOM_OBJECT_PTR(class_ptr);
+        if (class_obj->instance_vars) {
+            ezom_array_t* names = (ezom_array_t*)EZOM_OBJECT_PTR(class_obj->instance_vars);
+            uint16_t first_slot = (class_obj->instance_size - sizeof(ezom_object_t)) / sizeof(uint24_t)
+                                  - class_obj->instance_var_count;
+            for (uint16_t i = 0; i < names->size; i++) {
+                ezom_symbol_t* symbol = (ezom_symbol_t*)EZOM_OBJECT_PTR(names->elements[i]);
+                if (symbol->length == name_length && memcmp(symbol->data, name, name_length) == 0) {
+                    return first_slot + i;
+                }
+            }
+        }
+        class_ptr = class_obj->superclass;
+    }
+    
+    return UINT16_MAX;
 }
\ No newline at end of file
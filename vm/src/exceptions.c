@@ -0,0 +1,130 @@
+// ============================================================================
+// File: src/exceptions.c
+// Exception classes, handlers and signaling
+// ============================================================================
+
+#include "../include/ezom_exceptions.h"
+#include "../include/ezom_memory.h"
+#include "../include/ezom_primitives.h"
+#include "../include/ezom_dispatch.h"
+#include "../include/ezom_context.h"
+#include "../include/ezom_evaluator.h"
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+
+uint24_t g_exception_class = 0;
+uint24_t g_error_class = 0;
+uint24_t g_exception_metaclass = 0;
+
+// Newest handler record (on the frame stack)
+static ezom_handler_t* g_handlers = NULL;
+
+uint24_t ezom_create_exception(uint24_t class_ptr, uint24_t message_text) {
+    uint24_t exception = ezom_create_instance(class_ptr);
+    if (!exception) return 0;
+
+    // Fields of a SOM subclass start out nil too
+    ezom_class_t* class_obj = (ezom_class_t*)EZOM_OBJECT_PTR(class_ptr);
+    uint16_t fields = (class_obj->instance_size - sizeof(ezom_object_t)) / sizeof(uint24_t);
+    for (uint16_t i = 0; i < fields; i++) {
+        ezom_set_instance_variable(exception, i, g_nil);
+    }
+    ezom_set_instance_variable(exception, 0, message_text);
+    return exception;
+}
+
+static bool ezom_class_inherits(uint24_t class_ptr, uint24_t ancestor) {
+    while (class_ptr) {
+        if (class_ptr == ancestor) return true;
+        class_ptr = ((ezom_class_t*)EZOM_OBJECT_PTR(class_ptr))->superclass;
+    }
+    return false;
+}
+
+static ezom_handler_t* ezom_find_handler(uint24_t class_ptr) {
+    for (ezom_handler_t* handler = g_handlers; handler; handler = handler->previous) {
+        if (!handler->disabled && ezom_class_inherits(class_ptr, handler->exception_class)) {
+            return handler;
+        }
+    }
+    return NULL;
+}
+
+bool ezom_exception_signal(uint24_t exception) {
+    ezom_handler_t* found = ezom_find_handler(ezom_class_of(exception));
+    if (!found) return false;
+
+    // A signal from the handler block looks further out
+    for (ezom_handler_t* handler = g_handlers; handler != found->previous; handler = handler->previous) {
+        handler->disabled++;
+    }
+    ezom_block_t* block = (ezom_block_t*)EZOM_OBJECT_PTR(found->block);
+    uint24_t value = ezom_block_evaluate(found->block, &exception, block->param_count ? 1 : 0);
+    for (ezom_handler_t* handler = g_handlers; handler != found->previous; handler = handler->previous) {
+        handler->disabled--;
+    }
+
+    // A ^ in the handler block, or an overflow, unwinds instead
+    if (EZOM_FRAME_UNWINDING()) return true;
+
+    g_frame_stack.raising = true;
+    g_frame_stack.raise_handler = EZOM_OBJECT_ADDR(found);
+    g_frame_stack.return_value = ezom_promote_double(value);
+    return true;
+}
+
+void ezom_primitive_failed(const char* format, ...) {
+    char message[128];
+    va_list args;
+    va_start(args, format);
+    int length = vsnprintf(message, sizeof(message), format, args);
+    va_end(args);
+    if (length < 0) return;
+    if (length >= (int)sizeof(message)) length = sizeof(message) - 1;
+
+    printf("%s\n", message);
+
+    // The Error is only made when something may handle it
+    if (!g_handlers || EZOM_FRAME_UNWINDING() || !ezom_find_handler(g_error_class)) return;
+    uint24_t text = ezom_create_string(message, (uint16_t)length);
+    uint24_t exception = ezom_create_exception(g_error_class, text ? text : g_nil);
+    if (exception) {
+        ezom_exception_signal(exception);
+    }
+}
+
+uint24_t ezom_exception_on_do(uint24_t block, uint24_t exception_class, uint24_t handler_block) {
+    ezom_handler_t* handler = (ezom_handler_t*)ezom_frame_reserve(sizeof(ezom_handler_t));
+    if (!handler) return g_nil;
+
+    handler->previous = g_handlers;
+    handler->exception_class = exception_class;
+    handler->block = handler_block;
+    handler->disabled = 0;
+    g_handlers = handler;
+
+    uint24_t result = ezom_block_evaluate(block, NULL, 0);
+
+    g_handlers = handler->previous;
+    if (g_frame_stack.raising && g_frame_stack.raise_handler == EZOM_OBJECT_ADDR(handler)) {
+        g_frame_stack.raising = false;
+        result = g_frame_stack.return_value;
+    }
+    ezom_frame_release(handler);
+    return result;
+}
+
+// After a stack overflow the cleanup block gets no further than its first send
+uint24_t ezom_exception_ensure(uint24_t block, uint24_t cleanup_block, bool only_if_curtailed) {
+    uint24_t result = ezom_block_evaluate(block, NULL, 0);
+
+    bool curtailed = EZOM_FRAME_UNWINDING();
+    if (curtailed || !only_if_curtailed) {
+        ezom_unwind_state_t unwind;
+        ezom_frame_suspend_unwind(&unwind);
+        ezom_block_evaluate(cleanup_block, NULL, 0);
+        ezom_frame_resume_unwind(&unwind);
+    }
+    return result;
+}
@@ -10,7 +10,13 @@
 #include "../include/ezom_parser.h"
 #include "../include/ezom_evaluator.h"
 #include "../include/ezom_context.h"
+#include "../include/ezom_dispatch.h"
 #include "../include/ezom_ast_memory.h"
+#include "../include/ezom_resolver.h"
+#include "../include/ezom_bytecode.h"
+#ifdef EZOM_JIT
+#include "../include/ezom_jit.h"
+#endif
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -121,6 +127,9 @@ ezom_file_result_t ezom_parse_file(ezom_file_context_t* context) {
         return EZOM_FILE_PARSE_ERROR;
     }
     
+    // Bind variable references to their lexical addresses
+    context->program_slots = ezom_resolve_program(ast);
+    
     context->program_ast = ast;
     printf("Parsed program successfully\n");
     return EZOM_FILE_OK;
@@ -131,16 +140,16 @@ ezom_file_result_t ezom_evaluate_file(ezom_file_context_t* context) {
         return EZOM_FILE_EVAL_ERROR;
     }
     
-    // Create evaluation context
-    uint24_t eval_context = ezom_create_extended_context(0, 0, 0, 10);
+    // Create evaluation context, with slots for inlined blocks' variables
+    uint24_t eval_context = ezom_create_extended_context(0, 0, 0, context->program_slots);
     if (!eval_context) {
         return EZOM_FILE_MEMORY_ERROR;
     }
     
-    // Evaluate the program AST
-    ezom_eval_result_t result = ezom_evaluate_ast(context->program_ast, eval_context);
+    // Run the program on the selected engine
+    ezom_eval_result_t result = ezom_run_program(context->program_ast, eval_context);
     if (result.is_error) {
-        printf("Evaluation error: %s\n", result.error_msg ? result.error_msg : "Unknown error");
+        printf("Evaluation error: %s\n", g_eval_error.message);
         return EZOM_FILE_EVAL_ERROR;
     }
     
@@ -162,11 +171,63 @@ void ezom_free_file_context(ezom_file_context_t* context) {
     memset(context, 0, sizeof(ezom_file_context_t));
 }
 
+// A class file starts "Name = Superclass (", which no program does
+bool ezom_is_class_source(char* source) {
+    ezom_lexer_t lexer;
+    ezom_parser_t parser;
+    ezom_lexer_init(&lexer, source);
+    ezom_parser_init(&parser, &lexer);
+    if (ezom_parser_check(&parser, TOKEN_NEWLINE)) {
+        ezom_parser_advance(&parser);
+    }
+    
+    if (!ezom_parser_match(&parser, TOKEN_IDENTIFIER) || !ezom_parser_match(&parser, TOKEN_EQUALS)) {
+        return false;
+    }
+    return ezom_parser_match(&parser, TOKEN_IDENTIFIER) && ezom_parser_check(&parser, TOKEN_LPAREN);
+}
+
+// Define every class in the file, then send run to a new instance of
+// main_class (NULL = the last one defined), as a translated program does
+ezom_file_result_t ezom_run_som_classes(ezom_file_context_t* context, const char* main_class) {
+    ezom_lexer_init(&context->lexer, context->source_code);
+    ezom_parser_init(&context->parser, &context->lexer);
+    
+    char last_class[256] = "";
+    while (true) {
+        if (ezom_parser_check(&context->parser, TOKEN_NEWLINE)) {
+            ezom_parser_advance(&context->parser);
+        }
+        if (ezom_parser_check(&context->parser, TOKEN_EOF)) break;
+        
+        ezom_ast_node_t* class_ast = ezom_parse_class_definition(&context->parser);
+        if (!class_ast || context->parser.has_error) {
+            return EZOM_FILE_PARSE_ERROR;
+        }
+        if (ezom_evaluate_class_definition(class_ast, 0).is_error) {
+            printf("Evaluation error: %s\n", g_eval_error.message);
+            return EZOM_FILE_EVAL_ERROR;
+        }
+        snprintf(last_class, sizeof(last_class), "%s", class_ast->data.class_def.name);
+    }
+    
+    const char* name = main_class ? main_class : last_class;
+    uint24_t class_ptr = ezom_lookup_global(name);
+    if (!name[0] || class_ptr == g_nil) {
+        printf("No class %s to run\n", name[0] ? name : "in file");
+        return EZOM_FILE_EVAL_ERROR;
+    }
+    
+    uint24_t instance = ezom_create_instance(class_ptr);
+    context->result_value = instance ? ezom_send0(instance, ezom_create_symbol("run", 3)) : 0;
+    return context->result_value ? EZOM_FILE_OK : EZOM_FILE_EVAL_ERROR;
+}
+
 // ============================================================================
 // High-Level Program Execution
 // ============================================================================
 
-ezom_file_result_t ezom_execute_som_file(const char* filename, uint24_t* result) {
+ezom_file_result_t ezom_execute_som_file(const char* filename, const char* main_class, uint24_t* result) {
     ezom_file_context_t context;
     ezom_file_result_t status;
     
@@ -176,6 +237,16 @@ ezom_file_result_t ezom_execute_som_file(const char* filename, uint24_t* result)
         return status;
     }
     
+    // Class files run their main class instead
+    if (ezom_is_class_source(context.source_code)) {
+        status = ezom_run_som_classes(&context, main_class);
+        if (status == EZOM_FILE_OK && result) {
+            *result = context.result_value;
+        }
+        ezom_free_file_context(&context);
+        return status;
+    }
+    
     // Parse file
     status = ezom_parse_file(&context);
     if (status != EZOM_FILE_OK) {
@@ -325,7 +396,7 @@ ezom_file_result_t ezom_evaluate_som_class(ezom_file_context_t* context) {
     ezom_eval_result_t result = ezom_evaluate_class_definition(context->program_ast, eval_context);
     
     if (result.is_error) {
-        printf("Evaluation error: %s\n", result.error_msg);
+        printf("Evaluation error: %s\n", g_eval_error.message);
         return EZOM_FILE_EVAL_ERROR;
     }
     
@@ -372,6 +443,42 @@ ezom_args_t ezom_parse_arguments(int argc, char* argv[]) {
             args.verbose_mode = 1;
         } else if (strcmp(argv[i], "-d") == 0 || strcmp(argv[i], "--debug") == 0) {
             args.debug_mode = 1;
+        } else if (strncmp(argv[i], "--dispatch=", 11) == 0) {
+            if (strcmp(argv[i] + 11, "table") == 0) {
+                args.dispatch_mode = EZOM_DISPATCH_TABLE;
+            } else if (strcmp(argv[i] + 11, "cache") == 0) {
+                args.dispatch_mode = EZOM_DISPATCH_CACHE;
+            } else {
+                printf("Unknown dispatch mode '%s' (use table or cache)\n", argv[i] + 11);
+            }
+        } else if (strncmp(argv[i], "--engine=", 9) == 0) {
+            if (strcmp(argv[i] + 9, "bytecode") == 0) {
+                args.engine = EZOM_ENGINE_BYTECODE;
+            } else if (strcmp(argv[i] + 9, "ast") == 0) {
+                args.engine = EZOM_ENGINE_AST;
+            } else {
+                printf("Unknown engine '%s' (use bytecode or ast)\n", argv[i] + 9);
+            }
+        } else if (strncmp(argv[i], "--max-depth=", 12) == 0) {
+            long depth = strtol(argv[i] + 12, NULL, 10);
+            if (depth > 0) {
+                args.max_depth = (uint32_t)depth;
+            } else {
+                printf("Invalid max depth '%s' (use a positive frame count)\n", argv[i] + 12);
+            }
+        } else if (strcmp(argv[i], "--no-optimize") == 0) {
+            args.no_optimize = 1;
+        } else if (strcmp(argv[i], "--no-jit") == 0) {
+            args.no_jit = 1;
+        } else if (strncmp(argv[i], "--jit-threshold=", 16) == 0) {
+            long threshold = strtol(argv[i] + 16, NULL, 10);
+            if (threshold > 0) {
+                args.jit_threshold = (uint32_t)threshold;
+            } else {
+                printf("Invalid JIT threshold '%s' (use a positive activation count)\n", argv[i] + 16);
+            }
+        } else if (strncmp(argv[i], "--main=", 7) == 0) {
+            args.main_class = argv[i] + 7;
         } else if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
             ezom_print_usage(argv[0]);
             exit(0);
@@ -394,6 +501,15 @@ void ezom_print_usage(const char* program_name) {
     printf("  -i, --interactive  Start interactive REPL\n");
     printf("  -v, --verbose      Enable verbose output\n");
     printf("  -d, --debug        Enable debug output\n");
+    printf("  --dispatch=MODE    Method lookup: cache (default) or table\n");
+    printf("  --engine=ENGINE    Execution: bytecode (default) or ast\n");
+    printf("  --max-depth=N      Frames before a stack overflow (default %d)\n", EZOM_DEFAULT_MAX_DEPTH);
+    printf("  --no-optimize      Skip the AST optimizer (constant folding and the like)\n");
+#ifdef EZOM_JIT
+    printf("  --jit-threshold=N  Activations before a method is compiled (default %d)\n", EZOM_JIT_DEFAULT_THRESHOLD);
+    printf("  --no-jit           Interpret every method\n");
+#endif
+    printf("  --main=CLASS       Class of a class file to run (default: the last one)\n");
     printf("  -h, --help         Show this help message\n");
     printf("  --version          Show version information\n");
     printf("\nExamples:\n");
@@ -445,7 +561,7 @@ void ezom_repl_loop(void) {
             printf("  help      - Show this help\n");
             printf("  exit/quit - Exit the REPL\n");
             printf("  gc        - Run garbage collection\n");
-            printf("  stats     - Show memory statistics\n");
+            printf("  stats     - Show memory and method cache statistics\n");
             printf("  classes   - List available classes\n");
             printf("Or enter any SOM expression to evaluate it.\n");
             continue;
@@ -455,6 +571,13 @@ void ezom_repl_loop(void) {
             continue;
         } else if (strcmp(input, "stats") == 0) {
             ezom_detailed_memory_stats();
+            ezom_method_cache_print_stats();
+            ezom_inline_cache_print_stats();
+            ezom_dispatch_table_print_stats();
+            ezom_specialize_print_stats();
+#ifdef EZOM_JIT
+            ezom_jit_print_stats();
+#endif
             continue;
         } else if (strcmp(input, "classes") == 0) {
             printf("Available classes:\n");
@@ -0,0 +1,530 @@
+// ============================================================================
+// File: src/interpreter.c
+// Bytecode interpreter loop
+// ============================================================================
+
+#include "../include/ezom_bytecode.h"
+#include "../include/ezom_memory.h"
+#include "../include/ezom_context.h"
+#include "../include/ezom_primitives.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+ezom_engine_t g_engine = EZOM_ENGINE_BYTECODE;
+
+// Where an activation the loop entered in place, instead of recursing
+// through C, hands its value back. Kept on the frame stack just below the
+// callee's frame; operand slots follow each frame.
+typedef struct ezom_interp_return {
+    struct ezom_interp_return* caller;  // NULL = caller is the entry activation
+    ezom_code_t*    code;
+    const uint8_t*  pc;
+    uint24_t*       sp;
+    uint24_t*       base;
+    uint24_t        context;
+    uint24_t        current_context;    // g_current_context to restore
+    uint16_t        scratch;
+} ezom_interp_return_t;
+
+void ezom_set_engine(ezom_engine_t engine) {
+    g_engine = engine;
+}
+
+// captured_vars[index] of the block running in context
+static inline uint24_t ezom_interp_captured(uint24_t context, uint8_t index) {
+    ezom_block_t* block = (ezom_block_t*)EZOM_OBJECT_PTR(((ezom_context_t*)EZOM_OBJECT_PTR(context))->receiver);
+    return index < block->capture_count ? block->captured_vars[index] : g_nil;
+}
+
+// Receiver of the home context from a self operand (0 = none)
+static inline uint24_t ezom_interp_self(uint24_t context, uint8_t self) {
+    if (!context) return 0;
+    if (self) return ezom_interp_captured(context, self - 1);
+    return ((ezom_context_t*)EZOM_OBJECT_PTR(context))->receiver;
+}
+
+// Compiled code a send can run in place, with its frame's outer context
+// and slot count; NULL leaves the send to ezom_invoke_method
+static inline ezom_code_t* ezom_interp_callee(ezom_method_t* method, ezom_message_t* msg,
+                                              uint24_t* outer, uint8_t* slots) {
+    if (!(method->flags & EZOM_METHOD_PRIMITIVE)) {
+        ezom_method_code_t* method_code = (ezom_method_code_t*)EZOM_OBJECT_PTR(method->code);
+        if (method_code->is_primitive || method_code->param_count != msg->arg_count) {
+            return NULL;
+        }
+        *outer = 0;
+        *slots = method_code->param_count + method_code->local_count;
+        return (ezom_code_t*)method_code->bytecode;
+    }
+
+    // value and value: on a block that is not inlined into its home
+    uint8_t prim = (uint8_t)method->code;
+    if ((prim != PRIM_BLOCK_VALUE && prim != PRIM_BLOCK_VALUE_WITH) ||
+        !ezom_is_block_object(msg->receiver)) {
+        return NULL;
+    }
+    ezom_block_t* block = (ezom_block_t*)EZOM_OBJECT_PTR(msg->receiver);
+    ezom_ast_node_t* ast = (ezom_ast_node_t*)block->code;
+    if (!ast || ast->type != AST_BLOCK || (ast->data.block.inlined && block->outer_context) ||
+        block->param_count != msg->arg_count) {
+        return NULL;
+    }
+    *outer = block->outer_context;
+    *slots = block->param_count + block->local_count;
+    return ezom_compile_block(ast);
+}
+
+ezom_eval_result_t ezom_interpret(ezom_code_t* code, uint24_t context) {
+    uint24_t* base = (uint24_t*)ezom_frame_reserve(code->max_stack * sizeof(uint24_t));
+    if (!base) {
+        return ezom_make_error_result("Stack overflow");
+    }
+    g_bytecode_stats.activations++;
+
+    uint24_t* sp = base;
+    uint24_t* locals = context ? ((ezom_context_t*)EZOM_OBJECT_PTR(context))->locals : NULL;
+    const uint8_t* pc = code->bytecodes;
+    uint16_t scratch = ezom_double_scratch_mark();
+    // Stores into the activation's own frame never let a closure escape
+    bool heap_context = context && !EZOM_IS_STACK_FRAME(context);
+    ezom_interp_return_t* ret = NULL;   // Set while in an activation entered in place
+    ezom_eval_result_t result;
+
+    // Back to the sender of an activation entered in place
+    #define RESUME_CALLER() do {                                            \
+        ezom_interp_return_t* from = ret;                                  \
+        code = from->code;                                                 \
+        pc = from->pc;                                                     \
+        sp = from->sp;                                                     \
+        base = from->base;                                                 \
+        context = from->context;                                           \
+        scratch = from->scratch;                                           \
+        g_current_context = from->current_context;                         \
+        ret = from->caller;                                                \
+        locals = context ? ((ezom_context_t*)EZOM_OBJECT_PTR(context))->locals : NULL; \
+        heap_context = context && !EZOM_IS_STACK_FRAME(context);           \
+        ezom_frame_release(from);                                          \
+    } while (0)
+
+#ifdef EZOM_THREADED_DISPATCH
+    static const void* const dispatch_table[BC_OPCODE_COUNT] = {
+        [BC_PUSH_LOCAL]   = &&op_BC_PUSH_LOCAL,
+        [BC_PUSH_CAPTURED] = &&op_BC_PUSH_CAPTURED,
+        [BC_PUSH_FIELD]   = &&op_BC_PUSH_FIELD,
+        [BC_PUSH_GLOBAL]  = &&op_BC_PUSH_GLOBAL,
+        [BC_PUSH_SELF]    = &&op_BC_PUSH_SELF,
+        [BC_PUSH_LITERAL] = &&op_BC_PUSH_LITERAL,
+        [BC_PUSH_NIL]     = &&op_BC_PUSH_NIL,
+        [BC_PUSH_TRUE]    = &&op_BC_PUSH_TRUE,
+        [BC_PUSH_FALSE]   = &&op_BC_PUSH_FALSE,
+        [BC_PUSH_BLOCK]   = &&op_BC_PUSH_BLOCK,
+        [BC_STORE_LOCAL]  = &&op_BC_STORE_LOCAL,
+        [BC_STORE_BOX]    = &&op_BC_STORE_BOX,
+        [BC_STORE_FIELD]  = &&op_BC_STORE_FIELD,
+        [BC_STORE_GLOBAL] = &&op_BC_STORE_GLOBAL,
+        [BC_POP]          = &&op_BC_POP,
+        [BC_DROP]         = &&op_BC_DROP,
+        [BC_SEND]         = &&op_BC_SEND,
+        [BC_RETURN]       = &&op_BC_RETURN,
+        [BC_END]          = &&op_BC_END,
+        [BC_JUMP]         = &&op_BC_JUMP,
+        [BC_JUMP_IF_TRUE] = &&op_BC_JUMP_IF_TRUE,
+        [BC_JUMP_IF_FALSE] = &&op_BC_JUMP_IF_FALSE,
+        [BC_TO_DO]        = &&op_BC_TO_DO,
+        [BC_TIMES_REPEAT] = &&op_BC_TIMES_REPEAT,
+        [BC_LOOP_NEXT]    = &&op_BC_LOOP_NEXT,
+        [BC_BOX_LOCAL]    = &&op_BC_BOX_LOCAL,
+        [BC_UNBOX]        = &&op_BC_UNBOX,
+        [BC_RETURN_NONLOCAL] = &&op_BC_RETURN_NONLOCAL
+    };
+    #define TARGET(op)  op_##op:
+    #define DISPATCH()  goto *dispatch_table[*pc++]
+    DISPATCH();
+#else
+    #define TARGET(op)  case op:
+    #define DISPATCH()  continue
+    for (;;) {
+        switch (*pc++) {
+#endif
+
+    TARGET(BC_PUSH_LOCAL) {
+        uint24_t value = locals[*pc++];
+        *sp++ = EZOM_IS_SMALLINT(value) ? value : ezom_load_slot_double(value);
+        DISPATCH();
+    }
+
+    // Only blocks with captures are compiled with this
+    TARGET(BC_PUSH_CAPTURED)
+        *sp++ = ezom_interp_captured(context, *pc++);
+        DISPATCH();
+
+    TARGET(BC_PUSH_FIELD) {
+        uint24_t self = ezom_interp_self(context, pc[0]);
+        if (!self) {
+            result = ezom_make_error_result("No receiver in context");
+            goto leave;
+        }
+        *sp++ = ezom_get_instance_variable(self, pc[1]);
+        pc += 2;
+        DISPATCH();
+    }
+
+    TARGET(BC_PUSH_GLOBAL) {
+        ezom_global_t* global = code->globals[*pc++];
+        if (!global->value) {
+            printf("   Debug: Undefined variable: '%s'\n", global->name);
+            result = ezom_make_error_result("Undefined variable");
+            goto leave;
+        }
+        *sp++ = global->value;
+        DISPATCH();
+    }
+
+    TARGET(BC_PUSH_SELF) {
+        uint24_t self = ezom_interp_self(context, *pc++);
+        *sp++ = self ? self : g_nil;
+        DISPATCH();
+    }
+
+    TARGET(BC_PUSH_LITERAL)
+        *sp++ = code->literals[*pc++];
+        DISPATCH();
+
+    TARGET(BC_PUSH_NIL)
+        *sp++ = g_nil;
+        DISPATCH();
+
+    TARGET(BC_PUSH_TRUE)
+        *sp++ = g_true;
+        DISPATCH();
+
+    TARGET(BC_PUSH_FALSE)
+        *sp++ = g_false;
+        DISPATCH();
+
+    TARGET(BC_PUSH_BLOCK)
+        *sp++ = ezom_block_literal(code->blocks[*pc++], context);
+        DISPATCH();
+
+    // Stores keep a heap copy of a scratch Double: variables outlive
+    // the statement. A local overwrites the Double it already owns.
+    TARGET(BC_STORE_LOCAL)
+        locals[*pc] = ezom_store_slot_double(locals[*pc], sp[-1]);
+        pc++;
+        if (heap_context) {
+            ezom_frame_note_store(context, sp[-1]);
+        }
+        DISPATCH();
+
+    TARGET(BC_STORE_BOX)
+        sp--;
+        sp[-1] = ezom_promote_double(sp[-1]);
+        ezom_box_set(sp[0], sp[-1]);
+        DISPATCH();
+
+    TARGET(BC_STORE_FIELD) {
+        uint24_t self = ezom_interp_self(context, pc[0]);
+        if (!self) {
+            result = ezom_make_error_result("No receiver in context");
+            goto leave;
+        }
+        sp[-1] = ezom_promote_double(sp[-1]);
+        ezom_set_instance_variable(self, pc[1], sp[-1]);
+        pc += 2;
+        DISPATCH();
+    }
+
+    TARGET(BC_STORE_GLOBAL)
+        sp[-1] = ezom_promote_double(sp[-1]);
+        code->globals[*pc++]->value = sp[-1];
+        ezom_frame_note_store(0, sp[-1]);
+        DISPATCH();
+
+    // End of a statement: its scratch Doubles are dead
+    TARGET(BC_POP)
+        sp--;
+        ezom_double_scratch_release(scratch);
+        DISPATCH();
+
+    TARGET(BC_DROP)
+        sp--;
+        DISPATCH();
+
+    // Arguments are already contiguous above the receiver. Compiled
+    // methods and block bodies run in place on the frame stack; everything
+    // else is invoked through C.
+    TARGET(BC_SEND) {
+        ezom_send_site_t* site = &code->sites[*pc++];
+        sp -= site->arg_count;
+        ezom_message_t msg = {
+            .selector = ezom_inline_cache_selector(&site->cache, site->selector),
+            .receiver = sp[-1],
+            .args = site->arg_count ? sp : NULL,
+            .arg_count = site->arg_count
+        };
+        ezom_method_t* method = ezom_inline_cache_lookup(&site->cache, &msg);
+        if (!method) {
+            sp[-1] = 0;
+            DISPATCH();
+        }
+
+        // Accessors and constant methods answer without a frame
+        if (!(method->flags & EZOM_METHOD_PRIMITIVE)) {
+            ezom_method_code_t* method_code = (ezom_method_code_t*)EZOM_OBJECT_PTR(method->code);
+            if (method_code->trivial && method_code->param_count == msg.arg_count) {
+                sp[-1] = ezom_run_trivial_method(method_code, msg.receiver, msg.args);
+                DISPATCH();
+            }
+        }
+
+        uint24_t outer;
+        uint8_t slots;
+        ezom_code_t* callee = ezom_interp_callee(method, &msg, &outer, &slots);
+        if (!callee) {
+            if (method->flags & EZOM_METHOD_PRIMITIVE) {
+                // Straight to the primitive, as ezom_send1 does
+                uint8_t prim_num = (uint8_t)method->code;
+                sp[-1] = prim_num < MAX_PRIMITIVES && g_primitives[prim_num] ?
+                         g_primitives[prim_num](msg.receiver, msg.args, msg.arg_count) : 0;
+            } else {
+                sp[-1] = ezom_invoke_method(method, &msg);
+            }
+            if (EZOM_FRAME_UNWINDING()) {
+                if (!g_frame_stack.overflow) goto unwind;
+                result = ezom_make_error_result("Stack overflow");
+                goto leave;
+            }
+            DISPATCH();
+        }
+
+        ezom_interp_return_t* to = (ezom_interp_return_t*)ezom_frame_reserve(sizeof(ezom_interp_return_t));
+        uint24_t frame = to ? ezom_push_frame(outer, msg.receiver, slots) : 0;
+        if (!frame) {
+            result = ezom_make_error_result("Stack overflow");
+            goto leave;
+        }
+        ezom_context_t* callee_context = (ezom_context_t*)EZOM_OBJECT_PTR(frame);
+        if (!(method->flags & EZOM_METHOD_PRIMITIVE)) {
+            callee_context->method = method->code;
+        }
+        // Binding into the newest frame never lets a closure escape
+        for (uint8_t i = 0; i < msg.arg_count; i++) {
+            callee_context->locals[i] = ezom_promote_double(msg.args[i]);
+        }
+
+        to->caller = ret;
+        to->code = code;
+        to->pc = pc;
+        to->sp = sp;
+        to->base = base;
+        to->context = context;
+        to->current_context = g_current_context;
+        to->scratch = scratch;
+        ret = to;
+
+        code = callee;
+        context = frame;
+        locals = callee_context->locals;
+        heap_context = false;
+        g_current_context = frame;
+        base = (uint24_t*)ezom_frame_reserve(code->max_stack * sizeof(uint24_t));
+        if (!base) {
+            result = ezom_make_error_result("Stack overflow");
+            goto leave;
+        }
+        sp = base;
+        pc = code->bytecodes;
+        scratch = ezom_double_scratch_mark();
+        g_bytecode_stats.activations++;
+        DISPATCH();
+    }
+
+    TARGET(BC_RETURN)
+        result = ezom_make_return_result(sp[-1]);
+        goto leave;
+
+    TARGET(BC_END)
+        result = ezom_make_result(sp[-1]);
+        goto leave;
+
+    TARGET(BC_RETURN_NONLOCAL)
+        if (!ezom_frame_begin_return(context, sp[-1])) {
+            result = ezom_make_error_result("Non-local return from a dead method");
+            goto leave;
+        }
+        goto unwind;
+
+    // The activation this call began with returns to C. One entered in
+    // place answers its sender: a method without ^ answers self, a block
+    // its last value, and a failed one 0 or nil as ezom_invoke_method and
+    // ezom_block_evaluate would.
+    leave:
+        if (!ret) goto done;
+        if (result.is_error && g_frame_stack.overflow) {
+            while (ret) {
+                ezom_pop_frame(context, 0);
+                RESUME_CALLER();
+            }
+            goto done;
+        } else {
+            ezom_context_t* frame = (ezom_context_t*)EZOM_OBJECT_PTR(context);
+            uint24_t value = result.value;
+            if (result.is_error) {
+                if (frame->method) {
+                    printf("DEBUG: Method failed: %s\n", g_eval_error.message);
+                }
+                value = frame->method ? 0 : g_nil;
+            } else if (frame->method && !result.is_return) {
+                value = frame->receiver;
+            }
+            ezom_pop_frame(context, value);
+            RESUME_CALLER();
+            sp[-1] = value;
+        }
+        DISPATCH();
+
+    // A ^ in a block: activations entered in place give way until its home
+    // method, which answers the value. Further out, C callers do the same,
+    // as they do for a signaled exception down to its on:do:.
+    unwind:
+        while (ret) {
+            if (ezom_frame_is_return_home(context)) {
+                result = ezom_make_return_result(ezom_frame_finish_return());
+                goto leave;
+            }
+            ezom_pop_frame(context, 0);
+            RESUME_CALLER();
+        }
+        result = ezom_make_unwind_result();
+        goto done;
+
+    TARGET(BC_JUMP)
+        pc = code->bytecodes + BC_READ_TARGET(pc);
+        DISPATCH();
+
+    // Branches of inlined control flow; anything but a Boolean stays on
+    // the stack for the fallback send
+    TARGET(BC_JUMP_IF_TRUE)
+        if (sp[-1] == g_true) {
+            sp--;
+            pc = code->bytecodes + BC_READ_TARGET(pc);
+        } else if (sp[-1] == g_false) {
+            sp--;
+            pc += 4;
+        } else {
+            pc = code->bytecodes + BC_READ_TARGET(pc + 2);
+        }
+        DISPATCH();
+
+    TARGET(BC_JUMP_IF_FALSE)
+        if (sp[-1] == g_false) {
+            sp--;
+            pc = code->bytecodes + BC_READ_TARGET(pc);
+        } else if (sp[-1] == g_true) {
+            sp--;
+            pc += 4;
+        } else {
+            pc = code->bytecodes + BC_READ_TARGET(pc + 2);
+        }
+        DISPATCH();
+
+    // start limit -> start limit index
+    TARGET(BC_TO_DO)
+        if (!EZOM_IS_SMALLINT(sp[-2]) || !EZOM_IS_SMALLINT(sp[-1])) {
+            pc = code->bytecodes + BC_READ_TARGET(pc + 2);
+        } else if (EZOM_SMALLINT_VALUE(sp[-2]) > EZOM_SMALLINT_VALUE(sp[-1])) {
+            pc = code->bytecodes + BC_READ_TARGET(pc);
+        } else {
+            sp[0] = sp[-2];
+            sp++;
+            pc += 4;
+        }
+        DISPATCH();
+
+    // count -> count index
+    TARGET(BC_TIMES_REPEAT)
+        if (!EZOM_IS_SMALLINT(sp[-1])) {
+            pc = code->bytecodes + BC_READ_TARGET(pc + 2);
+        } else if (EZOM_SMALLINT_VALUE(sp[-1]) < 1) {
+            pc = code->bytecodes + BC_READ_TARGET(pc);
+        } else {
+            *sp++ = EZOM_SMALLINT_FROM(1);
+            pc += 4;
+        }
+        DISPATCH();
+
+    // The index never steps past the limit, so it stays a SmallInteger
+    TARGET(BC_LOOP_NEXT)
+        if (sp[-1] == sp[-2]) {
+            sp--;
+            pc += 2;
+        } else {
+            sp[-1] = EZOM_SMALLINT_FROM(EZOM_SMALLINT_VALUE(sp[-1]) + 1);
+            pc = code->bytecodes + BC_READ_TARGET(pc);
+        }
+        DISPATCH();
+
+    TARGET(BC_BOX_LOCAL)
+        locals[*pc] = ezom_create_box(locals[*pc]);
+        pc++;
+        DISPATCH();
+
+    TARGET(BC_UNBOX)
+        sp[-1] = ezom_box_get(sp[-1]);
+        DISPATCH();
+
+#ifndef EZOM_THREADED_DISPATCH
+        default:
+            result = ezom_make_error_result("Invalid bytecode");
+            goto leave;
+        }
+    }
+#endif
+    #undef TARGET
+    #undef DISPATCH
+    #undef RESUME_CALLER
+
+done:
+    ezom_frame_release(base);
+    return result;
+}
+
+ezom_eval_result_t ezom_run_program(ezom_ast_node_t* ast, uint24_t context) {
+    // A new top-level program starts clean after an earlier overflow
+    if (g_frame_stack.depth == 0) {
+        g_frame_stack.overflow = false;
+        g_frame_stack.returning = false;
+        g_frame_stack.raising = false;
+    }
+
+    ezom_code_t* code = g_engine == EZOM_ENGINE_BYTECODE ? ezom_compile_program(ast) : NULL;
+    ezom_eval_result_t result;
+    if (code) {
+        result = ezom_interpret(code, context);
+        ezom_code_free(code);
+    } else {
+        result = ezom_evaluate_ast(ast, context);
+    }
+
+    // A ^ in a block made at the top level ends the program
+    if (g_frame_stack.returning) {
+        result = ezom_make_return_result(ezom_frame_finish_return());
+    }
+    return result;
+}
+
+void ezom_bytecode_print_stats(void) {
+    printf("\n=== Bytecode Engine ===\n");
+    printf("Engine: %s (%s dispatch)\n", g_engine == EZOM_ENGINE_BYTECODE ? "bytecode" : "ast",
+#ifdef EZOM_THREADED_DISPATCH
+           "threaded"
+#else
+           "switch"
+#endif
+           );
+    printf("Units compiled: %u (%lu bytes), AST fallbacks: %u\n",
+           g_bytecode_stats.units, (unsigned long)g_bytecode_stats.bytes, g_bytecode_stats.fallbacks);
+    printf("Activations: %lu\n", (unsigned long)g_bytecode_stats.activations);
+    printf("=======================\n\n");
+}
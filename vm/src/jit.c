@@ -0,0 +1,1007 @@
+// ============================================================================
+// File: src/jit.c
+// Baseline x86-64 JIT for hot methods (native builds, -DEZOM_JIT)
+// ============================================================================
+
+#ifdef EZOM_JIT
+
+#define _DEFAULT_SOURCE     // MAP_ANONYMOUS under -std=c99
+#include "../include/ezom_jit.h"
+#include "../include/ezom_memory.h"
+#include "../include/ezom_dispatch.h"
+#include "../include/ezom_primitives.h"
+#include "../include/ezom_context.h"
+#include "../include/ezom_ast_memory.h"
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+
+// Generated code keeps the frame's locals in rbx, self's fields in r14,
+// self in r12d, the context in r13d and the method's scratch Double mark
+// in r15d. Expressions leave their value in eax; operands wait on the
+// machine stack. Helpers answer bit 63 set when the activation unwinds.
+#define EZOM_JIT_UNWIND         (1ULL << 63)
+#define EZOM_JIT_MAX_ARGS       16
+#define EZOM_JIT_MAX_EXITS      512
+#define EZOM_JIT_BUFFER_SIZE    (64 * 1024)
+
+ezom_jit_stats_t g_jit_stats = {0, 0, 0, 0, 0, 0};
+
+static bool g_jit_enabled = true;
+static uint16_t g_jit_threshold = EZOM_JIT_DEFAULT_THRESHOLD;
+static const char* g_jit_error = NULL;      // Set by generated code on failure
+
+// Executable region, bump-allocated. It starts over (a new generation)
+// once all of its code is stale or it is full, unless machine code is
+// still running on the C stack; translations from an older generation
+// are dropped when their method next runs.
+static uint8_t* g_jit_region = NULL;
+static uint32_t g_jit_region_used = 0;
+static uint32_t g_jit_region_generation = 1;
+static uint32_t g_jit_region_version = 0;   // Integer's stamp for the newest code
+static uint32_t g_jit_running = 0;          // Machine code activations under way
+
+typedef struct ezom_jit_buffer {
+    uint8_t  bytes[EZOM_JIT_BUFFER_SIZE];
+    uint32_t size;
+    uint32_t depth;             // 8-byte slots pushed below the saved registers
+    uint32_t exits[EZOM_JIT_MAX_EXITS];     // rel32 fields jumping to the epilogue
+    uint16_t exit_count;
+    bool     uses_fields;
+    const char* reject;         // Why the method stays interpreted
+    bool     retry;             // Only for now: no code space yet
+} ezom_jit_buffer_t;
+
+static ezom_jit_buffer_t g_jit_buffer;
+
+void ezom_jit_configure(bool enabled, uint32_t threshold) {
+    g_jit_enabled = enabled;
+    if (threshold) {
+        g_jit_threshold = threshold < EZOM_JIT_REJECTED ? (uint16_t)threshold : EZOM_JIT_REJECTED - 1;
+    }
+}
+
+// ============================================================================
+// Helpers called from generated code
+// ============================================================================
+
+static uint64_t ezom_jit_site_send(ezom_ast_node_t* node, uint24_t receiver,
+                                   uint24_t* args, uint8_t arg_count) {
+    const char* selector_name = node->data.message_send.selector;
+    ezom_inline_cache_t* ic = node->data.message_send.inline_cache;
+    ezom_message_t msg = {
+        .selector = ic ? ezom_inline_cache_selector(ic, selector_name)
+                       : ezom_create_symbol(selector_name, strlen(selector_name)),
+        .receiver = receiver,
+        .args = arg_count ? args : NULL,
+        .arg_count = arg_count
+    };
+
+    uint24_t result = ezom_send_message_cached(ic, &msg);
+    return EZOM_FRAME_UNWINDING() ? EZOM_JIT_UNWIND : result;
+}
+
+// Ordinary send: the receiver and then each argument were pushed, so
+// slots[arg_count] is the receiver and slots[0] the last argument
+static uint64_t ezom_jit_send(ezom_ast_node_t* node, const uint64_t* slots) {
+    uint8_t arg_count = node->data.message_send.arg_count;
+    uint24_t args[EZOM_JIT_MAX_ARGS];
+    for (uint8_t i = 0; i < arg_count; i++) {
+        args[i] = (uint24_t)slots[arg_count - 1 - i];
+    }
+    return ezom_jit_site_send(node, (uint24_t)slots[arg_count], args, arg_count);
+}
+
+// Inlined control-flow send whose receiver is not a Boolean or
+// SmallInteger: its blocks become closures over the frame after all
+static uint64_t ezom_jit_send_blocks(ezom_ast_node_t* node, uint24_t receiver,
+                                     uint24_t limit, uint24_t context) {
+    ezom_ast_node_t* block = node->data.message_send.arguments;
+    uint24_t args[2];
+    uint8_t arg_count = 0;
+
+    if (node->data.message_send.inline_kind == AST_INLINE_TO_DO) {
+        args[arg_count++] = limit;
+        block = block->next;
+    }
+    for (; block && arg_count < 2; block = block->next) {
+        args[arg_count++] = ezom_create_ast_block(block, context);
+    }
+    return ezom_jit_site_send(node, receiver, args, arg_count);
+}
+
+// Stores of anything but a SmallInteger: variables outlive the statement,
+// so a scratch Double is copied to the heap first (a local overwrites the
+// Double it already owns)
+static uint24_t ezom_jit_store_local(uint24_t context, uint32_t index, uint24_t value) {
+    ezom_context_set_local(context, (uint8_t)index, value);
+    return value;
+}
+
+static uint24_t ezom_jit_store_field(uint24_t receiver, uint32_t index, uint24_t value) {
+    value = ezom_promote_double(value);
+    ezom_set_instance_variable(receiver, (uint16_t)index, value);
+    return value;
+}
+
+static uint24_t ezom_jit_store_box(uint24_t box, uint24_t value) {
+    value = ezom_promote_double(value);
+    ezom_box_set(box, value);
+    return value;
+}
+
+static uint24_t ezom_jit_store_global(ezom_global_t* global, uint24_t value) {
+    value = ezom_promote_double(value);
+    global->value = value;
+    ezom_frame_note_store(0, value);
+    return value;
+}
+
+static void ezom_jit_undefined(ezom_ast_node_t* node) {
+    printf("   Debug: Undefined variable: '%s'\n", node->data.variable.name);
+    g_jit_error = "Undefined variable";
+}
+
+// ============================================================================
+// Emitter
+// ============================================================================
+
+#define EZOM_JIT_EMIT(cg, bytes) ezom_jit_emit(cg, bytes, sizeof(bytes) - 1)
+
+static void ezom_jit_emit(ezom_jit_buffer_t* cg, const char* bytes, uint32_t length) {
+    if (cg->size + length > EZOM_JIT_BUFFER_SIZE) {
+        cg->reject = "method too large";
+        return;
+    }
+    memcpy(cg->bytes + cg->size, bytes, length);
+    cg->size += length;
+}
+
+static void ezom_jit_emit32(ezom_jit_buffer_t* cg, uint32_t value) {
+    ezom_jit_emit(cg, (const char*)&value, 4);
+}
+
+static void ezom_jit_emit64(ezom_jit_buffer_t* cg, uint64_t value) {
+    ezom_jit_emit(cg, (const char*)&value, 8);
+}
+
+// mov eax, imm32
+static void ezom_jit_load_constant(ezom_jit_buffer_t* cg, uint24_t value) {
+    EZOM_JIT_EMIT(cg, "\xB8");
+    ezom_jit_emit32(cg, value);
+}
+
+// mov rdi, imm64
+static void ezom_jit_load_rdi(ezom_jit_buffer_t* cg, const void* pointer) {
+    EZOM_JIT_EMIT(cg, "\x48\xBF");
+    ezom_jit_emit64(cg, (uint64_t)(uintptr_t)pointer);
+}
+
+// Operand slot pushed at depth index slot, as a disp32 from rsp
+static uint32_t ezom_jit_slot(ezom_jit_buffer_t* cg, uint32_t slot) {
+    return 8 * (cg->depth - 1 - slot);
+}
+
+// op reg, [rsp + slot]: opcode, then ModRM with a SIB byte and disp32
+static void ezom_jit_slot_op(ezom_jit_buffer_t* cg, const char* opcode, uint8_t reg, uint32_t slot) {
+    char modrm[2] = {(char)(0x84 | (reg << 3)), 0x24};
+    ezom_jit_emit(cg, opcode, 1);
+    ezom_jit_emit(cg, modrm, 2);
+    ezom_jit_emit32(cg, ezom_jit_slot(cg, slot));
+}
+
+// push rax / add rsp, 8 * count, tracked so calls keep rsp 16-byte aligned
+static void ezom_jit_push(ezom_jit_buffer_t* cg) {
+    EZOM_JIT_EMIT(cg, "\x50");
+    cg->depth++;
+}
+
+static void ezom_jit_drop(ezom_jit_buffer_t* cg, uint32_t count) {
+    EZOM_JIT_EMIT(cg, "\x48\x81\xC4");
+    ezom_jit_emit32(cg, 8 * count);
+    cg->depth -= count;
+}
+
+static void ezom_jit_call(ezom_jit_buffer_t* cg, const void* function) {
+    bool pad = cg->depth & 1;
+    if (pad) EZOM_JIT_EMIT(cg, "\x48\x83\xEC\x08");
+    EZOM_JIT_EMIT(cg, "\x48\xB8");
+    ezom_jit_emit64(cg, (uint64_t)(uintptr_t)function);
+    EZOM_JIT_EMIT(cg, "\xFF\xD0");
+    if (pad) EZOM_JIT_EMIT(cg, "\x48\x83\xC4\x08");
+}
+
+// Forward jump: emits the opcode and answers where its rel32 goes
+static uint32_t ezom_jit_jump(ezom_jit_buffer_t* cg, const char* opcode, uint32_t length) {
+    ezom_jit_emit(cg, opcode, length);
+    ezom_jit_emit32(cg, 0);
+    return cg->size - 4;
+}
+
+static void ezom_jit_land(ezom_jit_buffer_t* cg, uint32_t at) {
+    if (cg->reject) return;
+    int32_t rel = (int32_t)(cg->size - (at + 4));
+    memcpy(cg->bytes + at, &rel, 4);
+}
+
+static void ezom_jit_jump_back(ezom_jit_buffer_t* cg, const char* opcode, uint32_t length, uint32_t target) {
+    ezom_jit_emit(cg, opcode, length);
+    ezom_jit_emit32(cg, (uint32_t)((int32_t)target - (int32_t)(cg->size + 4)));
+}
+
+#define EZOM_JIT_JUMP(cg, opcode) ezom_jit_jump(cg, opcode, sizeof(opcode) - 1)
+
+// Leave the activation with eax: the epilogue drops any pending operands
+static void ezom_jit_exit(ezom_jit_buffer_t* cg) {
+    if (cg->exit_count == EZOM_JIT_MAX_EXITS) {
+        cg->reject = "too many exits";
+        return;
+    }
+    cg->exits[cg->exit_count++] = EZOM_JIT_JUMP(cg, "\xE9");
+}
+
+// test rax, rax; js epilogue
+static void ezom_jit_check_unwind(ezom_jit_buffer_t* cg) {
+    EZOM_JIT_EMIT(cg, "\x48\x85\xC0");
+    if (cg->exit_count == EZOM_JIT_MAX_EXITS) {
+        cg->reject = "too many exits";
+        return;
+    }
+    cg->exits[cg->exit_count++] = EZOM_JIT_JUMP(cg, "\x0F\x88");
+}
+
+// Push the scratch Double mark, as a statement list or loop takes one
+static uint32_t ezom_jit_push_mark(ezom_jit_buffer_t* cg) {
+    EZOM_JIT_EMIT(cg, "\x48\xB8");
+    ezom_jit_emit64(cg, (uint64_t)(uintptr_t)&g_double_scratch.top);
+    EZOM_JIT_EMIT(cg, "\x0F\xB7\x00");                 // movzx eax, word [rax]
+    ezom_jit_push(cg);
+    return cg->depth - 1;
+}
+
+// ezom_double_scratch_release, inline: slot UINT32_MAX is the method's mark
+static void ezom_jit_release(ezom_jit_buffer_t* cg, uint32_t slot) {
+    if (slot == UINT32_MAX) {
+        EZOM_JIT_EMIT(cg, "\x44\x89\xF9");             // mov ecx, r15d
+    } else {
+        ezom_jit_slot_op(cg, "\x8B", 1, slot);          // mov ecx, [rsp + slot]
+    }
+    EZOM_JIT_EMIT(cg, "\x48\xB8");
+    ezom_jit_emit64(cg, (uint64_t)(uintptr_t)&g_double_scratch.top);
+    EZOM_JIT_EMIT(cg, "\x0F\xB7\x10"                   // movzx edx, word [rax]
+                      "\x39\xCA"                       // cmp edx, ecx
+                      "\x76\x03"                       // jbe +3
+                      "\x66\x89\x08");                 // mov [rax], cx
+}
+
+// ============================================================================
+// Templates
+// ============================================================================
+
+static void ezom_jit_expression(ezom_jit_buffer_t* cg, ezom_ast_node_t* node);
+static void ezom_jit_statements(ezom_jit_buffer_t* cg, ezom_ast_node_t* list, uint32_t mark);
+
+static void ezom_jit_literal(ezom_jit_buffer_t* cg, ezom_ast_node_t* node) {
+    if (!node->data.literal.object) {
+        node->data.literal.object = ezom_literal_object(node);
+    }
+    if (!node->data.literal.object) {
+        cg->reject = "literal";
+        return;
+    }
+    ezom_jit_load_constant(cg, node->data.literal.object);
+}
+
+static void ezom_jit_variable(ezom_jit_buffer_t* cg, ezom_ast_node_t* node) {
+    uint32_t offset = 4 * node->data.variable.index;
+
+    // Closures' captured copies only occur in blocks, which stay interpreted
+    if (node->data.variable.capture != AST_NO_CAPTURE) {
+        cg->reject = "captured variable";
+        return;
+    }
+
+    switch (node->data.variable.kind) {
+        case AST_VAR_CONTEXT:
+            EZOM_JIT_EMIT(cg, "\x8B\x83");                 // mov eax, [rbx + offset]
+            ezom_jit_emit32(cg, offset);
+            if (node->data.variable.boxed) {
+                EZOM_JIT_EMIT(cg, "\x89\xC7");             // mov edi, eax
+                ezom_jit_call(cg, ezom_box_get);
+            } else {
+                // A Double the slot owns is read as a copy
+                EZOM_JIT_EMIT(cg, "\xA8\x01");             // test al, 1
+                uint32_t integer = EZOM_JIT_JUMP(cg, "\x0F\x85");
+                EZOM_JIT_EMIT(cg, "\x89\xC7");             // mov edi, eax
+                ezom_jit_call(cg, ezom_load_slot_double);
+                ezom_jit_land(cg, integer);
+            }
+            break;
+
+        case AST_VAR_INSTANCE:
+            EZOM_JIT_EMIT(cg, "\x41\x8B\x86");             // mov eax, [r14 + offset]
+            ezom_jit_emit32(cg, offset);
+            cg->uses_fields = true;
+            break;
+
+        case AST_VAR_SELF:
+            EZOM_JIT_EMIT(cg, "\x44\x89\xE0");             // mov eax, r12d
+            break;
+
+        case AST_VAR_GLOBAL: {
+            EZOM_JIT_EMIT(cg, "\x48\xB8");
+            ezom_jit_emit64(cg, (uint64_t)(uintptr_t)&node->data.variable.global->value);
+            EZOM_JIT_EMIT(cg, "\x8B\x00"                   // mov eax, [rax]
+                              "\x85\xC0");                 // test eax, eax
+            uint32_t defined = EZOM_JIT_JUMP(cg, "\x0F\x85");
+            ezom_jit_load_rdi(cg, node);
+            ezom_jit_call(cg, ezom_jit_undefined);
+            ezom_jit_exit(cg);
+            ezom_jit_land(cg, defined);
+            break;
+        }
+
+        default:
+            cg->reject = "unresolved variable";
+            break;
+    }
+}
+
+static void ezom_jit_assignment(ezom_jit_buffer_t* cg, ezom_ast_node_t* node) {
+    ezom_ast_node_t* variable = node->data.assignment.variable;
+    if (variable->type != AST_VARIABLE_DEF || variable->data.variable.capture != AST_NO_CAPTURE) {
+        cg->reject = "assignment target";
+        return;
+    }
+    uint32_t index = variable->data.variable.index;
+
+    ezom_jit_expression(cg, node->data.assignment.value);
+
+    switch (variable->data.variable.kind) {
+        case AST_VAR_CONTEXT:
+            if (variable->data.variable.boxed) {
+                EZOM_JIT_EMIT(cg, "\x89\xC6"               // mov esi, eax
+                                  "\x8B\xBB");             // mov edi, [rbx + offset]
+                ezom_jit_emit32(cg, 4 * index);
+                ezom_jit_call(cg, ezom_jit_store_box);
+            } else {
+                // SmallIntegers go straight into the slot
+                EZOM_JIT_EMIT(cg, "\xA8\x01");             // test al, 1
+                uint32_t slow = EZOM_JIT_JUMP(cg, "\x0F\x84");
+                EZOM_JIT_EMIT(cg, "\x89\x83");             // mov [rbx + offset], eax
+                ezom_jit_emit32(cg, 4 * index);
+                uint32_t done = EZOM_JIT_JUMP(cg, "\xE9");
+                ezom_jit_land(cg, slow);
+                EZOM_JIT_EMIT(cg, "\x89\xC2"               // mov edx, eax
+                                  "\x44\x89\xEF"           // mov edi, r13d
+                                  "\xBE");                 // mov esi, index
+                ezom_jit_emit32(cg, index);
+                ezom_jit_call(cg, ezom_jit_store_local);
+                ezom_jit_land(cg, done);
+            }
+            break;
+
+        case AST_VAR_INSTANCE: {
+            EZOM_JIT_EMIT(cg, "\xA8\x01");                 // test al, 1
+            uint32_t slow = EZOM_JIT_JUMP(cg, "\x0F\x84");
+            EZOM_JIT_EMIT(cg, "\x41\x89\x86");             // mov [r14 + offset], eax
+            ezom_jit_emit32(cg, 4 * index);
+            uint32_t done = EZOM_JIT_JUMP(cg, "\xE9");
+            ezom_jit_land(cg, slow);
+            EZOM_JIT_EMIT(cg, "\x89\xC2"                   // mov edx, eax
+                              "\x44\x89\xE7"               // mov edi, r12d
+                              "\xBE");                     // mov esi, index
+            ezom_jit_emit32(cg, index);
+            ezom_jit_call(cg, ezom_jit_store_field);
+            ezom_jit_land(cg, done);
+            cg->uses_fields = true;
+            break;
+        }
+
+        case AST_VAR_GLOBAL:
+            EZOM_JIT_EMIT(cg, "\x89\xC6");                 // mov esi, eax
+            ezom_jit_load_rdi(cg, variable->data.variable.global);
+            ezom_jit_call(cg, ezom_jit_store_global);
+            break;
+
+        default:
+            cg->reject = "assignment target";
+            break;
+    }
+}
+
+// Body of an inlined block, in this frame: its locals start out nil
+static void ezom_jit_inlined_block(ezom_jit_buffer_t* cg, ezom_ast_node_t* block) {
+    if (!block || block->type != AST_BLOCK || !block->data.block.inlined) {
+        cg->reject = "inlined block";
+        return;
+    }
+
+    uint8_t first_local = block->data.block.inline_base +
+                          ezom_ast_count_parameters(block->data.block.parameters);
+    uint8_t local_count = ezom_ast_count_locals(block->data.block.locals);
+    for (uint8_t i = 0; i < local_count; i++) {
+        EZOM_JIT_EMIT(cg, "\xC7\x83");                     // mov dword [rbx + offset], nil
+        ezom_jit_emit32(cg, 4 * (first_local + i));
+        ezom_jit_emit32(cg, g_nil);
+    }
+    if (block->data.block.vars && block->data.block.vars->boxed_count) {
+        EZOM_JIT_EMIT(cg, "\x44\x89\xEF"                   // mov edi, r13d
+                          "\x48\xBE");                     // mov rsi, boxed
+        ezom_jit_emit64(cg, (uint64_t)(uintptr_t)block->data.block.vars->boxed);
+        EZOM_JIT_EMIT(cg, "\xBA");                         // mov edx, boxed_count
+        ezom_jit_emit32(cg, block->data.block.vars->boxed_count);
+        ezom_jit_call(cg, ezom_box_locals);
+    }
+
+    if (!block->data.block.body) {
+        ezom_jit_load_constant(cg, g_nil);
+    } else if (block->data.block.body->type == AST_STATEMENT_LIST) {
+        ezom_jit_statements(cg, block->data.block.body, 0);
+    } else {
+        ezom_jit_expression(cg, block->data.block.body);
+    }
+}
+
+// Closures over the frame and a send, for a receiver that is not a
+// Boolean or SmallInteger. The receiver is in esi, a to:do: limit in edx.
+static void ezom_jit_inlined_fallback(ezom_jit_buffer_t* cg, ezom_ast_node_t* node) {
+    ezom_jit_load_rdi(cg, node);
+    EZOM_JIT_EMIT(cg, "\x44\x89\xE9");                     // mov ecx, r13d
+    ezom_jit_call(cg, ezom_jit_send_blocks);
+    ezom_jit_check_unwind(cg);
+}
+
+// [cond] whileTrue: [body]: any value but the expected Boolean ends it
+static void ezom_jit_inlined_while(ezom_jit_buffer_t* cg, ezom_ast_node_t* node) {
+    uint24_t continue_on = node->data.message_send.inline_kind == AST_INLINE_WHILE_TRUE ? g_true : g_false;
+    uint32_t mark = ezom_jit_push_mark(cg);
+
+    uint32_t top = cg->size;
+    ezom_jit_inlined_block(cg, node->data.message_send.receiver);
+    EZOM_JIT_EMIT(cg, "\x3D");                             // cmp eax, continue_on
+    ezom_jit_emit32(cg, continue_on);
+    uint32_t done = EZOM_JIT_JUMP(cg, "\x0F\x85");
+    ezom_jit_inlined_block(cg, node->data.message_send.arguments);
+    ezom_jit_release(cg, mark);
+    ezom_jit_jump_back(cg, "\xE9", 1, top);
+
+    ezom_jit_land(cg, done);
+    ezom_jit_drop(cg, 1);
+    ezom_jit_load_constant(cg, g_nil);
+}
+
+// to:do: and timesRepeat: over SmallIntegers; answers the receiver
+static void ezom_jit_inlined_loop(ezom_jit_buffer_t* cg, ezom_ast_node_t* node) {
+    bool to_do = node->data.message_send.inline_kind == AST_INLINE_TO_DO;
+    ezom_ast_node_t* block = node->data.message_send.arguments;
+
+    ezom_jit_expression(cg, node->data.message_send.receiver);
+    ezom_jit_push(cg);
+    uint32_t receiver_slot = cg->depth - 1;
+
+    if (to_do) {
+        ezom_jit_expression(cg, block);
+        block = block->next;
+        EZOM_JIT_EMIT(cg, "\x89\xC1");                     // mov ecx, eax (limit)
+        ezom_jit_slot_op(cg, "\x8B", 2, receiver_slot);    // mov edx, [receiver]
+        EZOM_JIT_EMIT(cg, "\x89\xD0"                       // mov eax, edx
+                          "\x21\xC8");                     // and eax, ecx
+    } else {
+        EZOM_JIT_EMIT(cg, "\x89\xC2"                       // mov edx, eax
+                          "\xB9\x03\x00\x00\x00");         // mov ecx, SmallInteger 1
+    }
+    EZOM_JIT_EMIT(cg, "\xA8\x01");                         // test al, 1
+    uint32_t fallback = EZOM_JIT_JUMP(cg, "\x0F\x84");
+
+    // From here: end and index as raw integers, then a scratch mark
+    if (to_do) {
+        EZOM_JIT_EMIT(cg, "\x89\xC8"                       // mov eax, ecx
+                          "\xD1\xF8"                       // sar eax, 1
+                          "\x50"                           // push rax (end)
+                          "\x89\xD0"                       // mov eax, edx
+                          "\xD1\xF8"                       // sar eax, 1
+                          "\x50");                         // push rax (index)
+    } else {
+        EZOM_JIT_EMIT(cg, "\x89\xD0"                       // mov eax, edx
+                          "\xD1\xF8"                       // sar eax, 1
+                          "\x50"                           // push rax (end)
+                          "\x6A\x01");                     // push 1 (index)
+    }
+    cg->depth += 2;
+    uint32_t end_slot = cg->depth - 2;
+    uint32_t index_slot = cg->depth - 1;
+    uint32_t mark = ezom_jit_push_mark(cg);
+    bool has_index = ezom_ast_count_parameters(block->data.block.parameters) == 1;
+
+    ezom_jit_slot_op(cg, "\x8B", 0, index_slot);           // mov eax, [index]
+    ezom_jit_slot_op(cg, "\x3B", 0, end_slot);             // cmp eax, [end]
+    uint32_t skip = EZOM_JIT_JUMP(cg, "\x0F\x8F");
+
+    uint32_t top = cg->size;
+    if (has_index) {
+        ezom_jit_slot_op(cg, "\x8B", 0, index_slot);
+        EZOM_JIT_EMIT(cg, "\x8D\x44\x00\x01"               // lea eax, [rax + rax + 1]
+                          "\x89\x83");                     // mov [rbx + offset], eax
+        ezom_jit_emit32(cg, 4 * block->data.block.inline_base);
+    }
+    ezom_jit_inlined_block(cg, block);
+    ezom_jit_release(cg, mark);
+
+    // Do not step past the largest value
+    ezom_jit_slot_op(cg, "\x8B", 0, index_slot);
+    ezom_jit_slot_op(cg, "\x3B", 0, end_slot);
+    uint32_t last = EZOM_JIT_JUMP(cg, "\x0F\x84");
+    ezom_jit_slot_op(cg, "\xFF", 0, index_slot);           // inc dword [index]
+    ezom_jit_jump_back(cg, "\xE9", 1, top);
+
+    ezom_jit_land(cg, skip);
+    ezom_jit_land(cg, last);
+    ezom_jit_drop(cg, 3);
+    EZOM_JIT_EMIT(cg, "\x58");                             // pop rax (receiver)
+    cg->depth--;
+    uint32_t done = EZOM_JIT_JUMP(cg, "\xE9");
+
+    // Not SmallIntegers: the receiver waits in its slot, the limit in ecx
+    cg->depth = receiver_slot + 1;
+    ezom_jit_land(cg, fallback);
+    EZOM_JIT_EMIT(cg, "\x89\xCA");                         // mov edx, ecx
+    ezom_jit_slot_op(cg, "\x8B", 6, receiver_slot);        // mov esi, [receiver]
+    ezom_jit_inlined_fallback(cg, node);
+    ezom_jit_drop(cg, 1);
+    ezom_jit_land(cg, done);
+}
+
+static void ezom_jit_inlined_send(ezom_jit_buffer_t* cg, ezom_ast_node_t* node) {
+    ezom_inline_kind_t kind = (ezom_inline_kind_t)node->data.message_send.inline_kind;
+    ezom_ast_node_t* block = node->data.message_send.arguments;
+
+    if (kind == AST_INLINE_WHILE_TRUE || kind == AST_INLINE_WHILE_FALSE) {
+        ezom_jit_inlined_while(cg, node);
+        return;
+    }
+    if (kind == AST_INLINE_TO_DO || kind == AST_INLINE_TIMES_REPEAT) {
+        ezom_jit_inlined_loop(cg, node);
+        return;
+    }
+
+    ezom_jit_expression(cg, node->data.message_send.receiver);
+    EZOM_JIT_EMIT(cg, "\x3D");                             // cmp eax, true
+    ezom_jit_emit32(cg, g_true);
+    uint32_t if_true = EZOM_JIT_JUMP(cg, "\x0F\x84");
+    EZOM_JIT_EMIT(cg, "\x3D");                             // cmp eax, false
+    ezom_jit_emit32(cg, g_false);
+    uint32_t if_false = EZOM_JIT_JUMP(cg, "\x0F\x84");
+
+    EZOM_JIT_EMIT(cg, "\x89\xC6");                         // mov esi, eax
+    ezom_jit_inlined_fallback(cg, node);
+    uint32_t done_send = EZOM_JIT_JUMP(cg, "\xE9");
+
+    ezom_jit_land(cg, if_true);
+    switch (kind) {
+        case AST_INLINE_IF_TRUE:
+        case AST_INLINE_IF_TRUE_IF_FALSE:
+        case AST_INLINE_AND:  ezom_jit_inlined_block(cg, block); break;
+        case AST_INLINE_OR:   ezom_jit_load_constant(cg, g_true); break;
+        default:              ezom_jit_load_constant(cg, g_nil); break;
+    }
+    uint32_t done_true = EZOM_JIT_JUMP(cg, "\xE9");
+
+    ezom_jit_land(cg, if_false);
+    switch (kind) {
+        case AST_INLINE_IF_FALSE:
+        case AST_INLINE_OR:   ezom_jit_inlined_block(cg, block); break;
+        case AST_INLINE_IF_TRUE_IF_FALSE: ezom_jit_inlined_block(cg, block->next); break;
+        case AST_INLINE_AND:  ezom_jit_load_constant(cg, g_false); break;
+        default:              ezom_jit_load_constant(cg, g_nil); break;
+    }
+
+    ezom_jit_land(cg, done_send);
+    ezom_jit_land(cg, done_true);
+}
+
+// Integer primitive the node's selector reaches, if its SmallInteger case
+// can be done inline: Integer must still use the primitive
+static uint8_t ezom_jit_integer_primitive(ezom_ast_node_t* node) {
+    static const struct { const char* selector; uint8_t primitive; } ops[] = {
+        {"+", PRIM_INTEGER_ADD}, {"-", PRIM_INTEGER_SUB}, {"<", PRIM_INTEGER_LT},
+        {">", PRIM_INTEGER_GT}, {"<=", PRIM_INTEGER_LTE}, {">=", PRIM_INTEGER_GTE},
+        {"=", PRIM_INTEGER_EQ}
+    };
+    const char* selector = node->data.message_send.selector;
+
+    if (node->data.message_send.arg_count != 1) return 0;
+    for (uint8_t i = 0; i < sizeof(ops) / sizeof(ops[0]); i++) {
+        if (strcmp(selector, ops[i].selector) != 0) continue;
+
+        uint24_t symbol = ezom_create_symbol(selector, strlen(selector));
+        ezom_method_t* method = symbol ? ezom_lookup_method(g_integer_class, symbol).method : NULL;
+        if (method && (method->flags & EZOM_METHOD_PRIMITIVE) && (uint8_t)method->code == ops[i].primitive) {
+            return ops[i].primitive;
+        }
+        return 0;
+    }
+    return 0;
+}
+
+// Receiver in edx, argument in ecx, both SmallIntegers: the answer in
+// eax, or a jump to the send for an overflow
+static void ezom_jit_integer_op(ezom_jit_buffer_t* cg, uint8_t primitive, uint32_t* overflow) {
+    *overflow = 0;
+    switch (primitive) {
+        case PRIM_INTEGER_ADD:
+            EZOM_JIT_EMIT(cg, "\x89\xD0"                   // mov eax, edx
+                              "\x83\xE8\x01"               // sub eax, 1
+                              "\x01\xC8");                 // add eax, ecx
+            *overflow = EZOM_JIT_JUMP(cg, "\x0F\x80");
+            return;
+        case PRIM_INTEGER_SUB:
+            EZOM_JIT_EMIT(cg, "\x89\xD0"                   // mov eax, edx
+                              "\x29\xC8");                 // sub eax, ecx
+            *overflow = EZOM_JIT_JUMP(cg, "\x0F\x80");
+            EZOM_JIT_EMIT(cg, "\x83\xC8\x01");             // or eax, 1
+            return;
+        default:
+            break;
+    }
+
+    // Tagged values compare as the integers do
+    EZOM_JIT_EMIT(cg, "\xB8");                             // mov eax, false
+    ezom_jit_emit32(cg, g_false);
+    EZOM_JIT_EMIT(cg, "\x41\xB8");                         // mov r8d, true
+    ezom_jit_emit32(cg, g_true);
+    EZOM_JIT_EMIT(cg, "\x39\xCA");                         // cmp edx, ecx
+    switch (primitive) {
+        case PRIM_INTEGER_LT:  EZOM_JIT_EMIT(cg, "\x41\x0F\x4C\xC0"); break;   // cmovl eax, r8d
+        case PRIM_INTEGER_GT:  EZOM_JIT_EMIT(cg, "\x41\x0F\x4F\xC0"); break;   // cmovg
+        case PRIM_INTEGER_LTE: EZOM_JIT_EMIT(cg, "\x41\x0F\x4E\xC0"); break;   // cmovle
+        case PRIM_INTEGER_GTE: EZOM_JIT_EMIT(cg, "\x41\x0F\x4D\xC0"); break;   // cmovge
+        default:               EZOM_JIT_EMIT(cg, "\x41\x0F\x44\xC0"); break;   // cmove
+    }
+}
+
+static void ezom_jit_send_node(ezom_jit_buffer_t* cg, ezom_ast_node_t* node) {
+    uint8_t arg_count = node->data.message_send.arg_count;
+
+    if (node->data.message_send.is_super || arg_count > EZOM_JIT_MAX_ARGS) {
+        cg->reject = "send";
+        return;
+    }
+    if (!node->data.message_send.inline_cache) {
+        ezom_inline_cache_t* ic = (ezom_inline_cache_t*)ezom_ast_alloc(sizeof(ezom_inline_cache_t));
+        if (ic) {
+            memset(ic, 0, sizeof(ezom_inline_cache_t));
+            node->data.message_send.inline_cache = ic;
+        }
+    }
+
+    ezom_jit_expression(cg, node->data.message_send.receiver);
+    ezom_jit_push(cg);
+
+    ezom_ast_node_t* arg = node->data.message_send.arguments;
+    for (uint8_t i = 0; i < arg_count; i++, arg = arg->next) {
+        if (!arg) {
+            cg->reject = "send arguments";
+            return;
+        }
+        ezom_jit_expression(cg, arg);
+        if (i + 1 < arg_count) ezom_jit_push(cg);
+    }
+
+    // The last value is in eax: SmallInteger arithmetic and comparisons
+    // are answered here when both operands are SmallIntegers
+    uint8_t primitive = ezom_jit_integer_primitive(node);
+    uint32_t not_integers = 0, overflow = 0, done = 0;
+    if (primitive) {
+        EZOM_JIT_EMIT(cg, "\x89\xC1"                       // mov ecx, eax
+                          "\x8B\x14\x24"                   // mov edx, [rsp]
+                          "\x21\xD0"                       // and eax, edx
+                          "\xA8\x01");                     // test al, 1
+        not_integers = EZOM_JIT_JUMP(cg, "\x0F\x84");
+        ezom_jit_integer_op(cg, primitive, &overflow);
+        EZOM_JIT_EMIT(cg, "\x48\x83\xC4\x08");             // add rsp, 8
+        done = EZOM_JIT_JUMP(cg, "\xE9");
+        ezom_jit_land(cg, not_integers);
+        if (overflow) ezom_jit_land(cg, overflow);
+        EZOM_JIT_EMIT(cg, "\x89\xC8");                     // mov eax, ecx
+    }
+
+    if (arg_count) ezom_jit_push(cg);
+    ezom_jit_load_rdi(cg, node);
+    EZOM_JIT_EMIT(cg, "\x48\x89\xE6");                     // mov rsi, rsp
+    ezom_jit_call(cg, ezom_jit_send);
+    ezom_jit_drop(cg, arg_count + 1);
+    ezom_jit_check_unwind(cg);
+
+    if (primitive) ezom_jit_land(cg, done);
+}
+
+// Statements in order; the scratch Doubles of each finished one but the
+// last are dead. mark 0 takes a fresh mark, UINT32_MAX uses the method's.
+static void ezom_jit_statements(ezom_jit_buffer_t* cg, ezom_ast_node_t* list, uint32_t mark) {
+    ezom_ast_node_t* statement = list->data.statement_list.statements;
+    if (!statement) {
+        ezom_jit_load_constant(cg, g_nil);
+        return;
+    }
+    if (!statement->next) {
+        ezom_jit_expression(cg, statement);
+        return;
+    }
+
+    bool own_mark = mark != UINT32_MAX;
+    if (own_mark) mark = ezom_jit_push_mark(cg);
+    for (; statement; statement = statement->next) {
+        ezom_jit_expression(cg, statement);
+        if (statement->next) ezom_jit_release(cg, mark);
+    }
+    if (own_mark) {
+        EZOM_JIT_EMIT(cg, "\x48\x83\xC4\x08");             // add rsp, 8 (keeps eax)
+        cg->depth--;
+    }
+}
+
+static void ezom_jit_expression(ezom_jit_buffer_t* cg, ezom_ast_node_t* node) {
+    if (cg->reject) return;
+    if (!node) {
+        ezom_jit_load_constant(cg, g_nil);
+        return;
+    }
+
+    switch (node->type) {
+        case AST_LITERAL:
+            ezom_jit_literal(cg, node);
+            break;
+
+        case AST_VARIABLE_DEF:
+            ezom_jit_variable(cg, node);
+            break;
+
+        case AST_ASSIGNMENT:
+        case AST_INCREMENT:
+            ezom_jit_assignment(cg, node);
+            break;
+
+        case AST_RETURN:
+            ezom_jit_expression(cg, node->data.return_stmt.expression);
+            ezom_jit_exit(cg);
+            break;
+
+        case AST_MESSAGE_SEND:
+            if (node->data.message_send.inline_kind != AST_INLINE_NONE) {
+                ezom_jit_inlined_send(cg, node);
+            } else {
+                ezom_jit_send_node(cg, node);
+            }
+            break;
+
+        case AST_BLOCK:
+            // A closure over this frame, made as the interpreter makes it
+            if (node->data.block.inlined) {
+                cg->reject = "inlined block";
+                break;
+            }
+            ezom_jit_load_rdi(cg, node);
+            EZOM_JIT_EMIT(cg, "\x44\x89\xEE");             // mov esi, r13d
+            ezom_jit_call(cg, ezom_block_literal);
+            break;
+
+        case AST_STATEMENT_LIST:
+            ezom_jit_statements(cg, node, 0);
+            break;
+
+        default:
+            cg->reject = "node type";
+            break;
+    }
+}
+
+// ============================================================================
+// Compilation and entry
+// ============================================================================
+
+// The code region is never writable and executable at once: it stays
+// read/execute except while a compiled method is copied in
+static bool ezom_jit_protect_region(int prot) {
+    if (mprotect(g_jit_region, EZOM_JIT_CODE_SIZE, prot) == 0) {
+        return true;
+    }
+    printf("JIT: cannot change code region protection; interpreting\n");
+    g_jit_enabled = false;
+    return false;
+}
+
+static bool ezom_jit_reserve_region(void) {
+    if (g_jit_region) return true;
+
+    void* region = mmap(NULL, EZOM_JIT_CODE_SIZE, PROT_READ | PROT_WRITE,
+                        MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (region == MAP_FAILED) {
+        printf("JIT: cannot map %d bytes of executable memory; interpreting\n", EZOM_JIT_CODE_SIZE);
+        g_jit_enabled = false;
+        return false;
+    }
+    g_jit_region = (uint8_t*)region;
+    if (!ezom_jit_protect_region(PROT_READ | PROT_EXEC)) {
+        munmap(region, EZOM_JIT_CODE_SIZE);
+        g_jit_region = NULL;
+        return false;
+    }
+    return true;
+}
+
+// Make room for size more bytes, starting the region over if everything
+// in it assumed an older Integer or it is full. False while running code
+// keeps a full region in use.
+static bool ezom_jit_make_room(uint32_t size) {
+    uint32_t version = ezom_class_version(g_integer_class);
+    bool stale = g_jit_region_used && g_jit_region_version != version;
+    bool full = g_jit_region_used + size > EZOM_JIT_CODE_SIZE;
+    
+    if ((stale || full) && !g_jit_running) {
+        g_jit_region_generation++;
+        g_jit_region_used = 0;
+        g_jit_stats.region_resets++;
+        return true;
+    }
+    return !full;
+}
+
+static ezom_jit_method_t* ezom_jit_compile(ezom_method_code_t* method_code) {
+    ezom_ast_node_t* method_ast = (ezom_ast_node_t*)method_code->ast_node;
+    ezom_jit_buffer_t* cg = &g_jit_buffer;
+
+    cg->size = 0;
+    cg->depth = 0;
+    cg->exit_count = 0;
+    cg->uses_fields = false;
+    cg->reject = NULL;
+    cg->retry = false;
+
+    // Prologue: save rbp and the callee-saved registers the templates
+    // use, and leave rsp 16-byte aligned
+    EZOM_JIT_EMIT(cg, "\x55"                               // push rbp
+                      "\x48\x89\xE5"                       // mov rbp, rsp
+                      "\x53\x41\x54\x41\x55\x41\x56\x41\x57"   // push rbx, r12-r15
+                      "\x48\x83\xEC\x08"                   // sub rsp, 8
+                      "\x48\x89\xFB"                       // mov rbx, rdi (locals)
+                      "\x49\x89\xF6"                       // mov r14, rsi (fields)
+                      "\x41\x89\xD4"                       // mov r12d, edx (self)
+                      "\x41\x89\xCD"                       // mov r13d, ecx (context)
+                      "\x45\x89\xC7");                     // mov r15d, r8d (scratch mark)
+
+    // A method without ^ answers self
+    ezom_ast_node_t* body = method_ast->data.method_def.body;
+    if (body && body->type == AST_STATEMENT_LIST) {
+        ezom_jit_statements(cg, body, UINT32_MAX);
+    } else {
+        ezom_jit_expression(cg, body);
+    }
+    EZOM_JIT_EMIT(cg, "\x44\x89\xE0");                     // mov eax, r12d
+
+    for (uint16_t i = 0; i < cg->exit_count; i++) {
+        ezom_jit_land(cg, cg->exits[i]);
+    }
+    EZOM_JIT_EMIT(cg, "\x48\x8D\x65\xD8"                   // lea rsp, [rbp - 40]
+                      "\x41\x5F\x41\x5E\x41\x5D\x41\x5C\x5B"   // pop r15-r12, rbx
+                      "\x5D"                               // pop rbp
+                      "\xC3");                             // ret
+
+    uint32_t total = (uint32_t)((sizeof(ezom_jit_method_t) + 15) & ~15u) + cg->size;
+    if (!cg->reject && total > EZOM_JIT_CODE_SIZE) {
+        cg->reject = "larger than the code region";
+    }
+    if (!cg->reject && !ezom_jit_make_room(total)) {
+        printf("JIT: %s waits for code space\n", method_ast->data.method_def.selector);
+        cg->retry = true;
+        return NULL;
+    }
+    if (cg->reject) {
+        printf("JIT: %s stays interpreted (%s)\n", method_ast->data.method_def.selector, cg->reject);
+        g_jit_stats.rejected++;
+        return NULL;
+    }
+
+    if (!ezom_jit_protect_region(PROT_READ | PROT_WRITE)) {
+        return NULL;
+    }
+    ezom_jit_method_t* jit = (ezom_jit_method_t*)(g_jit_region + g_jit_region_used);
+    uint8_t* code = (uint8_t*)jit + (total - cg->size);
+    memcpy(code, cg->bytes, cg->size);
+    jit->entry = (ezom_jit_entry_t)(void*)code;
+    jit->version = ezom_class_version(g_integer_class);
+    jit->size = cg->size;
+    jit->uses_fields = cg->uses_fields;
+    g_jit_region_used += total;
+    g_jit_region_version = jit->version;
+    method_code->jit_region = g_jit_region_generation;
+    if (!ezom_jit_protect_region(PROT_READ | PROT_EXEC)) {
+        return NULL;
+    }
+
+    g_jit_stats.compiled++;
+    g_jit_stats.code_bytes = g_jit_region_used;
+    printf("JIT: compiled %s (%lu bytes)\n", method_ast->data.method_def.selector, (unsigned long)cg->size);
+    return jit;
+}
+
+// Count an activation; answers the machine code to run it with, if any
+ezom_jit_method_t* ezom_jit_method_for(ezom_method_code_t* method_code, uint24_t receiver) {
+    if (!g_jit_enabled || method_code->jit_counter == EZOM_JIT_REJECTED) {
+        return NULL;
+    }
+
+    ezom_jit_method_t* jit = method_code->jit;
+    if (jit && (method_code->jit_region != g_jit_region_generation ||
+                jit->version != ezom_class_version(g_integer_class))) {
+        // The region started over, or inline SmallInteger operations may
+        // no longer be Integer's
+        method_code->jit = jit = NULL;
+        method_code->jit_counter = 0;
+        g_jit_stats.invalidated++;
+    }
+
+    if (!jit) {
+        if (++method_code->jit_counter < g_jit_threshold || !ezom_jit_reserve_region()) {
+            return NULL;
+        }
+        jit = ezom_jit_compile(method_code);
+        if (!jit) {
+            // Out of code space only until the region can start over
+            method_code->jit_counter = g_jit_buffer.retry ? 0 : EZOM_JIT_REJECTED;
+            return NULL;
+        }
+        method_code->jit = jit;
+    }
+
+    // Fields are read through a pointer: self must be a heap object
+    if (jit->uses_fields && EZOM_IS_SMALLINT(receiver)) {
+        return NULL;
+    }
+    return jit;
+}
+
+// Run the machine code in method_context, already pushed and bound
+ezom_eval_result_t ezom_jit_run(ezom_jit_method_t* jit, ezom_method_code_t* method_code,
+                                uint24_t receiver, uint24_t method_context) {
+    ezom_ast_node_t* method_ast = (ezom_ast_node_t*)method_code->ast_node;
+    ezom_context_t* context = (ezom_context_t*)EZOM_OBJECT_PTR(method_context);
+    uint24_t* fields = EZOM_IS_SMALLINT(receiver) ? NULL :
+                       (uint24_t*)((char*)EZOM_OBJECT_PTR(receiver) + sizeof(ezom_object_t));
+
+    ezom_box_locals(method_context, method_ast->data.method_def.boxed,
+                    method_ast->data.method_def.boxed_count);
+
+    uint24_t old_context = g_current_context;
+    g_current_context = method_context;
+    g_jit_stats.runs++;
+    g_jit_running++;
+    uint24_t value = jit->entry(context->locals, fields, receiver, method_context,
+                                ezom_double_scratch_mark());
+    g_jit_running--;
+    g_current_context = old_context;
+
+    const char* error = g_jit_error;
+    g_jit_error = NULL;
+    if (error) {
+        return ezom_make_error_result(error);
+    }
+    if (g_frame_stack.overflow) {
+        return ezom_make_error_result("Stack overflow");
+    }
+    return ezom_make_return_result(value);
+}
+
+void ezom_jit_print_stats(void) {
+    printf("\n=== JIT ===\n");
+    printf("Threshold: %u activations%s\n", g_jit_threshold, g_jit_enabled ? "" : " (disabled)");
+    printf("Compiled: %lu, rejected: %lu, invalidated: %lu\n",
+           (unsigned long)g_jit_stats.compiled, (unsigned long)g_jit_stats.rejected,
+           (unsigned long)g_jit_stats.invalidated);
+    printf("Code: %lu of %d bytes (region reset %lu times)\n", (unsigned long)g_jit_stats.code_bytes,
+           EZOM_JIT_CODE_SIZE, (unsigned long)g_jit_stats.region_resets);
+    printf("Activations run as machine code: %lu\n", (unsigned long)g_jit_stats.runs);
+    printf("===========\n\n");
+}
+
+#endif // EZOM_JIT
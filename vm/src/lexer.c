@@ -3,6 +3,7 @@
 // Lexical analyzer implementation
 // ============================================================================
 
+#define _DEFAULT_SOURCE     // strndup under -std=c99
 #include "../include/ezom_lexer.h"
 #include <stdio.h>
 #include <stdlib.h>
@@ -20,6 +21,7 @@ static void ezom_lexer_read_symbol(ezom_lexer_t* lexer);
 static void ezom_lexer_read_comment(ezom_lexer_t* lexer);
 static void ezom_lexer_read_identifier(ezom_lexer_t* lexer);
 static void ezom_lexer_read_integer(ezom_lexer_t* lexer);
+static void ezom_lexer_read_double(ezom_lexer_t* lexer, char* start);
 static void ezom_lexer_read_separator(ezom_lexer_t* lexer);
 static void ezom_lexer_make_token(ezom_lexer_t* lexer, ezom_token_type_t type);
 
@@ -57,8 +59,15 @@ void ezom_lexer_next_token(ezom_lexer_t* lexer) {
         case '+': ezom_lexer_make_token(lexer, TOKEN_PLUS); break;
         case '*': ezom_lexer_make_token(lexer, TOKEN_MULTIPLY); break;
         case '/': ezom_lexer_make_token(lexer, TOKEN_DIVIDE); break;
-        case '<': ezom_lexer_make_token(lexer, TOKEN_LT); break;
-        case '>': ezom_lexer_make_token(lexer, TOKEN_GT); break;
+        case '<':
+        case '>':
+            // <= and >= are one binary selector
+            ezom_lexer_make_token(lexer, ch == '<' ? TOKEN_LT : TOKEN_GT);
+            if (ezom_lexer_peek(lexer) == '=') {
+                ezom_lexer_advance(lexer);
+                lexer->current_token.length = 2;
+            }
+            break;
         case '\n': 
             lexer->line++;
             lexer->column = 1;
@@ -275,14 +284,56 @@ static void ezom_lexer_read_integer(ezom_lexer_t* lexer) {
         ezom_lexer_advance(lexer);
     }
     
+    // "1.5" is a Double; "1." followed by anything else ends a statement
+    if (ezom_lexer_peek(lexer) == '.' && isdigit(ezom_lexer_peek_next(lexer))) {
+        ezom_lexer_read_double(lexer, start);
+        return;
+    }
+    
     uint16_t length = lexer->current - start;
     lexer->current_token.type = TOKEN_INTEGER;
     lexer->current_token.text = start;
     lexer->current_token.length = length;
     
-    // Parse integer value
+    // Accumulate toward the sign so the most negative value still parses
+    ezom_large_int_t value = 0;
+    for (char* digit = negative ? start + 1 : start; digit < lexer->current; digit++) {
+        ezom_large_int_t d = *digit - '0';
+        if (__builtin_mul_overflow(value, 10, &value) ||
+            (negative ? __builtin_sub_overflow(value, d, &value)
+                      : __builtin_add_overflow(value, d, &value))) {
+            ezom_lexer_error(lexer, "Integer literal too large");
+            value = 0;
+            break;
+        }
+    }
+    lexer->current_token.value.int_value = value;
+}
+
+// Fraction and optional exponent after the integer part at start
+static void ezom_lexer_read_double(ezom_lexer_t* lexer, char* start) {
+    ezom_lexer_advance(lexer);  // '.'
+    while (isdigit(ezom_lexer_peek(lexer))) {
+        ezom_lexer_advance(lexer);
+    }
+    
+    if (ezom_lexer_peek(lexer) == 'e' &&
+        (isdigit(ezom_lexer_peek_next(lexer)) ||
+         (ezom_lexer_peek_next(lexer) == '-' && isdigit(lexer->current[2])))) {
+        ezom_lexer_advance(lexer);  // 'e'
+        if (ezom_lexer_peek(lexer) == '-') ezom_lexer_advance(lexer);
+        while (isdigit(ezom_lexer_peek(lexer))) {
+            ezom_lexer_advance(lexer);
+        }
+    }
+    
+    uint16_t length = lexer->current - start;
+    lexer->current_token.type = TOKEN_DOUBLE;
+    lexer->current_token.text = start;
+    lexer->current_token.length = length;
+    
     char* temp = strndup(start, length);
-    lexer->current_token.value.int_value = (int16_t)atoi(temp);
+    lexer->current_token.value.double_value = strtod(temp, NULL);
     free(temp);
 }
 
@@ -301,6 +352,22 @@ static void ezom_lexer_make_token(ezom_lexer_t* lexer, ezom_token_type_t type) {
     lexer->current_token.column = lexer->column;
     lexer->current_token.text = NULL;
     lexer->current_token.length = 0;
+    
+    // Operator characters double as binary selectors, so keep their text
+    switch (type) {
+        case TOKEN_PLUS:
+        case TOKEN_MINUS:
+        case TOKEN_MULTIPLY:
+        case TOKEN_DIVIDE:
+        case TOKEN_LT:
+        case TOKEN_GT:
+        case TOKEN_EQUALS:
+            lexer->current_token.text = lexer->current - 1;
+            lexer->current_token.length = 1;
+            break;
+        default:
+            break;
+    }
 }
 
 // Utility functions
@@ -311,6 +378,7 @@ const char* ezom_token_type_name(ezom_token_type_t type) {
         case TOKEN_IDENTIFIER: return "IDENTIFIER";
         case TOKEN_STRING: return "STRING";
         case TOKEN_INTEGER: return "INTEGER";
+        case TOKEN_DOUBLE: return "DOUBLE";
         case TOKEN_SYMBOL: return "SYMBOL";
         case TOKEN_LPAREN: return "LPAREN";
         case TOKEN_RPAREN: return "RPAREN";
@@ -349,7 +417,9 @@ void ezom_token_print(ezom_token_t* token) {
     }
     
     if (token->type == TOKEN_INTEGER) {
-        printf(" value=%d", token->value.int_value);
+        printf(" value=%ld", (long)token->value.int_value);
+    } else if (token->type == TOKEN_DOUBLE) {
+        printf(" value=%g", token->value.double_value);
     } else if (token->type == TOKEN_STRING || token->type == TOKEN_IDENTIFIER || token->type == TOKEN_SYMBOL) {
         if (token->value.string_value) {
             printf(" value='%s'", token->value.string_value);
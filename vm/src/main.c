@@ -17,27 +17,7 @@
 #include <stdio.h>
 #include <string.h>
 
-// Global class pointers (basic classes)
-uint24_t g_object_class = 0;
-uint24_t g_class_class = 0;
-uint24_t g_integer_class = 0;
-uint24_t g_string_class = 0;
-uint24_t g_symbol_class = 0;
-
-// Enhanced global class pointers
-uint24_t g_array_class = 0;
-uint24_t g_block_class = 0;
-uint24_t g_boolean_class = 0;
-uint24_t g_true_class = 0;
-uint24_t g_false_class = 0;
-uint24_t g_nil_class = 0;
-uint24_t g_context_class = 0;
-
-// Global singleton objects
-uint24_t g_nil = 0;
-uint24_t g_true = 0;
-uint24_t g_false = 0;
-// Note: g_current_context is defined in context.c
+// Global class pointers and singletons are defined in globals.c
 
 // Function to wait for user input
 void wait_for_continue() {
@@ -107,8 +87,8 @@ int main(int argc, char* argv[]) {
     
     if (int1 && int2) {
         printf("   Created integers: %d and %d\n", 
-               ((ezom_integer_t*)EZOM_OBJECT_PTR(int1))->value,
-               ((ezom_integer_t*)EZOM_OBJECT_PTR(int2))->value);
+               (int)EZOM_SMALLINT_VALUE(int1),
+               (int)EZOM_SMALLINT_VALUE(int2));
     }
     
     // Test 2: Create strings
@@ -196,8 +176,7 @@ int main(int argc, char* argv[]) {
             
             uint24_t result = ezom_send_binary_message(int1, plus_selector, int2);
             if (result) {
-                ezom_integer_t* res = (ezom_integer_t*)EZOM_OBJECT_PTR(result);
-                printf("   42 + 8 = %d\n", res->value);
+                printf("   42 + 8 = %d\n", (int)EZOM_SMALLINT_VALUE(result));
                 
                 // Test println
                 if (println_selector) {
@@ -322,9 +301,8 @@ int main(int argc, char* argv[]) {
             printf("   Object with data created successfully\n");
             ezom_log("   Object with data created successfully\n");
             
-            ezom_integer_t* obj = (ezom_integer_t*)EZOM_OBJECT_PTR(test_obj);
-            printf("   Object value: %d\n", obj->value);
-            ezom_log("   Object value: %d\n", obj->value);
+            printf("   Object value: %d\n", (int)EZOM_SMALLINT_VALUE(test_obj));
+            ezom_log("   Object value: %d\n", (int)EZOM_SMALLINT_VALUE(test_obj));
         }
         
         // Test 9: Inheritance test (using existing class hierarchy)
@@ -418,8 +396,7 @@ int main(int argc, char* argv[]) {
         if (mod_selector) {
             uint24_t result = ezom_send_binary_message(num1, mod_selector, num2);
             if (result) {
-                ezom_integer_t* res = (ezom_integer_t*)EZOM_OBJECT_PTR(result);
-                printf("   10 \\\\ 3 = %d\n", res->value);
+                printf("   10 \\\\ 3 = %d\n", (int)EZOM_SMALLINT_VALUE(result));
             }
         }
         
@@ -490,8 +467,7 @@ int main(int argc, char* argv[]) {
         if (length_selector) {
             uint24_t result = ezom_send_unary_message(array, length_selector);
             if (result) {
-                ezom_integer_t* len = (ezom_integer_t*)EZOM_OBJECT_PTR(result);
-                printf("   array length = %d\n", len->value);
+                printf("   array length = %d\n", (int)EZOM_SMALLINT_VALUE(result));
             }
         }
     }
@@ -556,7 +532,7 @@ int main(int argc, char* argv[]) {
         
         switch (lexer.current_token.type) {
             case TOKEN_INTEGER:
-                printf("   -> INTEGER: %d\n", lexer.current_token.value.int_value);
+                printf("   -> INTEGER: %ld\n", (long)lexer.current_token.value.int_value);
                 break;
             case TOKEN_STRING:
                 printf("   -> STRING: '%s'\n", lexer.current_token.value.string_value);
@@ -577,8 +553,7 @@ int main(int argc, char* argv[]) {
     // Test AST-based expression evaluation
     uint24_t ast_result = ezom_ast_test_simple_expression();
     if (ast_result) {
-        ezom_integer_t* res = (ezom_integer_t*)EZOM_OBJECT_PTR(ast_result);
-        printf("   AST evaluation of '5 + 3' = %d ✓\n", res->value);
+        printf("   AST evaluation of '5 + 3' = %d ✓\n", (int)EZOM_SMALLINT_VALUE(ast_result));
     } else {
         printf("   AST evaluation failed ✗\n");
     }
@@ -590,8 +565,7 @@ int main(int argc, char* argv[]) {
     printf("   → Testing: (10 + 5) * 2\n");
     ast_result = ezom_ast_test_nested_arithmetic();
     if (ast_result) {
-        ezom_integer_t* res = (ezom_integer_t*)EZOM_OBJECT_PTR(ast_result);
-        printf("     Result: %d ✓\n", res->value);
+        printf("     Result: %d ✓\n", (int)EZOM_SMALLINT_VALUE(ast_result));
     } else {
         printf("     Failed ✗\n");
     }
@@ -600,8 +574,7 @@ int main(int argc, char* argv[]) {
     printf("   → Testing: 20 - 5 + 3\n");
     ast_result = ezom_ast_test_chain_operations();
     if (ast_result) {
-        ezom_integer_t* res = (ezom_integer_t*)EZOM_OBJECT_PTR(ast_result);
-        printf("     Result: %d ✓\n", res->value);
+        printf("     Result: %d ✓\n", (int)EZOM_SMALLINT_VALUE(ast_result));
     } else {
         printf("     Failed ✗\n");
     }
@@ -610,8 +583,7 @@ int main(int argc, char* argv[]) {
     printf("   → Testing: 100 / 4 + 15 * 2\n");
     ast_result = ezom_ast_test_mixed_operations();
     if (ast_result) {
-        ezom_integer_t* res = (ezom_integer_t*)EZOM_OBJECT_PTR(ast_result);
-        printf("     Result: %d ✓\n", res->value);
+        printf("     Result: %d ✓\n", (int)EZOM_SMALLINT_VALUE(ast_result));
     } else {
         printf("     Failed ✗\n");
     }
@@ -635,8 +607,7 @@ int main(int argc, char* argv[]) {
     printf("   → Testing: ((8 + 2) * 3) - (5 + 1)\n");
     ast_result = ezom_ast_test_deep_nesting();
     if (ast_result) {
-        ezom_integer_t* res = (ezom_integer_t*)EZOM_OBJECT_PTR(ast_result);
-        printf("     Result: %d ✓\n", res->value);
+        printf("     Result: %d ✓\n", (int)EZOM_SMALLINT_VALUE(ast_result));
     } else {
         printf("     Failed ✗\n");
     }
@@ -1190,8 +1161,9 @@ int main(int argc, char* argv[]) {
     
     // Test 1: Load hello_world.som
     printf("\n1. Loading hello_world.som:\n");
-    EZOM_FILE_EVAL_ERROR result = ezom_load_som_class_file("test_programs/hello_world.som");
-    if (result == EZOM_FILE_EVAL_SUCCESS) {
+    uint24_t loaded_class;
+    ezom_file_result_t result = ezom_load_som_class_file("test_programs/hello_world.som", &loaded_class);
+    if (result == EZOM_FILE_OK) {
         printf("   ✓ hello_world.som loaded successfully\n");
     } else {
         printf("   ✗ hello_world.som failed to load (error: %d)\n", result);
@@ -1199,8 +1171,8 @@ int main(int argc, char* argv[]) {
     
     // Test 2: Load counter.som
     printf("\n2. Loading counter.som:\n");
-    result = ezom_load_som_class_file("test_programs/counter.som");
-    if (result == EZOM_FILE_EVAL_SUCCESS) {
+    result = ezom_load_som_class_file("test_programs/counter.som", &loaded_class);
+    if (result == EZOM_FILE_OK) {
         printf("   ✓ counter.som loaded successfully\n");
     } else {
         printf("   ✗ counter.som failed to load (error: %d)\n", result);
@@ -1208,8 +1180,8 @@ int main(int argc, char* argv[]) {
     
     // Test 3: Load basic_math.som
     printf("\n3. Loading basic_math.som:\n");
-    result = ezom_load_som_class_file("test_programs/basic_math.som");
-    if (result == EZOM_FILE_EVAL_SUCCESS) {
+    result = ezom_load_som_class_file("test_programs/basic_math.som", &loaded_class);
+    if (result == EZOM_FILE_OK) {
         printf("   ✓ basic_math.som loaded successfully\n");
     } else {
         printf("   ✗ basic_math.som failed to load (error: %d)\n", result);
@@ -1218,7 +1190,7 @@ int main(int argc, char* argv[]) {
     // Test 4: Load entire directory
     printf("\n4. Loading all files from test_programs directory:\n");
     result = ezom_load_som_directory("test_programs");
-    if (result == EZOM_FILE_EVAL_SUCCESS) {
+    if (result == EZOM_FILE_OK) {
         printf("   ✓ test_programs directory loaded successfully\n");
     } else {
         printf("   ✗ test_programs directory failed to load (error: %d)\n", result);
@@ -0,0 +1,107 @@
+// ============================================================================
+// File: src/main_aotc.c
+// ezom_aotc: translate a .som class file to C for an ezom_native -DEZOM_AOT build
+// ============================================================================
+
+#include "../include/ezom_memory.h"
+#include "../include/ezom_object.h"
+#include "../include/ezom_primitives.h"
+#include "../include/ezom_context.h"
+#include "../include/ezom_aotc.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static void ezom_aotc_usage(const char* program_name) {
+    fprintf(stderr, "Usage: %s [--source-only] [-o OUTPUT.c] FILE.som\n", program_name);
+    fprintf(stderr, "  -o OUTPUT.c      Where to write the C (default: FILE.c)\n");
+    fprintf(stderr, "  --source-only    Keep every method as source: the interpreted baseline\n");
+}
+
+static char* ezom_aotc_read_file(const char* filename) {
+    FILE* file = fopen(filename, "rb");
+    if (!file) return NULL;
+
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    char* text = malloc(size + 1);
+    if (text && fread(text, 1, size, file) != (size_t)size) {
+        free(text);
+        text = NULL;
+    }
+    if (text) text[size] = '\0';
+    fclose(file);
+    return text;
+}
+
+int main(int argc, char* argv[]) {
+    const char* input = NULL;
+    const char* output = NULL;
+    bool translate = true;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+            output = argv[++i];
+        } else if (strcmp(argv[i], "--source-only") == 0) {
+            translate = false;
+        } else if (argv[i][0] != '-' && !input) {
+            input = argv[i];
+        } else {
+            ezom_aotc_usage(argv[0]);
+            return 1;
+        }
+    }
+    if (!input) {
+        ezom_aotc_usage(argv[0]);
+        return 1;
+    }
+
+    char* source = ezom_aotc_read_file(input);
+    if (!source) {
+        fprintf(stderr, "%s: cannot read %s\n", argv[0], input);
+        return 1;
+    }
+
+    // FILE.som -> FILE.c
+    char default_output[1024];
+    if (!output) {
+        snprintf(default_output, sizeof(default_output), "%s", input);
+        char* extension = strrchr(default_output, '.');
+        if (extension && strcmp(extension, ".som") == 0) *extension = '\0';
+        strncat(default_output, ".c", sizeof(default_output) - strlen(default_output) - 1);
+        output = default_output;
+    }
+
+    // The classes are defined in a VM as they are translated, so the
+    // resolver can place instance variables and inline control flow
+    g_nil = 1;
+    ezom_init_memory();
+    ezom_init_object_system();
+    ezom_init_primitives();
+    ezom_bootstrap_enhanced_classes();
+    ezom_init_context_system();
+    ezom_init_boolean_objects();
+
+    FILE* out = fopen(output, "w");
+    if (!out) {
+        fprintf(stderr, "%s: cannot write %s\n", argv[0], output);
+        free(source);
+        return 1;
+    }
+
+    const char* source_name = strrchr(input, '/') ? strrchr(input, '/') + 1 : input;
+    ezom_aotc_stats_t stats = {0, 0, 0};
+    bool ok = ezom_aotc_translate_file(source, source_name, out, translate, &stats);
+    fclose(out);
+    free(source);
+
+    if (!ok) {
+        remove(output);
+        return 1;
+    }
+    fprintf(stderr, "%s -> %s: %u classes, %u methods as C, %u as source\n",
+            input, output, stats.classes, stats.translated, stats.kept);
+    return 0;
+}
@@ -14,6 +14,14 @@
 #include "../include/ezom_ast.h"
 #include "../include/ezom_ast_memory.h"
 #include "../include/ezom_file_loader.h"
+#include "../include/ezom_bytecode.h"
+#include "../include/ezom_optimizer.h"
+#ifdef EZOM_JIT
+#include "../include/ezom_jit.h"
+#endif
+#ifdef EZOM_AOT
+#include "../include/ezom_aot.h"
+#endif
 #include <stdio.h>
 #include <string.h>
 
@@ -100,6 +108,36 @@ int main(int argc, char* argv[]) {
     
     // Parse command line arguments
     ezom_args_t args = ezom_parse_arguments(argc, argv);
+    ezom_set_dispatch_mode((ezom_dispatch_mode_t)args.dispatch_mode);
+    ezom_set_engine((ezom_engine_t)args.engine);
+    ezom_set_max_depth(args.max_depth);
+    ezom_optimizer_configure(!args.no_optimize, args.verbose_mode);
+#ifdef EZOM_JIT
+    ezom_jit_configure(!args.no_jit, args.jit_threshold);
+#else
+    if (args.no_jit || args.jit_threshold) {
+        printf("Built without the JIT (-DEZOM_JIT): JIT options ignored\n");
+    }
+#endif
+    
+#ifdef EZOM_AOT
+    // Classes translated by ezom_aotc replace parsing the program
+    if (!ezom_aot_load_program(&ezom_aot_program)) {
+        ezom_log_close();
+        return 1;
+    }
+    if (!args.eval_code && !args.interactive_mode && !args.filename) {
+        int exit_code = ezom_aot_run_program(&ezom_aot_program, args.main_class);
+        if (args.verbose_mode) {
+            ezom_aot_print_stats();
+            ezom_optimizer_print_stats();
+            ezom_specialize_print_stats();
+            ezom_frame_print_stats();
+        }
+        ezom_log_close();
+        return exit_code;
+    }
+#endif
     
     // If no arguments, run VM tests and exit
     if (argc == 1) {
@@ -138,7 +176,7 @@ int main(int argc, char* argv[]) {
         // Execute file
         printf("Loading file: %s\n", args.filename);
         uint24_t result;
-        ezom_file_result_t status = ezom_execute_som_file(args.filename, &result);
+        ezom_file_result_t status = ezom_execute_som_file(args.filename, args.main_class, &result);
         
         if (status == EZOM_FILE_OK) {
             printf("Program executed successfully\n");
@@ -161,6 +199,16 @@ int main(int argc, char* argv[]) {
     if (args.verbose_mode) {
         printf("\n=== Memory Statistics ===\n");
         ezom_detailed_memory_stats();
+        ezom_bytecode_print_stats();
+        ezom_optimizer_print_stats();
+        ezom_specialize_print_stats();
+#ifdef EZOM_JIT
+        ezom_jit_print_stats();
+#endif
+#ifdef EZOM_AOT
+        ezom_aot_print_stats();
+#endif
+        ezom_frame_print_stats();
     }
     
     // Cleanup
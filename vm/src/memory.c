@@ -6,6 +6,7 @@
 #include "../include/ezom_memory.h"
 #include "../include/ezom_object.h"
 #include "../include/ezom_platform.h"
+#include "../include/ezom_dispatch.h"
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
@@ -15,8 +16,9 @@ ezom_heap_t g_heap;
 
 void ezom_init_memory(void) {
 #ifdef EZOM_PLATFORM_NATIVE
-    // For native development - allocate heap using malloc
-    g_heap_base = malloc(EZOM_HEAP_SIZE);
+    // For native development - allocate heap using malloc, with the
+    // frame stack region reserved after it
+    g_heap_base = malloc(EZOM_HEAP_SIZE + EZOM_FRAME_STACK_SIZE);
     if (!g_heap_base) {
         printf("EZOM: Failed to allocate heap memory!\n");
         exit(1);
@@ -189,6 +191,7 @@ void ezom_detailed_memory_stats(void) {
     printf("  Arrays:   %d\n", g_heap.array_objects);
     printf("  Blocks:   %d\n", g_heap.block_objects);
     printf("  Other:    %d\n", g_heap.other_objects);
+    printf("  Interned symbols: %d\n", ezom_symbol_table_size());
     
     printf("\nGC Status:\n");
     printf("  GC Enabled: %s\n", g_heap.gc_enabled ? "Yes" : "No");
@@ -437,7 +440,8 @@ bool ezom_is_marked(uint24_t obj) {
 
 // Mark an object as reachable
 void ezom_mark_object(uint24_t obj) {
-    if (!obj || !ezom_is_valid_object(obj)) {
+    // SmallIntegers are immediates with no heap storage to keep alive
+    if (!obj || EZOM_IS_SMALLINT(obj) || !ezom_is_valid_object(obj)) {
         return;
     }
     
@@ -486,7 +490,10 @@ void ezom_clear_all_marks(void) {
             
             switch (type) {
                 case EZOM_TYPE_INTEGER:
-                    obj_size = sizeof(ezom_object_t) + sizeof(int16_t);
+                    obj_size = sizeof(ezom_large_integer_t);
+                    break;
+                case EZOM_TYPE_DOUBLE:
+                    obj_size = sizeof(ezom_double_t);
                     break;
                 case EZOM_TYPE_STRING:
                 case EZOM_TYPE_SYMBOL: {
@@ -552,6 +559,19 @@ void ezom_mark_object_references(uint24_t obj) {
             // Mark method dictionary
             if (class_obj->method_dict) {
                 ezom_mark_object(class_obj->method_dict);
+                
+                // The dictionary is a plain object to the collector, so its
+                // selector array (interned symbols), method record block and
+                // method code are marked here
+                ezom_method_dict_t* dict = (ezom_method_dict_t*)EZOM_OBJECT_PTR(class_obj->method_dict);
+                ezom_mark_object(dict->selectors);
+                ezom_mark_object(dict->methods);
+                for (uint16_t i = 0; i < dict->capacity; i++) {
+                    ezom_method_t* method = ezom_method_dict_entry_at(dict, i);
+                    if (method && !(method->flags & EZOM_METHOD_PRIMITIVE)) {
+                        ezom_mark_object(method->code);
+                    }
+                }
             }
             break;
         }
@@ -567,13 +587,15 @@ void ezom_mark_object_references(uint24_t obj) {
             // Note: block->code is an AST node (native pointer), not an EZOM object
             // AST nodes are not garbage collected by the EZOM memory system
             
-            // Note: captured_vars array would need more complex handling
-            // For now, we'll skip it as it's a variable-length array
+            for (uint8_t i = 0; i < block->capture_count; i++) {
+                ezom_mark_object(block->captured_vars[i]);
+            }
             break;
         }
         
         // Primitive types (integer, string, symbol) have no references
         case EZOM_TYPE_INTEGER:
+        case EZOM_TYPE_DOUBLE:
         case EZOM_TYPE_STRING:
         case EZOM_TYPE_SYMBOL:
         case EZOM_TYPE_BOOLEAN:
@@ -591,6 +613,11 @@ void ezom_mark_object_references(uint24_t obj) {
 void ezom_mark_from_roots(void) {
     printf("EZOM: Marking from %d GC roots...\n", g_gc_roots.count);
     
+    // Scratch cells are reused in place, never collected
+    for (uint24_t cell = g_double_scratch.base; cell < g_double_scratch.limit; cell += EZOM_DOUBLE_CELL_SIZE) {
+        ezom_mark_object(cell);
+    }
+    
     for (uint8_t i = 0; i < g_gc_roots.count; i++) {
         uint24_t root = g_gc_roots.roots[i];
         if (root) {
@@ -822,6 +849,9 @@ bool ezom_full_garbage_collection(void) {
     printf("EZOM: GC Phase 1 - Marking reachable objects\n");
     ezom_mark_phase();
     
+    // The symbol table is weak: forget symbols that are about to be swept
+    ezom_symbol_table_sweep();
+    
     // Phase 2: Sweep unreachable objects
     printf("EZOM: GC Phase 2 - Sweeping unreachable objects\n");
     uint16_t objects_collected = ezom_sweep_phase();
@@ -837,6 +867,9 @@ bool ezom_full_garbage_collection(void) {
     g_gc_stats.objects_after_gc = g_heap.objects_allocated;
     g_gc_stats.fragmentation_after_gc = ezom_calculate_fragmentation();
     
+    // Swept selectors/classes may be reused, so cached lookups are unsafe
+    ezom_method_cache_flush();
+    
     // Reset GC trigger
     g_heap.bytes_since_last_gc = 0;
     
@@ -859,7 +892,7 @@ uint16_t ezom_sweep_phase(void) {
         if (ezom_is_valid_object(current)) {
             ezom_object_t* obj = (ezom_object_t*)EZOM_OBJECT_PTR(current);
             
-            if (!(obj->flags & EZOM_FLAG_MARKED)) {
+            if (!(obj->flags & (EZOM_FLAG_MARKED | EZOM_FLAG_FIXED))) {
                 // Object is unmarked - it's garbage
                 uint16_t obj_size = ezom_calculate_object_size(current);
                 
@@ -932,7 +965,10 @@ uint16_t ezom_calculate_object_size(uint24_t obj_ptr) {
     
     switch (type) {
         case EZOM_TYPE_INTEGER:
-            return sizeof(ezom_integer_t);
+            return sizeof(ezom_large_integer_t);
+            
+        case EZOM_TYPE_DOUBLE:
+            return sizeof(ezom_double_t);
             
         case EZOM_TYPE_STRING:
         case EZOM_TYPE_SYMBOL: {
@@ -945,8 +981,10 @@ uint16_t ezom_calculate_object_size(uint24_t obj_ptr) {
             return sizeof(ezom_array_t) + (arr->size * sizeof(uint24_t));
         }
         
-        case EZOM_TYPE_BLOCK:
-            return sizeof(ezom_block_t);
+        case EZOM_TYPE_BLOCK: {
+            ezom_block_t* block = (ezom_block_t*)obj;
+            return sizeof(ezom_block_t) + (block->capture_count * sizeof(uint24_t));
+        }
             
         case EZOM_TYPE_CLASS: {
             ezom_class_t* cls = (ezom_class_t*)obj;
@@ -1032,8 +1070,9 @@ bool ezom_should_gc_now(void) {
         return true;
     }
     
-    // Check if we're running low on memory
-    uint16_t available = EZOM_HEAP_SIZE - g_heap.bytes_allocated;
+    // Check if we're running low on memory (the 16-bit byte counter wraps
+    // on the native heap, so measure from the allocation pointer)
+    uint24_t available = EZOM_HEAP_END - g_heap.next_free;
     if (available < (EZOM_HEAP_SIZE / 10)) { // Less than 10% available
         return true;
     }
@@ -1110,4 +1149,133 @@ uint16_t ezom_gc_pressure(void) {
 // Simple wrapper function for garbage collection
 void ezom_garbage_collect(void) {
     ezom_trigger_garbage_collection();
-}
\ No newline at end of file
+}
+// ============================================================================
+// DOUBLE SCRATCH SPACE
+// ============================================================================
+//
+// A small stack of preallocated Double cells. Arithmetic primitives build
+// their results here, so an expression such as zr * zr - (zi * zi) + cr
+// does not touch the allocator for its intermediates. Statement lists and
+// loop primitives release the cells their finished statements used; any
+// store into a heap slot copies the value out first (ezom_promote_double),
+// and a frame variable keeps one Double of its own (ezom_store_slot_double).
+
+ezom_double_scratch_t g_double_scratch = {0, 0, 0, 0};
+
+void ezom_init_double_scratch(void) {
+    if (g_double_scratch.base) return;
+    
+    uint24_t base = ezom_allocate(EZOM_DOUBLE_SCRATCH_CELLS * EZOM_DOUBLE_CELL_SIZE);
+    if (!base) {
+        printf("EZOM: No room for double scratch space, Doubles will use the heap\n");
+        return;
+    }
+    
+    for (uint16_t i = 0; i < EZOM_DOUBLE_SCRATCH_CELLS; i++) {
+        ezom_init_object(base + i * EZOM_DOUBLE_CELL_SIZE, g_double_class, EZOM_TYPE_DOUBLE);
+    }
+    
+    g_double_scratch.base = base;
+    g_double_scratch.limit = base + EZOM_DOUBLE_SCRATCH_CELLS * EZOM_DOUBLE_CELL_SIZE;
+    g_double_scratch.top = 0;
+    g_double_scratch.spills = 0;
+}
+
+// Double result that only has to live until the current statement ends
+uint24_t ezom_scratch_double(double value) {
+    if (g_double_scratch.top >= EZOM_DOUBLE_SCRATCH_CELLS || !g_double_scratch.base) {
+        g_double_scratch.spills++;
+        return ezom_create_double(value);
+    }
+    
+    uint24_t cell = g_double_scratch.base + g_double_scratch.top++ * EZOM_DOUBLE_CELL_SIZE;
+    ((ezom_double_t*)EZOM_OBJECT_PTR(cell))->value = value;
+    return cell;
+}
+
+static bool ezom_is_slot_double(uint24_t value) {
+    return value && !EZOM_IS_SMALLINT(value) &&
+           (((ezom_object_t*)EZOM_OBJECT_PTR(value))->flags & EZOM_FLAG_SLOT_DOUBLE);
+}
+
+// Copy a scratch Double (or one a variable slot owns) to the heap before
+// it is stored; any other value is returned unchanged
+uint24_t ezom_promote_double(uint24_t value) {
+    if (!EZOM_IS_SCRATCH_DOUBLE(value) && !ezom_is_slot_double(value)) return value;
+    
+    uint24_t promoted = ezom_create_double(ezom_double_value(value));
+    return promoted ? promoted : g_nil;
+}
+
+// Frame variables hold Doubles by value. The first Double stored into a
+// slot gets a heap copy that only that slot references; later stores
+// overwrite it in place, so a loop updating a Double local does not
+// allocate. Answers what the slot (currently holding old) should hold.
+uint24_t ezom_store_slot_double(uint24_t old, uint24_t value) {
+    if (!value || EZOM_IS_SMALLINT(value)) return value;
+    
+    ezom_object_t* object = (ezom_object_t*)EZOM_OBJECT_PTR(value);
+    if ((object->flags & 0xF0) != EZOM_TYPE_DOUBLE) return value;
+    
+    if (ezom_is_slot_double(old)) {
+        ((ezom_double_t*)EZOM_OBJECT_PTR(old))->value = ezom_double_value(value);
+        return old;
+    }
+    if (object->flags & EZOM_FLAG_FIXED) return value;  // Literals are shared read-only
+    
+    uint24_t owned = ezom_create_double(ezom_double_value(value));
+    if (!owned) return g_nil;
+    ((ezom_object_t*)EZOM_OBJECT_PTR(owned))->flags |= EZOM_FLAG_SLOT_DOUBLE;
+    return owned;
+}
+
+// Reading a slot's own Double answers a scratch copy, so a later store
+// into the slot cannot change a value that is still in use
+uint24_t ezom_load_slot_double(uint24_t value) {
+    if (!ezom_is_slot_double(value)) return value;
+    return ezom_scratch_double(ezom_double_value(value));
+}
+
+uint16_t ezom_double_scratch_mark(void) {
+    return g_double_scratch.top;
+}
+
+void ezom_double_scratch_release(uint16_t mark) {
+    if (mark < g_double_scratch.top) {
+        g_double_scratch.top = mark;
+    }
+}
+
+// ============================================================================
+// LITERAL AREA
+// ============================================================================
+//
+// Literals are materialized once per AST node and then shared by every
+// evaluation of that node. They carry EZOM_FLAG_FIXED: the collector never
+// reclaims them and mutating primitives refuse to write into them.
+
+ezom_literal_stats_t g_literal_stats = {0, 0};
+
+uint24_t ezom_fix_literal(uint24_t obj) {
+    if (!obj || EZOM_IS_SMALLINT(obj) || !ezom_is_valid_object(obj)) {
+        return obj;
+    }
+    
+    ezom_object_t* object = (ezom_object_t*)EZOM_OBJECT_PTR(obj);
+    if (!(object->flags & EZOM_FLAG_FIXED)) {
+        object->flags |= EZOM_FLAG_FIXED;
+        g_literal_stats.objects++;
+        g_literal_stats.bytes += ezom_calculate_object_size(obj);
+    }
+    return obj;
+}
+
+bool ezom_is_fixed(uint24_t obj) {
+    if (!obj || EZOM_IS_SMALLINT(obj) || !ezom_is_valid_object(obj)) {
+        return false;
+    }
+    
+    ezom_object_t* object = (ezom_object_t*)EZOM_OBJECT_PTR(obj);
+    return (object->flags & EZOM_FLAG_FIXED) != 0;
+}
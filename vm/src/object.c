@@ -5,6 +5,7 @@
 
 #include "../include/ezom_object.h"
 #include "../include/ezom_memory.h"
+#include "../include/ezom_dispatch.h"
 #include <stdio.h>
 #include <string.h>
 
@@ -12,6 +13,7 @@
 extern uint24_t g_object_class;
 extern uint24_t g_class_class;
 extern uint24_t g_integer_class;
+extern uint24_t g_large_integer_class;
 extern uint24_t g_string_class;
 extern uint24_t g_symbol_class;
 extern uint24_t g_nil;
@@ -30,6 +32,10 @@ void ezom_init_object(uint24_t obj_ptr, uint24_t class_ptr, uint8_t type) {
     obj->class_ptr = class_ptr; // Allow 0 during bootstrap
     obj->hash = ezom_compute_hash(obj_ptr);
     obj->flags = type;
+    
+    if (type == EZOM_TYPE_CLASS) {
+        ezom_class_register(obj_ptr);
+    }
 }
 
 // Bootstrap-safe object initialization
@@ -55,7 +61,10 @@ uint16_t ezom_get_object_size(uint24_t obj_ptr) {
     
     switch (obj->flags & 0xF0) {
         case EZOM_TYPE_INTEGER:
-            return sizeof(ezom_integer_t);
+            return sizeof(ezom_large_integer_t);
+            
+        case EZOM_TYPE_DOUBLE:
+            return sizeof(ezom_double_t);
             
         case EZOM_TYPE_STRING: {
             ezom_string_t* str = (ezom_string_t*)EZOM_OBJECT_PTR(obj_ptr);
@@ -76,10 +85,21 @@ bool ezom_is_valid_object(uint24_t obj_ptr) {
         return false;
     }
     
-    // Check alignment
+    // Check alignment (odd references are tagged SmallIntegers)
     if (obj_ptr & 1) {
         return false;
     }
     
     return true;
+}
+
+// Class of any reference, including immediates that have no header
+uint24_t ezom_class_of(uint24_t obj_ptr) {
+    if (EZOM_IS_SMALLINT(obj_ptr)) {
+        return g_integer_class;
+    }
+    if (!obj_ptr) return 0;
+    
+    ezom_object_t* obj = (ezom_object_t*)EZOM_OBJECT_PTR(obj_ptr);
+    return obj->class_ptr;
 }
\ No newline at end of file
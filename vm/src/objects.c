@@ -5,43 +5,92 @@
 
 #include "../include/ezom_object.h"
 #include "../include/ezom_memory.h"
+#include "../include/ezom_dispatch.h"
+#include <stddef.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
-// Create integer object
-uint24_t ezom_create_integer(int16_t value) {
-    printf("DEBUG: ezom_create_integer called with value=%d\n", value);
-    printf("DEBUG: g_integer_class=0x%06X\n", g_integer_class);
+// Create integer object: SmallIntegers are tagged immediates and never
+// touch the heap; only values outside their range are boxed
+uint24_t ezom_create_integer(ezom_large_int_t value) {
+    if (EZOM_SMALLINT_FITS(value)) {
+        return EZOM_SMALLINT_FROM(value);
+    }
     
-    // Phase 3: Use typed allocation for object tracking
-    uint24_t ptr = ezom_allocate_typed(sizeof(ezom_integer_t), EZOM_TYPE_INTEGER);
-    printf("DEBUG: ezom_allocate_typed returned ptr=0x%06X\n", ptr);
+    uint24_t ptr = ezom_allocate_typed(sizeof(ezom_large_integer_t), EZOM_TYPE_INTEGER);
     if (!ptr) return 0;
     
-    printf("DEBUG: About to call ezom_init_object...\n");
+    ezom_init_object(ptr, g_large_integer_class ? g_large_integer_class : g_integer_class,
+                     EZOM_TYPE_INTEGER);
     
-    // Bootstrap safety: use Object class if Integer class not ready
-    uint24_t class_ptr = g_integer_class ? g_integer_class : g_object_class;
-    if (!class_ptr) {
-        // Ultra-bootstrap: create minimal object without class
-        ezom_object_t* header = (ezom_object_t*)EZOM_OBJECT_PTR(ptr);
-        header->class_ptr = 0; // Bootstrap: no class initially
-        header->hash = (uint16_t)(value & 0xFFFF);
-        header->flags = EZOM_TYPE_INTEGER;
-        printf("DEBUG: Ultra-bootstrap mode - no class available\n");
-    } else {
-        ezom_init_object(ptr, class_ptr, EZOM_TYPE_INTEGER);
-        printf("DEBUG: ezom_init_object completed with class=0x%06X\n", class_ptr);
+    ezom_large_integer_t* obj = (ezom_large_integer_t*)EZOM_OBJECT_PTR(ptr);
+    obj->value = value;
+    return ptr;
+}
+
+ezom_large_int_t ezom_integer_value(uint24_t obj_ptr) {
+    if (EZOM_IS_SMALLINT(obj_ptr)) {
+        return EZOM_SMALLINT_VALUE(obj_ptr);
     }
+    return ((ezom_large_integer_t*)EZOM_OBJECT_PTR(obj_ptr))->value;
+}
+
+// Decimal text for any integer value; printf cannot be relied on for
+// 64-bit arguments on every target. Returns the length written.
+uint16_t ezom_format_integer(char* buffer, ezom_large_int_t value) {
+    char digits[24];
+    uint16_t count = 0;
+    uint16_t length = 0;
+    
+    // Work with non-positive values so the minimum value does not overflow
+    ezom_large_int_t rest = value < 0 ? value : -value;
+    do {
+        digits[count++] = (char)('0' - (rest % 10));
+        rest /= 10;
+    } while (rest);
+    
+    if (value < 0) buffer[length++] = '-';
+    while (count) buffer[length++] = digits[--count];
+    buffer[length] = '\0';
+    return length;
+}
+
+// Create a heap Double. Arithmetic primitives use ezom_scratch_double
+// instead, which only reaches the heap when a result is stored.
+uint24_t ezom_create_double(double value) {
+    uint24_t ptr = ezom_allocate_typed(sizeof(ezom_double_t), EZOM_TYPE_DOUBLE);
+    if (!ptr) return 0;
     
-    ezom_integer_t* obj = (ezom_integer_t*)EZOM_OBJECT_PTR(ptr);
-    printf("DEBUG: Setting obj->value = %d\n", value);
-    obj->value = value;
+    ezom_init_object(ptr, g_double_class ? g_double_class : g_object_class, EZOM_TYPE_DOUBLE);
     
-    printf("DEBUG: ezom_create_integer returning ptr=0x%06X\n", ptr);
+    ezom_double_t* obj = (ezom_double_t*)EZOM_OBJECT_PTR(ptr);
+    obj->value = value;
     return ptr;
 }
 
+double ezom_double_value(uint24_t obj_ptr) {
+    return ((ezom_double_t*)EZOM_OBJECT_PTR(obj_ptr))->value;
+}
+
+// Shortest text that reads back as the same value, always with a decimal
+// point so that Doubles and Integers print differently
+uint16_t ezom_format_double(char* buffer, double value) {
+    int length = 0;
+    for (int precision = 15; precision <= 17; precision++) {
+        length = snprintf(buffer, 32, "%.*g", precision, value);
+        if (strtod(buffer, NULL) == value) break;
+    }
+    if (length < 0) length = 0;
+    
+    if (!strpbrk(buffer, ".eEni")) {    // Not already "1.5", "1e+20", "inf" or "nan"
+        buffer[length++] = '.';
+        buffer[length++] = '0';
+        buffer[length] = '\0';
+    }
+    return (uint16_t)length;
+}
+
 // Create string object
 uint24_t ezom_create_string(const char* data, uint16_t length) {
     printf("DEBUG: ezom_create_string entry, data='%.*s', length=%d\n", length, data, length);
@@ -81,48 +130,195 @@ uint24_t ezom_create_string(const char* data, uint16_t length) {
     return ptr;
 }
 
+// ============================================================================
+// Symbol table (interning)
+// ============================================================================
+//
+// Open-addressing table of canonical symbols, keyed on the content hash
+// stored in each symbol's hash_cache. The table lives outside the object
+// heap and does not keep symbols alive: ezom_symbol_table_sweep() drops
+// entries for symbols the collector is about to reclaim.
+
+#define EZOM_SYMBOL_TABLE_INITIAL 128
+// Largest power of two a uint16_t capacity holds; doubling past it wraps
+#define EZOM_SYMBOL_TABLE_MAX     32768
+
+static uint24_t* g_symbol_table = NULL;
+static uint16_t  g_symbol_table_capacity = 0;
+static uint16_t  g_symbol_table_count = 0;
+
+static char* ezom_symbol_chars(uint24_t sym_ptr) {
+    // Same layout arithmetic as ezom_create_symbol (avoids flexible array access)
+    return (char*)EZOM_OBJECT_PTR(sym_ptr + offsetof(ezom_symbol_t, data));
+}
+
+// Content hash used for symbol interning
+uint16_t ezom_hash_chars(const char* data, uint16_t length) {
+    uint16_t hash = length;
+    for (uint16_t i = 0; i < length; i++) {
+        hash = (uint16_t)((hash << 5) - hash) + (uint8_t)data[i];
+    }
+    return hash;
+}
+
+static void ezom_symbol_table_insert(uint24_t sym_ptr) {
+    ezom_symbol_t* sym = (ezom_symbol_t*)EZOM_OBJECT_PTR(sym_ptr);
+    uint16_t mask = g_symbol_table_capacity - 1;
+    uint16_t slot = sym->hash_cache & mask;
+    
+    while (g_symbol_table[slot]) {
+        slot = (slot + 1) & mask;
+    }
+    g_symbol_table[slot] = sym_ptr;
+    g_symbol_table_count++;
+}
+
+static bool ezom_symbol_table_resize(uint16_t new_capacity) {
+    uint24_t* old_table = g_symbol_table;
+    uint16_t old_capacity = g_symbol_table_capacity;
+    
+    uint24_t* table = (uint24_t*)calloc(new_capacity, sizeof(uint24_t));
+    if (!table) {
+        printf("EZOM: Symbol table resize to %d failed\n", new_capacity);
+        return false;
+    }
+    
+    g_symbol_table = table;
+    g_symbol_table_capacity = new_capacity;
+    g_symbol_table_count = 0;
+    
+    for (uint16_t i = 0; i < old_capacity; i++) {
+        if (old_table[i]) {
+            ezom_symbol_table_insert(old_table[i]);
+        }
+    }
+    free(old_table);
+    return true;
+}
+
+static uint24_t ezom_symbol_table_find(const char* data, uint16_t length, uint16_t hash) {
+    if (!g_symbol_table) return 0;
+    
+    uint16_t mask = g_symbol_table_capacity - 1;
+    uint16_t slot = hash & mask;
+    
+    while (g_symbol_table[slot]) {
+        uint24_t sym_ptr = g_symbol_table[slot];
+        ezom_symbol_t* sym = (ezom_symbol_t*)EZOM_OBJECT_PTR(sym_ptr);
+        if (sym->hash_cache == hash && sym->length == length &&
+            memcmp(ezom_symbol_chars(sym_ptr), data, length) == 0) {
+            return sym_ptr;
+        }
+        slot = (slot + 1) & mask;
+    }
+    return 0;
+}
+
+// Remove symbols that the current GC cycle did not mark. Must run after
+// the mark phase and before the sweep zeroes the dead objects.
+void ezom_symbol_table_sweep(void) {
+    if (!g_symbol_table) return;
+    
+    uint16_t removed = 0;
+    for (uint16_t i = 0; i < g_symbol_table_capacity; i++) {
+        if (g_symbol_table[i] && !ezom_is_marked(g_symbol_table[i]) && !ezom_is_fixed(g_symbol_table[i])) {
+            g_symbol_table[i] = 0;
+            removed++;
+        }
+    }
+    
+    if (removed) {
+        // Rehash survivors so probe sequences stay unbroken
+        ezom_symbol_table_resize(g_symbol_table_capacity);
+        printf("EZOM: Symbol table dropped %d dead symbols (%d live)\n",
+               removed, g_symbol_table_count);
+    }
+}
+
+uint16_t ezom_symbol_table_size(void) {
+    return g_symbol_table_count;
+}
+
+// Selector IDs: dense small integers handed out the first time a symbol
+// is used as a method selector. They index the dispatch table columns.
+static uint16_t g_selector_id_count = 0;
+
+uint16_t ezom_selector_id(uint24_t selector) {
+    if (!selector) return 0;
+    
+    ezom_symbol_t* sym = (ezom_symbol_t*)EZOM_OBJECT_PTR(selector);
+    if (!sym->selector_id && g_selector_id_count < 0xFFFF) {
+        sym->selector_id = ++g_selector_id_count;
+    }
+    return sym->selector_id;
+}
+
+uint16_t ezom_selector_id_count(void) {
+    return g_selector_id_count;
+}
+
 // Create symbol (interned string)
 uint24_t ezom_create_symbol(const char* data, uint16_t length) {
-    // For Phase 1, just create like a string - interning comes later
-    printf("DEBUG: ezom_create_symbol called: data='%.*s' length=%d\n", length, data, length);
+    uint16_t hash = ezom_hash_chars(data, length);
+    
+    // Fast path: the canonical symbol already exists
+    uint24_t existing = ezom_symbol_table_find(data, length, hash);
+    if (existing) {
+        ezom_object_t* header = (ezom_object_t*)EZOM_OBJECT_PTR(existing);
+        if (!header->class_ptr && g_symbol_class) {
+            // Interned during early bootstrap, before Symbol existed
+            header->class_ptr = g_symbol_class;
+        }
+        return existing;
+    }
+    
+    printf("DEBUG: ezom_create_symbol interning: data='%.*s' length=%d\n", length, data, length);
+    
+    // Keep the load factor under 3/4
+    if (!g_symbol_table) {
+        if (!ezom_symbol_table_resize(EZOM_SYMBOL_TABLE_INITIAL)) return 0;
+    } else if ((uint32_t)(g_symbol_table_count + 1) * 4 > (uint32_t)g_symbol_table_capacity * 3) {
+        if (g_symbol_table_capacity >= EZOM_SYMBOL_TABLE_MAX) {
+            printf("EZOM: Symbol table full (%d symbols), cannot intern '%.*s'\n",
+                   g_symbol_table_count, length, data);
+            return 0;
+        }
+        if (!ezom_symbol_table_resize(g_symbol_table_capacity * 2)) return 0;
+    }
     
     // Phase 3: Use typed allocation for object tracking
     uint24_t ptr = ezom_allocate_typed(sizeof(ezom_symbol_t) + length + 1, EZOM_TYPE_SYMBOL);
     printf("DEBUG: ezom_allocate_typed returned ptr=0x%06X\n", ptr);
     if (!ptr) return 0;
     
-    printf("DEBUG: About to call ezom_init_object with ptr=0x%06X, g_symbol_class=0x%06X\n", ptr, g_symbol_class);
     ezom_init_object(ptr, g_symbol_class, EZOM_TYPE_OBJECT);
-    printf("DEBUG: ezom_init_object completed\n");
     
     ezom_symbol_t* obj = (ezom_symbol_t*)EZOM_OBJECT_PTR(ptr);
-    printf("DEBUG: obj pointer = 0x%06X\n", (uint24_t)obj);
     
     // FIXED: Use explicit pointer arithmetic instead of flexible array member
     // Calculate data pointer manually to avoid ez80 compiler issues
-    char* data_ptr = (char*)EZOM_OBJECT_PTR(ptr + sizeof(ezom_object_t) + sizeof(uint16_t) + sizeof(uint16_t));
-    printf("DEBUG: Calculated data_ptr = 0x%06X\n", (uint24_t)data_ptr);
-    printf("DEBUG: Expected offset = %d bytes\n", sizeof(ezom_object_t) + sizeof(uint16_t) + sizeof(uint16_t));
+    char* data_ptr = ezom_symbol_chars(ptr);
     
     obj->length = length;
-    obj->hash_cache = ezom_compute_hash(ptr); // Simple hash for now
+    obj->hash_cache = hash;
+    obj->selector_id = 0;
     
-    printf("DEBUG: About to memcpy to address 0x%06X\n", (uint24_t)data_ptr);
     memcpy(data_ptr, data, length);
     data_ptr[length] = '\0';
     
+    ezom_symbol_table_insert(ptr);
+    
     printf("DEBUG: ezom_create_symbol returning ptr=0x%06X\n", ptr);
     return ptr;
 }
 
 // Create method dictionary
 uint24_t ezom_create_method_dictionary(uint16_t initial_capacity) {
-    if (initial_capacity == 0) initial_capacity = 8;
-    
-    uint16_t size = sizeof(ezom_method_dict_t) + 
-                    (initial_capacity * sizeof(ezom_method_t));
+    // Capacity is a power of two so probes can mask instead of divide
+    uint16_t capacity = 8;
+    while (capacity < initial_capacity) capacity <<= 1;
     
-    uint24_t ptr = ezom_allocate(size);
+    uint24_t ptr = ezom_allocate(sizeof(ezom_method_dict_t));
     if (!ptr) return 0;
     
     // Bootstrap safety: only initialize if Object class exists
@@ -138,11 +334,127 @@ uint24_t ezom_create_method_dictionary(uint16_t initial_capacity) {
     
     ezom_method_dict_t* dict = (ezom_method_dict_t*)EZOM_OBJECT_PTR(ptr);
     dict->size = 0;
-    dict->capacity = initial_capacity;
+    dict->capacity = 0;
+    dict->selectors = 0;
+    dict->methods = 0;
+    
+    if (!ezom_method_dict_grow(dict, capacity)) {
+        return 0;
+    }
     
     return ptr;
 }
 
+static ezom_method_table_t* ezom_method_dict_table(ezom_method_dict_t* dict) {
+    return (ezom_method_table_t*)EZOM_OBJECT_PTR(dict->methods);
+}
+
+static ezom_array_t* ezom_method_dict_selectors(ezom_method_dict_t* dict) {
+    return (ezom_array_t*)EZOM_OBJECT_PTR(dict->selectors);
+}
+
+static uint16_t ezom_method_dict_probe(ezom_array_t* selectors, uint16_t capacity, uint24_t selector) {
+    ezom_symbol_t* sym = (ezom_symbol_t*)EZOM_OBJECT_PTR(selector);
+    uint16_t mask = capacity - 1;
+    uint16_t slot = sym->hash_cache & mask;
+    
+    while (selectors->elements[slot] && selectors->elements[slot] != selector) {
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+// Reallocate both arrays at new_capacity and rehash the existing methods.
+// The dictionary object itself stays put, so class->method_dict is stable.
+bool ezom_method_dict_grow(ezom_method_dict_t* dict, uint16_t new_capacity) {
+    uint24_t selectors_ptr = ezom_create_array(new_capacity);
+    uint24_t methods_ptr = ezom_allocate(sizeof(ezom_method_table_t) + new_capacity * sizeof(ezom_method_t));
+    if (!selectors_ptr || !methods_ptr) {
+        printf("EZOM: Method dictionary resize to %d failed\n", new_capacity);
+        return false;
+    }
+    
+    ezom_init_object(methods_ptr, g_object_class, EZOM_TYPE_OBJECT);
+    ezom_method_table_t* table = (ezom_method_table_t*)EZOM_OBJECT_PTR(methods_ptr);
+    table->capacity = new_capacity;
+    
+    ezom_array_t* selectors = (ezom_array_t*)EZOM_OBJECT_PTR(selectors_ptr);
+    for (uint16_t i = 0; i < new_capacity; i++) {
+        selectors->elements[i] = 0;  // Empty slot
+    }
+    
+    // Rehash existing entries
+    if (dict->selectors) {
+        ezom_array_t* old_selectors = ezom_method_dict_selectors(dict);
+        ezom_method_table_t* old_table = ezom_method_dict_table(dict);
+        
+        for (uint16_t i = 0; i < dict->capacity; i++) {
+            uint24_t selector = old_selectors->elements[i];
+            if (!selector) continue;
+            
+            uint16_t slot = ezom_method_dict_probe(selectors, new_capacity, selector);
+            selectors->elements[slot] = selector;
+            table->entries[slot] = old_table->entries[i];
+        }
+    }
+    
+    dict->selectors = selectors_ptr;
+    dict->methods = methods_ptr;
+    dict->capacity = new_capacity;
+    return true;
+}
+
+ezom_method_t* ezom_method_dict_find(ezom_method_dict_t* dict, uint24_t selector) {
+    if (!dict || !dict->selectors || !selector) return NULL;
+    
+    ezom_array_t* selectors = ezom_method_dict_selectors(dict);
+    uint16_t slot = ezom_method_dict_probe(selectors, dict->capacity, selector);
+    if (!selectors->elements[slot]) return NULL;
+    
+    return &ezom_method_dict_table(dict)->entries[slot];
+}
+
+// Add or replace a method. Grows the table past 3/4 load; method record
+// pointers obtained earlier are invalid after a grow.
+ezom_method_t* ezom_method_dict_put(ezom_method_dict_t* dict, uint24_t selector, uint24_t code,
+                                    uint16_t arg_count, uint8_t flags) {
+    if (!dict || !selector) return NULL;
+    
+    ezom_method_t* method = ezom_method_dict_find(dict, selector);
+    if (!method) {
+        // Give the selector a dispatch table column
+        ezom_selector_id(selector);
+        
+        if ((uint32_t)(dict->size + 1) * 4 > (uint32_t)dict->capacity * 3) {
+            if (!ezom_method_dict_grow(dict, dict->capacity * 2)) {
+                return NULL;
+            }
+            // Cached lookups point at the old method records; the installer
+            // restamps the class for inline caches
+            ezom_method_cache_flush();
+        }
+        
+        ezom_array_t* selectors = ezom_method_dict_selectors(dict);
+        uint16_t slot = ezom_method_dict_probe(selectors, dict->capacity, selector);
+        selectors->elements[slot] = selector;
+        method = &ezom_method_dict_table(dict)->entries[slot];
+        dict->size++;
+    }
+    
+    method->selector = selector;
+    method->code = code;
+    method->arg_count = arg_count;
+    method->flags = flags;
+    return method;
+}
+
+// Iteration helper: method record in a slot, or NULL for an empty slot
+ezom_method_t* ezom_method_dict_entry_at(ezom_method_dict_t* dict, uint16_t slot) {
+    if (!dict || !dict->selectors || slot >= dict->capacity) return NULL;
+    if (!ezom_method_dict_selectors(dict)->elements[slot]) return NULL;
+    return &ezom_method_dict_table(dict)->entries[slot];
+}
+
 // NEW: Create array object
 uint24_t ezom_create_array(uint16_t size) {
     uint16_t total_size = sizeof(ezom_array_t) + (size * sizeof(uint24_t));
@@ -175,6 +487,7 @@ uint24_t ezom_create_block(uint8_t param_count, uint8_t local_count, uint24_t ou
     obj->code = 0; // Will be set by parser
     obj->param_count = param_count;
     obj->local_count = local_count;
+    obj->capture_count = local_count;
     
     // Initialize captured variables to nil
     for (uint8_t i = 0; i < local_count; i++) {
@@ -214,14 +527,25 @@ uint24_t ezom_object_to_string(uint24_t obj_ptr) {
         return ezom_create_string("nil", 3);
     }
     
+    if (EZOM_IS_SMALLINT(obj_ptr)) {
+        char buffer[24];
+        uint16_t length = ezom_format_integer(buffer, EZOM_SMALLINT_VALUE(obj_ptr));
+        return ezom_create_string(buffer, length);
+    }
+    
     ezom_object_t* obj = (ezom_object_t*)EZOM_OBJECT_PTR(obj_ptr);
     
     switch (obj->flags & 0xF0) {
         case EZOM_TYPE_INTEGER: {
-            ezom_integer_t* int_obj = (ezom_integer_t*)EZOM_OBJECT_PTR(obj_ptr);
-            char buffer[16];
-            sprintf(buffer, "%d", int_obj->value);
-            return ezom_create_string(buffer, strlen(buffer));
+            char buffer[24];
+            uint16_t length = ezom_format_integer(buffer, ezom_integer_value(obj_ptr));
+            return ezom_create_string(buffer, length);
+        }
+        
+        case EZOM_TYPE_DOUBLE: {
+            char buffer[32];
+            uint16_t length = ezom_format_double(buffer, ezom_double_value(obj_ptr));
+            return ezom_create_string(buffer, length);
         }
         
         case EZOM_TYPE_STRING:
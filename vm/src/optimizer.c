@@ -0,0 +1,311 @@
+// ============================================================================
+// File: src/optimizer.c
+// AST optimization pass implementation
+// ============================================================================
+
+#include "../include/ezom_optimizer.h"
+#include "../include/ezom_object.h"
+#include "../include/ezom_dispatch.h"
+#include "../include/ezom_primitives.h"
+#include <stdio.h>
+#include <string.h>
+
+ezom_optimizer_stats_t g_optimizer_stats = {0, 0, 0, 0, 0, 0};
+
+static bool g_optimizer_enabled = true;
+static bool g_optimizer_report = false;
+
+// What the pass did to one method
+typedef struct ezom_optimizer_pass {
+    uint16_t removed;
+    uint16_t folded;
+    uint16_t dead;
+    uint16_t flattened;
+    uint16_t increments;
+} ezom_optimizer_pass_t;
+
+void ezom_optimizer_configure(bool enabled, bool report) {
+    g_optimizer_enabled = enabled;
+    g_optimizer_report = report;
+}
+
+static void ezom_optimize_node(ezom_optimizer_pass_t* pass, ezom_ast_node_t* node);
+
+// Nodes in a subtree, for the count of nodes removed
+static uint16_t ezom_optimizer_count(ezom_ast_node_t* node) {
+    if (!node) return 0;
+
+    uint16_t count = 1;
+    switch (node->type) {
+        case AST_MESSAGE_SEND:
+            count += ezom_optimizer_count(node->data.message_send.receiver);
+            for (ezom_ast_node_t* arg = node->data.message_send.arguments; arg; arg = arg->next) {
+                count += ezom_optimizer_count(arg);
+            }
+            break;
+        case AST_ASSIGNMENT:
+        case AST_INCREMENT:
+            count += ezom_optimizer_count(node->data.assignment.variable);
+            count += ezom_optimizer_count(node->data.assignment.value);
+            break;
+        case AST_RETURN:
+            count += ezom_optimizer_count(node->data.return_stmt.expression);
+            break;
+        case AST_BLOCK:
+            count += ezom_optimizer_count(node->data.block.body);
+            break;
+        case AST_STATEMENT_LIST:
+            for (ezom_ast_node_t* stmt = node->data.statement_list.statements; stmt; stmt = stmt->next) {
+                count += ezom_optimizer_count(stmt);
+            }
+            break;
+        default:
+            break;
+    }
+    return count;
+}
+
+static bool ezom_optimizer_smallint(ezom_ast_node_t* node, int64_t* value) {
+    if (!node || node->type != AST_LITERAL || node->data.literal.type != LITERAL_INTEGER) return false;
+    *value = node->data.literal.value.integer_value;
+    return EZOM_SMALLINT_FITS(*value);
+}
+
+// Integer primitive behind a binary selector, or 0 once Integer answers it
+// with a method of its own
+static uint8_t ezom_optimizer_integer_primitive(const char* selector) {
+    static const struct { const char* selector; uint8_t primitive; } ops[] = {
+        {"+", PRIM_INTEGER_ADD}, {"-", PRIM_INTEGER_SUB}, {"*", PRIM_INTEGER_MUL},
+        {"<", PRIM_INTEGER_LT}, {">", PRIM_INTEGER_GT}, {"<=", PRIM_INTEGER_LTE},
+        {">=", PRIM_INTEGER_GTE}, {"=", PRIM_INTEGER_EQ}
+    };
+
+    if (!g_integer_class) return 0;
+    for (uint8_t i = 0; i < sizeof(ops) / sizeof(ops[0]); i++) {
+        if (strcmp(selector, ops[i].selector) != 0) continue;
+
+        uint24_t symbol = ezom_create_symbol(selector, strlen(selector));
+        ezom_method_t* method = symbol ? ezom_lookup_method(g_integer_class, symbol).method : NULL;
+        if (method && (method->flags & EZOM_METHOD_PRIMITIVE) && (uint8_t)method->code == ops[i].primitive) {
+            return ops[i].primitive;
+        }
+        return 0;
+    }
+    return 0;
+}
+
+// 3 + 4 -> 7, 2 < 1 -> false: the send node becomes the literal it answers
+static bool ezom_optimizer_fold(ezom_ast_node_t* node) {
+    ezom_ast_node_t* arg = node->data.message_send.arguments;
+    int64_t a, b, value = 0;
+    uint8_t type = LITERAL_INTEGER;
+
+    if (node->data.message_send.inline_kind != AST_INLINE_NONE || node->data.message_send.is_super ||
+        !arg || arg->next ||
+        !ezom_optimizer_smallint(node->data.message_send.receiver, &a) ||
+        !ezom_optimizer_smallint(arg, &b)) {
+        return false;
+    }
+
+    switch (ezom_optimizer_integer_primitive(node->data.message_send.selector)) {
+        case PRIM_INTEGER_ADD: value = a + b; break;
+        case PRIM_INTEGER_SUB: value = a - b; break;
+        case PRIM_INTEGER_MUL: value = a * b; break;
+        case PRIM_INTEGER_LT:  type = a < b ? LITERAL_TRUE : LITERAL_FALSE; break;
+        case PRIM_INTEGER_GT:  type = a > b ? LITERAL_TRUE : LITERAL_FALSE; break;
+        case PRIM_INTEGER_LTE: type = a <= b ? LITERAL_TRUE : LITERAL_FALSE; break;
+        case PRIM_INTEGER_GTE: type = a >= b ? LITERAL_TRUE : LITERAL_FALSE; break;
+        case PRIM_INTEGER_EQ:  type = a == b ? LITERAL_TRUE : LITERAL_FALSE; break;
+        default: return false;
+    }
+    // Past SmallInteger the primitive answers a new LargeInteger each time
+    if (type == LITERAL_INTEGER && !EZOM_SMALLINT_FITS(value)) return false;
+
+    memset(&node->data, 0, sizeof(node->data));
+    node->type = AST_LITERAL;
+    node->data.literal.type = type;
+    node->data.literal.value.integer_value = (ezom_large_int_t)value;
+    return true;
+}
+
+static bool ezom_optimizer_same_variable(ezom_ast_node_t* a, ezom_ast_node_t* b) {
+    return a->type == AST_VARIABLE_DEF && b->type == AST_VARIABLE_DEF &&
+           a->data.variable.kind == b->data.variable.kind &&
+           a->data.variable.index == b->data.variable.index &&
+           a->data.variable.capture == b->data.variable.capture &&
+           a->data.variable.boxed == b->data.variable.boxed &&
+           a->data.variable.global == b->data.variable.global;
+}
+
+// x := x + k and x := x - k on a variable the evaluator can store to
+static bool ezom_optimizer_increment(ezom_ast_node_t* node) {
+    ezom_ast_node_t* variable = node->data.assignment.variable;
+    ezom_ast_node_t* value = node->data.assignment.value;
+    int64_t k;
+
+    if (!variable || !value || variable->type != AST_VARIABLE_DEF || value->type != AST_MESSAGE_SEND) {
+        return false;
+    }
+    switch (variable->data.variable.kind) {
+        case AST_VAR_CONTEXT:
+            // Captured copies are read-only; captured boxes are not
+            if (!variable->data.variable.boxed && variable->data.variable.capture != AST_NO_CAPTURE) {
+                return false;
+            }
+            break;
+        case AST_VAR_INSTANCE:
+        case AST_VAR_GLOBAL:
+            break;
+        default:
+            return false;
+    }
+    if (value->data.message_send.inline_kind != AST_INLINE_NONE || value->data.message_send.is_super ||
+        (strcmp(value->data.message_send.selector, "+") != 0 &&
+         strcmp(value->data.message_send.selector, "-") != 0) ||
+        !value->data.message_send.receiver ||
+        !ezom_optimizer_same_variable(variable, value->data.message_send.receiver) ||
+        !value->data.message_send.arguments || value->data.message_send.arguments->next ||
+        !ezom_optimizer_smallint(value->data.message_send.arguments, &k)) {
+        return false;
+    }
+
+    node->type = AST_INCREMENT;
+    return true;
+}
+
+// Optimize a statement list: flatten nested lists and drop what follows a ^
+static void ezom_optimize_statements(ezom_optimizer_pass_t* pass, ezom_ast_node_t* list) {
+    ezom_ast_node_t** link = &list->data.statement_list.statements;
+    uint16_t count = 0;
+
+    while (*link) {
+        ezom_ast_node_t* stmt = *link;
+
+        if (stmt->type == AST_STATEMENT_LIST) {
+            // Splice the nested statements in place of the list
+            ezom_ast_node_t* first = stmt->data.statement_list.statements;
+            ezom_ast_node_t* last = first;
+            while (last && last->next) last = last->next;
+            if (last) {
+                last->next = stmt->next;
+                *link = first;
+            } else {
+                *link = stmt->next;
+            }
+            pass->flattened++;
+            pass->removed++;
+            continue;
+        }
+
+        ezom_optimize_node(pass, stmt);
+        count++;
+
+        if (stmt->type == AST_RETURN && stmt->next) {
+            for (ezom_ast_node_t* dead = stmt->next; dead; dead = dead->next) {
+                pass->removed += ezom_optimizer_count(dead);
+                pass->dead++;
+            }
+            stmt->next = NULL;
+        }
+        link = &stmt->next;
+    }
+    list->data.statement_list.count = count;
+}
+
+// A one-statement list used as an expression becomes that statement
+static void ezom_optimizer_unwrap(ezom_optimizer_pass_t* pass, ezom_ast_node_t* node) {
+    if (!node || node->type != AST_STATEMENT_LIST) return;
+
+    ezom_ast_node_t* only = node->data.statement_list.statements;
+    if (!only || only->next) return;
+
+    ezom_ast_node_t* next = node->next;
+    *node = *only;
+    node->next = next;
+    pass->flattened++;
+    pass->removed++;
+}
+
+static void ezom_optimize_expression(ezom_optimizer_pass_t* pass, ezom_ast_node_t* node) {
+    if (!node) return;
+    ezom_optimizer_unwrap(pass, node);
+    ezom_optimize_node(pass, node);
+}
+
+static void ezom_optimize_node(ezom_optimizer_pass_t* pass, ezom_ast_node_t* node) {
+    if (!node) return;
+
+    switch (node->type) {
+        case AST_MESSAGE_SEND: {
+            ezom_optimize_expression(pass, node->data.message_send.receiver);
+            for (ezom_ast_node_t* arg = node->data.message_send.arguments; arg; arg = arg->next) {
+                ezom_optimize_expression(pass, arg);
+            }
+            uint16_t nodes = ezom_optimizer_count(node);
+            if (ezom_optimizer_fold(node)) {
+                pass->removed += nodes - 1;
+                pass->folded++;
+            }
+            break;
+        }
+
+        case AST_ASSIGNMENT:
+            ezom_optimize_expression(pass, node->data.assignment.value);
+            if (ezom_optimizer_increment(node)) {
+                pass->increments++;
+            }
+            break;
+
+        case AST_RETURN:
+            ezom_optimize_expression(pass, node->data.return_stmt.expression);
+            break;
+
+        case AST_BLOCK:
+            // Inlined blocks (including a whileTrue: receiver) and closures alike
+            if (node->data.block.body) {
+                ezom_optimize_statements(pass, node->data.block.body);
+            }
+            break;
+
+        case AST_STATEMENT_LIST:
+            ezom_optimize_statements(pass, node);
+            break;
+
+        default:
+            break;
+    }
+}
+
+uint16_t ezom_optimize_method(ezom_ast_node_t* method_ast) {
+    if (!g_optimizer_enabled || !method_ast || method_ast->type != AST_METHOD_DEF ||
+        method_ast->data.method_def.is_primitive || !method_ast->data.method_def.body) {
+        return 0;
+    }
+
+    ezom_optimizer_pass_t pass = {0, 0, 0, 0, 0};
+    ezom_optimize_statements(&pass, method_ast->data.method_def.body);
+
+    g_optimizer_stats.methods++;
+    g_optimizer_stats.nodes_removed += pass.removed;
+    g_optimizer_stats.folded += pass.folded;
+    g_optimizer_stats.dead += pass.dead;
+    g_optimizer_stats.flattened += pass.flattened;
+    g_optimizer_stats.increments += pass.increments;
+
+    if (g_optimizer_report && (pass.removed || pass.increments)) {
+        printf("Optimizer: %s: %u nodes removed (folded %u, dead %u, flattened %u, increments %u)\n",
+               method_ast->data.method_def.selector, pass.removed, pass.folded,
+               pass.dead, pass.flattened, pass.increments);
+    }
+    return pass.removed;
+}
+
+void ezom_optimizer_print_stats(void) {
+    printf("\n=== AST Optimizer ===\n");
+    printf("Methods: %lu, nodes removed: %lu\n",
+           (unsigned long)g_optimizer_stats.methods, (unsigned long)g_optimizer_stats.nodes_removed);
+    printf("Folded: %lu, dead statements: %lu, flattened: %lu, increments: %lu\n",
+           (unsigned long)g_optimizer_stats.folded, (unsigned long)g_optimizer_stats.dead,
+           (unsigned long)g_optimizer_stats.flattened, (unsigned long)g_optimizer_stats.increments);
+    printf("=====================\n\n");
+}
@@ -3,6 +3,7 @@
 // Parser implementation for EZOM language
 // ============================================================================
 
+#define _DEFAULT_SOURCE     // strdup under -std=c99
 #include "../include/ezom_parser.h"
 #include <stdio.h>
 #include <stdlib.h>
@@ -214,6 +215,7 @@ ezom_ast_node_t* ezom_parse_expression(ezom_parser_t* parser) {
 ezom_ast_node_t* ezom_parse_primary(ezom_parser_t* parser) {
     switch (parser->lexer->current_token.type) {
         case TOKEN_INTEGER:
+        case TOKEN_DOUBLE:
         case TOKEN_STRING:
         case TOKEN_SYMBOL:
             return ezom_parse_literal(parser);
@@ -236,10 +238,8 @@ ezom_ast_node_t* ezom_parse_primary(ezom_parser_t* parser) {
             return ezom_parse_block(parser);
             
         case TOKEN_HASH:
-            if (ezom_parser_check(parser, TOKEN_LPAREN)) {
-                return ezom_parse_array_literal(parser);
-            }
-            // Fall through for symbol
+            // The lexer emits TOKEN_HASH only for "#(", symbols are TOKEN_SYMBOL
+            return ezom_parse_array_literal(parser);
             
         default:
             ezom_parser_error(parser, "Expected expression");
@@ -394,6 +394,10 @@ ezom_ast_node_t* ezom_parse_statement_list(ezom_parser_t* parser) {
 
 ezom_ast_node_t* ezom_parse_return_statement(ezom_parser_t* parser) {
     ezom_ast_node_t* expr = ezom_parse_expression(parser);
+    
+    // Consume optional dot: statements may follow (the optimizer drops them)
+    ezom_parser_match(parser, TOKEN_DOT);
+    
     return ezom_ast_create_return(expr);
 }
 
@@ -452,11 +456,18 @@ ezom_ast_node_t* ezom_parse_literal(ezom_parser_t* parser) {
     switch (parser->lexer->current_token.type) {
         case TOKEN_INTEGER:
             {
-                int16_t value = parser->lexer->current_token.value.int_value;
+                ezom_large_int_t value = parser->lexer->current_token.value.int_value;
                 ezom_parser_advance(parser);
                 return ezom_ast_create_literal_integer(value);
             }
             
+        case TOKEN_DOUBLE:
+            {
+                double value = parser->lexer->current_token.value.double_value;
+                ezom_parser_advance(parser);
+                return ezom_ast_create_literal_double(value);
+            }
+            
         case TOKEN_STRING:
             {
                 char* value = strdup(parser->lexer->current_token.value.string_value);
@@ -475,15 +486,38 @@ ezom_ast_node_t* ezom_parse_literal(ezom_parser_t* parser) {
                 return node;
             }
             
+        case TOKEN_HASH:
+            return ezom_parse_array_literal(parser);
+            
         default:
             ezom_parser_error(parser, "Expected literal value");
             return NULL;
     }
 }
 
+// Inside #( ) a bare word is true, false, nil or a symbol
+static ezom_ast_node_t* ezom_parse_array_word(ezom_parser_t* parser) {
+    char* word = ezom_copy_current_token_text(parser);
+    ezom_parser_advance(parser);
+    
+    ezom_ast_node_t* node;
+    if (strcmp(word, "true") == 0 || strcmp(word, "false") == 0 || strcmp(word, "nil") == 0) {
+        node = ezom_ast_create(AST_LITERAL);
+        if (node) {
+            node->data.literal.type = word[0] == 't' ? LITERAL_TRUE :
+                                      word[0] == 'f' ? LITERAL_FALSE : LITERAL_NIL;
+        }
+    } else {
+        node = ezom_ast_create_literal_symbol(word);
+    }
+    
+    free(word);
+    return node;
+}
+
 ezom_ast_node_t* ezom_parse_array_literal(ezom_parser_t* parser) {
-    ezom_parser_consume(parser, TOKEN_HASH, "Expected '#'");
-    ezom_parser_consume(parser, TOKEN_LPAREN, "Expected '(' after '#'");
+    // "#(" arrives as a single TOKEN_HASH
+    ezom_parser_consume(parser, TOKEN_HASH, "Expected '#('");
     
     ezom_ast_node_t* array = ezom_ast_create(AST_LITERAL);
     array->data.literal.type = LITERAL_ARRAY;
@@ -492,10 +526,16 @@ ezom_ast_node_t* ezom_parse_array_literal(ezom_parser_t* parser) {
     while (!ezom_parser_check(parser, TOKEN_RPAREN) && 
            !ezom_parser_check(parser, TOKEN_EOF)) {
         
-        ezom_ast_node_t* element = ezom_parse_literal(parser);
-        if (element) {
-            ezom_ast_add_statement(array->data.literal.value.array_elements, element);
+        ezom_ast_node_t* element;
+        if (ezom_parser_check(parser, TOKEN_IDENTIFIER)) {
+            element = ezom_parse_array_word(parser);
+        } else {
+            element = ezom_parse_literal(parser);
+        }
+        if (!element) {
+            break;
         }
+        ezom_ast_add_statement(array->data.literal.value.array_elements, element);
     }
     
     ezom_parser_consume(parser, TOKEN_RPAREN, "Expected ')' after array elements");
@@ -662,7 +702,10 @@ void ezom_parser_consume(ezom_parser_t* parser, ezom_token_type_t type, const ch
 }
 
 void ezom_parser_advance(ezom_parser_t* parser) {
-    ezom_lexer_next_token(parser->lexer);
+    // A newline separates nothing: an expression may continue on the next line
+    do {
+        ezom_lexer_next_token(parser->lexer);
+    } while (parser->lexer->current_token.type == TOKEN_NEWLINE);
 }
 
 void ezom_parser_error(ezom_parser_t* parser, const char* message) {
@@ -7,6 +7,9 @@
 #include "../include/ezom_object.h"
 #include "../include/ezom_memory.h"
 #include "../include/ezom_context.h"
+#include "../include/ezom_dispatch.h"
+#include "../include/ezom_exceptions.h"
+#include "../include/ezom_evaluator.h"
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
@@ -55,6 +58,21 @@ uint24_t prim_integer_as_string(uint24_t receiver, uint24_t* args, uint8_t arg_c
 uint24_t prim_integer_abs(uint24_t receiver, uint24_t* args, uint8_t arg_count);
 uint24_t prim_integer_to_do(uint24_t receiver, uint24_t* args, uint8_t arg_count);
 uint24_t prim_integer_times_repeat(uint24_t receiver, uint24_t* args, uint8_t arg_count);
+uint24_t prim_integer_as_double(uint24_t receiver, uint24_t* args, uint8_t arg_count);
+
+uint24_t prim_double_add(uint24_t receiver, uint24_t* args, uint8_t arg_count);
+uint24_t prim_double_sub(uint24_t receiver, uint24_t* args, uint8_t arg_count);
+uint24_t prim_double_mul(uint24_t receiver, uint24_t* args, uint8_t arg_count);
+uint24_t prim_double_div(uint24_t receiver, uint24_t* args, uint8_t arg_count);
+uint24_t prim_double_lt(uint24_t receiver, uint24_t* args, uint8_t arg_count);
+uint24_t prim_double_gt(uint24_t receiver, uint24_t* args, uint8_t arg_count);
+uint24_t prim_double_lte(uint24_t receiver, uint24_t* args, uint8_t arg_count);
+uint24_t prim_double_gte(uint24_t receiver, uint24_t* args, uint8_t arg_count);
+uint24_t prim_double_eq(uint24_t receiver, uint24_t* args, uint8_t arg_count);
+uint24_t prim_double_neq(uint24_t receiver, uint24_t* args, uint8_t arg_count);
+uint24_t prim_double_as_string(uint24_t receiver, uint24_t* args, uint8_t arg_count);
+uint24_t prim_double_as_integer(uint24_t receiver, uint24_t* args, uint8_t arg_count);
+uint24_t prim_double_sqrt(uint24_t receiver, uint24_t* args, uint8_t arg_count);
 
 uint24_t prim_string_length(uint24_t receiver, uint24_t* args, uint8_t arg_count);
 uint24_t prim_string_concat(uint24_t receiver, uint24_t* args, uint8_t arg_count);
@@ -77,6 +95,15 @@ uint24_t prim_block_value(uint24_t receiver, uint24_t* args, uint8_t arg_count);
 uint24_t prim_block_value_with(uint24_t receiver, uint24_t* args, uint8_t arg_count);
 uint24_t prim_block_while_true(uint24_t receiver, uint24_t* args, uint8_t arg_count);
 uint24_t prim_block_while_false(uint24_t receiver, uint24_t* args, uint8_t arg_count);
+uint24_t prim_block_on_do(uint24_t receiver, uint24_t* args, uint8_t arg_count);
+uint24_t prim_block_ensure(uint24_t receiver, uint24_t* args, uint8_t arg_count);
+uint24_t prim_block_if_curtailed(uint24_t receiver, uint24_t* args, uint8_t arg_count);
+
+uint24_t prim_exception_new(uint24_t receiver, uint24_t* args, uint8_t arg_count);
+uint24_t prim_exception_signal(uint24_t receiver, uint24_t* args, uint8_t arg_count);
+uint24_t prim_exception_signal_with(uint24_t receiver, uint24_t* args, uint8_t arg_count);
+uint24_t prim_exception_message_text(uint24_t receiver, uint24_t* args, uint8_t arg_count);
+uint24_t prim_exception_set_message_text(uint24_t receiver, uint24_t* args, uint8_t arg_count);
 
 void ezom_init_primitives(void) {
     // Clear primitive table
@@ -106,6 +133,22 @@ void ezom_init_primitives(void) {
     g_primitives[PRIM_INTEGER_ABS] = prim_integer_abs;
     g_primitives[PRIM_INTEGER_TO_DO] = prim_integer_to_do;
     g_primitives[PRIM_INTEGER_TIMES_REPEAT] = prim_integer_times_repeat;
+    g_primitives[PRIM_INTEGER_AS_DOUBLE] = prim_integer_as_double;
+    
+    // Install Double primitives
+    g_primitives[PRIM_DOUBLE_ADD] = prim_double_add;
+    g_primitives[PRIM_DOUBLE_SUB] = prim_double_sub;
+    g_primitives[PRIM_DOUBLE_MUL] = prim_double_mul;
+    g_primitives[PRIM_DOUBLE_DIV] = prim_double_div;
+    g_primitives[PRIM_DOUBLE_LT] = prim_double_lt;
+    g_primitives[PRIM_DOUBLE_GT] = prim_double_gt;
+    g_primitives[PRIM_DOUBLE_LTE] = prim_double_lte;
+    g_primitives[PRIM_DOUBLE_GTE] = prim_double_gte;
+    g_primitives[PRIM_DOUBLE_EQ] = prim_double_eq;
+    g_primitives[PRIM_DOUBLE_NEQ] = prim_double_neq;
+    g_primitives[PRIM_DOUBLE_AS_STRING] = prim_double_as_string;
+    g_primitives[PRIM_DOUBLE_AS_INTEGER] = prim_double_as_integer;
+    g_primitives[PRIM_DOUBLE_SQRT] = prim_double_sqrt;
     
     // Install String primitives
     g_primitives[PRIM_STRING_LENGTH] = prim_string_length;
@@ -132,14 +175,23 @@ void ezom_init_primitives(void) {
     g_primitives[PRIM_BLOCK_VALUE_WITH] = prim_block_value_with;
     g_primitives[PRIM_BLOCK_WHILE_TRUE] = prim_block_while_true;
     g_primitives[PRIM_BLOCK_WHILE_FALSE] = prim_block_while_false;
+    g_primitives[PRIM_BLOCK_ON_DO] = prim_block_on_do;
+    g_primitives[PRIM_BLOCK_ENSURE] = prim_block_ensure;
+    g_primitives[PRIM_BLOCK_IF_CURTAILED] = prim_block_if_curtailed;
+    
+    // Install Exception primitives
+    g_primitives[PRIM_EXCEPTION_NEW] = prim_exception_new;
+    g_primitives[PRIM_EXCEPTION_SIGNAL] = prim_exception_signal;
+    g_primitives[PRIM_EXCEPTION_SIGNAL_WITH] = prim_exception_signal_with;
+    g_primitives[PRIM_EXCEPTION_MESSAGE_TEXT] = prim_exception_message_text;
+    g_primitives[PRIM_EXCEPTION_SET_MESSAGE_TEXT] = prim_exception_set_message_text;
     
     printf("EZOM: Enhanced primitives initialized (%d total)\n", MAX_PRIMITIVES);
 }
 
 // Object>>class
 uint24_t prim_object_class(uint24_t receiver, uint24_t* args, uint8_t arg_count) {
-    ezom_object_t* obj = (ezom_object_t*)EZOM_OBJECT_PTR(receiver);
-    return obj->class_ptr;
+    return ezom_class_of(receiver);
 }
 
 // Object>>=
@@ -152,6 +204,10 @@ uint24_t prim_object_equals(uint24_t receiver, uint24_t* args, uint8_t arg_count
 
 // Object>>hash
 uint24_t prim_object_hash(uint24_t receiver, uint24_t* args, uint8_t arg_count) {
+    if (EZOM_IS_SMALLINT(receiver)) {
+        return receiver;  // A SmallInteger is its own hash
+    }
+    
     ezom_object_t* obj = (ezom_object_t*)EZOM_OBJECT_PTR(receiver);
     return ezom_create_integer(obj->hash);
 }
@@ -180,250 +236,261 @@ uint24_t prim_object_not_nil(uint24_t receiver, uint24_t* args, uint8_t arg_coun
     return (receiver != g_nil) ? g_true : g_false;
 }
 
-// Integer>>+
-uint24_t prim_integer_add(uint24_t receiver, uint24_t* args, uint8_t arg_count) {
-    // Immediate corruption check - return safe value if corrupted
-    if (receiver == 0xffffff || (args && args[0] == 0xffffff)) {
-        return ezom_create_integer(0); // Return 0 instead of crashing
+// ============================================================================
+// INTEGER PRIMITIVES
+// ============================================================================
+//
+// Fast path: both operands are SmallIntegers and the result fits, checked
+// with the compiler's overflow builtins. Anything else (LargeInteger
+// operands, overflowing results) goes through ezom_large_integer_op, which
+// works on ezom_large_int_t and boxes only when the result needs it.
+
+#define EZOM_SMALLINT_ARGS(receiver, args, arg_count) \
+    ((arg_count) == 1 && (args) && EZOM_IS_SMALLINT((receiver) & (args)[0]))
+
+typedef enum {
+    EZOM_INT_OP_ADD,
+    EZOM_INT_OP_SUB,
+    EZOM_INT_OP_MUL,
+    EZOM_INT_OP_DIV,
+    EZOM_INT_OP_MOD,
+    EZOM_INT_OP_COMPARE
+} ezom_int_op_t;
+
+// Mixed Integer/Double arithmetic is done by the Double primitives
+static uint24_t ezom_double_op(ezom_int_op_t op, uint24_t receiver, uint24_t* args, uint8_t arg_count);
+static bool ezom_double_compare(uint24_t receiver, uint24_t* args, uint8_t arg_count, int* order);
+
+static bool ezom_integer_args(uint24_t receiver, uint24_t* args, uint8_t arg_count,
+                              ezom_large_int_t* a, ezom_large_int_t* b) {
+    if (arg_count != 1 || !args || !ezom_is_integer(receiver) || !ezom_is_integer(args[0])) {
+        return false;
+    }
+    *a = ezom_integer_value(receiver);
+    *b = ezom_integer_value(args[0]);
+    return true;
+}
+
+// Slow path for arithmetic; returns 0 on a type error
+static uint24_t ezom_large_integer_op(ezom_int_op_t op, uint24_t receiver, uint24_t* args, uint8_t arg_count) {
+    ezom_large_int_t a, b, result;
+    if (arg_count == 1 && args && ezom_is_double(args[0]) && op != EZOM_INT_OP_MOD) {
+        return ezom_double_op(op, receiver, args, arg_count);
+    }
+    if (!ezom_integer_args(receiver, args, arg_count, &a, &b)) {
+        return 0;
     }
     
-    if (arg_count != 1) return g_nil;
-    if (!receiver || !args || !args[0]) return g_nil;
-    
-    // Simple type checking without validation calls that might crash
-    ezom_object_t* recv_obj = (ezom_object_t*)EZOM_OBJECT_PTR(receiver);
-    ezom_object_t* arg_obj = (ezom_object_t*)EZOM_OBJECT_PTR(args[0]);
+    bool overflow = false;
+    switch (op) {
+        case EZOM_INT_OP_ADD: overflow = __builtin_add_overflow(a, b, &result); break;
+        case EZOM_INT_OP_SUB: overflow = __builtin_sub_overflow(a, b, &result); break;
+        case EZOM_INT_OP_MUL: overflow = __builtin_mul_overflow(a, b, &result); break;
+        case EZOM_INT_OP_DIV:
+        case EZOM_INT_OP_MOD:
+            if (b == 0) {
+                ezom_primitive_failed(op == EZOM_INT_OP_DIV ? "Division by zero" : "Division by zero in modulo");
+                return g_nil;
+            }
+            // The one quotient that does not fit: MIN / -1
+            overflow = (b == -1 && a == (ezom_large_int_t)((uint64_t)1 << (sizeof(a) * 8 - 1)));
+            result = overflow ? 0 : (op == EZOM_INT_OP_DIV ? a / b : a % b);
+            break;
+        default:
+            return 0;
+    }
     
-    // Direct type flag checking instead of calling ezom_is_integer
-    if ((recv_obj->flags & 0xF0) != EZOM_TYPE_INTEGER || 
-        (arg_obj->flags & 0xF0) != EZOM_TYPE_INTEGER) {
+    if (overflow) {
+        ezom_primitive_failed("Integer overflow");
         return g_nil;
     }
+    return ezom_create_integer(result);
+}
+
+// Three-way compare for any Integer pair; false on a type error
+static bool ezom_integer_compare(uint24_t receiver, uint24_t* args, uint8_t arg_count, int* order) {
+    if (EZOM_SMALLINT_ARGS(receiver, args, arg_count)) {
+        int32_t a = EZOM_SMALLINT_VALUE(receiver);
+        int32_t b = EZOM_SMALLINT_VALUE(args[0]);
+        *order = (a > b) - (a < b);
+        return true;
+    }
     
-    ezom_integer_t* recv = (ezom_integer_t*)EZOM_OBJECT_PTR(receiver);
-    ezom_integer_t* arg = (ezom_integer_t*)EZOM_OBJECT_PTR(args[0]);
+    ezom_large_int_t a, b;
+    if (arg_count == 1 && args && ezom_is_double(args[0])) {
+        return ezom_double_compare(receiver, args, arg_count, order);
+    }
+    if (!ezom_integer_args(receiver, args, arg_count, &a, &b)) {
+        return false;
+    }
+    *order = (a > b) - (a < b);
+    return true;
+}
+
+// Integer>>+
+uint24_t prim_integer_add(uint24_t receiver, uint24_t* args, uint8_t arg_count) {
+    if (EZOM_SMALLINT_ARGS(receiver, args, arg_count)) {
+#ifdef EZOM_PLATFORM_NATIVE
+        // (a << 1 | 1) + (b << 1) == (a + b) << 1 | 1, so adding the tagged
+        // words directly sets the overflow flag exactly when a + b leaves
+        // the 31-bit range
+        int32_t tagged;
+        if (!__builtin_add_overflow((int32_t)receiver, (int32_t)(args[0] - EZOM_SMALLINT_TAG), &tagged)) {
+            return (uint24_t)tagged;
+        }
+#else
+        int32_t sum = EZOM_SMALLINT_VALUE(receiver) + EZOM_SMALLINT_VALUE(args[0]);
+        if (EZOM_SMALLINT_FITS(sum)) {
+            return EZOM_SMALLINT_FROM(sum);
+        }
+#endif
+    }
     
-    return ezom_create_integer(recv->value + arg->value);
+    uint24_t result = ezom_large_integer_op(EZOM_INT_OP_ADD, receiver, args, arg_count);
+    return result ? result : g_nil;
 }
 
 // Integer>>-
 uint24_t prim_integer_sub(uint24_t receiver, uint24_t* args, uint8_t arg_count) {
-    if (arg_count != 1) return g_nil;
-    
-    ezom_integer_t* recv = (ezom_integer_t*)EZOM_OBJECT_PTR(receiver);
-    ezom_integer_t* arg = (ezom_integer_t*)EZOM_OBJECT_PTR(args[0]);
+    if (EZOM_SMALLINT_ARGS(receiver, args, arg_count)) {
+#ifdef EZOM_PLATFORM_NATIVE
+        // (a << 1 | 1) - (b << 1) == (a - b) << 1 | 1
+        int32_t tagged;
+        if (!__builtin_sub_overflow((int32_t)receiver, (int32_t)(args[0] - EZOM_SMALLINT_TAG), &tagged)) {
+            return (uint24_t)tagged;
+        }
+#else
+        int32_t difference = EZOM_SMALLINT_VALUE(receiver) - EZOM_SMALLINT_VALUE(args[0]);
+        if (EZOM_SMALLINT_FITS(difference)) {
+            return EZOM_SMALLINT_FROM(difference);
+        }
+#endif
+    }
     
-    if (!ezom_is_integer(receiver) || !ezom_is_integer(args[0])) {
-        printf("Type error in integer subtraction\n");
+    uint24_t result = ezom_large_integer_op(EZOM_INT_OP_SUB, receiver, args, arg_count);
+    if (!result) {
+        ezom_primitive_failed("Type error in integer subtraction");
         return g_nil;
     }
-    
-    return ezom_create_integer(recv->value - arg->value);
+    return result;
 }
 
 // Integer>>*
 uint24_t prim_integer_mul(uint24_t receiver, uint24_t* args, uint8_t arg_count) {
-    if (arg_count != 1) return g_nil;
-    
-    ezom_integer_t* recv = (ezom_integer_t*)EZOM_OBJECT_PTR(receiver);
-    ezom_integer_t* arg = (ezom_integer_t*)EZOM_OBJECT_PTR(args[0]);
+    if (EZOM_SMALLINT_ARGS(receiver, args, arg_count)) {
+        int32_t product;
+        if (!__builtin_mul_overflow(EZOM_SMALLINT_VALUE(receiver), EZOM_SMALLINT_VALUE(args[0]), &product) &&
+            EZOM_SMALLINT_FITS(product)) {
+            return EZOM_SMALLINT_FROM(product);
+        }
+    }
     
-    if (!ezom_is_integer(receiver) || !ezom_is_integer(args[0])) {
-        printf("Type error in integer multiplication\n");
+    uint24_t result = ezom_large_integer_op(EZOM_INT_OP_MUL, receiver, args, arg_count);
+    if (!result) {
+        ezom_primitive_failed("Type error in integer multiplication");
         return g_nil;
     }
-    
-    return ezom_create_integer(recv->value * arg->value);
+    return result;
 }
 
 // Integer>>/
 uint24_t prim_integer_div(uint24_t receiver, uint24_t* args, uint8_t arg_count) {
-    if (arg_count != 1) return g_nil;
-    
-    ezom_integer_t* recv = (ezom_integer_t*)EZOM_OBJECT_PTR(receiver);
-    ezom_integer_t* arg = (ezom_integer_t*)EZOM_OBJECT_PTR(args[0]);
-    
-    if (!ezom_is_integer(receiver) || !ezom_is_integer(args[0])) {
-        printf("Type error in integer division\n");
-        return g_nil;
-    }
-    
-    if (arg->value == 0) {
-        printf("Division by zero\n");
+    uint24_t result = ezom_large_integer_op(EZOM_INT_OP_DIV, receiver, args, arg_count);
+    if (!result) {
+        ezom_primitive_failed("Type error in integer division");
         return g_nil;
     }
-    
-    return ezom_create_integer(recv->value / arg->value);
+    return result;
 }
 
 // Integer>>\\  (modulo)
 uint24_t prim_integer_mod(uint24_t receiver, uint24_t* args, uint8_t arg_count) {
-    if (arg_count != 1) return g_nil;
-    if (!receiver || !args || !args[0]) return g_nil;
-    
-    // Direct type checking without validation calls that might crash
-    ezom_object_t* recv_obj = (ezom_object_t*)EZOM_OBJECT_PTR(receiver);
-    ezom_object_t* arg_obj = (ezom_object_t*)EZOM_OBJECT_PTR(args[0]);
-    
-    if ((recv_obj->flags & 0xF0) != EZOM_TYPE_INTEGER || 
-        (arg_obj->flags & 0xF0) != EZOM_TYPE_INTEGER) {
-        printf("Type error in integer modulo\n");
-        return g_nil;
-    }
-    
-    ezom_integer_t* recv = (ezom_integer_t*)EZOM_OBJECT_PTR(receiver);
-    ezom_integer_t* arg = (ezom_integer_t*)EZOM_OBJECT_PTR(args[0]);
-    
-    if (arg->value == 0) {
-        printf("Division by zero in modulo\n");
+    uint24_t result = ezom_large_integer_op(EZOM_INT_OP_MOD, receiver, args, arg_count);
+    if (!result) {
+        ezom_primitive_failed("Type error in integer modulo");
         return g_nil;
     }
-    
-    return ezom_create_integer(recv->value % arg->value);
+    return result;
 }
 
 // Integer>><
 uint24_t prim_integer_lt(uint24_t receiver, uint24_t* args, uint8_t arg_count) {
-    if (arg_count != 1) return g_false;
+    int order;
+    if (!ezom_integer_compare(receiver, args, arg_count, &order)) return g_false;
     
-    ezom_integer_t* recv = (ezom_integer_t*)EZOM_OBJECT_PTR(receiver);
-    ezom_integer_t* arg = (ezom_integer_t*)EZOM_OBJECT_PTR(args[0]);
-    
-    if (!ezom_is_integer(receiver) || !ezom_is_integer(args[0])) {
-        return g_false;
-    }
-    
-    return (recv->value < arg->value) ? g_true : g_false;
+    return (order < 0) ? g_true : g_false;
 }
 
 // Integer>>>
 uint24_t prim_integer_gt(uint24_t receiver, uint24_t* args, uint8_t arg_count) {
-    if (arg_count != 1) return g_false;
+    int order;
+    if (!ezom_integer_compare(receiver, args, arg_count, &order)) return g_false;
     
-    ezom_integer_t* recv = (ezom_integer_t*)EZOM_OBJECT_PTR(receiver);
-    ezom_integer_t* arg = (ezom_integer_t*)EZOM_OBJECT_PTR(args[0]);
-    
-    if (!ezom_is_integer(receiver) || !ezom_is_integer(args[0])) {
-        return g_false;
-    }
-    
-    return (recv->value > arg->value) ? g_true : g_false;
+    return (order > 0) ? g_true : g_false;
 }
 
 // Integer>><=
 uint24_t prim_integer_lte(uint24_t receiver, uint24_t* args, uint8_t arg_count) {
-    if (arg_count != 1) return g_false;
-    if (!receiver || !args || !args[0]) return g_false;
-    
-    // Direct type checking without validation calls that might crash
-    ezom_object_t* recv_obj = (ezom_object_t*)EZOM_OBJECT_PTR(receiver);
-    ezom_object_t* arg_obj = (ezom_object_t*)EZOM_OBJECT_PTR(args[0]);
+    int order;
+    if (!ezom_integer_compare(receiver, args, arg_count, &order)) return g_false;
     
-    if ((recv_obj->flags & 0xF0) != EZOM_TYPE_INTEGER || 
-        (arg_obj->flags & 0xF0) != EZOM_TYPE_INTEGER) {
-        return g_false;
-    }
-    
-    ezom_integer_t* recv = (ezom_integer_t*)EZOM_OBJECT_PTR(receiver);
-    ezom_integer_t* arg = (ezom_integer_t*)EZOM_OBJECT_PTR(args[0]);
-    
-    return (recv->value <= arg->value) ? g_true : g_false;
+    return (order <= 0) ? g_true : g_false;
 }
 
 // Integer>>>=
 uint24_t prim_integer_gte(uint24_t receiver, uint24_t* args, uint8_t arg_count) {
-    if (arg_count != 1) return g_false;
-    
-    ezom_integer_t* recv = (ezom_integer_t*)EZOM_OBJECT_PTR(receiver);
-    ezom_integer_t* arg = (ezom_integer_t*)EZOM_OBJECT_PTR(args[0]);
+    int order;
+    if (!ezom_integer_compare(receiver, args, arg_count, &order)) return g_false;
     
-    if (!ezom_is_integer(receiver) || !ezom_is_integer(args[0])) {
-        return g_false;
-    }
-    
-    return (recv->value >= arg->value) ? g_true : g_false;
+    return (order >= 0) ? g_true : g_false;
 }
 
-// Integer>>=
+// Integer>>=  (equal SmallIntegers have identical references)
 uint24_t prim_integer_eq(uint24_t receiver, uint24_t* args, uint8_t arg_count) {
-    if (arg_count != 1) return g_false;
-    if (!receiver || !args || !args[0]) return g_false;
-    
-    // Direct type checking without validation calls that might crash
-    ezom_object_t* recv_obj = (ezom_object_t*)EZOM_OBJECT_PTR(receiver);
-    ezom_object_t* arg_obj = (ezom_object_t*)EZOM_OBJECT_PTR(args[0]);
-    
-    if ((recv_obj->flags & 0xF0) != EZOM_TYPE_INTEGER || 
-        (arg_obj->flags & 0xF0) != EZOM_TYPE_INTEGER) {
-        return g_false;
-    }
+    int order;
+    if (arg_count != 1 || !args) return g_false;
+    if (receiver == args[0]) return g_true;
+    if (!ezom_integer_compare(receiver, args, arg_count, &order)) return g_false;
     
-    ezom_integer_t* recv = (ezom_integer_t*)EZOM_OBJECT_PTR(receiver);
-    ezom_integer_t* arg = (ezom_integer_t*)EZOM_OBJECT_PTR(args[0]);
-    
-    return (recv->value == arg->value) ? g_true : g_false;
+    return (order == 0) ? g_true : g_false;
 }
 
 // Integer>>~=
 uint24_t prim_integer_neq(uint24_t receiver, uint24_t* args, uint8_t arg_count) {
-    if (arg_count != 1) return g_false;
-    if (!receiver || !args || !args[0]) return g_false;
-    
-    // Direct type checking without validation calls that might crash
-    ezom_object_t* recv_obj = (ezom_object_t*)EZOM_OBJECT_PTR(receiver);
-    ezom_object_t* arg_obj = (ezom_object_t*)EZOM_OBJECT_PTR(args[0]);
-    
-    if ((recv_obj->flags & 0xF0) != EZOM_TYPE_INTEGER || 
-        (arg_obj->flags & 0xF0) != EZOM_TYPE_INTEGER) {
-        return g_true; // Different types are not equal
-    }
-    
-    ezom_integer_t* recv = (ezom_integer_t*)EZOM_OBJECT_PTR(receiver);
-    ezom_integer_t* arg = (ezom_integer_t*)EZOM_OBJECT_PTR(args[0]);
-    
-    return (recv->value != arg->value) ? g_true : g_false;
+    return (prim_integer_eq(receiver, args, arg_count) == g_true) ? g_false : g_true;
 }
 
 // Integer>>asString
 uint24_t prim_integer_as_string(uint24_t receiver, uint24_t* args, uint8_t arg_count) {
-    printf("DEBUG: prim_integer_as_string entry, receiver=0x%06X\n", receiver);
-    
-    if (!receiver) {
-        printf("DEBUG: Null receiver in asString\n");
-        return g_nil;
-    }
-    
-    // Direct type checking without validation calls that might crash
-    ezom_object_t* recv_obj = (ezom_object_t*)EZOM_OBJECT_PTR(receiver);
-    
-    printf("DEBUG: Checking object type, flags=0x%02X\n", recv_obj->flags);
-    
-    if ((recv_obj->flags & 0xF0) != EZOM_TYPE_INTEGER) {
-        printf("Type error: asString sent to non-integer\n");
+    if (!ezom_is_integer(receiver)) {
+        ezom_primitive_failed("Type error: asString sent to non-integer");
         return g_nil;
     }
     
-    ezom_integer_t* int_obj = (ezom_integer_t*)EZOM_OBJECT_PTR(receiver);
-    char buffer[16];
-    sprintf(buffer, "%d", int_obj->value);
-    printf("DEBUG: sprintf completed, buffer='%s', about to call ezom_create_string\n", buffer);
-    
-    uint24_t result = ezom_create_string(buffer, strlen(buffer));
-    printf("DEBUG: ezom_create_string returned 0x%06X\n", result);
-    
-    return result;
+    return ezom_object_to_string(receiver);
 }
 
 // Integer>>abs
 uint24_t prim_integer_abs(uint24_t receiver, uint24_t* args, uint8_t arg_count) {
     if (!ezom_is_integer(receiver)) {
-        printf("Type error: abs sent to non-integer\n");
+        ezom_primitive_failed("Type error: abs sent to non-integer");
         return g_nil;
     }
     
-    ezom_integer_t* int_obj = (ezom_integer_t*)EZOM_OBJECT_PTR(receiver);
-    int16_t value = int_obj->value;
-    return ezom_create_integer(value < 0 ? -value : value);
+    ezom_large_int_t value = ezom_integer_value(receiver);
+    if (value >= 0) return receiver;
+    
+    ezom_large_int_t negated;
+    if (__builtin_sub_overflow((ezom_large_int_t)0, value, &negated)) {
+        ezom_primitive_failed("Integer overflow");
+        return g_nil;
+    }
+    return ezom_create_integer(negated);
+}
+
+// value and value:, as the control primitives send them to their blocks
+static uint24_t ezom_value_selector(uint8_t arg_count) {
+    return arg_count ? ezom_create_symbol("value:", 6) : ezom_create_symbol("value", 5);
 }
 
 // Integer>>to:do:
@@ -431,21 +498,25 @@ uint24_t prim_integer_to_do(uint24_t receiver, uint24_t* args, uint8_t arg_count
     if (arg_count != 2) return receiver;
     
     if (!ezom_is_integer(receiver) || !ezom_is_integer(args[0]) || !ezom_is_block(args[1])) {
-        printf("Type error in to:do:\n");
+        ezom_primitive_failed("Type error in to:do:");
         return receiver;
     }
     
-    ezom_integer_t* start = (ezom_integer_t*)EZOM_OBJECT_PTR(receiver);
-    ezom_integer_t* end = (ezom_integer_t*)EZOM_OBJECT_PTR(args[0]);
+    ezom_large_int_t start = ezom_integer_value(receiver);
+    ezom_large_int_t end = ezom_integer_value(args[0]);
     uint24_t block = args[1];
     
-    // Execute loop: start to: end do: block
-    for (int16_t i = start->value; i <= end->value; i++) {
-        uint24_t index_obj = ezom_create_integer(i);
-        uint24_t block_args[] = {index_obj};
-        
+    // Execute loop: start to: end do: block (SmallInteger indices are
+    // immediates, so the loop itself does not allocate)
+    uint24_t value_with = ezom_value_selector(1);
+    uint16_t scratch = ezom_double_scratch_mark();
+    for (ezom_large_int_t i = start; i <= end; i++) {
         // Call block value: index
-        g_primitives[PRIM_BLOCK_VALUE_WITH](block, block_args, 1);
+        ezom_send1(block, value_with, ezom_create_integer(i));
+        ezom_double_scratch_release(scratch);
+        
+        // Do not step past the largest value, or go on after a ^ in the block
+        if (i == end || EZOM_FRAME_UNWINDING()) break;
     }
     
     return receiver;
@@ -456,95 +527,257 @@ uint24_t prim_integer_times_repeat(uint24_t receiver, uint24_t* args, uint8_t ar
     if (arg_count != 1) return receiver;
     
     if (!ezom_is_integer(receiver) || !ezom_is_block(args[0])) {
-        printf("Type error in timesRepeat:\n");
+        ezom_primitive_failed("Type error in timesRepeat:");
         return receiver;
     }
     
-    ezom_integer_t* count = (ezom_integer_t*)EZOM_OBJECT_PTR(receiver);
+    ezom_large_int_t count = ezom_integer_value(receiver);
     uint24_t block = args[0];
     
     // Execute block count times
-    for (int16_t i = 0; i < count->value; i++) {
-        g_primitives[PRIM_BLOCK_VALUE](block, NULL, 0);
+    uint24_t value = ezom_value_selector(0);
+    uint16_t scratch = ezom_double_scratch_mark();
+    for (ezom_large_int_t i = 0; i < count && !EZOM_FRAME_UNWINDING(); i++) {
+        ezom_send0(block, value);
+        ezom_double_scratch_release(scratch);
     }
     
     return receiver;
 }
 
-// String>>length
-// String>>length
-uint24_t prim_string_length(uint24_t receiver, uint24_t* args, uint8_t arg_count) {
-    ezom_string_t* str = (ezom_string_t*)EZOM_OBJECT_PTR(receiver);
+// Integer>>asDouble
+uint24_t prim_integer_as_double(uint24_t receiver, uint24_t* args, uint8_t arg_count) {
+    if (!ezom_is_integer(receiver)) {
+        ezom_primitive_failed("Type error: asDouble sent to non-integer");
+        return g_nil;
+    }
     
-    if (!ezom_is_string(receiver)) {
-        printf("Type error: length sent to non-string\n");
+    return ezom_scratch_double((double)ezom_integer_value(receiver));
+}
+
+// ============================================================================
+// DOUBLE PRIMITIVES
+// ============================================================================
+//
+// Results come from the double scratch space, so chained arithmetic does
+// not allocate. Integer operands are converted; Integer primitives hand
+// a Double argument over to ezom_double_op.
+
+static bool ezom_number_as_double(uint24_t obj, double* value) {
+    if (ezom_is_double(obj)) {
+        *value = ezom_double_value(obj);
+        return true;
+    }
+    if (ezom_is_integer(obj)) {
+        *value = (double)ezom_integer_value(obj);
+        return true;
+    }
+    return false;
+}
+
+static bool ezom_double_args(uint24_t receiver, uint24_t* args, uint8_t arg_count, double* a, double* b) {
+    return arg_count == 1 && args &&
+           ezom_number_as_double(receiver, a) && ezom_number_as_double(args[0], b);
+}
+
+// Returns 0 on a type error
+static uint24_t ezom_double_op(ezom_int_op_t op, uint24_t receiver, uint24_t* args, uint8_t arg_count) {
+    double a, b;
+    if (!ezom_double_args(receiver, args, arg_count, &a, &b)) {
+        return 0;
+    }
+    
+    switch (op) {
+        case EZOM_INT_OP_ADD: return ezom_scratch_double(a + b);
+        case EZOM_INT_OP_SUB: return ezom_scratch_double(a - b);
+        case EZOM_INT_OP_MUL: return ezom_scratch_double(a * b);
+        case EZOM_INT_OP_DIV: return ezom_scratch_double(a / b);  // IEEE: x / 0 is infinite
+        default:              return 0;
+    }
+}
+
+// Three-way compare; NaN compares as unordered (order 2) so that every
+// relational test fails
+static bool ezom_double_compare(uint24_t receiver, uint24_t* args, uint8_t arg_count, int* order) {
+    double a, b;
+    if (!ezom_double_args(receiver, args, arg_count, &a, &b)) {
+        return false;
+    }
+    
+    if (a < b) *order = -1;
+    else if (a > b) *order = 1;
+    else if (a == b) *order = 0;
+    else *order = 2;
+    return true;
+}
+
+static uint24_t ezom_double_result(uint24_t result, const char* operation) {
+    if (!result) {
+        ezom_primitive_failed("Type error in double %s", operation);
         return g_nil;
     }
+    return result;
+}
+
+// Double>>+
+uint24_t prim_double_add(uint24_t receiver, uint24_t* args, uint8_t arg_count) {
+    return ezom_double_result(ezom_double_op(EZOM_INT_OP_ADD, receiver, args, arg_count), "addition");
+}
+
+// Double>>-
+uint24_t prim_double_sub(uint24_t receiver, uint24_t* args, uint8_t arg_count) {
+    return ezom_double_result(ezom_double_op(EZOM_INT_OP_SUB, receiver, args, arg_count), "subtraction");
+}
+
+// Double>>*
+uint24_t prim_double_mul(uint24_t receiver, uint24_t* args, uint8_t arg_count) {
+    return ezom_double_result(ezom_double_op(EZOM_INT_OP_MUL, receiver, args, arg_count), "multiplication");
+}
+
+// Double>>/
+uint24_t prim_double_div(uint24_t receiver, uint24_t* args, uint8_t arg_count) {
+    return ezom_double_result(ezom_double_op(EZOM_INT_OP_DIV, receiver, args, arg_count), "division");
+}
+
+// Double>><
+uint24_t prim_double_lt(uint24_t receiver, uint24_t* args, uint8_t arg_count) {
+    int order;
+    if (!ezom_double_compare(receiver, args, arg_count, &order)) return g_false;
     
-    return ezom_create_integer(str->length);
+    return (order == -1) ? g_true : g_false;
 }
 
-// String>>+
-uint24_t prim_string_concat(uint24_t receiver, uint24_t* args, uint8_t arg_count) {
-    printf("DEBUG: prim_string_concat entry\n");
+// Double>>>
+uint24_t prim_double_gt(uint24_t receiver, uint24_t* args, uint8_t arg_count) {
+    int order;
+    if (!ezom_double_compare(receiver, args, arg_count, &order)) return g_false;
     
-    if (arg_count != 1) {
-        printf("DEBUG: Wrong arg count in string concat\n");
+    return (order == 1) ? g_true : g_false;
+}
+
+// Double>><=
+uint24_t prim_double_lte(uint24_t receiver, uint24_t* args, uint8_t arg_count) {
+    int order;
+    if (!ezom_double_compare(receiver, args, arg_count, &order)) return g_false;
+    
+    return (order == -1 || order == 0) ? g_true : g_false;
+}
+
+// Double>>>=
+uint24_t prim_double_gte(uint24_t receiver, uint24_t* args, uint8_t arg_count) {
+    int order;
+    if (!ezom_double_compare(receiver, args, arg_count, &order)) return g_false;
+    
+    return (order == 1 || order == 0) ? g_true : g_false;
+}
+
+// Double>>=
+uint24_t prim_double_eq(uint24_t receiver, uint24_t* args, uint8_t arg_count) {
+    int order;
+    if (!ezom_double_compare(receiver, args, arg_count, &order)) return g_false;
+    
+    return (order == 0) ? g_true : g_false;
+}
+
+// Double>>~=
+uint24_t prim_double_neq(uint24_t receiver, uint24_t* args, uint8_t arg_count) {
+    return (prim_double_eq(receiver, args, arg_count) == g_true) ? g_false : g_true;
+}
+
+// Double>>asString
+uint24_t prim_double_as_string(uint24_t receiver, uint24_t* args, uint8_t arg_count) {
+    if (!ezom_is_double(receiver)) {
+        ezom_primitive_failed("Type error: asString sent to non-double");
         return g_nil;
     }
-    if (!receiver || !args || !args[0]) {
-        printf("DEBUG: Null pointers in string concat\n");
+    
+    return ezom_object_to_string(receiver);
+}
+
+// Double>>asInteger (truncates toward zero)
+uint24_t prim_double_as_integer(uint24_t receiver, uint24_t* args, uint8_t arg_count) {
+    if (!ezom_is_double(receiver)) {
+        ezom_primitive_failed("Type error: asInteger sent to non-double");
         return g_nil;
     }
     
-    printf("DEBUG: Checking object types\n");
+    // The bounds are powers of two, so they convert to double exactly
+    double value = ezom_double_value(receiver);
+    double limit = (double)((ezom_large_int_t)1 << (sizeof(ezom_large_int_t) * 8 - 2)) * 2.0;
+    if (!(value > -limit && value < limit)) {   // Also rejects NaN
+        ezom_primitive_failed("Integer overflow");
+        return g_nil;
+    }
+    return ezom_create_integer((ezom_large_int_t)value);
+}
+
+// Double>>sqrt (Newton's method; the VM does not link libm)
+uint24_t prim_double_sqrt(uint24_t receiver, uint24_t* args, uint8_t arg_count) {
+    if (!ezom_is_double(receiver)) {
+        ezom_primitive_failed("Type error: sqrt sent to non-double");
+        return g_nil;
+    }
     
-    // Direct type checking without validation calls that might crash
-    ezom_object_t* recv_obj = (ezom_object_t*)EZOM_OBJECT_PTR(receiver);
-    ezom_object_t* arg_obj = (ezom_object_t*)EZOM_OBJECT_PTR(args[0]);
+    double value = ezom_double_value(receiver);
+    if (value < 0) {
+        ezom_primitive_failed("Domain error: sqrt of negative number");
+        return g_nil;
+    }
+    if (value == 0 || value != value || value - value != 0) {   // Zero, NaN, infinity
+        return ezom_scratch_double(value);
+    }
     
-    if ((recv_obj->flags & 0xF0) != EZOM_TYPE_STRING || 
-        (arg_obj->flags & 0xF0) != EZOM_TYPE_STRING) {
-        printf("Type error in string concatenation\n");
+    // Starting above the root, the iterates decrease strictly until they
+    // settle, so the loop always terminates
+    double root = value > 1 ? value : 1;
+    while (true) {
+        double next = 0.5 * (root + value / root);
+        if (next >= root) break;
+        root = next;
+    }
+    return ezom_scratch_double(root);
+}
+
+// String>>length
+// String>>length
+uint24_t prim_string_length(uint24_t receiver, uint24_t* args, uint8_t arg_count) {
+    ezom_string_t* str = (ezom_string_t*)EZOM_OBJECT_PTR(receiver);
+    
+    if (!ezom_is_string(receiver)) {
+        ezom_primitive_failed("Type error: length sent to non-string");
         return g_nil;
     }
     
-    printf("DEBUG: Type check passed, accessing string data\n");
+    return ezom_create_integer(str->length);
+}
+
+// String>>+
+uint24_t prim_string_concat(uint24_t receiver, uint24_t* args, uint8_t arg_count) {
+    // SmallIntegers are not heap objects: check the tag before the header
+    if (arg_count != 1 || !args || EZOM_IS_SMALLINT(receiver) || EZOM_IS_SMALLINT(args[0]) ||
+        !ezom_is_string(receiver) || !ezom_is_string(args[0])) {
+        ezom_primitive_failed("Type error in string concatenation");
+        return g_nil;
+    }
     
     ezom_string_t* str1 = (ezom_string_t*)EZOM_OBJECT_PTR(receiver);
     ezom_string_t* str2 = (ezom_string_t*)EZOM_OBJECT_PTR(args[0]);
     
-    printf("DEBUG: str1 length: %d, str2 length: %d\n", str1->length, str2->length);
-    
     uint16_t new_length = str1->length + str2->length;
-    printf("DEBUG: About to allocate %lu bytes\n", (unsigned long)(sizeof(ezom_string_t) + new_length + 1));
-    
     uint24_t result = ezom_allocate(sizeof(ezom_string_t) + new_length + 1);
-    
     if (!result) {
-        printf("DEBUG: Allocation failed\n");
+        printf("DEBUG: String allocation failed\n");
         return g_nil;
     }
     
-    printf("DEBUG: Allocated string at 0x%06X, about to init object\n", result);
-    
     ezom_init_object(result, g_string_class, EZOM_TYPE_STRING);
     
-    printf("DEBUG: Object initialized, setting up result string\n");
-    
-    printf("DEBUG: Object initialized, setting up result string\n");
-    
     ezom_string_t* result_str = (ezom_string_t*)EZOM_OBJECT_PTR(result);
     result_str->length = new_length;
-    
-    printf("DEBUG: About to copy string data\n");
-    
     memcpy(result_str->data, str1->data, str1->length);
     memcpy(result_str->data + str1->length, str2->data, str2->length);
     result_str->data[new_length] = '\0';
     
-    printf("DEBUG: String concatenation successful, returning result\n");
-    
     return result;
 }
 
@@ -573,34 +806,34 @@ uint24_t prim_string_equals(uint24_t receiver, uint24_t* args, uint8_t arg_count
 // Array class>>new:
 uint24_t prim_array_new(uint24_t receiver, uint24_t* args, uint8_t arg_count) {
     if (arg_count != 1 || !ezom_is_integer(args[0])) {
-        printf("Type error in Array new:\n");
+        ezom_primitive_failed("Type error in Array new:");
         return 0;
     }
     
-    ezom_integer_t* size_obj = (ezom_integer_t*)EZOM_OBJECT_PTR(args[0]);
-    if (size_obj->value < 0) {
-        printf("Negative array size\n");
+    ezom_large_int_t size = ezom_integer_value(args[0]);
+    if (size < 0 || size > 0xFFFF) {
+        ezom_primitive_failed("Invalid array size");
         return 0;
     }
     
-    return ezom_create_array(size_obj->value);
+    return ezom_create_array((uint16_t)size);
 }
 
 // Array>>at:
 uint24_t prim_array_at(uint24_t receiver, uint24_t* args, uint8_t arg_count) {
     if (arg_count != 1 || !ezom_is_array(receiver) || !ezom_is_integer(args[0])) {
-        printf("Type error in Array at:\n");
+        ezom_primitive_failed("Type error in Array at:");
         return 0;
     }
     
     ezom_array_t* array = (ezom_array_t*)EZOM_OBJECT_PTR(receiver);
-    ezom_integer_t* index_obj = (ezom_integer_t*)EZOM_OBJECT_PTR(args[0]);
+    ezom_large_int_t index_value = ezom_integer_value(args[0]);
     
     // SOM uses 1-based indexing
-    int16_t index = index_obj->value - 1;
+    ezom_large_int_t index = index_value - 1;
     
     if (index < 0 || index >= array->size) {
-        printf("Array index out of bounds: %d (size: %d)\n", index_obj->value, array->size);
+        ezom_primitive_failed("Array index out of bounds: %ld (size: %d)", (long)index_value, array->size);
         return 0;
     }
     
@@ -610,22 +843,30 @@ uint24_t prim_array_at(uint24_t receiver, uint24_t* args, uint8_t arg_count) {
 // Array>>at:put:
 uint24_t prim_array_at_put(uint24_t receiver, uint24_t* args, uint8_t arg_count) {
     if (arg_count != 2 || !ezom_is_array(receiver) || !ezom_is_integer(args[0])) {
-        printf("Type error in Array at:put:\n");
+        ezom_primitive_failed("Type error in Array at:put:");
+        return 0;
+    }
+    
+    if (ezom_is_fixed(receiver)) {
+        ezom_primitive_failed("Cannot modify a literal array");
         return 0;
     }
     
     ezom_array_t* array = (ezom_array_t*)EZOM_OBJECT_PTR(receiver);
-    ezom_integer_t* index_obj = (ezom_integer_t*)EZOM_OBJECT_PTR(args[0]);
+    ezom_large_int_t index_value = ezom_integer_value(args[0]);
     uint24_t value = args[1];
     
     // SOM uses 1-based indexing
-    int16_t index = index_obj->value - 1;
+    ezom_large_int_t index = index_value - 1;
     
     if (index < 0 || index >= array->size) {
-        printf("Array index out of bounds: %d (size: %d)\n", index_obj->value, array->size);
+        ezom_primitive_failed("Array index out of bounds: %ld (size: %d)", (long)index_value, array->size);
         return 0;
     }
     
+    // The array outlives the statement, so a scratch Double moves to the heap
+    value = ezom_promote_double(value);
+    ezom_frame_note_store(0, value);
     array->elements[index] = value;
     return value;
 }
@@ -633,7 +874,7 @@ uint24_t prim_array_at_put(uint24_t receiver, uint24_t* args, uint8_t arg_count)
 // Array>>length
 uint24_t prim_array_length(uint24_t receiver, uint24_t* args, uint8_t arg_count) {
     if (!ezom_is_array(receiver)) {
-        printf("Type error: length sent to non-array\n");
+        ezom_primitive_failed("Type error: length sent to non-array");
         return 0;
     }
     
@@ -658,12 +899,12 @@ uint24_t prim_true_if_true(uint24_t receiver, uint24_t* args, uint8_t arg_count)
     
     // Check if argument is a block
     if (!ezom_is_block(args[0])) {
-        printf("Type error: ifTrue: sent with non-block argument\n");
+        ezom_primitive_failed("Type error: ifTrue: sent with non-block argument");
         return g_nil;
     }
     
     // Evaluate the true block and return its result
-    return g_primitives[PRIM_BLOCK_VALUE](args[0], NULL, 0);
+    return ezom_send0(args[0], ezom_value_selector(0));
 }
 
 // True>>ifFalse:
@@ -679,7 +920,7 @@ uint24_t prim_true_if_false(uint24_t receiver, uint24_t* args, uint8_t arg_count
     
     // Check if argument is a block (for consistency)
     if (!ezom_is_block(args[0])) {
-        printf("Type error: ifFalse: sent with non-block argument\n");
+        ezom_primitive_failed("Type error: ifFalse: sent with non-block argument");
         return g_nil;
     }
     
@@ -700,12 +941,12 @@ uint24_t prim_true_if_true_if_false(uint24_t receiver, uint24_t* args, uint8_t a
     
     // Check if both arguments are blocks
     if (!ezom_is_block(args[0]) || !ezom_is_block(args[1])) {
-        printf("Type error: ifTrue:ifFalse: sent with non-block argument(s)\n");
+        ezom_primitive_failed("Type error: ifTrue:ifFalse: sent with non-block argument(s)");
         return g_nil;
     }
     
     // Evaluate the true block (first argument) and return its result
-    return g_primitives[PRIM_BLOCK_VALUE](args[0], NULL, 0);
+    return ezom_send0(args[0], ezom_value_selector(0));
 }
 
 // False>>ifTrue:
@@ -721,7 +962,7 @@ uint24_t prim_false_if_true(uint24_t receiver, uint24_t* args, uint8_t arg_count
     
     // Check if argument is a block (for consistency)
     if (!ezom_is_block(args[0])) {
-        printf("Type error: ifTrue: sent with non-block argument\n");
+        ezom_primitive_failed("Type error: ifTrue: sent with non-block argument");
         return g_nil;
     }
     
@@ -742,12 +983,12 @@ uint24_t prim_false_if_false(uint24_t receiver, uint24_t* args, uint8_t arg_coun
     
     // Check if argument is a block
     if (!ezom_is_block(args[0])) {
-        printf("Type error: ifFalse: sent with non-block argument\n");
+        ezom_primitive_failed("Type error: ifFalse: sent with non-block argument");
         return g_nil;
     }
     
     // Evaluate the false block and return its result
-    return g_primitives[PRIM_BLOCK_VALUE](args[0], NULL, 0);
+    return ezom_send0(args[0], ezom_value_selector(0));
 }
 
 // False>>ifTrue:ifFalse:
@@ -763,12 +1004,12 @@ uint24_t prim_false_if_true_if_false(uint24_t receiver, uint24_t* args, uint8_t
     
     // Check if both arguments are blocks
     if (!ezom_is_block(args[0]) || !ezom_is_block(args[1])) {
-        printf("Type error: ifTrue:ifFalse: sent with non-block argument(s)\n");
+        ezom_primitive_failed("Type error: ifTrue:ifFalse: sent with non-block argument(s)");
         return g_nil;
     }
     
     // Evaluate the false block (second argument) and return its result
-    return g_primitives[PRIM_BLOCK_VALUE](args[1], NULL, 0);
+    return ezom_send0(args[1], ezom_value_selector(0));
 }
 
 // Boolean>>not
@@ -779,7 +1020,7 @@ uint24_t prim_boolean_not(uint24_t receiver, uint24_t* args, uint8_t arg_count)
         return g_true;
     }
     
-    printf("Type error: not sent to non-boolean\n");
+    ezom_primitive_failed("Type error: not sent to non-boolean");
     return g_nil;
 }
 
@@ -790,14 +1031,14 @@ uint24_t prim_boolean_not(uint24_t receiver, uint24_t* args, uint8_t arg_count)
 // Block>>value
 uint24_t prim_block_value(uint24_t receiver, uint24_t* args, uint8_t arg_count) {
     if (!ezom_is_block(receiver)) {
-        printf("Type error: value sent to non-block\n");
+        ezom_primitive_failed("Type error: value sent to non-block");
         return g_nil;
     }
     
     ezom_block_t* block = (ezom_block_t*)EZOM_OBJECT_PTR(receiver);
     
     if (block->param_count != 0) {
-        printf("Block expects %d parameters, got 0\n", block->param_count);
+        ezom_primitive_failed("Block expects %d parameters, got 0", block->param_count);
         return g_nil;
     }
     
@@ -808,19 +1049,19 @@ uint24_t prim_block_value(uint24_t receiver, uint24_t* args, uint8_t arg_count)
 // Block>>value:
 uint24_t prim_block_value_with(uint24_t receiver, uint24_t* args, uint8_t arg_count) {
     if (!ezom_is_block(receiver)) {
-        printf("Type error: value: sent to non-block\n");
+        ezom_primitive_failed("Type error: value: sent to non-block");
         return g_nil;
     }
     
     if (arg_count != 1) {
-        printf("Block value: expects 1 argument, got %d\n", arg_count);
+        ezom_primitive_failed("Block value: expects 1 argument, got %d", arg_count);
         return g_nil;
     }
     
     ezom_block_t* block = (ezom_block_t*)EZOM_OBJECT_PTR(receiver);
     
     if (block->param_count != 1) {
-        printf("Block expects %d parameters, got 1\n", block->param_count);
+        ezom_primitive_failed("Block expects %d parameters, got 1", block->param_count);
         return g_nil;
     }
     
@@ -831,12 +1072,12 @@ uint24_t prim_block_value_with(uint24_t receiver, uint24_t* args, uint8_t arg_co
 // Block>>whileTrue:
 uint24_t prim_block_while_true(uint24_t receiver, uint24_t* args, uint8_t arg_count) {
     if (!ezom_is_block(receiver)) {
-        printf("Type error: whileTrue: sent to non-block\n");
+        ezom_primitive_failed("Type error: whileTrue: sent to non-block");
         return g_nil;
     }
     
     if (arg_count != 1 || !ezom_is_block(args[0])) {
-        printf("Type error: whileTrue: expects one block argument\n");
+        ezom_primitive_failed("Type error: whileTrue: expects one block argument");
         return g_nil;
     }
     
@@ -844,19 +1085,23 @@ uint24_t prim_block_while_true(uint24_t receiver, uint24_t* args, uint8_t arg_co
     uint24_t body_block = args[0];
     
     if (condition_block->param_count != 0) {
-        printf("Condition block must have no parameters\n");
+        ezom_primitive_failed("Condition block must have no parameters");
         return g_nil;
     }
     
     // Execute while loop: [ condition ] whileTrue: [ body ]
+    uint24_t value = ezom_value_selector(0);
+    uint16_t scratch = ezom_double_scratch_mark();
     while (true) {
         // Evaluate condition block
         uint24_t result = ezom_block_evaluate(receiver, NULL, 0);
         
         // Check if result is true
         if (result == g_true) {
-            // Execute body block
-            g_primitives[PRIM_BLOCK_VALUE](body_block, NULL, 0);
+            // Execute body block; its result is discarded
+            ezom_send0(body_block, value);
+            ezom_double_scratch_release(scratch);
+            if (EZOM_FRAME_UNWINDING()) break;     // A ^ left the loop
         } else {
             break;
         }
@@ -868,12 +1113,12 @@ uint24_t prim_block_while_true(uint24_t receiver, uint24_t* args, uint8_t arg_co
 // Block>>whileFalse:
 uint24_t prim_block_while_false(uint24_t receiver, uint24_t* args, uint8_t arg_count) {
     if (!ezom_is_block(receiver)) {
-        printf("Type error: whileFalse: sent to non-block\n");
+        ezom_primitive_failed("Type error: whileFalse: sent to non-block");
         return g_nil;
     }
     
     if (arg_count != 1 || !ezom_is_block(args[0])) {
-        printf("Type error: whileFalse: expects one block argument\n");
+        ezom_primitive_failed("Type error: whileFalse: expects one block argument");
         return g_nil;
     }
     
@@ -881,19 +1126,23 @@ uint24_t prim_block_while_false(uint24_t receiver, uint24_t* args, uint8_t arg_c
     uint24_t body_block = args[0];
     
     if (condition_block->param_count != 0) {
-        printf("Condition block must have no parameters\n");
+        ezom_primitive_failed("Condition block must have no parameters");
         return g_nil;
     }
     
     // Execute while loop: [ condition ] whileFalse: [ body ]
+    uint24_t value = ezom_value_selector(0);
+    uint16_t scratch = ezom_double_scratch_mark();
     while (true) {
         // Evaluate condition block
         uint24_t result = ezom_block_evaluate(receiver, NULL, 0);
         
         // Check if result is false
         if (result == g_false) {
-            // Execute body block
-            g_primitives[PRIM_BLOCK_VALUE](body_block, NULL, 0);
+            // Execute body block; its result is discarded
+            ezom_send0(body_block, value);
+            ezom_double_scratch_release(scratch);
+            if (EZOM_FRAME_UNWINDING()) break;     // A ^ left the loop
         } else {
             break;
         }
@@ -902,16 +1151,138 @@ uint24_t prim_block_while_false(uint24_t receiver, uint24_t* args, uint8_t arg_c
     return g_nil;
 }
 
+static bool ezom_is_class_object(uint24_t obj) {
+    if (!obj || !ezom_is_valid_object(obj)) return false;
+    ezom_object_t* object = (ezom_object_t*)EZOM_OBJECT_PTR(obj);
+    return (object->flags & 0xF0) == EZOM_TYPE_CLASS;
+}
+
+// Block>>on:do:
+uint24_t prim_block_on_do(uint24_t receiver, uint24_t* args, uint8_t arg_count) {
+    if (!ezom_is_block(receiver) || arg_count != 2 || !args ||
+        !ezom_is_class_object(args[0]) || !ezom_is_block(args[1])) {
+        ezom_primitive_failed("Type error: on:do: expects a block, a class and a handler block");
+        return g_nil;
+    }
+    
+    ezom_block_t* block = (ezom_block_t*)EZOM_OBJECT_PTR(receiver);
+    ezom_block_t* handler = (ezom_block_t*)EZOM_OBJECT_PTR(args[1]);
+    if (block->param_count != 0 || handler->param_count > 1) {
+        ezom_primitive_failed("on:do: expects a block without parameters and a handler with at most one");
+        return g_nil;
+    }
+    
+    return ezom_exception_on_do(receiver, args[0], args[1]);
+}
+
+static uint24_t ezom_block_ensure(uint24_t receiver, uint24_t* args, uint8_t arg_count, bool only_if_curtailed) {
+    if (!ezom_is_block(receiver) || arg_count != 1 || !args || !ezom_is_block(args[0])) {
+        ezom_primitive_failed("Type error: %s expects a block argument", only_if_curtailed ? "ifCurtailed:" : "ensure:");
+        return g_nil;
+    }
+    
+    ezom_block_t* block = (ezom_block_t*)EZOM_OBJECT_PTR(receiver);
+    ezom_block_t* cleanup = (ezom_block_t*)EZOM_OBJECT_PTR(args[0]);
+    if (block->param_count != 0 || cleanup->param_count != 0) {
+        ezom_primitive_failed("%s blocks must have no parameters", only_if_curtailed ? "ifCurtailed:" : "ensure:");
+        return g_nil;
+    }
+    
+    return ezom_exception_ensure(receiver, args[0], only_if_curtailed);
+}
+
+// Block>>ensure:
+uint24_t prim_block_ensure(uint24_t receiver, uint24_t* args, uint8_t arg_count) {
+    return ezom_block_ensure(receiver, args, arg_count, false);
+}
+
+// Block>>ifCurtailed:
+uint24_t prim_block_if_curtailed(uint24_t receiver, uint24_t* args, uint8_t arg_count) {
+    return ezom_block_ensure(receiver, args, arg_count, true);
+}
+
+// ============================================================================
+// EXCEPTION PRIMITIVES
+// ============================================================================
+
+// Classes answer signal through the Exception metaclass
+static bool ezom_is_exception_class(uint24_t obj) {
+    return g_exception_metaclass && ezom_class_of(obj) == g_exception_metaclass;
+}
+
+// Exception class>>new
+uint24_t prim_exception_new(uint24_t receiver, uint24_t* args, uint8_t arg_count) {
+    (void)args;
+    (void)arg_count;
+    uint24_t exception = ezom_create_exception(receiver, g_nil);
+    return exception ? exception : g_nil;
+}
+
+// Exception>>signal and Exception class>>signal. Answers the handler
+// block's value to nobody: the on:do: answers it after the unwind.
+uint24_t prim_exception_signal(uint24_t receiver, uint24_t* args, uint8_t arg_count) {
+    (void)args;
+    (void)arg_count;
+    uint24_t exception = ezom_is_exception_class(receiver) ? ezom_create_exception(receiver, g_nil) : receiver;
+    if (!exception) return g_nil;
+    
+    if (!ezom_exception_signal(exception)) {
+        uint24_t text = ezom_get_instance_variable(exception, 0);
+        if (ezom_is_string(text)) {
+            ezom_string_t* string = (ezom_string_t*)EZOM_OBJECT_PTR(text);
+            printf("Unhandled exception: %.*s", string->length, string->data);
+        } else {
+            printf("Unhandled exception");
+        }
+        printf("\n");
+    }
+    return g_nil;
+}
+
+// Exception>>signal: and Exception class>>signal:
+uint24_t prim_exception_signal_with(uint24_t receiver, uint24_t* args, uint8_t arg_count) {
+    uint24_t exception = ezom_is_exception_class(receiver) ? ezom_create_exception(receiver, g_nil) : receiver;
+    if (!exception) return g_nil;
+    if (arg_count == 1 && args) {
+        ezom_set_instance_variable(exception, 0, args[0]);
+    }
+    return prim_exception_signal(exception, NULL, 0);
+}
+
+// Exception>>messageText
+uint24_t prim_exception_message_text(uint24_t receiver, uint24_t* args, uint8_t arg_count) {
+    (void)args;
+    (void)arg_count;
+    return ezom_get_instance_variable(receiver, 0);
+}
+
+// Exception>>messageText:
+uint24_t prim_exception_set_message_text(uint24_t receiver, uint24_t* args, uint8_t arg_count) {
+    if (arg_count == 1 && args) {
+        ezom_set_instance_variable(receiver, 0, args[0]);
+    }
+    return receiver;
+}
+
 // ============================================================================
 // UTILITY FUNCTIONS
 // ============================================================================
 
 bool ezom_is_integer(uint24_t obj) {
+    if (EZOM_IS_SMALLINT(obj)) return true;
+    
+    // Boxed LargeInteger
     if (!obj || !ezom_is_valid_object(obj)) return false;
     ezom_object_t* object = (ezom_object_t*)EZOM_OBJECT_PTR(obj);
     return (object->flags & 0xF0) == EZOM_TYPE_INTEGER;
 }
 
+bool ezom_is_double(uint24_t obj) {
+    if (!obj || !ezom_is_valid_object(obj)) return false;
+    ezom_object_t* object = (ezom_object_t*)EZOM_OBJECT_PTR(obj);
+    return (object->flags & 0xF0) == EZOM_TYPE_DOUBLE;
+}
+
 bool ezom_is_string(uint24_t obj) {
     if (!obj || !ezom_is_valid_object(obj)) return false;
     ezom_object_t* object = (ezom_object_t*)EZOM_OBJECT_PTR(obj);
@@ -0,0 +1,517 @@
+// ============================================================================
+// File: src/resolver.c
+// Variable resolution pass implementation
+// ============================================================================
+
+#include "../include/ezom_resolver.h"
+#include "../include/ezom_evaluator.h"
+#include "../include/ezom_parser.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+ezom_resolver_stats_t g_resolver_stats = {0, 0, 0, 0, 0, 0, 0, 0};
+
+// A reference to a frame slot, kept until the frame is finished and it is
+// known whether the slot holds a box
+typedef struct ezom_slot_ref {
+    ezom_ast_node_t* node;
+    uint8_t          slot;
+} ezom_slot_ref_t;
+
+// A method, block or inlined block scope. A frame scope owns a context;
+// an inlined block's scope lends its variables slots in the frame of the
+// scope it is inlined into. Slots follow the context layout: parameters
+// first, then locals, then the variables of inlined blocks.
+typedef struct ezom_scope {
+    ezom_ast_node_t*   parameters;
+    ezom_ast_node_t*   locals;
+    struct ezom_scope* outer;       // Enclosing scope (NULL = home)
+    struct ezom_scope* frame;       // Scope owning the context (itself if not inlined)
+    ezom_ast_node_t*   block;       // Closure literal owning this frame (NULL = home)
+    uint8_t            base;        // Frame slot of the first parameter
+    uint8_t            slot_count;  // Frame scopes: slots handed out so far
+    // Frame scopes: slots closures capture and slots assigned (bit sets),
+    // every reference to a slot, and the blocks inlined into the frame
+    uint8_t            captured[32];
+    uint8_t            assigned[32];
+    ezom_slot_ref_t*   refs;
+    uint16_t           ref_count;
+    ezom_ast_node_t**  inlined;
+    uint16_t           inlined_count;
+} ezom_scope_t;
+
+#define EZOM_SLOT_IN(set, slot)     (((set)[(slot) >> 3] >> ((slot) & 7)) & 1)
+#define EZOM_SLOT_ADD(set, slot)    ((set)[(slot) >> 3] |= (uint8_t)(1 << ((slot) & 7)))
+
+static void ezom_resolve_node(ezom_ast_node_t* node, ezom_scope_t* scope, uint24_t class_ptr);
+
+static void ezom_scope_init(ezom_scope_t* scope, ezom_ast_node_t* parameters,
+                            ezom_ast_node_t* locals, ezom_scope_t* outer) {
+    scope->parameters = parameters;
+    scope->locals = locals;
+    scope->outer = outer;
+    scope->frame = scope;
+    scope->block = NULL;
+    scope->base = 0;
+    scope->slot_count = ezom_ast_count_parameters(parameters) + ezom_ast_count_locals(locals);
+    memset(scope->captured, 0, sizeof(scope->captured));
+    memset(scope->assigned, 0, sizeof(scope->assigned));
+    scope->refs = NULL;
+    scope->ref_count = 0;
+    scope->inlined = NULL;
+    scope->inlined_count = 0;
+}
+
+// Append to a table that grows in steps of 8 entries
+static bool ezom_resolver_append(void** table, uint16_t* count, size_t entry_size, const void* entry) {
+    if (*count % 8 == 0) {
+        void* grown = realloc(*table, (*count + 8) * entry_size);
+        if (!grown) {
+            printf("Warning: out of memory resolving variables\n");
+            return false;
+        }
+        *table = grown;
+    }
+    memcpy((char*)*table + *count * entry_size, entry, entry_size);
+    (*count)++;
+    return true;
+}
+
+// Frame slot of name in one scope, or -1
+static int ezom_scope_slot(ezom_scope_t* scope, const char* name) {
+    int index = ezom_find_parameter_index(name, scope->parameters);
+    if (index >= 0) {
+        return scope->base + index;
+    }
+
+    index = ezom_find_local_variable_index(name, scope->locals);
+    if (index >= 0) {
+        return scope->base + ezom_ast_count_parameters(scope->parameters) + index;
+    }
+
+    return -1;
+}
+
+// The method or program frame scope enclosing scope
+static ezom_scope_t* ezom_scope_home(ezom_scope_t* scope) {
+    for (scope = scope->frame; scope->block; scope = scope->outer->frame) {
+    }
+    return scope;
+}
+
+// Resolver results beside a block node, made when first needed
+static ezom_block_vars_t* ezom_block_vars(ezom_ast_node_t* block) {
+    if (!block->data.block.vars) {
+        block->data.block.vars = (ezom_block_vars_t*)calloc(1, sizeof(ezom_block_vars_t));
+        if (!block->data.block.vars) {
+            printf("Warning: out of memory resolving variables\n");
+        }
+    }
+    return block->data.block.vars;
+}
+
+// Index in closure's captures of a slot of frame, or of frame's receiver
+// (slot < 0), adding it if need be. Closures in between capture it too,
+// so each new closure copies the value from the one creating it. Answers
+// -1 if a closure has too many captures.
+static int ezom_scope_capture(ezom_scope_t* closure, ezom_scope_t* frame, int slot) {
+    ezom_scope_t* creator = closure->outer->frame;
+    ezom_capture_t capture;
+    if (creator == frame) {
+        capture.source = slot < 0 ? AST_CAPTURE_SELF : AST_CAPTURE_LOCAL;
+        capture.index = slot < 0 ? 0 : (uint8_t)slot;
+    } else {
+        int outer = ezom_scope_capture(creator, frame, slot);
+        if (outer < 0) return -1;
+        capture.source = AST_CAPTURE_OUTER;
+        capture.index = (uint8_t)outer;
+    }
+
+    ezom_block_vars_t* vars = ezom_block_vars(closure->block);
+    if (!vars) return -1;
+    for (uint8_t i = 0; i < vars->capture_count; i++) {
+        if (vars->captures[i].source == capture.source && vars->captures[i].index == capture.index) {
+            return i;
+        }
+    }
+    if (vars->capture_count == AST_NO_CAPTURE) return -1;
+
+    uint16_t count = vars->capture_count;
+    if (!ezom_resolver_append((void**)&vars->captures, &count, sizeof(capture), &capture)) {
+        return -1;
+    }
+    vars->capture_count = (uint8_t)count;
+    g_resolver_stats.captures++;
+    return count - 1;
+}
+
+// A reference from scope reaches past the frames of the closures in
+// between: they need their outer context and cannot be shared. With no
+// target it reaches the home frame (self, instance variables, ^).
+static void ezom_scope_reach(ezom_scope_t* scope, ezom_scope_t* target) {
+    for (scope = scope->frame; scope != target && scope->block; scope = scope->outer->frame) {
+        scope->block->data.block.clean = false;
+    }
+}
+
+// Identifier becomes a literal (nil, true, false)
+static void ezom_resolve_to_literal(ezom_ast_node_t* node, int literal_type) {
+    free(node->data.identifier.name);
+    node->type = AST_LITERAL;
+    node->data.literal.type = literal_type;
+    node->data.literal.object = 0;
+}
+
+// Identifier becomes a variable reference. The name stays in place: it is
+// the first field of both the identifier and variable structs.
+static void ezom_resolve_to_variable(ezom_ast_node_t* node, ezom_var_kind_t kind,
+                                     uint8_t capture, uint16_t index) {
+    node->type = AST_VARIABLE_DEF;
+    node->data.variable.kind = kind;
+    node->data.variable.capture = capture;
+    node->data.variable.boxed = false;
+    node->data.variable.index = index;
+    node->data.variable.is_instance_var = (kind == AST_VAR_INSTANCE);
+    node->data.variable.is_local = (kind == AST_VAR_CONTEXT);
+    node->data.variable.global = NULL;
+}
+
+// self, or an instance variable of self: the receiver of the home frame,
+// which a closure reads from its captures
+static bool ezom_resolve_receiver_ref(ezom_ast_node_t* node, ezom_scope_t* scope,
+                                      ezom_var_kind_t kind, uint16_t index) {
+    ezom_scope_t* home = ezom_scope_home(scope);
+    int capture = AST_NO_CAPTURE;
+    if (scope->frame != home) {
+        capture = ezom_scope_capture(scope->frame, home, -1);
+        if (capture < 0) {
+            printf("Warning: '%s' left unresolved (too many captured variables)\n",
+                   node->data.identifier.name);
+            return false;
+        }
+    }
+    ezom_resolve_to_variable(node, kind, (uint8_t)capture, index);
+    ezom_scope_reach(scope, NULL);
+    return true;
+}
+
+// Answers the frame scope owning the slot for a parameter or local
+static ezom_scope_t* ezom_resolve_identifier(ezom_ast_node_t* node, ezom_scope_t* scope, uint24_t class_ptr) {
+    const char* name = node->data.identifier.name;
+
+    if (strcmp(name, "nil") == 0) {
+        ezom_resolve_to_literal(node, LITERAL_NIL);
+        return NULL;
+    }
+    if (strcmp(name, "true") == 0) {
+        ezom_resolve_to_literal(node, LITERAL_TRUE);
+        return NULL;
+    }
+    if (strcmp(name, "false") == 0) {
+        ezom_resolve_to_literal(node, LITERAL_FALSE);
+        return NULL;
+    }
+    if (strcmp(name, "self") == 0 || strcmp(name, "super") == 0) {
+        if (ezom_resolve_receiver_ref(node, scope, AST_VAR_SELF, 0)) {
+            g_resolver_stats.self_refs++;
+        }
+        return NULL;
+    }
+
+    // Parameters and locals, innermost scope first. One in another frame
+    // is read from the closure's captures.
+    for (ezom_scope_t* current = scope; current; current = current->outer) {
+        int slot = ezom_scope_slot(current, name);
+        if (slot < 0) continue;
+
+        ezom_scope_t* frame = current->frame;
+        int capture = AST_NO_CAPTURE;
+        if (scope->frame != frame) {
+            capture = ezom_scope_capture(scope->frame, frame, slot);
+            if (capture < 0) {
+                printf("Warning: '%s' left unresolved (too many captured variables)\n", name);
+                return NULL;
+            }
+            EZOM_SLOT_ADD(frame->captured, slot);
+        }
+        ezom_resolve_to_variable(node, AST_VAR_CONTEXT, (uint8_t)capture, (uint16_t)slot);
+        ezom_scope_reach(scope, frame);
+
+        ezom_slot_ref_t ref = {node, (uint8_t)slot};
+        ezom_resolver_append((void**)&frame->refs, &frame->ref_count, sizeof(ref), &ref);
+        g_resolver_stats.context_refs++;
+        return frame;
+    }
+
+    // Instance variables of the method's class and its superclasses
+    if (class_ptr) {
+        uint16_t index = ezom_find_instance_variable_index_in_class(class_ptr, name);
+        if (index != UINT16_MAX) {
+            if (ezom_resolve_receiver_ref(node, scope, AST_VAR_INSTANCE, index)) {
+                g_resolver_stats.instance_refs++;
+            }
+            return NULL;
+        }
+    }
+
+    // Anything else is a global, bound now and assigned later if need be
+    ezom_global_t* global = ezom_global_binding(name);
+    if (!global) {
+        printf("Warning: '%s' left unresolved (global table full)\n", name);
+        return NULL;
+    }
+    ezom_resolve_to_variable(node, AST_VAR_GLOBAL, AST_NO_CAPTURE, 0);
+    node->data.variable.global = global;
+    g_resolver_stats.global_refs++;
+    return NULL;
+}
+
+// Slots first..first+count-1 of frame that closures capture and code
+// assigns: they hold boxes, made when their scope is entered. The list
+// goes to owner, a method or block node.
+static void ezom_scope_boxed_slots(ezom_scope_t* frame, uint8_t first, uint16_t count,
+                                   ezom_ast_node_t* owner) {
+    uint8_t* boxed = NULL;
+    uint16_t boxed_count = 0;
+    for (uint16_t slot = first; slot < first + count; slot++) {
+        if (!EZOM_SLOT_IN(frame->captured, slot) || !EZOM_SLOT_IN(frame->assigned, slot)) continue;
+        uint8_t entry = (uint8_t)slot;
+        if (ezom_resolver_append((void**)&boxed, &boxed_count, 1, &entry)) {
+            g_resolver_stats.boxed_vars++;
+        }
+    }
+
+    uint8_t** list;
+    uint8_t* list_count;
+    if (owner->type == AST_METHOD_DEF) {
+        list = &owner->data.method_def.boxed;
+        list_count = &owner->data.method_def.boxed_count;
+    } else if (boxed_count || owner->data.block.vars) {
+        ezom_block_vars_t* vars = ezom_block_vars(owner);
+        if (!vars) {
+            free(boxed);
+            return;
+        }
+        list = &vars->boxed;
+        list_count = &vars->boxed_count;
+    } else {
+        return;
+    }
+    free(*list);
+    *list = boxed;
+    *list_count = (uint8_t)boxed_count;
+}
+
+// Every reference to frame's slots has been seen: mark the ones to boxed
+// slots, and give owner (NULL for a program) and each block inlined into
+// the frame the list of its own slots to box
+static void ezom_scope_finish(ezom_scope_t* frame, ezom_ast_node_t* owner) {
+    for (uint16_t i = 0; i < frame->ref_count; i++) {
+        uint8_t slot = frame->refs[i].slot;
+        frame->refs[i].node->data.variable.boxed =
+            EZOM_SLOT_IN(frame->captured, slot) && EZOM_SLOT_IN(frame->assigned, slot);
+    }
+
+    if (owner) {
+        ezom_scope_boxed_slots(frame, 0, ezom_ast_count_parameters(frame->parameters) +
+                                         ezom_ast_count_locals(frame->locals), owner);
+    }
+    for (uint16_t i = 0; i < frame->inlined_count; i++) {
+        ezom_ast_node_t* block = frame->inlined[i];
+        ezom_scope_boxed_slots(frame, block->data.block.inline_base,
+                               ezom_ast_count_parameters(block->data.block.parameters) +
+                               ezom_ast_count_locals(block->data.block.locals), block);
+    }
+
+    free(frame->refs);
+    free(frame->inlined);
+    frame->refs = NULL;
+    frame->inlined = NULL;
+}
+
+// Literal block with the given number of parameters?
+static bool ezom_is_literal_block(ezom_ast_node_t* node, uint16_t param_count) {
+    return node && node->type == AST_BLOCK &&
+           ezom_ast_count_parameters(node->data.block.parameters) == param_count;
+}
+
+// Which control-flow send this is, if its block arguments allow inlining
+static ezom_inline_kind_t ezom_inline_kind(ezom_ast_node_t* node) {
+    const char* selector = node->data.message_send.selector;
+    ezom_ast_node_t* receiver = node->data.message_send.receiver;
+    ezom_ast_node_t* arg = node->data.message_send.arguments;
+
+    if (!arg || !strchr(selector, ':')) return AST_INLINE_NONE;
+
+    if (!arg->next) {
+        if (!ezom_is_literal_block(arg, 0)) return AST_INLINE_NONE;
+        if (strcmp(selector, "ifTrue:") == 0) return AST_INLINE_IF_TRUE;
+        if (strcmp(selector, "ifFalse:") == 0) return AST_INLINE_IF_FALSE;
+        if (strcmp(selector, "and:") == 0) return AST_INLINE_AND;
+        if (strcmp(selector, "or:") == 0) return AST_INLINE_OR;
+        if (strcmp(selector, "timesRepeat:") == 0) return AST_INLINE_TIMES_REPEAT;
+        if (ezom_is_literal_block(receiver, 0)) {
+            if (strcmp(selector, "whileTrue:") == 0) return AST_INLINE_WHILE_TRUE;
+            if (strcmp(selector, "whileFalse:") == 0) return AST_INLINE_WHILE_FALSE;
+        }
+        return AST_INLINE_NONE;
+    }
+
+    if (arg->next->next) return AST_INLINE_NONE;
+
+    if (strcmp(selector, "ifTrue:ifFalse:") == 0 &&
+        ezom_is_literal_block(arg, 0) && ezom_is_literal_block(arg->next, 0)) {
+        return AST_INLINE_IF_TRUE_IF_FALSE;
+    }
+    if (strcmp(selector, "to:do:") == 0 && ezom_is_literal_block(arg->next, 1)) {
+        return AST_INLINE_TO_DO;
+    }
+    return AST_INLINE_NONE;
+}
+
+// Block inlined into scope's frame: its variables take the next free
+// slots there (never reused, since closures may still see them).
+// Answers false if it had to stay a closure.
+static bool ezom_resolve_inlined_block(ezom_ast_node_t* block, ezom_scope_t* scope, uint24_t class_ptr) {
+    ezom_scope_t* frame = scope->frame;
+    ezom_scope_t inlined_scope;
+    ezom_scope_init(&inlined_scope, block->data.block.parameters, block->data.block.locals, scope);
+    inlined_scope.frame = frame;
+    inlined_scope.base = frame->slot_count;
+
+    uint16_t slots = frame->slot_count + inlined_scope.slot_count;
+    if (slots > 255) {
+        // Too many to address: leave it a closure
+        ezom_resolve_node(block, scope, class_ptr);
+        return false;
+    }
+    frame->slot_count = (uint8_t)slots;
+
+    block->data.block.inlined = true;
+    block->data.block.inline_base = inlined_scope.base;
+    ezom_resolver_append((void**)&frame->inlined, &frame->inlined_count, sizeof(block), &block);
+    ezom_resolve_node(block->data.block.body, &inlined_scope, class_ptr);
+    return true;
+}
+
+static void ezom_resolve_send(ezom_ast_node_t* node, ezom_scope_t* scope, uint24_t class_ptr) {
+    ezom_inline_kind_t kind = ezom_inline_kind(node);
+    bool inlined = (kind != AST_INLINE_NONE);
+
+    ezom_ast_node_t* receiver = node->data.message_send.receiver;
+    if (kind == AST_INLINE_WHILE_TRUE || kind == AST_INLINE_WHILE_FALSE) {
+        inlined = ezom_resolve_inlined_block(receiver, scope, class_ptr);
+    } else {
+        ezom_resolve_node(receiver, scope, class_ptr);
+    }
+
+    for (ezom_ast_node_t* arg = node->data.message_send.arguments; arg; arg = arg->next) {
+        if (kind != AST_INLINE_NONE && arg->type == AST_BLOCK) {
+            inlined = ezom_resolve_inlined_block(arg, scope, class_ptr) && inlined;
+        } else {
+            ezom_resolve_node(arg, scope, class_ptr);
+        }
+    }
+
+    // A block that stayed a closure makes this an ordinary send; the
+    // inlined ones still run in this frame when the send evaluates them
+    node->data.message_send.inline_kind = inlined ? kind : AST_INLINE_NONE;
+    if (inlined) {
+        g_resolver_stats.inlined_sends++;
+    }
+}
+
+static void ezom_resolve_node(ezom_ast_node_t* node, ezom_scope_t* scope, uint24_t class_ptr) {
+    if (!node) return;
+
+    switch (node->type) {
+        case AST_IDENTIFIER:
+            ezom_resolve_identifier(node, scope, class_ptr);
+            break;
+
+        case AST_MESSAGE_SEND:
+            ezom_resolve_send(node, scope, class_ptr);
+            break;
+
+        case AST_UNARY_MESSAGE:
+        case AST_BINARY_MESSAGE:
+        case AST_KEYWORD_MESSAGE:
+            ezom_resolve_node(node->data.message_send.receiver, scope, class_ptr);
+            for (ezom_ast_node_t* arg = node->data.message_send.arguments; arg; arg = arg->next) {
+                ezom_resolve_node(arg, scope, class_ptr);
+            }
+            break;
+
+        case AST_ASSIGNMENT: {
+            ezom_ast_node_t* target = node->data.assignment.variable;
+            if (target->type == AST_IDENTIFIER) {
+                ezom_scope_t* frame = ezom_resolve_identifier(target, scope, class_ptr);
+                if (frame) {
+                    EZOM_SLOT_ADD(frame->assigned, target->data.variable.index);
+                }
+            }
+            ezom_resolve_node(node->data.assignment.value, scope, class_ptr);
+            break;
+        }
+
+        case AST_RETURN:
+            ezom_scope_reach(scope, NULL);
+            ezom_resolve_node(node->data.return_stmt.expression, scope, class_ptr);
+            break;
+
+        case AST_STATEMENT_LIST:
+            for (ezom_ast_node_t* stmt = node->data.statement_list.statements; stmt; stmt = stmt->next) {
+                ezom_resolve_node(stmt, scope, class_ptr);
+            }
+            break;
+
+        case AST_BLOCK: {
+            ezom_scope_t block_scope;
+            ezom_scope_init(&block_scope, node->data.block.parameters, node->data.block.locals, scope);
+            block_scope.block = node;
+            node->data.block.clean = true;
+            if (node->data.block.vars) {
+                node->data.block.vars->capture_count = 0;
+            }
+            ezom_resolve_node(node->data.block.body, &block_scope, class_ptr);
+            node->data.block.inlined_slots = block_scope.slot_count - ezom_ast_count_parameters(node->data.block.parameters)
+                                                                    - ezom_ast_count_locals(node->data.block.locals);
+            ezom_scope_finish(&block_scope, node);
+            if (node->data.block.clean && ezom_block_vars(node)) {
+                g_resolver_stats.clean_blocks++;
+            } else {
+                node->data.block.clean = false;
+            }
+            break;
+        }
+
+        default:
+            // Literals, already resolved variables, and class definitions
+            // (their methods are resolved when installed)
+            break;
+    }
+}
+
+uint8_t ezom_resolve_program(ezom_ast_node_t* ast) {
+    ezom_scope_t program_scope;
+    ezom_scope_init(&program_scope, NULL, NULL, NULL);
+    ezom_resolve_node(ast, &program_scope, 0);
+
+    // The program declares no variables of its own
+    ezom_scope_finish(&program_scope, NULL);
+    return program_scope.slot_count;
+}
+
+void ezom_resolve_method(ezom_ast_node_t* method_ast, uint24_t class_ptr) {
+    if (!method_ast || method_ast->type != AST_METHOD_DEF) return;
+
+    ezom_scope_t method_scope;
+    ezom_scope_init(&method_scope, method_ast->data.method_def.parameters,
+                    method_ast->data.method_def.locals, NULL);
+    ezom_resolve_node(method_ast->data.method_def.body, &method_scope, class_ptr);
+    method_ast->data.method_def.inlined_slots = method_scope.slot_count
+        - ezom_ast_count_parameters(method_ast->data.method_def.parameters)
+        - ezom_ast_count_locals(method_ast->data.method_def.locals);
+    ezom_scope_finish(&method_scope, method_ast);
+}
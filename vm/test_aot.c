@@ -0,0 +1,94 @@
+#include "test_support.h"
+#ifdef EZOM_AOT
+#include "include/ezom_aot.h"
+#include "include/ezom_aotc.h"
+
+// Methods become C unless a block stays a closure
+void test_translate(void) {
+    printf("=== AOT Translation Test ===\n");
+
+    FILE* out = tmpfile();
+    ezom_aotc_stats_t stats = {0, 0, 0};
+    assert(ezom_aotc_translate_file(
+        "Tally = Object ( | last | "
+        "last: v = ( last := v ) "
+        "sumTo: n = ( | s | s := 0. 1 to: n do: [:i | s := s + i]. ^s ) "
+        "each: a = ( a do: [:e | last := e]. ^last ) )",
+        "tally.som", out, true, &stats));
+    assert(stats.classes == 1 && stats.translated == 2 && stats.kept == 1);
+
+    long length = ftell(out);
+    char* text = malloc(length + 1);
+    rewind(out);
+    text[fread(text, 1, length, out)] = '\0';
+    fclose(out);
+
+    assert(strstr(text, "static uint24_t aot_Tally_0(uint24_t self, uint24_t* args)"));
+    assert(strstr(text, "ezom_aot_add("));
+    assert(strstr(text, "\"each: a = ( a do: [:e | last := e]. ^last )\""));
+    assert(strstr(text, "const ezom_aot_program_t ezom_aot_program"));
+    free(text);
+
+    printf("✓ %u methods as C, %u kept as source\n", stats.translated, stats.kept);
+}
+
+// What ezom_aotc writes for  double: n = ( ^n + n )
+static ezom_inline_cache_t g_double_ic[1];
+
+static uint24_t aot_double(uint24_t self, uint24_t* args) {
+    uint24_t t0 = args[0];
+    uint24_t t1;
+    if (!ezom_aot_add(t0, t0, &t1)) {
+        t1 = ezom_aot_send(&g_double_ic[0], "+", t0, &t0, 1);
+        EZOM_AOT_CHECK();
+    }
+    return t1;
+}
+
+static const char* const g_fields[] = {"total"};
+static const ezom_aot_method_t g_methods[] = {
+    {"double:", 1, aot_double, NULL},
+    {"twice:", 1, NULL, "twice: n = ( ^[:x | self double: x] value: n )"},
+};
+static const ezom_aot_class_t g_aot_class = {"Doubler", NULL, g_fields, 1, g_methods, 2, NULL, 0};
+
+// A registered class answers through C, Doubles take the send, and a
+// method kept as source runs interpreted and calls back into C
+void test_registered_class(void) {
+    printf("=== AOT Registration Test ===\n");
+
+    uint24_t class_ptr = ezom_aot_define_class(&g_aot_class);
+    assert(class_ptr != 0 && ezom_lookup_global("Doubler") == class_ptr);
+    assert(g_aot_stats.translated == 1 && g_aot_stats.parsed == 1);
+
+    uint24_t doubler = ezom_create_instance(class_ptr);
+    assert(ezom_send1(doubler, selector("double:"), ezom_create_integer(21)) == ezom_create_integer(42));
+    uint24_t sum = ezom_send1(doubler, selector("double:"), ezom_create_double(1.5));
+    assert(ezom_is_double(sum) && ((ezom_double_t*)EZOM_OBJECT_PTR(sum))->value == 3.0);
+    assert(ezom_send1(doubler, selector("twice:"), ezom_create_integer(4)) == ezom_create_integer(8));
+    assert(g_aot_stats.runs == 3);
+
+    printf("✓ double: and twice: answer 42, 3.0 and 8\n");
+}
+
+int main() {
+    printf("=== AOT Tests ===\n");
+
+    test_init_vm();
+
+    test_translate();
+    test_registered_class();
+
+    printf("\n=== All AOT Tests Passed! ===\n");
+    return 0;
+}
+
+#else
+
+int main() {
+    printf("=== AOT Tests ===\n");
+    printf("Built without -DEZOM_AOT: nothing to test\n");
+    return 0;
+}
+
+#endif
@@ -48,7 +48,7 @@ void test_block_system() {
             uint24_t prim_result = prim_block_value(result.value, NULL, 0);
             printf("✓ Block primitive result: 0x%06X\n", prim_result);
         } else {
-            printf("✗ Block literal evaluation failed: %s\n", result.error_msg);
+            printf("✗ Block literal evaluation failed: %s\n", g_eval_error.message);
         }
     } else {
         printf("✗ Block parsing failed\n");
@@ -82,7 +82,7 @@ void test_block_system() {
             uint24_t prim_result = prim_block_value_with(result.value, block_args, 1);
             printf("✓ Block primitive with arg 5: 0x%06X\n", prim_result);
         } else {
-            printf("✗ Block literal evaluation failed: %s\n", result.error_msg);
+            printf("✗ Block literal evaluation failed: %s\n", g_eval_error.message);
         }
     } else {
         printf("✗ Block with parameter parsing failed\n");
@@ -110,7 +110,7 @@ void test_block_system() {
             uint24_t block_result = ezom_block_evaluate(result.value, NULL, 0);
             printf("✓ Block execution result: 0x%06X\n", block_result);
         } else {
-            printf("✗ Block literal evaluation failed: %s\n", result.error_msg);
+            printf("✗ Block literal evaluation failed: %s\n", g_eval_error.message);
         }
     } else {
         printf("✗ Block with locals parsing failed\n");
@@ -139,7 +139,7 @@ void test_block_system() {
             uint24_t block_result = ezom_block_evaluate(result.value, args, 2);
             printf("✓ Block execution with args 3,4: 0x%06X\n", block_result);
         } else {
-            printf("✗ Block literal evaluation failed: %s\n", result.error_msg);
+            printf("✗ Block literal evaluation failed: %s\n", g_eval_error.message);
         }
     } else {
         printf("✗ Block with params and locals parsing failed\n");
@@ -161,7 +161,7 @@ void test_block_system() {
         if (!result.is_error) {
             printf("✓ Control flow evaluation successful: 0x%06X\n", result.value);
         } else {
-            printf("✗ Control flow evaluation failed: %s\n", result.error_msg);
+            printf("✗ Control flow evaluation failed: %s\n", g_eval_error.message);
         }
     } else {
         printf("✗ Control flow parsing failed\n");
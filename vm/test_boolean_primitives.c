@@ -33,11 +33,9 @@ ezom_eval_result_t parse_and_evaluate(const char* code) {
 bool is_integer_with_value(uint24_t obj, int expected_value) {
     if (!obj) return false;
     
-    ezom_object_t* obj_ptr = (ezom_object_t*)EZOM_OBJECT_PTR(obj);
-    if (!obj_ptr || obj_ptr->flags != EZOM_TYPE_INTEGER) return false;
+    if (!EZOM_IS_SMALLINT(obj)) return false;
     
-    ezom_integer_t* int_obj = (ezom_integer_t*)obj_ptr;
-    return int_obj->value == expected_value;
+    return EZOM_SMALLINT_VALUE(obj) == expected_value;
 }
 
 // Helper function to check if result is true
@@ -0,0 +1,173 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "include/ezom_object.h"
+#include "include/ezom_memory.h"
+#include "include/ezom_primitives.h"
+#include "include/ezom_dispatch.h"
+#include "include/ezom_context.h"
+#include "include/ezom_lexer.h"
+#include "include/ezom_parser.h"
+#include "include/ezom_evaluator.h"
+#include "include/ezom_resolver.h"
+#include "include/ezom_bytecode.h"
+
+static ezom_ast_node_t* parse(const char* code) {
+    static ezom_lexer_t lexer;
+    static ezom_parser_t parser;
+    ezom_lexer_init(&lexer, (char*)code);
+    ezom_parser_init(&parser, &lexer);
+    ezom_ast_node_t* ast = ezom_parse_statement(&parser);
+    assert(ast != NULL);
+    return ast;
+}
+
+// Block bodies compile once and run from the cached code
+void test_block_compilation() {
+    printf("=== Block Compilation Test ===\n");
+
+    ezom_ast_node_t* block_ast = parse("[:x | | t | t := x * 2. t + 1]");
+    ezom_resolve_program(block_ast);
+
+    ezom_code_t* code = ezom_compile_block(block_ast);
+    assert(code != NULL);
+    assert(ezom_compile_block(block_ast) == code);
+    ezom_code_print(code);
+
+    assert(code->param_count == 1 && code->local_count == 1);
+    assert(code->bytecodes[0] == BC_PUSH_LOCAL && code->bytecodes[1] == 0);
+    assert(code->bytecodes[code->length - 1] == BC_END);
+    assert(code->site_count == 2);
+
+    uint24_t block = ezom_create_ast_block(block_ast, ezom_create_extended_context(0, 0, 0, 0));
+    uint24_t arg = ezom_create_integer(5);
+    assert(ezom_block_evaluate(block, &arg, 1) == ezom_create_integer(11));
+
+    printf("✓ [:x | t := x * 2. t + 1] value: 5 = 11\n");
+}
+
+// Both engines give the same answer for the same program
+void test_engine_parity() {
+    printf("=== Engine Parity Test ===\n");
+
+    ezom_ast_node_t* ast = parse("1 to: 4 do: [:i | sum := sum + (i * i)]");
+    uint8_t slots = ezom_resolve_program(ast);
+
+    ezom_set_engine(EZOM_ENGINE_AST);
+    ezom_set_global("sum", ezom_create_integer(0));
+    assert(!ezom_run_program(ast, ezom_create_extended_context(0, 0, 0, slots)).is_error);
+    assert(ezom_lookup_global("sum") == ezom_create_integer(30));
+
+    ezom_set_engine(EZOM_ENGINE_BYTECODE);
+    uint32_t activations = g_bytecode_stats.activations;
+    ezom_set_global("sum", ezom_create_integer(0));
+    assert(!ezom_run_program(ast, ezom_create_extended_context(0, 0, 0, slots)).is_error);
+    assert(ezom_lookup_global("sum") == ezom_create_integer(30));
+    assert(g_bytecode_stats.activations > activations);
+
+    printf("✓ Sum of squares 1..4 = 30 on both engines\n");
+}
+
+// Control-flow sends with literal blocks run in place
+void test_inlined_control_flow() {
+    printf("=== Inlined Control Flow Test ===\n");
+
+    ezom_ast_node_t* ast = parse("[i < 11] whileTrue: [i > 5 ifTrue: [sum := sum + i]. i := i + 1]");
+    uint8_t slots = ezom_resolve_program(ast);
+    assert(ast->data.message_send.inline_kind == AST_INLINE_WHILE_TRUE);
+
+    ezom_code_t* code = ezom_compile_program(ast);
+    assert(code != NULL);
+    ezom_code_print(code);
+    assert(code->block_count == 1);     // ifTrue: closure for a non-Boolean
+
+    ezom_set_global("i", ezom_create_integer(1));
+    ezom_set_global("sum", ezom_create_integer(0));
+    uint24_t context = ezom_create_extended_context(0, 0, 0, slots);
+    uint16_t allocations = g_heap.total_allocations;
+    assert(ezom_run_program(ast, context).value == g_nil);
+    assert(g_heap.total_allocations == allocations);
+    assert(ezom_lookup_global("sum") == ezom_create_integer(40));
+    ezom_code_free(code);
+
+    // A receiver that is not a Boolean still gets a real send, which nil
+    // does not understand
+    ast = parse("nil ifTrue: [1]");
+    ezom_resolve_program(ast);
+    assert(ast->data.message_send.inline_kind == AST_INLINE_IF_TRUE);
+    assert(ezom_run_program(ast, context).value == 0);
+
+    printf("✓ 6 + 7 + 8 + 9 + 10 = 40 without allocating\n");
+}
+
+// Unresolved trees are left to the AST evaluator
+void test_fallback() {
+    printf("=== AST Fallback Test ===\n");
+
+    uint16_t fallbacks = g_bytecode_stats.fallbacks;
+    ezom_ast_node_t* ast = parse("3 + 4");
+    ezom_ast_node_t* unresolved = parse("undefinedName");
+
+    assert(ezom_compile_program(unresolved) == NULL);
+    assert(g_bytecode_stats.fallbacks == fallbacks + 1);
+
+    ezom_resolve_program(ast);
+    ezom_code_t* code = ezom_compile_program(ast);
+    assert(code != NULL);
+    assert(ezom_interpret(code, 0).value == ezom_create_integer(7));
+    ezom_code_free(code);
+
+    printf("✓ Unresolved program declined, resolved one compiled\n");
+}
+
+// Methods compile at install time and run through ordinary sends
+void test_method_send() {
+    printf("=== Method Send Test ===\n");
+
+    static ezom_lexer_t lexer;
+    static ezom_parser_t parser;
+    ezom_lexer_init(&lexer, "Tally = Object ( | n | reset = ( n := 0 ) add: k = ( n := n + k ) total = ( ^n ) clamp: k = ( k > n ifTrue: [^n]. ^k ) )");
+    ezom_parser_init(&parser, &lexer);
+    ezom_ast_node_t* class_ast = ezom_parse_class_definition(&parser);
+    assert(class_ast != NULL);
+
+    uint24_t tally_class = ezom_evaluate_class_definition(class_ast, 0).value;
+    uint24_t add_selector = ezom_create_symbol("add:", 4);
+    ezom_method_lookup_t lookup = ezom_lookup_method(tally_class, add_selector);
+    assert(lookup.method != NULL);
+    ezom_method_code_t* add_code = (ezom_method_code_t*)EZOM_OBJECT_PTR(lookup.method->code);
+    assert(add_code->bytecode != NULL);
+
+    uint24_t tally = ezom_create_instance(tally_class);
+    assert(ezom_send_unary_message(tally, ezom_create_symbol("reset", 5)) == tally);
+    ezom_send_binary_message(tally, add_selector, ezom_create_integer(5));
+    assert(ezom_send_binary_message(tally, add_selector, ezom_create_integer(7)) == tally);
+    assert(ezom_send_unary_message(tally, ezom_create_symbol("total", 5)) == ezom_create_integer(12));
+
+    // ^ inside an inlined ifTrue: returns from the method
+    uint24_t clamp_selector = ezom_create_symbol("clamp:", 6);
+    assert(ezom_send_binary_message(tally, clamp_selector, ezom_create_integer(20)) == ezom_create_integer(12));
+    assert(ezom_send_binary_message(tally, clamp_selector, ezom_create_integer(3)) == ezom_create_integer(3));
+
+    printf("✓ Tally reset; add: 5; add: 7; total = 12; clamp: 20 = 12\n");
+}
+
+int main() {
+    printf("=== Bytecode Engine Tests ===\n");
+
+    ezom_init_memory();
+    ezom_init_object_system();
+    ezom_init_primitives();
+    ezom_bootstrap_enhanced_classes();
+
+    test_block_compilation();
+    test_engine_parity();
+    test_inlined_control_flow();
+    test_fallback();
+    test_method_send();
+
+    ezom_bytecode_print_stats();
+    printf("\n=== All Bytecode Engine Tests Passed! ===\n");
+    return 0;
+}
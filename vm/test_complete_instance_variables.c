@@ -83,17 +83,11 @@ void test_complete_instance_variable_system() {
                     
                     // Verify values
                     if (value1 != 0) {
-                        ezom_integer_t* int_obj = EZOM_OBJECT_PTR(value1);
-                        if (int_obj) {
-                            printf("  'value' = %d\n", int_obj->value);
-                        }
+                        printf("  'value' = %d\n", (int)EZOM_SMALLINT_VALUE(value1));
                     }
                     
                     if (value2 != 0) {
-                        ezom_integer_t* int_obj = EZOM_OBJECT_PTR(value2);
-                        if (int_obj) {
-                            printf("  'counter_id' = %d\n", int_obj->value);
-                        }
+                        printf("  'counter_id' = %d\n", (int)EZOM_SMALLINT_VALUE(value2));
                     }
                     
                     // Test 4: Test instance variable count
@@ -113,7 +107,7 @@ void test_complete_instance_variable_system() {
                 printf("✗ Failed to access class object\n");
             }
         } else {
-            printf("✗ Class evaluation failed: %s\n", class_result.error_msg);
+            printf("✗ Class evaluation failed: %s\n", g_eval_error.message);
         }
     } else {
         printf("✗ Class parsing failed\n");
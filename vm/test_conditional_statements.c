@@ -22,10 +22,7 @@ ezom_eval_result_t parse_and_evaluate(const char* code) {
     
     ezom_ast_node_t* ast = ezom_parse_expression(&parser);
     if (!ast) {
-        ezom_eval_result_t error_result = {0};
-        error_result.is_error = true;
-        strcpy(error_result.error_msg, "Parse failed");
-        return error_result;
+        return ezom_make_error_result("Parse failed");
     }
     
     return ezom_evaluate_ast(ast, 0);
@@ -51,15 +48,13 @@ int main() {
     ezom_eval_result_t result1 = parse_and_evaluate(code1);
     
     if (result1.is_error) {
-        printf("✗ Error: %s\n", result1.error_msg);
+        printf("✗ Error: %s\n", g_eval_error.message);
     } else {
         printf("✓ Evaluation result: 0x%06X\n", result1.value);
         
         // Check if result is integer 42
         if (result1.value && ezom_is_integer(result1.value)) {
-            ezom_object_t* obj = EZOM_OBJECT_PTR(result1.value);
-            ezom_integer_t* int_obj = (ezom_integer_t*)obj;
-            printf("✓ Result is integer: %d\n", int_obj->value);
+            printf("✓ Result is integer: %d\n", (int)EZOM_SMALLINT_VALUE(result1.value));
         } else {
             printf("✗ Result is not integer: 0x%06X\n", result1.value);
         }
@@ -73,7 +68,7 @@ int main() {
     ezom_eval_result_t result2 = parse_and_evaluate(code2);
     
     if (result2.is_error) {
-        printf("✗ Error: %s\n", result2.error_msg);
+        printf("✗ Error: %s\n", g_eval_error.message);
     } else {
         printf("✓ Evaluation result: 0x%06X\n", result2.value);
         
@@ -93,7 +88,7 @@ int main() {
     ezom_eval_result_t result3 = parse_and_evaluate(code3);
     
     if (result3.is_error) {
-        printf("✗ Error: %s\n", result3.error_msg);
+        printf("✗ Error: %s\n", g_eval_error.message);
     } else {
         printf("✓ Evaluation result: 0x%06X\n", result3.value);
         
@@ -113,15 +108,13 @@ int main() {
     ezom_eval_result_t result4 = parse_and_evaluate(code4);
     
     if (result4.is_error) {
-        printf("✗ Error: %s\n", result4.error_msg);
+        printf("✗ Error: %s\n", g_eval_error.message);
     } else {
         printf("✓ Evaluation result: 0x%06X\n", result4.value);
         
         // Check if result is integer 42
         if (result4.value && ezom_is_integer(result4.value)) {
-            ezom_object_t* obj = EZOM_OBJECT_PTR(result4.value);
-            ezom_integer_t* int_obj = (ezom_integer_t*)obj;
-            printf("✓ Result is integer: %d\n", int_obj->value);
+            printf("✓ Result is integer: %d\n", (int)EZOM_SMALLINT_VALUE(result4.value));
         } else {
             printf("✗ Result is not integer: 0x%06X\n", result4.value);
         }
@@ -135,15 +128,13 @@ int main() {
     ezom_eval_result_t result5 = parse_and_evaluate(code5);
     
     if (result5.is_error) {
-        printf("✗ Error: %s\n", result5.error_msg);
+        printf("✗ Error: %s\n", g_eval_error.message);
     } else {
         printf("✓ Evaluation result: 0x%06X\n", result5.value);
         
         // Check if result is integer 100
         if (result5.value && ezom_is_integer(result5.value)) {
-            ezom_object_t* obj = EZOM_OBJECT_PTR(result5.value);
-            ezom_integer_t* int_obj = (ezom_integer_t*)obj;
-            printf("✓ Result is integer: %d (should be 100)\n", int_obj->value);
+            printf("✓ Result is integer: %d (should be 100)\n", (int)EZOM_SMALLINT_VALUE(result5.value));
         } else {
             printf("✗ Result is not integer: 0x%06X\n", result5.value);
         }
@@ -157,15 +148,13 @@ int main() {
     ezom_eval_result_t result6 = parse_and_evaluate(code6);
     
     if (result6.is_error) {
-        printf("✗ Error: %s\n", result6.error_msg);
+        printf("✗ Error: %s\n", g_eval_error.message);
     } else {
         printf("✓ Evaluation result: 0x%06X\n", result6.value);
         
         // Check if result is integer 200
         if (result6.value && ezom_is_integer(result6.value)) {
-            ezom_object_t* obj = EZOM_OBJECT_PTR(result6.value);
-            ezom_integer_t* int_obj = (ezom_integer_t*)obj;
-            printf("✓ Result is integer: %d (should be 200)\n", int_obj->value);
+            printf("✓ Result is integer: %d (should be 200)\n", (int)EZOM_SMALLINT_VALUE(result6.value));
         } else {
             printf("✗ Result is not integer: 0x%06X\n", result6.value);
         }
@@ -179,7 +168,7 @@ int main() {
     ezom_eval_result_t result7 = parse_and_evaluate(code7);
     
     if (result7.is_error) {
-        printf("✗ Error: %s\n", result7.error_msg);
+        printf("✗ Error: %s\n", g_eval_error.message);
     } else {
         printf("✓ Evaluation result: 0x%06X\n", result7.value);
         
@@ -199,7 +188,7 @@ int main() {
     ezom_eval_result_t result8 = parse_and_evaluate(code8);
     
     if (result8.is_error) {
-        printf("✗ Error: %s\n", result8.error_msg);
+        printf("✗ Error: %s\n", g_eval_error.message);
     } else {
         printf("✓ Evaluation result: 0x%06X\n", result8.value);
         
@@ -0,0 +1,72 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "include/ezom_object.h"
+#include "include/ezom_memory.h"
+#include "include/ezom_primitives.h"
+#include "include/ezom_dispatch.h"
+#include "include/ezom_evaluator.h"
+
+static const char* test_selectors[] = {
+    "println", "+", "-", "<", "=", "isNil", "notNil", "class", "hash",
+    "value", "at:", "at:put:", "length", "ifTrue:", "noSuchSelector"
+};
+
+// Table dispatch must agree with the superclass walk for every class
+void test_table_matches_walk() {
+    printf("=== Dispatch Table Agreement Test ===\n");
+
+    uint24_t classes[] = {
+        g_object_class, g_integer_class, g_string_class, g_array_class,
+        g_true_class, g_false_class, g_block_class, g_nil_class
+    };
+    uint16_t checked = 0;
+
+    for (size_t c = 0; c < sizeof(classes) / sizeof(classes[0]); c++) {
+        for (size_t s = 0; s < sizeof(test_selectors) / sizeof(test_selectors[0]); s++) {
+            uint24_t selector = ezom_create_symbol(test_selectors[s], strlen(test_selectors[s]));
+            ezom_method_lookup_t walked = ezom_lookup_method_uncached(classes[c], selector);
+            ezom_method_lookup_t table = ezom_dispatch_table_lookup(classes[c], selector);
+            assert(walked.method == table.method);
+            assert(walked.is_primitive == table.is_primitive);
+            checked++;
+        }
+    }
+
+    printf("✓ %d class/selector pairs agree\n", checked);
+}
+
+// Installing a method marks the tables stale; subclasses see it next lookup
+void test_table_rebuild_on_install() {
+    printf("=== Dispatch Table Rebuild Test ===\n");
+
+    uint24_t selector = ezom_create_symbol("tableProbe", 10);
+    assert(ezom_dispatch_table_lookup(g_integer_class, selector).method == NULL);
+
+    uint32_t rebuilds = g_dispatch_table_stats.rebuilds;
+    ezom_install_method_in_class(g_object_class, "tableProbe", 1, 0, true);
+
+    ezom_method_lookup_t lookup = ezom_dispatch_table_lookup(g_integer_class, selector);
+    assert(lookup.method != NULL);
+    assert(lookup.method->selector == selector);
+    assert(g_dispatch_table_stats.rebuilds == rebuilds + 1);
+
+    printf("✓ Inherited method visible after rebuild\n");
+}
+
+int main() {
+    printf("=== Dispatch Table Tests ===\n");
+
+    ezom_init_memory();
+    ezom_init_object_system();
+    ezom_init_primitives();
+    ezom_bootstrap_enhanced_classes();
+    ezom_set_dispatch_mode(EZOM_DISPATCH_TABLE);
+
+    test_table_matches_walk();
+    test_table_rebuild_on_install();
+
+    printf("\n=== All Dispatch Table Tests Passed! ===\n");
+    return 0;
+}
@@ -0,0 +1,140 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "include/ezom_object.h"
+#include "include/ezom_memory.h"
+#include "include/ezom_primitives.h"
+#include "include/ezom_dispatch.h"
+
+// Double arithmetic, comparison, and mixed Integer/Double operands
+void test_arithmetic() {
+    printf("=== Double Arithmetic Test ===\n");
+
+    uint24_t plus = ezom_create_symbol("+", 1);
+    uint24_t times = ezom_create_symbol("*", 1);
+    uint24_t divide = ezom_create_symbol("/", 1);
+    uint24_t less = ezom_create_symbol("<", 1);
+    uint24_t sqrt_sel = ezom_create_symbol("sqrt", 4);
+
+    uint24_t half = ezom_create_double(0.5);
+    assert(ezom_is_double(half));
+    assert(ezom_class_of(half) == g_double_class);
+
+    uint24_t sum = ezom_send_binary_message(half, plus, ezom_create_integer(2));
+    assert(ezom_double_value(sum) == 2.5);
+
+    // Integer receiver with a Double argument answers a Double
+    uint24_t product = ezom_send_binary_message(ezom_create_integer(3), times, half);
+    assert(ezom_is_double(product));
+    assert(ezom_double_value(product) == 1.5);
+
+    uint24_t quotient = ezom_send_binary_message(ezom_create_integer(1), divide, ezom_create_double(4.0));
+    assert(ezom_double_value(quotient) == 0.25);
+
+    assert(ezom_send_binary_message(half, less, ezom_create_integer(1)) == g_true);
+    assert(ezom_send_binary_message(ezom_create_integer(1), less, half) == g_false);
+
+    uint24_t root = ezom_send_unary_message(ezom_create_double(2.0), sqrt_sel);
+    assert(ezom_double_value(root) * ezom_double_value(root) - 2.0 < 1e-15);
+
+    char buffer[32];
+    ezom_format_double(buffer, 0.1);
+    assert(strcmp(buffer, "0.1") == 0);
+    ezom_format_double(buffer, 3.0);
+    assert(strcmp(buffer, "3.0") == 0);
+
+    printf("✓ Mixed arithmetic and printing\n");
+}
+
+// A z := z * z + c loop keeps its intermediates in the scratch space
+void test_scratch_space() {
+    printf("=== Double Scratch Space Test ===\n");
+
+    uint24_t plus = ezom_create_symbol("+", 1);
+    uint24_t times = ezom_create_symbol("*", 1);
+    uint24_t c = ezom_create_double(0.25);
+    double z = 0.0;
+
+    uint16_t bytes_before = g_heap.bytes_allocated;
+    uint16_t spills_before = g_double_scratch.spills;
+    for (int i = 0; i < 1000; i++) {
+        uint16_t mark = ezom_double_scratch_mark();
+        uint24_t boxed = ezom_scratch_double(z);
+        uint24_t next = ezom_send_binary_message(ezom_send_binary_message(boxed, times, boxed), plus, c);
+        assert(EZOM_IS_SCRATCH_DOUBLE(next));
+        z = ezom_double_value(next);
+        ezom_double_scratch_release(mark);
+    }
+
+    printf("  Heap bytes before: %d, after: %d\n", bytes_before, g_heap.bytes_allocated);
+    assert(g_heap.bytes_allocated == bytes_before);
+    assert(g_double_scratch.spills == spills_before);
+    assert(z > 0.49 && z < 0.5);
+
+    // Storing a scratch value copies it to the heap
+    uint24_t scratch = ezom_scratch_double(z);
+    uint24_t stored = ezom_promote_double(scratch);
+    assert(stored != scratch);
+    assert(!EZOM_IS_SCRATCH_DOUBLE(stored));
+    assert(ezom_double_value(stored) == z);
+    assert(ezom_promote_double(stored) == stored);
+
+    printf("✓ 1000 iterations allocated nothing\n");
+}
+
+// A Double variable updated in a loop overwrites its own heap Double
+void test_slot_doubles() {
+    printf("=== Double Variable Slot Test ===\n");
+
+    uint24_t half = ezom_create_double(0.5);
+    uint24_t slot = g_nil;
+
+    // The first store copies; the slot then owns that copy
+    slot = ezom_store_slot_double(slot, ezom_scratch_double(1.0));
+    uint24_t owned = slot;
+    assert(owned != half && !EZOM_IS_SCRATCH_DOUBLE(owned));
+
+    uint16_t bytes_before = g_heap.bytes_allocated;
+    for (int i = 0; i < 1000; i++) {
+        uint16_t mark = ezom_double_scratch_mark();
+        uint24_t value = ezom_load_slot_double(slot);
+        assert(EZOM_IS_SCRATCH_DOUBLE(value));
+        slot = ezom_store_slot_double(slot, ezom_scratch_double(ezom_double_value(value) + 1.0));
+        ezom_double_scratch_release(mark);
+    }
+    assert(slot == owned);
+    assert(ezom_double_value(slot) == 1001.0);
+    assert(g_heap.bytes_allocated == bytes_before);
+
+    // Anywhere else gets its own copy, unchanged by later stores to the slot
+    uint24_t field = ezom_promote_double(slot);
+    assert(field != slot);
+    slot = ezom_store_slot_double(slot, half);
+    assert(slot == owned && ezom_double_value(slot) == 0.5);
+    assert(ezom_double_value(field) == 1001.0);
+
+    // A heap Double owned by something else is copied, not overwritten
+    uint24_t other = ezom_store_slot_double(g_nil, field);
+    assert(other != field);
+    other = ezom_store_slot_double(other, half);
+    assert(ezom_double_value(field) == 1001.0);
+
+    printf("✓ 1000 stores to one variable allocated nothing\n");
+}
+
+int main() {
+    printf("=== Double Tests ===\n");
+
+    ezom_init_memory();
+    ezom_init_object_system();
+    ezom_init_primitives();
+    ezom_bootstrap_enhanced_classes();
+
+    test_arithmetic();
+    test_scratch_space();
+    test_slot_doubles();
+
+    printf("\n=== All Double Tests Passed! ===\n");
+    return 0;
+}
@@ -91,12 +91,12 @@ void test_evaluator_instance_variables() {
                         
                         // Verify the values
                         if (x_value != 0 && y_value != 0) {
-                            ezom_integer_t* x_int = EZOM_OBJECT_PTR(x_value);
-                            ezom_integer_t* y_int = EZOM_OBJECT_PTR(y_value);
-                            printf("  'x' value: %d\n", x_int->value);
-                            printf("  'y' value: %d\n", y_int->value);
+                            int32_t x_int = EZOM_SMALLINT_VALUE(x_value);
+                            int32_t y_int = EZOM_SMALLINT_VALUE(y_value);
+                            printf("  'x' value: %d\n", (int)x_int);
+                            printf("  'y' value: %d\n", (int)y_int);
                             
-                            if (x_int->value == 42 && y_int->value == 99) {
+                            if (x_int == 42 && y_int == 99) {
                                 printf("✓ Instance variables working correctly\n");
                             } else {
                                 printf("✗ Instance variable values incorrect\n");
@@ -0,0 +1,72 @@
+#include "test_support.h"
+#include "include/ezom_exceptions.h"
+
+static uint24_t g_try_class;
+
+static bool is_string(uint24_t value, const char* text) {
+    if (!ezom_is_string(value)) return false;
+    ezom_string_t* string = (ezom_string_t*)EZOM_OBJECT_PTR(value);
+    return string->length == strlen(text) && memcmp(string->data, text, string->length) == 0;
+}
+
+// on:do: answers the handler block's value
+void test_handled(void) {
+    printf("=== Handled Signal Test ===\n");
+
+    uint24_t try = ezom_create_instance(g_try_class);
+    assert(is_string(send0(try, "divide"), "Division by zero"));
+    assert(is_string(send0(try, "boom"), "boom"));
+    assert(!g_frame_stack.raising);
+
+    printf("✓ 10 / 0 and Error signal: 'boom' reach their handlers\n");
+}
+
+// Cleanup blocks run on the way out
+void test_cleanup(void) {
+    printf("=== Cleanup Test ===\n");
+
+    uint24_t try = ezom_create_instance(g_try_class);
+    assert(send0(try, "ensure") == ezom_create_integer(1));
+    assert(send0(try, "log") == ezom_create_integer(5));
+    assert(send0(try, "curtailed") == ezom_create_integer(2));
+    assert(send0(try, "log") == ezom_create_integer(7));
+
+    printf("✓ ensure: ran under a ^, ifCurtailed: under a signal\n");
+}
+
+// Nothing handles it: signal answers nil and nothing unwinds
+void test_unhandled(void) {
+    printf("=== Unhandled Signal Test ===\n");
+
+    uint24_t try = ezom_create_instance(g_try_class);
+    assert(send0(try, "loose") == ezom_create_integer(3));
+    assert(!g_frame_stack.raising);
+
+    printf("✓ Error signal: 'loose' went on\n");
+}
+
+static void engine_tests(void) {
+    test_handled();
+    test_cleanup();
+    test_unhandled();
+}
+
+int main() {
+    printf("=== Exception Tests ===\n");
+
+    test_init_vm();
+
+    g_try_class = define_class(
+        "Try = Object ( | log | "
+        "divide = ( ^[10 / 0] on: Error do: [:e | e messageText] ) "
+        "boom = ( ^[Error signal: 'boom'. 1] on: Error do: [:e | e messageText] ) "
+        "ensure = ( [^1] ensure: [log := 5]. ^0 ) "
+        "curtailed = ( ^[[Error signal. 1] ifCurtailed: [log := 7]] on: Exception do: [:e | 2] ) "
+        "loose = ( Error signal: 'loose'. ^3 ) "
+        "log = ( ^log ) )");
+
+    run_on_each_engine(engine_tests);
+
+    printf("\n=== All Exception Tests Passed! ===\n");
+    return 0;
+}
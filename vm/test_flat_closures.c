@@ -0,0 +1,63 @@
+#include "test_support.h"
+
+static uint24_t g_closures_class;
+
+// A closure copies what it reads and keeps no frame
+void test_copied_captures(void) {
+    printf("=== Copied Capture Test ===\n");
+
+    uint24_t closures = ezom_create_instance(g_closures_class);
+    uint32_t promoted = g_frame_stack.promoted;
+
+    // [[k + base]]: the inner block copies k and self from the outer one
+    uint24_t outer = send1(closures, "nested:", ezom_create_integer(5));
+    ezom_block_t* block = (ezom_block_t*)EZOM_OBJECT_PTR(outer);
+    assert(block->outer_context == 0 && block->capture_count == 2);
+
+    send1(closures, "nested:", ezom_create_integer(9));
+    uint24_t inner = ezom_block_evaluate(outer, NULL, 0);
+    assert(((ezom_block_t*)EZOM_OBJECT_PTR(inner))->outer_context == 0);
+    assert(ezom_block_evaluate(inner, NULL, 0) == ezom_create_integer(105));
+    assert(g_frame_stack.promoted == promoted);
+
+    printf("✓ [[k + base]] made with k = 5 answers 105\n");
+}
+
+// Closures over an assigned variable share its box
+void test_boxed_variables(void) {
+    printf("=== Boxed Variable Test ===\n");
+
+    uint24_t closures = ezom_create_instance(g_closures_class);
+    assert(send0(closures, "shared") == ezom_create_integer(3));
+
+    uint24_t counter = send0(closures, "counter");
+    uint24_t other = send0(closures, "counter");
+    assert(ezom_block_evaluate(counter, NULL, 0) == ezom_create_integer(1));
+    assert(ezom_block_evaluate(counter, NULL, 0) == ezom_create_integer(2));
+    assert(ezom_block_evaluate(other, NULL, 0) == ezom_create_integer(1));
+
+    printf("✓ Two closures share n; each counter has its own\n");
+}
+
+static void engine_tests(void) {
+    test_copied_captures();
+    test_boxed_variables();
+}
+
+int main() {
+    printf("=== Flat Closure Tests ===\n");
+
+    test_init_vm();
+
+    g_closures_class = define_class(
+        "Closures = Object ( | base | "
+        "nested: k = ( base := 100. ^[[k + base]] ) "
+        "counter = ( | n | n := 0. ^[n := n + 1] ) "
+        "shared = ( | n bump | n := 0. bump := [n := n + 1]. "
+        "bump value. 1 to: 2 do: [:i | bump value]. ^[n] value ) )");
+
+    run_on_each_engine(engine_tests);
+
+    printf("\n=== All Flat Closure Tests Passed! ===\n");
+    return 0;
+}
@@ -0,0 +1,124 @@
+#include "test_support.h"
+
+static uint24_t g_frames_class;
+
+// Recursion runs entirely on the frame stack
+void test_recursion(void) {
+    printf("=== Recursion Test ===\n");
+
+    uint24_t frames = ezom_create_instance(g_frames_class);
+    uint32_t pushed = g_frame_stack.frames;
+    uint32_t promoted = g_frame_stack.promoted;
+    uint16_t allocations = g_heap.total_allocations;
+
+    assert(send1(frames, "fib:", ezom_create_integer(15)) == ezom_create_integer(610));
+    assert(g_heap.total_allocations == allocations);
+    assert(g_frame_stack.frames - pushed > 1000);
+    assert(g_frame_stack.promoted == promoted);
+    assert(g_frame_stack.depth == 0 && g_frame_stack.top == g_frame_stack.base);
+
+    printf("✓ fib: 15 = 610 with no heap contexts\n");
+}
+
+// A closure that is only passed down never moves its frame
+void test_downward_closure(void) {
+    printf("=== Downward Closure Test ===\n");
+
+    uint24_t frames = ezom_create_instance(g_frames_class);
+    uint32_t promoted = g_frame_stack.promoted;
+
+    assert(send1(frames, "scale:", ezom_create_integer(4)) == ezom_create_integer(12));
+    assert(g_frame_stack.promoted == promoted);
+
+    printf("✓ [:x | x * k] passed down, frame not promoted\n");
+}
+
+// Answered or stored closures copy what they capture and leave their
+// frame behind
+void test_escaping_closures(void) {
+    printf("=== Escaping Closure Test ===\n");
+
+    uint24_t frames = ezom_create_instance(g_frames_class);
+    uint32_t promoted = g_frame_stack.promoted;
+
+    uint24_t adder = send1(frames, "adder:", ezom_create_integer(10));
+    assert(ezom_is_block_object(adder));
+    ezom_block_t* block = (ezom_block_t*)EZOM_OBJECT_PTR(adder);
+    assert(block->outer_context == 0);
+    assert(block->capture_count == 1 && block->captured_vars[0] == ezom_create_integer(10));
+
+    send1(frames, "keep:", ezom_create_integer(7));
+    assert(g_frame_stack.promoted == promoted);
+
+    // Reuse the stack before calling back into the closures
+    send1(frames, "fib:", ezom_create_integer(8));
+    uint24_t arg = ezom_create_integer(5);
+    assert(ezom_block_evaluate(adder, &arg, 1) == ezom_create_integer(15));
+    assert(send0(frames, "kept") == ezom_create_integer(7));
+    assert(g_frame_stack.capture_count == 0);
+
+    printf("✓ adder: 10 value: 5 = 15, kept closure answers 7\n");
+}
+
+// Recursion far deeper than the C stack allows runs in place
+void test_deep_recursion(void) {
+    printf("=== Deep Recursion Test ===\n");
+
+    uint24_t frames = ezom_create_instance(g_frames_class);
+    assert(send1(frames, "down:", ezom_create_integer(100000)) == ezom_create_integer(100000));
+    assert(g_frame_stack.peak_depth > 100000);
+    assert(g_frame_stack.depth == 0 && g_frame_stack.top == g_frame_stack.base);
+
+    printf("✓ down: 100000 = 100000\n");
+}
+
+// Going past --max-depth unwinds every activation with an error
+void test_overflow(void) {
+    printf("=== Stack Overflow Test ===\n");
+
+    uint24_t frames = ezom_create_instance(g_frames_class);
+    uint32_t overflows = g_frame_stack.overflows;
+    ezom_set_max_depth(500);
+
+    assert(send1(frames, "down:", ezom_create_integer(1000)) == 0);
+    assert(g_frame_stack.overflows == overflows + 1);
+    assert(strcmp(g_eval_error.message, "Stack overflow") == 0);
+    assert(g_frame_stack.depth == 0 && g_frame_stack.top == g_frame_stack.base);
+    assert(g_frame_stack.native_depth == 0);
+
+    ezom_set_max_depth(0);
+    assert(send1(frames, "fib:", ezom_create_integer(10)) == ezom_create_integer(55));
+
+    printf("✓ down: 1000 stopped at 500 frames, VM still usable\n");
+}
+
+static void engine_tests(void) {
+    test_recursion();
+    test_downward_closure();
+    test_escaping_closures();
+    test_overflow();
+}
+
+int main() {
+    printf("=== Frame Stack Tests ===\n");
+
+    test_init_vm();
+
+    g_frames_class = define_class(
+        "Frames = Object ( | saved | "
+        "fib: n = ( n < 2 ifTrue: [^n]. ^(self fib: n - 1) + (self fib: n - 2) ) "
+        "apply: aBlock = ( ^aBlock value: 3 ) "
+        "scale: k = ( ^self apply: [:x | x * k] ) "
+        "adder: k = ( ^[:x | x + k] ) "
+        "keep: k = ( saved := [k] ) "
+        "kept = ( ^saved value ) "
+        "down: n = ( n = 0 ifTrue: [^0]. ^(self down: n - 1) + 1 ) )");
+
+    run_on_each_engine(engine_tests);
+    ezom_set_engine(EZOM_ENGINE_BYTECODE);
+    test_deep_recursion();
+
+    ezom_frame_print_stats();
+    printf("\n=== All Frame Stack Tests Passed! ===\n");
+    return 0;
+}
@@ -0,0 +1,157 @@
+#include "test_support.h"
+
+// One send through a call site, the way a message send node makes it
+static uint24_t site_send(ezom_inline_cache_t* ic, const char* name, uint24_t receiver) {
+    ezom_message_t msg = {
+        .selector = ezom_inline_cache_selector(ic, name),
+        .receiver = receiver,
+        .args = NULL,
+        .arg_count = 0
+    };
+    return ezom_send_message_cached(ic, &msg);
+}
+
+// A site starts monomorphic and keeps one entry per receiver class
+void test_polymorphic_site(void) {
+    printf("=== Monomorphic to Polymorphic Test ===\n");
+
+    ezom_inline_cache_t ic;
+    memset(&ic, 0, sizeof(ic));
+    ezom_inline_cache_stats_t before = g_inline_cache_stats;
+
+    assert(site_send(&ic, "isNil", ezom_create_integer(3)) == g_false);
+    assert(ic.count == 1 && ic.entries[0].method != NULL);
+    ezom_method_t* is_nil = ic.entries[0].method;
+    assert(site_send(&ic, "isNil", ezom_create_integer(4)) == g_false);
+    assert(g_inline_cache_stats.misses == before.misses + 1);
+    assert(g_inline_cache_stats.hits == before.hits + 1);
+    assert(g_inline_cache_stats.polymorphic_sites == before.polymorphic_sites);
+
+    assert(site_send(&ic, "isNil", ezom_create_string("s", 1)) == g_false);
+    assert(ic.count == 2 && !ic.megamorphic);
+    assert(ic.entries[0].method == is_nil && ic.entries[1].method == is_nil);
+    assert(g_inline_cache_stats.polymorphic_sites == before.polymorphic_sites + 1);
+
+    // Both classes now hit
+    site_send(&ic, "isNil", ezom_create_integer(5));
+    site_send(&ic, "isNil", ezom_create_string("t", 1));
+    assert(g_inline_cache_stats.hits == before.hits + 3);
+    assert(g_inline_cache_stats.misses == before.misses + 2);
+
+    printf("✓ Integer then String: 2 entries, one polymorphic site\n");
+}
+
+// Past EZOM_INLINE_CACHE_SIZE classes the site stops filling and sends
+// through the shared lookup cache
+void test_megamorphic_site(void) {
+    printf("=== Megamorphic Fallback Test ===\n");
+
+    uint24_t receivers[] = {
+        ezom_create_integer(1), ezom_create_string("s", 1), g_true, g_false,
+        g_nil, ezom_create_array(2)
+    };
+    assert(sizeof(receivers) / sizeof(receivers[0]) > EZOM_INLINE_CACHE_SIZE + 1);
+
+    ezom_inline_cache_t ic;
+    memset(&ic, 0, sizeof(ic));
+    ezom_inline_cache_stats_t before = g_inline_cache_stats;
+
+    for (int i = 0; i < EZOM_INLINE_CACHE_SIZE; i++) {
+        assert(site_send(&ic, "isNil", receivers[i]) != 0);
+    }
+    assert(ic.count == EZOM_INLINE_CACHE_SIZE && !ic.megamorphic);
+
+    assert(site_send(&ic, "isNil", receivers[EZOM_INLINE_CACHE_SIZE]) == g_true);
+    assert(ic.megamorphic && ic.count == EZOM_INLINE_CACHE_SIZE);
+    assert(g_inline_cache_stats.megamorphic_sites == before.megamorphic_sites + 1);
+    assert(g_inline_cache_stats.megamorphic_sends == before.megamorphic_sends);
+
+    // New classes take the shared path; the cached ones still hit
+    uint32_t hits = g_inline_cache_stats.hits;
+    assert(site_send(&ic, "isNil", receivers[EZOM_INLINE_CACHE_SIZE]) == g_true);
+    assert(site_send(&ic, "isNil", receivers[EZOM_INLINE_CACHE_SIZE + 1]) == g_false);
+    assert(g_inline_cache_stats.megamorphic_sends == before.megamorphic_sends + 2);
+    assert(site_send(&ic, "isNil", receivers[0]) == g_false);
+    assert(g_inline_cache_stats.hits == hits + 1);
+    assert(g_inline_cache_stats.megamorphic_sites == before.megamorphic_sites + 1);
+
+    printf("✓ %d classes filled the site, later misses counted as megamorphic sends\n",
+           EZOM_INLINE_CACHE_SIZE);
+}
+
+// A method installed after a site warmed up replaces the cached one
+void test_install_invalidates_site(void) {
+    printf("=== Inline Cache Invalidation Test ===\n");
+
+    uint24_t probe_class = ezom_create_class_with_inheritance("SiteProbe", g_object_class, 0);
+    uint24_t probe = ezom_create_instance(probe_class);
+    ezom_install_method_in_class(g_object_class, "siteProbe", PRIM_OBJECT_CLASS, 0, true);
+
+    ezom_inline_cache_t ic;
+    memset(&ic, 0, sizeof(ic));
+    assert(site_send(&ic, "siteProbe", probe) == probe_class);
+    ezom_method_t* inherited = ic.entries[0].method;
+    assert(site_send(&ic, "siteProbe", probe) == probe_class);
+
+    // SiteProbe now overrides Object's method
+    ezom_install_method_in_class(probe_class, "siteProbe", PRIM_OBJECT_IS_NIL, 0, true);
+
+    assert(site_send(&ic, "siteProbe", probe) == g_false);
+    assert(ic.count == 1 && ic.entries[0].method != inherited);
+    uint32_t hits = g_inline_cache_stats.hits;
+    assert(site_send(&ic, "siteProbe", probe) == g_false);
+    assert(g_inline_cache_stats.hits == hits + 1);
+
+    printf("✓ Warm site picked up SiteProbe>>siteProbe after install\n");
+}
+
+// An install restamps the defining class and its subclasses; sites warmed
+// on other classes keep hitting
+void test_install_restamps_subclasses(void) {
+    printf("=== Class Dispatch Version Test ===\n");
+
+    uint24_t parent = ezom_create_class_with_inheritance("StampParent", g_object_class, 0);
+    uint24_t child = ezom_create_class_with_inheritance("StampChild", parent, 0);
+    uint24_t sibling = ezom_create_class_with_inheritance("StampSibling", g_object_class, 0);
+    assert(ezom_class_version(parent) != ezom_class_version(child));
+
+    ezom_inline_cache_t ic;
+    memset(&ic, 0, sizeof(ic));
+    site_send(&ic, "isNil", ezom_create_integer(1));
+    site_send(&ic, "isNil", ezom_create_instance(sibling));
+
+    uint32_t object_version = ezom_class_version(g_object_class);
+    uint32_t integer_version = ezom_class_version(g_integer_class);
+    uint32_t sibling_version = ezom_class_version(sibling);
+    uint32_t child_version = ezom_class_version(child);
+    ezom_install_method_in_class(parent, "stampProbe", PRIM_OBJECT_IS_NIL, 0, true);
+
+    assert(ezom_class_version(child) != child_version);
+    assert(ezom_class_version(g_object_class) == object_version);
+    assert(ezom_class_version(g_integer_class) == integer_version);
+    assert(ezom_class_version(sibling) == sibling_version);
+
+    uint32_t hits = g_inline_cache_stats.hits;
+    uint32_t stale = g_inline_cache_stats.stale;
+    site_send(&ic, "isNil", ezom_create_integer(2));
+    site_send(&ic, "isNil", ezom_create_instance(sibling));
+    assert(g_inline_cache_stats.hits == hits + 2);
+    assert(g_inline_cache_stats.stale == stale);
+
+    printf("✓ StampParent>>stampProbe restamped StampChild only; Integer and sibling sites still hit\n");
+}
+
+int main() {
+    printf("=== Inline Cache Tests ===\n");
+
+    test_init_vm();
+
+    test_polymorphic_site();
+    test_megamorphic_site();
+    test_install_invalidates_site();
+    test_install_restamps_subclasses();
+
+    ezom_inline_cache_print_stats();
+    printf("\n=== All Inline Cache Tests Passed! ===\n");
+    return 0;
+}
@@ -0,0 +1,111 @@
+#include <time.h>
+#include "test_support.h"
+#ifdef EZOM_JIT
+#include "include/ezom_jit.h"
+
+static uint24_t g_bench_class;
+
+// Interpreted, then as machine code: same answer; prints both times
+static uint24_t compare(const char* name, int32_t n) {
+    uint24_t bench = ezom_create_instance(g_bench_class);
+    uint24_t arg = ezom_create_integer(n);
+
+    ezom_jit_configure(false, 0);
+    clock_t start = clock();
+    uint24_t interpreted = ezom_send1(bench, selector(name), arg);
+    double interpreted_time = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    ezom_jit_configure(true, 1);
+    ezom_send1(bench, selector(name), ezom_create_integer(1));     // Warm up
+    start = clock();
+    uint24_t compiled = ezom_send1(bench, selector(name), arg);
+    double compiled_time = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    assert(compiled == interpreted);
+    printf("✓ %s %d: interpreted %.3fs, JIT %.3fs\n", name, n, interpreted_time, compiled_time);
+    return compiled;
+}
+
+// Fibonacci and loop benchmarks answer what the interpreter answers
+void test_benchmarks(void) {
+    printf("=== JIT Benchmark Test ===\n");
+
+    assert(compare("fib:", 16) == ezom_create_integer(987));
+    assert(compare("loop:", 2000) == ezom_create_integer(2000));
+    assert(g_jit_stats.compiled >= 2 && g_jit_stats.runs > 0);
+}
+
+// Overflow, Doubles, closures and ^ out of a block leave the machine code
+void test_slow_paths(void) {
+    printf("=== JIT Slow Path Test ===\n");
+
+    ezom_jit_configure(true, 1);
+    uint24_t bench = ezom_create_instance(g_bench_class);
+
+    uint24_t big = ezom_send2(bench, selector("add:to:"), ezom_create_integer(EZOM_SMALLINT_MAX),
+                              ezom_create_integer(1));
+    assert(!EZOM_IS_SMALLINT(big));
+    uint24_t sum = ezom_send2(bench, selector("add:to:"), ezom_create_double(1.5), ezom_create_integer(2));
+    assert(ezom_is_double(sum) && ((ezom_double_t*)EZOM_OBJECT_PTR(sum))->value == 3.5);
+
+    assert(ezom_send1(bench, selector("find:"), ezom_create_integer(7)) == ezom_create_integer(70));
+    assert(ezom_send1(bench, selector("find:"), ezom_create_integer(99)) == ezom_create_integer(0));
+    assert(!g_frame_stack.returning);
+
+    printf("✓ SmallInteger overflow, 1.5 + 2 and [^i * 10] from a block\n");
+}
+
+// A method installed in Integer drops compiled code, which inlines its
+// arithmetic; the method warms up again. A lookup cache flush does not.
+void test_invalidate(void) {
+    printf("=== JIT Invalidation Test ===\n");
+
+    uint24_t bench = ezom_create_instance(g_bench_class);
+    uint32_t invalidated = g_jit_stats.invalidated;
+    uint32_t resets = g_jit_stats.region_resets;
+    ezom_method_cache_flush();
+    assert(compare("fib:", 10) == ezom_create_integer(55));
+    assert(g_jit_stats.invalidated == invalidated);
+
+    // Every translation is now stale, so the region starts over
+    ezom_install_method_in_class(g_integer_class, "jitProbe", PRIM_OBJECT_IS_NIL, 0, true);
+    assert(compare("fib:", 10) == ezom_create_integer(55));
+    assert(g_jit_stats.invalidated > invalidated);
+    assert(g_jit_stats.region_resets == resets + 1);
+    assert(ezom_send1(bench, selector("fib:"), ezom_create_integer(12)) == ezom_create_integer(144));
+
+    printf("✓ %u translations dropped and rebuilt in a fresh region\n", g_jit_stats.invalidated);
+}
+
+int main() {
+    printf("=== JIT Tests ===\n");
+
+    test_init_vm();
+
+    g_bench_class = define_class(
+        "Bench = Object ( | total | "
+        "fib: n = ( n < 2 ifTrue: [^n]. ^(self fib: n - 1) + (self fib: n - 2) ) "
+        "loop: n = ( | sum i | sum := 0. i := 0. total := 0. "
+        "[i < n] whileTrue: [sum := sum + i. i := i + 1]. "
+        "1 to: n do: [:k | sum := sum - k + 1]. "
+        "n timesRepeat: [total := total + 1]. ^sum + total ) "
+        "add: a to: b = ( ^a + b ) "
+        "find: n = ( | blk | blk := [:i | i = n ifTrue: [^i * 10]]. 1 to: 20 do: blk. ^0 ) )");
+
+    test_benchmarks();
+    test_slow_paths();
+    test_invalidate();
+
+    printf("\n=== All JIT Tests Passed! ===\n");
+    return 0;
+}
+
+#else
+
+int main() {
+    printf("=== JIT Tests ===\n");
+    printf("Built without -DEZOM_JIT: nothing to test\n");
+    return 0;
+}
+
+#endif
@@ -0,0 +1,79 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "include/ezom_object.h"
+#include "include/ezom_memory.h"
+#include "include/ezom_primitives.h"
+#include "include/ezom_dispatch.h"
+#include "include/ezom_lexer.h"
+#include "include/ezom_parser.h"
+#include "include/ezom_evaluator.h"
+
+static ezom_ast_node_t* parse(const char* code) {
+    static ezom_lexer_t lexer;
+    static ezom_parser_t parser;
+    ezom_lexer_init(&lexer, (char*)code);
+    ezom_parser_init(&parser, &lexer);
+    ezom_ast_node_t* ast = ezom_parse_expression(&parser);
+    assert(ast != NULL);
+    return ast;
+}
+
+// Re-evaluating a literal node answers the same object and allocates nothing
+void test_literal_identity() {
+    printf("=== Literal Identity Test ===\n");
+
+    const char* sources[] = {"'Fib('", "#answer", "2.5", "#(1 two 'three' 4.0 nil)"};
+    for (size_t i = 0; i < sizeof(sources) / sizeof(sources[0]); i++) {
+        ezom_ast_node_t* ast = parse(sources[i]);
+        uint24_t first = ezom_evaluate_ast(ast, 0).value;
+        assert(first != 0 && first != g_nil);
+        assert(ezom_is_fixed(first));
+
+        uint16_t bytes_before = g_heap.bytes_allocated;
+        for (int n = 0; n < 100; n++) {
+            assert(ezom_evaluate_ast(ast, 0).value == first);
+        }
+        assert(g_heap.bytes_allocated == bytes_before);
+    }
+
+    printf("✓ Literals materialize once per node\n");
+}
+
+// Literal arrays are real constant arrays
+void test_literal_array() {
+    printf("=== Literal Array Test ===\n");
+
+    uint24_t array_ptr = ezom_evaluate_ast(parse("#(1 #(2 3) true foo)"), 0).value;
+    assert(ezom_is_array(array_ptr));
+
+    ezom_array_t* array = (ezom_array_t*)EZOM_OBJECT_PTR(array_ptr);
+    assert(array->size == 4);
+    assert(array->elements[0] == ezom_create_integer(1));
+    assert(ezom_is_array(array->elements[1]) && ezom_is_fixed(array->elements[1]));
+    assert(array->elements[2] == g_true);
+    assert(array->elements[3] == ezom_create_symbol("foo", 3));
+
+    uint24_t args[2] = {ezom_create_integer(1), ezom_create_integer(9)};
+    assert(g_primitives[PRIM_ARRAY_AT_PUT](array_ptr, args, 2) == 0);
+    assert(array->elements[0] == ezom_create_integer(1));
+
+    printf("✓ Nested literal array is fixed and read-only\n");
+}
+
+int main() {
+    printf("=== Literal Pool Tests ===\n");
+
+    ezom_init_memory();
+    ezom_init_object_system();
+    ezom_init_primitives();
+    ezom_bootstrap_enhanced_classes();
+
+    test_literal_identity();
+    test_literal_array();
+
+    printf("  %d literal objects, %d bytes\n", g_literal_stats.objects, g_literal_stats.bytes);
+    printf("\n=== All Literal Pool Tests Passed! ===\n");
+    return 0;
+}
@@ -0,0 +1,86 @@
+#include "test_support.h"
+
+// The second lookup of a (class, selector) pair is answered from the cache
+void test_hit_after_lookup(void) {
+    printf("=== Method Cache Hit Test ===\n");
+
+    ezom_method_cache_flush();
+    uint24_t println = selector("println");
+    ezom_method_cache_stats_t before = g_method_cache_stats;
+
+    ezom_method_lookup_t first = ezom_lookup_method(g_integer_class, println);
+    assert(first.method != NULL);
+    assert(g_method_cache_stats.misses == before.misses + 1);
+    assert(g_method_cache_stats.hits == before.hits);
+
+    ezom_method_lookup_t second = ezom_lookup_method(g_integer_class, println);
+    assert(second.method == first.method && second.class_ptr == first.class_ptr);
+    assert(g_method_cache_stats.misses == before.misses + 1);
+    assert(g_method_cache_stats.hits == before.hits + 1);
+    assert(g_method_cache_stats.negative_hits == before.negative_hits);
+
+    printf("✓ Integer>>println walked once, then hit\n");
+}
+
+// A selector nobody understands is cached as a miss
+void test_cached_miss(void) {
+    printf("=== Method Cache Negative Entry Test ===\n");
+
+    uint24_t probe = selector("cacheProbe");
+    ezom_method_cache_stats_t before = g_method_cache_stats;
+
+    assert(ezom_lookup_method(g_integer_class, probe).method == NULL);
+    assert(g_method_cache_stats.misses == before.misses + 1);
+
+    assert(ezom_lookup_method(g_integer_class, probe).method == NULL);
+    assert(g_method_cache_stats.misses == before.misses + 1);
+    assert(g_method_cache_stats.hits == before.hits + 1);
+    assert(g_method_cache_stats.negative_hits == before.negative_hits + 1);
+
+    printf("✓ Integer>>cacheProbe not understood, answered from the cache\n");
+}
+
+// Installing a method drops the entries for its selector, so both a cached
+// miss and an inherited hit see the new method on the next lookup
+void test_install_invalidates(void) {
+    printf("=== Method Cache Invalidation Test ===\n");
+
+    uint24_t probe_class = ezom_create_class_with_inheritance("CacheProbe", g_object_class, 0);
+    uint24_t probe = selector("cacheProbe");
+    assert(ezom_lookup_method(probe_class, probe).method == NULL);
+
+    ezom_method_cache_stats_t before = g_method_cache_stats;
+    ezom_install_method_in_class(g_object_class, "cacheProbe", 1, 0, true);
+    // Dropped on its own, or with everything else if the dictionary grew
+    assert(g_method_cache_stats.invalidations + g_method_cache_stats.flushes >
+           before.invalidations + before.flushes);
+
+    ezom_method_lookup_t inherited = ezom_lookup_method(probe_class, probe);
+    assert(inherited.method != NULL && ezom_symbols_equal(inherited.method->selector, probe));
+    assert(inherited.method == ezom_lookup_method_uncached(g_object_class, probe).method);
+    assert(g_method_cache_stats.misses == before.misses + 1);
+    assert(ezom_lookup_method(probe_class, probe).method == inherited.method);
+    assert(g_method_cache_stats.hits == before.hits + 1);
+
+    // An override in the subclass replaces the cached inherited method
+    ezom_install_method_in_class(probe_class, "cacheProbe", 1, 0, true);
+    ezom_method_lookup_t own = ezom_lookup_method(probe_class, probe);
+    assert(own.method != NULL && own.method != inherited.method);
+    assert(g_method_cache_stats.misses == before.misses + 2);
+
+    printf("✓ Cached miss and inherited entry refreshed after install\n");
+}
+
+int main() {
+    printf("=== Method Cache Tests ===\n");
+
+    test_init_vm();
+
+    test_hit_after_lookup();
+    test_cached_miss();
+    test_install_invalidates();
+
+    ezom_method_cache_print_stats();
+    printf("\n=== All Method Cache Tests Passed! ===\n");
+    return 0;
+}
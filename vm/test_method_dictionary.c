@@ -0,0 +1,84 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "include/ezom_object.h"
+#include "include/ezom_memory.h"
+#include "include/ezom_primitives.h"
+#include "include/ezom_dispatch.h"
+#include "include/ezom_evaluator.h"
+
+#define TEST_METHOD_COUNT 80
+
+// Hashed method dictionary: grows past its initial capacity, finds
+// every selector, and overrides in place
+void test_dictionary_growth() {
+    printf("=== Method Dictionary Growth Test ===\n");
+
+    uint24_t dict_ptr = ezom_create_method_dictionary(4);
+    assert(dict_ptr != 0);
+    ezom_method_dict_t* dict = (ezom_method_dict_t*)EZOM_OBJECT_PTR(dict_ptr);
+    uint16_t initial_capacity = dict->capacity;
+
+    char name[16];
+    for (int i = 0; i < TEST_METHOD_COUNT; i++) {
+        sprintf(name, "sel%d:", i);
+        uint24_t selector = ezom_create_symbol(name, strlen(name));
+        assert(ezom_method_dict_put(dict, selector, i, 1, EZOM_METHOD_PRIMITIVE) != NULL);
+    }
+
+    assert(dict->size == TEST_METHOD_COUNT);
+    assert(dict->capacity > initial_capacity);
+    assert((dict->capacity & (dict->capacity - 1)) == 0);
+
+    for (int i = 0; i < TEST_METHOD_COUNT; i++) {
+        sprintf(name, "sel%d:", i);
+        ezom_method_t* method = ezom_method_dict_find(dict, ezom_create_symbol(name, strlen(name)));
+        assert(method != NULL);
+        assert(method->code == (uint24_t)i);
+    }
+    assert(ezom_method_dict_find(dict, ezom_create_symbol("missing", 7)) == NULL);
+
+    // Override keeps the size unchanged
+    uint24_t selector = ezom_create_symbol("sel7:", 5);
+    ezom_method_dict_put(dict, selector, 99, 1, EZOM_METHOD_PRIMITIVE);
+    assert(dict->size == TEST_METHOD_COUNT);
+    assert(ezom_method_dict_find(dict, selector)->code == 99);
+
+    printf("✓ %d methods installed, capacity %d -> %d\n",
+           TEST_METHOD_COUNT, initial_capacity, dict->capacity);
+}
+
+// Installing more methods than the class dictionary was created with
+void test_class_install() {
+    printf("=== Class Method Install Test ===\n");
+
+    char name[16];
+    for (int i = 0; i < TEST_METHOD_COUNT; i++) {
+        sprintf(name, "extra%d", i);
+        ezom_install_method_in_class(g_object_class, name, 1, 0, true);
+    }
+
+    for (int i = 0; i < TEST_METHOD_COUNT; i++) {
+        sprintf(name, "extra%d", i);
+        ezom_method_lookup_t lookup = ezom_lookup_method(g_integer_class, ezom_create_symbol(name, strlen(name)));
+        assert(lookup.method != NULL);
+    }
+
+    printf("✓ Inherited lookups resolve after dictionary growth\n");
+}
+
+int main() {
+    printf("=== Method Dictionary Tests ===\n");
+
+    ezom_init_memory();
+    ezom_init_object_system();
+    ezom_init_primitives();
+    ezom_bootstrap_enhanced_classes();
+
+    test_dictionary_growth();
+    test_class_install();
+
+    printf("\n=== All Method Dictionary Tests Passed! ===\n");
+    return 0;
+}
@@ -0,0 +1,69 @@
+#include "test_support.h"
+
+static uint24_t g_returns_class;
+
+// ^ in a block answers from the method the block was made in
+void test_return_to_home(void) {
+    printf("=== Home Return Test ===\n");
+
+    uint24_t returns = ezom_create_instance(g_returns_class);
+    uint32_t count = g_frame_stack.nonlocal_returns;
+
+    // Through a value send, and through another method
+    assert(send0(returns, "direct") == ezom_create_integer(1));
+    assert(send0(returns, "deep") == ezom_create_integer(42));
+    assert(!g_frame_stack.returning);
+    assert(g_frame_stack.nonlocal_returns == count + 2);
+
+    printf("✓ [^1] value and self through: [^42] answer from their home\n");
+}
+
+// A primitive loop stops at the ^
+void test_loop_exit(void) {
+    printf("=== Loop Exit Test ===\n");
+
+    uint24_t returns = ezom_create_instance(g_returns_class);
+    assert(send0(returns, "stop") == ezom_create_integer(3));
+    assert(send0(returns, "ran") == ezom_create_integer(3));
+
+    printf("✓ 1 to: 10 do: blk left the loop at 3\n");
+}
+
+// The home method has returned: ^ fails and nothing unwinds
+void test_dead_home(void) {
+    printf("=== Dead Home Test ===\n");
+
+    uint24_t returns = ezom_create_instance(g_returns_class);
+    uint24_t block = send0(returns, "escaped");
+    uint24_t args[1] = {ezom_create_integer(7)};
+    assert(ezom_block_evaluate(block, args, 1) == g_nil);
+    assert(!g_frame_stack.returning);
+
+    printf("✓ [:x | ^x] after escaped returned answers nil\n");
+}
+
+static void engine_tests(void) {
+    test_return_to_home();
+    test_loop_exit();
+    test_dead_home();
+}
+
+int main() {
+    printf("=== Non-local Return Tests ===\n");
+
+    test_init_vm();
+
+    g_returns_class = define_class(
+        "Returns = Object ( | ran | "
+        "direct = ( [^1] value. ^0 ) "
+        "deep = ( self through: [^42]. ^0 ) "
+        "through: blk = ( blk value. ^0 ) "
+        "stop = ( | blk | blk := [:i | ran := i. i = 3 ifTrue: [^i]]. 1 to: 10 do: blk. ^0 ) "
+        "ran = ( ^ran ) "
+        "escaped = ( ^[:x | ^x] ) )");
+
+    run_on_each_engine(engine_tests);
+
+    printf("\n=== All Non-local Return Tests Passed! ===\n");
+    return 0;
+}
@@ -0,0 +1,99 @@
+#include "test_support.h"
+#include "include/ezom_optimizer.h"
+
+// First statement of a method's optimized body
+static ezom_ast_node_t* first_statement(uint24_t class_ptr, const char* name) {
+    ezom_method_t* method = ezom_lookup_method(class_ptr, selector(name)).method;
+    assert(method != NULL);
+    ezom_method_code_t* code = (ezom_method_code_t*)EZOM_OBJECT_PTR(method->code);
+    ezom_ast_node_t* method_ast = (ezom_ast_node_t*)code->ast_node;
+    return method_ast->data.method_def.body->data.statement_list.statements;
+}
+
+// Parsed methods: folded, cut after ^ and incremented, answering what
+// the source says
+void test_parsed_methods(void) {
+    printf("=== Optimizer Parsed Method Test ===\n");
+
+    ezom_optimizer_stats_t before = g_optimizer_stats;
+    ezom_optimizer_configure(true, true);
+    uint24_t calc_class = define_class(
+        "Calc = Object ( | total | "
+        "fold = ( ^3 + 4 * 2 - (10 < 20 ifTrue: [1] ifFalse: [2]) ) "
+        "dead = ( ^42. 'never' println. ^0 ) "
+        "count: n = ( | i | i := 0. total := 0. "
+        "[i < n] whileTrue: [i := i + 1. total := total + 2]. total := total - 1. ^total ) )");
+    assert(g_optimizer_stats.folded - before.folded == 3 && g_optimizer_stats.dead - before.dead == 2 &&
+           g_optimizer_stats.increments - before.increments == 3);
+
+    ezom_ast_node_t* fold = first_statement(calc_class, "fold");
+    ezom_ast_node_t* value = fold->data.return_stmt.expression->data.message_send.receiver;
+    assert(value->type == AST_LITERAL && value->data.literal.value.integer_value == 14);
+    ezom_ast_node_t* test = fold->data.return_stmt.expression->data.message_send.arguments->data.message_send.receiver;
+    assert(test->type == AST_LITERAL && test->data.literal.type == LITERAL_TRUE);
+    assert(first_statement(calc_class, "dead")->next == NULL);
+
+    uint24_t calc = ezom_create_instance(calc_class);
+    assert(ezom_send0(calc, selector("fold")) == ezom_create_integer(13));
+    assert(ezom_send0(calc, selector("dead")) == ezom_create_integer(42));
+    assert(ezom_send1(calc, selector("count:"), ezom_create_integer(100)) == ezom_create_integer(199));
+
+    // The AST engine runs the increments itself
+    ezom_set_engine(EZOM_ENGINE_AST);
+    assert(ezom_send1(calc, selector("count:"), ezom_create_integer(100)) == ezom_create_integer(199));
+    ezom_set_engine(EZOM_ENGINE_BYTECODE);
+
+    printf("✓ fold answers 13, dead 42 and count: 100 199 on both engines\n");
+}
+
+// Hand-built trees: nested and single-statement lists go, and a sum past
+// SmallInteger stays a send
+void test_flatten(void) {
+    printf("=== Optimizer Flattening Test ===\n");
+
+    ezom_ast_node_t* nested = ezom_ast_create_statement_list();
+    ezom_ast_add_statement(nested, ezom_ast_create_literal_integer(1));
+    ezom_ast_add_statement(nested, ezom_ast_create_literal_integer(2));
+
+    ezom_ast_node_t* sum = ezom_ast_create_message_send(ezom_ast_create_literal_integer(5), "+");
+    ezom_ast_add_argument(sum, ezom_ast_create_literal_integer(6));
+    ezom_ast_node_t* wrapper = ezom_ast_create_statement_list();
+    ezom_ast_add_statement(wrapper, sum);
+
+    ezom_ast_node_t* overflow = ezom_ast_create_message_send(ezom_ast_create_literal_integer(EZOM_SMALLINT_MAX), "+");
+    ezom_ast_add_argument(overflow, ezom_ast_create_literal_integer(1));
+
+    ezom_ast_node_t* method = ezom_ast_create_method_def("flat", false);
+    method->data.method_def.body = ezom_ast_create_statement_list();
+    ezom_ast_add_statement(method->data.method_def.body, nested);
+    ezom_ast_add_statement(method->data.method_def.body, overflow);
+    ezom_ast_add_statement(method->data.method_def.body, ezom_ast_create_return(wrapper));
+
+    // The list and the wrapper go, 5 + 6 becomes 11
+    assert(ezom_optimize_method(method) == 4);
+
+    ezom_ast_node_t* stmt = method->data.method_def.body->data.statement_list.statements;
+    assert(method->data.method_def.body->data.statement_list.count == 4);
+    assert(stmt->type == AST_LITERAL && stmt->data.literal.value.integer_value == 1);
+    stmt = stmt->next->next;
+    assert(stmt->type == AST_MESSAGE_SEND);
+    stmt = stmt->next;
+    assert(stmt->type == AST_RETURN && stmt->next == NULL);
+    assert(stmt->data.return_stmt.expression->type == AST_LITERAL &&
+           stmt->data.return_stmt.expression->data.literal.value.integer_value == 11);
+
+    printf("✓ 4 nodes removed, %ld + 1 left as a send\n", (long)EZOM_SMALLINT_MAX);
+}
+
+int main() {
+    printf("=== Optimizer Tests ===\n");
+
+    test_init_vm();
+
+    test_parsed_methods();
+    test_flatten();
+
+    ezom_optimizer_print_stats();
+    printf("\n=== All Optimizer Tests Passed! ===\n");
+    return 0;
+}
@@ -230,8 +230,7 @@ bool test_evaluator_literals() {
     ASSERT(!result.is_error);
     ASSERT(result.value != 0);
     
-    ezom_integer_t* int_obj = (ezom_integer_t*)result.value;
-    ASSERT(int_obj->value == 42);
+    ASSERT(EZOM_SMALLINT_VALUE(result.value) == 42);
     
     // Test string literal
     ezom_ast_node_t* str_node = ezom_ast_create_literal_string("hello");
@@ -292,8 +291,7 @@ bool test_integration_simple() {
     ASSERT(!result.is_error);
     ASSERT(result.value != 0);
     
-    ezom_integer_t* int_obj = (ezom_integer_t*)result.value;
-    ASSERT(int_obj->value == 42);
+    ASSERT(EZOM_SMALLINT_VALUE(result.value) == 42);
     
     ezom_ast_free(expr);
     return true;
@@ -309,8 +307,7 @@ bool test_context_system() {
     uint24_t value = ezom_context_get_local(context, 0);
     ASSERT(value != 0);
     
-    ezom_integer_t* int_obj = (ezom_integer_t*)value;
-    ASSERT(int_obj->value == 42);
+    ASSERT(EZOM_SMALLINT_VALUE(value) == 42);
     
     return true;
 }
@@ -332,8 +329,7 @@ bool test_block_objects() {
     uint24_t result = ezom_block_evaluate(block_obj, NULL, 0);
     ASSERT(result != 0);
     
-    ezom_integer_t* int_obj = (ezom_integer_t*)result;
-    ASSERT(int_obj->value == 42);
+    ASSERT(EZOM_SMALLINT_VALUE(result) == 42);
     
     ezom_ast_free(block_ast);
     return true;
@@ -0,0 +1,200 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "include/ezom_object.h"
+#include "include/ezom_memory.h"
+#include "include/ezom_primitives.h"
+#include "include/ezom_dispatch.h"
+#include "include/ezom_context.h"
+#include "include/ezom_lexer.h"
+#include "include/ezom_parser.h"
+#include "include/ezom_evaluator.h"
+#include "include/ezom_resolver.h"
+
+static ezom_ast_node_t* parse(const char* code) {
+    static ezom_lexer_t lexer;
+    static ezom_parser_t parser;
+    ezom_lexer_init(&lexer, (char*)code);
+    ezom_parser_init(&parser, &lexer);
+    ezom_ast_node_t* ast = ezom_parse_statement(&parser);
+    assert(ast != NULL);
+    return ast;
+}
+
+static void assert_variable(ezom_ast_node_t* node, ezom_var_kind_t kind, uint8_t capture, uint16_t index) {
+    assert(node->type == AST_VARIABLE_DEF);
+    assert(node->data.variable.kind == kind);
+    assert(node->data.variable.capture == capture);
+    assert(node->data.variable.index == index);
+}
+
+// Block parameters and locals become frame slots; a closure reads outer
+// ones from its captures, and t, captured and assigned, is boxed
+void test_lexical_addresses() {
+    printf("=== Lexical Address Test ===\n");
+
+    ezom_ast_node_t* block = parse("[:x | | t | t := x. [:y | t + y + self]]");
+    ezom_resolve_program(block);
+
+    ezom_ast_node_t* assign = block->data.block.body->data.statement_list.statements;
+    assert(assign->type == AST_ASSIGNMENT);
+    assert_variable(assign->data.assignment.variable, AST_VAR_CONTEXT, AST_NO_CAPTURE, 1);
+    assert_variable(assign->data.assignment.value, AST_VAR_CONTEXT, AST_NO_CAPTURE, 0);
+    assert(assign->data.assignment.variable->data.variable.boxed);
+    assert(!assign->data.assignment.value->data.variable.boxed);
+    assert(block->data.block.vars->boxed_count == 1 && block->data.block.vars->boxed[0] == 1);
+
+    // t + y + self parses as (t + y) + self
+    ezom_ast_node_t* inner = assign->next;
+    assert(inner->type == AST_BLOCK);
+    ezom_ast_node_t* outer_sum = inner->data.block.body->data.statement_list.statements;
+    ezom_ast_node_t* sum = outer_sum->data.message_send.receiver;
+    assert_variable(sum->data.message_send.receiver, AST_VAR_CONTEXT, 0, 1);
+    assert_variable(sum->data.message_send.arguments, AST_VAR_CONTEXT, AST_NO_CAPTURE, 0);
+    assert_variable(outer_sum->data.message_send.arguments, AST_VAR_SELF, 1, 0);
+    assert(sum->data.message_send.receiver->data.variable.boxed);
+
+    // self reaches the inner block through the outer block's copy
+    ezom_block_vars_t* inner_vars = inner->data.block.vars;
+    assert(inner_vars->capture_count == 2);
+    assert(inner_vars->captures[0].source == AST_CAPTURE_LOCAL && inner_vars->captures[0].index == 1);
+    assert(inner_vars->captures[1].source == AST_CAPTURE_OUTER && inner_vars->captures[1].index == 0);
+    assert(block->data.block.vars->capture_count == 1);
+    assert(block->data.block.vars->captures[0].source == AST_CAPTURE_SELF);
+
+    printf("✓ Parameters, locals and self resolved to slots and captures\n");
+}
+
+// Reserved words become literals; other names share one binding cell
+void test_globals() {
+    printf("=== Global Binding Test ===\n");
+
+    ezom_ast_node_t* ast = parse("counter := counter + (nil isNil ifTrue: [1] ifFalse: [2])");
+    ezom_resolve_program(ast);
+
+    ezom_ast_node_t* target = ast->data.assignment.variable;
+    ezom_ast_node_t* read = ast->data.assignment.value->data.message_send.receiver;
+    assert(target->data.variable.kind == AST_VAR_GLOBAL);
+    assert(read->data.variable.kind == AST_VAR_GLOBAL);
+    assert(target->data.variable.global == read->data.variable.global);
+
+    ezom_ast_node_t* condition = ast->data.assignment.value->data.message_send.arguments;
+    ezom_ast_node_t* nil_node = condition->data.message_send.receiver->data.message_send.receiver;
+    assert(nil_node->type == AST_LITERAL && nil_node->data.literal.type == LITERAL_NIL);
+
+    // Unassigned globals are still undefined
+    uint24_t context = ezom_create_extended_context(0, 0, 0, 0);
+    assert(ezom_evaluate_ast(ast, context).is_error);
+
+    ezom_set_global("counter", ezom_create_integer(41));
+    assert(ezom_evaluate_ast(ast, context).value == ezom_create_integer(42));
+    assert(ezom_lookup_global("counter") == ezom_create_integer(42));
+
+    printf("✓ Global references share one binding cell\n");
+}
+
+// Block locals are found by slot while a loop runs
+void test_block_evaluation() {
+    printf("=== Resolved Block Evaluation Test ===\n");
+
+    ezom_ast_node_t* ast = parse("1 to: 3 do: [:i | | square | square := i * i. total := total + square]");
+    uint8_t slots = ezom_resolve_program(ast);
+    assert(slots == 2);
+
+    ezom_set_global("total", ezom_create_integer(0));
+    uint24_t context = ezom_create_extended_context(0, 0, 0, slots);
+    assert(!ezom_evaluate_ast(ast, context).is_error);
+    assert(ezom_lookup_global("total") == ezom_create_integer(14));
+
+    printf("✓ 1*1 + 2*2 + 3*3 = 14\n");
+}
+
+// Instance variables resolve to slots after the superclass's
+void test_instance_variables() {
+    printf("=== Instance Variable Slot Test ===\n");
+
+    static ezom_lexer_t lexer;
+    static ezom_parser_t parser;
+    ezom_lexer_init(&lexer, "Point = Object ( | x y | x: ax y: ay = ( x := ax. y := ay ) sum = ( ^x + y ) )");
+    ezom_parser_init(&parser, &lexer);
+    ezom_ast_node_t* class_ast = ezom_parse_class_definition(&parser);
+    assert(class_ast != NULL);
+
+    uint24_t point_class = ezom_evaluate_class_definition(class_ast, 0).value;
+    assert(ezom_find_instance_variable_index_in_class(point_class, "y") == 1);
+
+    ezom_ast_node_t* setter = class_ast->data.class_def.instance_methods->data.statement_list.statements;
+    ezom_ast_node_t* sum = setter->next;
+    ezom_ast_node_t* assign_y = setter->data.method_def.body->data.statement_list.statements->next;
+    assert_variable(assign_y->data.assignment.variable, AST_VAR_INSTANCE, AST_NO_CAPTURE, 1);
+    assert_variable(assign_y->data.assignment.value, AST_VAR_CONTEXT, AST_NO_CAPTURE, 1);
+
+    // Run the method bodies in contexts laid out as a send would
+    uint24_t point = ezom_create_instance(point_class);
+    uint24_t setter_context = ezom_create_extended_context(0, point, 0, 2);
+    ezom_context_set_local(setter_context, 0, ezom_create_integer(3));
+    ezom_context_set_local(setter_context, 1, ezom_create_integer(4));
+    ezom_evaluate_method_body(setter->data.method_def.body, setter_context);
+
+    uint24_t sum_context = ezom_create_extended_context(0, point, 0, 0);
+    ezom_eval_result_t result = ezom_evaluate_method_body(sum->data.method_def.body, sum_context);
+    assert(result.is_return && result.value == ezom_create_integer(7));
+
+    printf("✓ Point 3@4 sums to 7 through instance slots\n");
+}
+
+// Blocks that reach nothing outside themselves are shared constants
+void test_clean_blocks() {
+    printf("=== Clean Block Test ===\n");
+
+    ezom_ast_node_t* adder = parse("[:x | [:y | x + y]]");
+    ezom_ast_node_t* escaper = parse("[:x | x > 0 ifTrue: [^x]. 0]");
+    ezom_ast_node_t* sorter = parse("[:a :b | a < b]");
+    ezom_resolve_program(adder);
+    ezom_resolve_program(escaper);
+    ezom_resolve_program(sorter);
+
+    ezom_ast_node_t* inner = adder->data.block.body->data.statement_list.statements;
+    assert(adder->data.block.clean && !inner->data.block.clean);
+    assert(!escaper->data.block.clean);
+    assert(sorter->data.block.clean);
+
+    // One fixed object for the clean literal, a new closure for the other
+    uint24_t context = ezom_create_extended_context(0, 0, 0, 0);
+    uint24_t first = ezom_evaluate_ast(sorter, context).value;
+    assert(ezom_evaluate_ast(sorter, context).value == first);
+    assert(ezom_is_fixed(first));
+    assert(((ezom_block_t*)EZOM_OBJECT_PTR(first))->outer_context == 0);
+
+    uint24_t args[2] = {ezom_create_integer(1), ezom_create_integer(2)};
+    assert(ezom_block_evaluate(first, args, 2) == g_true);
+
+    uint24_t add3 = ezom_block_evaluate(ezom_evaluate_ast(adder, context).value, args, 1);
+    assert(ezom_block_evaluate(add3, &args[1], 1) == ezom_create_integer(3));
+    assert(ezom_block_evaluate(ezom_evaluate_ast(adder, context).value, args, 1) != add3);
+
+    printf("✓ [:a :b | a < b] shared, [:y | x + y] still a closure\n");
+}
+
+int main() {
+    printf("=== Resolver Tests ===\n");
+
+    ezom_init_memory();
+    ezom_init_object_system();
+    ezom_init_primitives();
+    ezom_bootstrap_enhanced_classes();
+
+    test_lexical_addresses();
+    test_globals();
+    test_block_evaluation();
+    test_instance_variables();
+    test_clean_blocks();
+
+    printf("  %d context, %d instance, %d global, %d self references, %d clean blocks\n",
+           g_resolver_stats.context_refs, g_resolver_stats.instance_refs,
+           g_resolver_stats.global_refs, g_resolver_stats.self_refs,
+           g_resolver_stats.clean_blocks);
+    printf("\n=== All Resolver Tests Passed! ===\n");
+    return 0;
+}
@@ -0,0 +1,58 @@
+#include "test_support.h"
+
+static uint24_t g_pair_class;
+
+// SOM methods of every arity run through the send entry points
+void test_compiled_sends(void) {
+    printf("=== Compiled Method Send Test ===\n");
+
+    uint24_t pair = ezom_create_instance(g_pair_class);
+    uint24_t args[3] = {ezom_create_integer(9), ezom_create_integer(4), ezom_create_integer(2)};
+
+    assert(ezom_send0(pair, selector("seven")) == ezom_create_integer(7));
+    assert(ezom_send1(pair, selector("twice:"), args[0]) == ezom_create_integer(18));
+    assert(ezom_send2(pair, selector("minus:by:"), args[0], args[1]) == ezom_create_integer(5));
+    assert(ezom_sendN(pair, selector("minus:by:less:"), args, 3) == ezom_create_integer(3));
+    assert(ezom_send0(pair, selector("unknown")) == 0);
+
+    // Two and more arguments no longer answer nil
+    ezom_eval_result_t result = ezom_eval_send_keyword_message(pair, "minus:by:", args, 2, 0);
+    assert(!result.is_error && result.value == ezom_create_integer(5));
+
+    printf("✓ send0, send1, send2 and sendN ran SOM methods\n");
+}
+
+// String>>+ is an ordinary primitive now
+void test_string_concat(void) {
+    printf("=== String Concatenation Test ===\n");
+
+    uint24_t hello = ezom_create_string("Hello, ", 7);
+    uint24_t world = ezom_create_string("World", 5);
+    uint24_t result = ezom_send1(hello, selector("+"), world);
+    assert(ezom_is_string(result));
+    ezom_string_t* string = (ezom_string_t*)EZOM_OBJECT_PTR(result);
+    assert(string->length == 12 && memcmp(string->data, "Hello, World", 12) == 0);
+
+    assert(ezom_send1(hello, selector("+"), ezom_create_integer(1)) == g_nil);
+
+    printf("✓ 'Hello, ' + 'World' and a type error\n");
+}
+
+int main() {
+    printf("=== Send Entry Point Tests ===\n");
+
+    test_init_vm();
+
+    g_pair_class = define_class(
+        "Pair = Object ( "
+        "seven = ( ^7 ) "
+        "twice: x = ( ^x + x ) "
+        "minus: x by: y = ( ^x - y ) "
+        "minus: x by: y less: z = ( ^x - y - z ) )");
+
+    test_compiled_sends();
+    test_string_concat();
+
+    printf("\n=== All Send Entry Point Tests Passed! ===\n");
+    return 0;
+}
@@ -0,0 +1,102 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "include/ezom_object.h"
+#include "include/ezom_memory.h"
+#include "include/ezom_primitives.h"
+#include "include/ezom_dispatch.h"
+
+// Tagged SmallIntegers: encoding round trips and class lookup
+void test_tagging() {
+    printf("=== SmallInteger Tagging Test ===\n");
+
+    int32_t samples[] = {0, 1, -1, 42, -42, 32767, -32768, EZOM_SMALLINT_MAX, EZOM_SMALLINT_MIN};
+    for (size_t i = 0; i < sizeof(samples) / sizeof(samples[0]); i++) {
+        uint24_t ref = ezom_create_integer(samples[i]);
+        assert(ref != 0);
+        assert(EZOM_IS_SMALLINT(ref));
+        assert(ezom_is_integer(ref));
+        assert(EZOM_SMALLINT_VALUE(ref) == samples[i]);
+        assert(ezom_class_of(ref) == g_integer_class);
+    }
+
+    // Equal values are identical references
+    assert(ezom_create_integer(7) == ezom_create_integer(7));
+    assert(!ezom_is_integer(g_nil));
+
+    printf("✓ Values round trip through the tagged encoding\n");
+}
+
+// An i + 1 loop allocates nothing
+void test_no_allocation() {
+    printf("=== Integer Arithmetic Allocation Test ===\n");
+
+    uint24_t plus = ezom_create_symbol("+", 1);
+    uint24_t less = ezom_create_symbol("<", 1);
+    uint24_t one = ezom_create_integer(1);
+    uint24_t limit = ezom_create_integer(1000);
+    uint24_t i = ezom_create_integer(0);
+
+    // Warm up caches before measuring
+    ezom_send_binary_message(i, plus, one);
+
+    uint16_t bytes_before = g_heap.bytes_allocated;
+    while (ezom_send_binary_message(i, less, limit) == g_true) {
+        i = ezom_send_binary_message(i, plus, one);
+    }
+
+    printf("  Heap bytes before: %d, after: %d\n", bytes_before, g_heap.bytes_allocated);
+    assert(EZOM_SMALLINT_VALUE(i) == 1000);
+    assert(g_heap.bytes_allocated == bytes_before);
+
+    printf("✓ 1000 additions allocated nothing\n");
+}
+
+// Results past the SmallInteger range box as LargeIntegers and come back
+void test_overflow_to_large() {
+    printf("=== LargeInteger Overflow Test ===\n");
+
+    uint24_t plus = ezom_create_symbol("+", 1);
+    uint24_t minus = ezom_create_symbol("-", 1);
+    uint24_t times = ezom_create_symbol("*", 1);
+    uint24_t equal = ezom_create_symbol("=", 1);
+    uint24_t max = ezom_create_integer(EZOM_SMALLINT_MAX);
+    uint24_t one = ezom_create_integer(1);
+
+    uint24_t big = ezom_send_binary_message(max, plus, one);
+    assert(!EZOM_IS_SMALLINT(big));
+    assert(ezom_is_integer(big));
+    assert(ezom_class_of(big) == g_large_integer_class);
+    assert(ezom_integer_value(big) == (ezom_large_int_t)EZOM_SMALLINT_MAX + 1);
+
+    // Back in range normalizes to a SmallInteger
+    uint24_t back = ezom_send_binary_message(big, minus, one);
+    assert(back == max);
+    assert(ezom_send_binary_message(big, equal, ezom_create_integer(EZOM_SMALLINT_MAX + (ezom_large_int_t)1)) == g_true);
+
+    uint24_t product = ezom_send_binary_message(max, times, max);
+    assert(ezom_integer_value(product) == (ezom_large_int_t)EZOM_SMALLINT_MAX * EZOM_SMALLINT_MAX);
+
+    char buffer[24];
+    ezom_format_integer(buffer, ezom_integer_value(big));
+    printf("  SmallInteger max + 1 = %s\n", buffer);
+
+    printf("✓ Overflow boxes and normalizes\n");
+}
+
+int main() {
+    printf("=== SmallInteger Tests ===\n");
+
+    ezom_init_memory();
+    ezom_init_object_system();
+    ezom_init_primitives();
+    ezom_bootstrap_enhanced_classes();
+
+    test_tagging();
+    test_no_allocation();
+    test_overflow_to_large();
+
+    printf("\n=== All SmallInteger Tests Passed! ===\n");
+    return 0;
+}
@@ -0,0 +1,64 @@
+#include "test_support.h"
+
+static uint24_t g_counter_class;
+
+// Hot sites rewrite themselves and give the same answers
+void test_specialize(void) {
+    printf("=== Specialization Test ===\n");
+
+    uint24_t counter = ezom_create_instance(g_counter_class);
+    ezom_send1(counter, selector("count:"), ezom_create_integer(5));
+    uint32_t specialized = g_specialize_stats.specialized;
+    uint32_t fast = g_specialize_stats.fast_sends;
+
+    // s + i, self count (a getter), i < 50 and blk value: i
+    assert(ezom_send1(counter, selector("sum:"), ezom_create_integer(100)) == ezom_create_integer(5050 + 500));
+    assert(ezom_send1(counter, selector("below:"), ezom_create_integer(100)) == ezom_create_integer(49));
+    assert(g_specialize_stats.specialized >= specialized + 4);
+    assert(g_specialize_stats.fast_sends > fast);
+
+    printf("✓ %u nodes specialized, %u fast sends\n",
+           g_specialize_stats.specialized, g_specialize_stats.fast_sends);
+}
+
+// A failed guard goes back to the generic send
+void test_despecialize(void) {
+    printf("=== Despecialization Test ===\n");
+
+    uint24_t counter = ezom_create_instance(g_counter_class);
+    uint24_t two = ezom_create_integer(2);
+    for (int i = 0; i < EZOM_SPECIALIZE_AFTER + 2; i++) {
+        assert(ezom_send2(counter, selector("add:to:"), two, two) == ezom_create_integer(4));
+    }
+    uint32_t despecialized = g_specialize_stats.despecialized;
+
+    uint24_t sum = ezom_send2(counter, selector("add:to:"), ezom_create_double(1.5), two);
+    assert(ezom_is_double(sum) && ((ezom_double_t*)EZOM_OBJECT_PTR(sum))->value == 3.5);
+    assert(g_specialize_stats.despecialized == despecialized + 1);
+    assert(ezom_send2(counter, selector("add:to:"), two, two) == ezom_create_integer(4));
+
+    printf("✓ 1.5 + 2 after 2 + 2 took the generic send\n");
+}
+
+int main() {
+    printf("=== Node Specialization Tests ===\n");
+
+    test_init_vm();
+    ezom_set_engine(EZOM_ENGINE_AST);
+
+    g_counter_class = define_class(
+        "Counter = Object ( | count | "
+        "count: n = ( count := n ) "
+        "count = ( ^count ) "
+        "sum: n = ( | s | s := 0. 1 to: n do: [:i | s := s + i + self count]. ^s ) "
+        "below: n = ( | last blk | blk := [:i | i < 50 ifTrue: [last := i]]. "
+        "1 to: n do: [:i | blk value: i]. ^last ) "
+        "add: a to: b = ( ^a + b ) )");
+
+    test_specialize();
+    test_despecialize();
+    ezom_specialize_print_stats();
+
+    printf("\n=== All Node Specialization Tests Passed! ===\n");
+    return 0;
+}
@@ -0,0 +1,62 @@
+// ============================================================================
+// File: vm/test_support.h
+// Shared fixture for the tests that run SOM classes on the VM
+// ============================================================================
+
+#pragma once
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "include/ezom_object.h"
+#include "include/ezom_memory.h"
+#include "include/ezom_primitives.h"
+#include "include/ezom_dispatch.h"
+#include "include/ezom_context.h"
+#include "include/ezom_lexer.h"
+#include "include/ezom_parser.h"
+#include "include/ezom_evaluator.h"
+#include "include/ezom_bytecode.h"
+
+static inline uint24_t selector(const char* name) {
+    return ezom_create_symbol(name, strlen(name));
+}
+
+static inline uint24_t send0(uint24_t receiver, const char* name) {
+    return ezom_send_unary_message(receiver, selector(name));
+}
+
+static inline uint24_t send1(uint24_t receiver, const char* name, uint24_t arg) {
+    return ezom_send_binary_message(receiver, selector(name), arg);
+}
+
+// Memory, classes and primitives, as the VM starts up
+static inline void test_init_vm(void) {
+    ezom_init_memory();
+    ezom_init_object_system();
+    ezom_init_primitives();
+    ezom_bootstrap_enhanced_classes();
+}
+
+// Parse and install one class definition. Method ASTs stay in use, so the
+// lexer and parser that made them are static.
+static inline uint24_t define_class(const char* source) {
+    static ezom_lexer_t lexer;
+    static ezom_parser_t parser;
+    ezom_lexer_init(&lexer, (char*)source);
+    ezom_parser_init(&parser, &lexer);
+    ezom_ast_node_t* class_ast = ezom_parse_class_definition(&parser);
+    assert(class_ast != NULL);
+    uint24_t class_ptr = ezom_evaluate_class_definition(class_ast, 0).value;
+    assert(class_ptr != 0);
+    return class_ptr;
+}
+
+// Run tests on the bytecode engine, then on the AST evaluator
+static inline void run_on_each_engine(void (*tests)(void)) {
+    ezom_engine_t engines[2] = {EZOM_ENGINE_BYTECODE, EZOM_ENGINE_AST};
+    for (int i = 0; i < 2; i++) {
+        ezom_set_engine(engines[i]);
+        tests();
+    }
+}
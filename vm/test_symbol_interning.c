@@ -0,0 +1,61 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "include/ezom_object.h"
+#include "include/ezom_memory.h"
+#include "include/ezom_primitives.h"
+#include "include/ezom_dispatch.h"
+
+// Symbol interning: equal names give the same object, no heap growth
+void test_symbol_identity() {
+    printf("=== Symbol Identity Test ===\n");
+    
+    uint24_t a = ezom_create_symbol("println", 7);
+    uint24_t b = ezom_create_symbol("println", 7);
+    uint24_t c = ezom_create_symbol("print", 5);
+    
+    assert(a != 0 && c != 0);
+    assert(a == b);
+    assert(a != c);
+    assert(ezom_symbols_equal(a, b));
+    assert(!ezom_symbols_equal(a, c));
+    
+    ezom_symbol_t* sym = (ezom_symbol_t*)EZOM_OBJECT_PTR(a);
+    assert(sym->hash_cache == ezom_hash_chars("println", 7));
+    
+    printf("✓ Equal selectors are identical objects\n");
+}
+
+void test_no_heap_growth() {
+    printf("=== Repeated Send Allocation Test ===\n");
+    
+    uint24_t receiver = ezom_create_integer(7);
+    ezom_create_symbol("isNil", 5);
+    
+    uint16_t bytes_before = g_heap.bytes_allocated;
+    for (int i = 0; i < 100; i++) {
+        uint24_t selector = ezom_create_symbol("isNil", 5);
+        ezom_send_unary_message(receiver, selector);
+    }
+    
+    printf("  Heap bytes before: %d, after: %d\n", bytes_before, g_heap.bytes_allocated);
+    assert(g_heap.bytes_allocated == bytes_before);
+    
+    printf("✓ 100 sends allocated no selector symbols\n");
+}
+
+int main() {
+    printf("=== Symbol Interning Tests ===\n");
+    
+    ezom_init_memory();
+    ezom_init_object_system();
+    ezom_init_primitives();
+    ezom_bootstrap_enhanced_classes();
+    
+    test_symbol_identity();
+    test_no_heap_growth();
+    
+    printf("\n=== All Symbol Interning Tests Passed! ===\n");
+    return 0;
+}
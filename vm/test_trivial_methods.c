@@ -0,0 +1,84 @@
+#include "test_support.h"
+
+static uint24_t g_point_class;
+
+static uint8_t trivial_kind(const char* name) {
+    ezom_method_t* method = ezom_lookup_method(g_point_class, selector(name)).method;
+    assert(method != NULL && !(method->flags & EZOM_METHOD_PRIMITIVE));
+    return ((ezom_method_code_t*)EZOM_OBJECT_PTR(method->code))->trivial;
+}
+
+// Each accessor shape gets its kind; anything more stays an ordinary method
+void test_classify(void) {
+    printf("=== Trivial Method Classification Test ===\n");
+
+    assert(trivial_kind("x") == EZOM_TRIVIAL_GETTER);
+    assert(trivial_kind("x:") == EZOM_TRIVIAL_SETTER);
+    assert(trivial_kind("y:") == EZOM_TRIVIAL_SETTER);
+    assert(trivial_kind("yourself") == EZOM_TRIVIAL_SELF);
+    assert(trivial_kind("nothing") == EZOM_TRIVIAL_SELF);
+    assert(trivial_kind("answer") == EZOM_TRIVIAL_LITERAL);
+    assert(trivial_kind("name") == EZOM_TRIVIAL_LITERAL);
+    assert(trivial_kind("second:and:") == EZOM_TRIVIAL_ARGUMENT);
+    assert(trivial_kind("sum") == EZOM_TRIVIAL_NONE);
+    assert(trivial_kind("swap:") == EZOM_TRIVIAL_NONE);
+
+    printf("✓ getter, setters, self, literals and argument; sum and swap: are not\n");
+}
+
+// Trivial methods answer as their bodies would, on both engines, and
+// push no frame
+void test_run(ezom_engine_t engine) {
+    printf("=== Trivial Method Run Test (%s) ===\n", engine == EZOM_ENGINE_AST ? "ast" : "bytecode");
+
+    ezom_set_engine(engine);
+    uint24_t point = ezom_create_instance(g_point_class);
+    uint32_t frames = g_frame_stack.frames;
+    uint32_t trivial = g_frame_stack.trivial;
+
+    assert(ezom_send1(point, selector("x:"), ezom_create_integer(3)) == point);
+    assert(ezom_send0(point, selector("x")) == ezom_create_integer(3));
+    assert(ezom_send0(point, selector("yourself")) == point);
+    assert(ezom_send0(point, selector("nothing")) == point);
+    assert(ezom_send0(point, selector("answer")) == ezom_create_integer(42));
+    assert(ezom_send2(point, selector("second:and:"), g_nil, g_true) == g_true);
+    assert(g_frame_stack.frames == frames && g_frame_stack.trivial == trivial + 6);
+
+    // A scratch Double is copied to the heap before it is stored
+    uint24_t half = ezom_create_double(0.5);
+    ezom_send1(point, selector("y:"), half);
+    uint24_t y = ezom_get_instance_variable(point, 1);
+    assert(ezom_is_double(y) && ((ezom_double_t*)EZOM_OBJECT_PTR(y))->value == 0.5);
+
+    // Sends from compiled code take the same path; sum runs with a frame
+    assert(ezom_send0(point, selector("sum")) == ezom_create_integer(3 + 42 + 4));
+    assert(g_frame_stack.frames == frames + 1);
+
+    printf("✓ %u sends without a frame\n", g_frame_stack.trivial - trivial);
+}
+
+int main() {
+    printf("=== Trivial Method Tests ===\n");
+
+    test_init_vm();
+
+    g_point_class = define_class(
+        "Point = Object ( | x y | "
+        "x = ( ^x ) "
+        "x: v = ( x := v ) "
+        "y: v = ( y := v. ^self ) "
+        "yourself = ( ^self ) "
+        "nothing = ( ) "
+        "answer = ( ^40 + 2 ) "
+        "name = ( ^'point' ) "
+        "second: a and: b = ( ^b ) "
+        "sum = ( ^self x + self answer + (self second: 3 and: 4) ) "
+        "swap: v = ( | t | t := x. x := v. ^t ) )");
+
+    test_classify();
+    test_run(EZOM_ENGINE_BYTECODE);
+    test_run(EZOM_ENGINE_AST);
+
+    printf("\n=== All Trivial Method Tests Passed! ===\n");
+    return 0;
+}